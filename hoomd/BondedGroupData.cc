@@ -303,6 +303,97 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         }
     }
 
+//! Begin a direct initialization of the local groups
+/*! \param N Number of local groups
+    \param type_mapping Names of the group types (must be the same on all ranks)
+
+    Prepares the group data to hold \a N local groups. The caller then fills the members, type (or value) and tag
+    of every group through getMembersArray(), getTypeValArray() and getTags(), and calls endLocalInitialization().
+    Every rank must hold all groups with at least one member among its local particles.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::beginLocalInitialization(unsigned int N,
+    const std::vector<std::string>& type_mapping)
+    {
+    // re-initialize data structures
+    initialize();
+
+    m_type_mapping = type_mapping;
+
+    reallocate(N);
+    m_n_groups = N;
+    }
+
+//! Finish a direct initialization of the local groups
+/*! Rebuilds the reverse-lookup table and the set of active tags from the tags of the local groups of all ranks.
+    This method must be called on all ranks.
+*/
+template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::endLocalInitialization()
+    {
+    unsigned int ntags = 0;
+        {
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::read);
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            ntags = std::max(ntags, h_group_tag.data[group_idx]+1);
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &ntags, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    // mark the tags that are in use on any rank (groups spanning several ranks are stored on each of them)
+    std::vector<unsigned char> in_use(ntags, 0);
+        {
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::read);
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            in_use[h_group_tag.data[group_idx]] = 1;
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition() && ntags > 0)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &in_use[0], ntags, MPI_UNSIGNED_CHAR, MPI_BOR, m_exec_conf->getMPICommunicator());
+
+        // member ranks are determined by the Communicator
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks, access_location::host, access_mode::overwrite);
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            for (unsigned int i = 0; i < group_size; ++i)
+                h_group_ranks.data[group_idx].idx[i] = 0;
+        }
+    #endif
+
+    m_nglobal = 0;
+    for (unsigned int tag = 0; tag < ntags; ++tag)
+        {
+        if (in_use[tag])
+            {
+            m_tag_set.insert(tag);
+            m_nglobal++;
+            }
+        else
+            m_recycled_tags.push(tag);
+        }
+    m_invalid_cached_tags = true;
+
+    // rebuild the reverse-lookup table
+    m_group_rtag.resize(ntags);
+        {
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag, access_location::host, access_mode::overwrite);
+        std::fill(h_group_rtag.data, h_group_rtag.data + ntags, GROUP_NOT_LOCAL);
+        for (unsigned int group_idx = 0; group_idx < m_n_groups; ++group_idx)
+            h_group_rtag.data[h_group_tag.data[group_idx]] = group_idx;
+        }
+
+    // notify observers
+    m_group_num_change_signal.emit();
+    notifyGroupReorder();
+    }
+
 template<unsigned int group_size, typename Group, const char *name, bool has_type_mapping>
 unsigned int BondedGroupData<group_size, Group, name, has_type_mapping>::addBondedGroup(Group g)
     {
@@ -249,6 +249,12 @@ class BondedGroupData
         //! Take a snapshot
         virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
+        //! Begin a direct initialization of the local groups
+        void beginLocalInitialization(unsigned int N, const std::vector<std::string>& type_mapping);
+
+        //! Finish a direct initialization of the local groups
+        void endLocalInitialization();
+
         //! Get local number of bonded groups
         unsigned int getN() const
             {
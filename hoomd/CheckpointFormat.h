@@ -0,0 +1,201 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file CheckpointFormat.h
+    \brief Declares helpers shared by CheckpointWriter and CheckpointReader
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_FORMAT_H__
+#define __CHECKPOINT_FORMAT_H__
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace hoomd
+{
+namespace detail
+{
+
+//! Magic bytes at the start of a checkpoint manifest
+const char checkpoint_manifest_magic[8] = {'H','O','O','M','D','C','K','M'};
+
+//! Magic bytes at the start of the checkpoint file of a domain
+const char checkpoint_domain_magic[8] = {'H','O','O','M','D','C','K','D'};
+
+//! Version of the checkpoint format
+const unsigned int checkpoint_version = 1;
+
+//! Get the name of the checkpoint manifest
+/*! \param prefix Prefix of the checkpoint files
+*/
+inline std::string checkpoint_manifest_name(const std::string& prefix)
+    {
+    return prefix + ".manifest";
+    }
+
+//! Get the name of the checkpoint file of a domain
+/*! \param prefix Prefix of the checkpoint files
+    \param timestep Timestep of the checkpoint
+    \param domain Linear index of the domain in the domain decomposition grid
+
+    Every checkpoint writes new domain files, so the files listed in the previous manifest are never overwritten.
+*/
+inline std::string checkpoint_domain_name(const std::string& prefix, uint64_t timestep, unsigned int domain)
+    {
+    std::ostringstream s;
+    s << prefix << "." << timestep << ".domain" << domain;
+    return s.str();
+    }
+
+//! Get the directory part of a checkpoint prefix, including the trailing separator
+inline std::string checkpoint_dirname(const std::string& prefix)
+    {
+    std::string::size_type pos = prefix.find_last_of('/');
+    return (pos == std::string::npos) ? std::string() : prefix.substr(0, pos+1);
+    }
+
+//! Get a checkpoint prefix without its directory part
+inline std::string checkpoint_basename(const std::string& prefix)
+    {
+    std::string::size_type pos = prefix.find_last_of('/');
+    return (pos == std::string::npos) ? prefix : prefix.substr(pos+1);
+    }
+
+//! Write a value in binary form
+template<class T>
+void checkpoint_write(std::ostream& out, const T& v)
+    {
+    out.write((const char *)&v, sizeof(T));
+    }
+
+//! Read a value in binary form
+template<class T>
+void checkpoint_read(std::istream& in, T& v)
+    {
+    in.read((char *)&v, sizeof(T));
+    }
+
+//! Write an array in binary form
+/*! \param out Stream to write to
+    \param data Data to write
+    \param n Number of elements to write
+
+    The data is written in a single call, directly from \a data.
+*/
+template<class T>
+void checkpoint_write_array(std::ostream& out, const T *data, unsigned int n)
+    {
+    if (n > 0)
+        out.write((const char *)data, sizeof(T)*n);
+    }
+
+//! Read an array in binary form
+/*! \param in Stream to read from
+    \param data Array to read into (must hold \a n elements)
+    \param n Number of elements to read
+*/
+template<class T>
+void checkpoint_read_array(std::istream& in, T *data, unsigned int n)
+    {
+    if (n > 0)
+        in.read((char *)data, sizeof(T)*n);
+    }
+
+//! Write a vector of values
+template<class T>
+void checkpoint_write_vector(std::ostream& out, const std::vector<T>& v)
+    {
+    checkpoint_write(out, (unsigned int)v.size());
+    checkpoint_write_array(out, v.data(), v.size());
+    }
+
+//! Read a vector of values
+template<class T>
+void checkpoint_read_vector(std::istream& in, std::vector<T>& v)
+    {
+    unsigned int n = 0;
+    checkpoint_read(in, n);
+    if (! in.good())
+        return;
+    v.resize(n);
+    checkpoint_read_array(in, v.data(), n);
+    }
+
+//! Write a string
+inline void checkpoint_write_string(std::ostream& out, const std::string& s)
+    {
+    checkpoint_write(out, (unsigned int)s.size());
+    out.write(s.data(), s.size());
+    }
+
+//! Read a string
+inline void checkpoint_read_string(std::istream& in, std::string& s)
+    {
+    unsigned int n = 0;
+    checkpoint_read(in, n);
+    if (! in.good())
+        return;
+    std::vector<char> buf(n);
+    checkpoint_read_array(in, buf.data(), n);
+    s.assign(buf.begin(), buf.end());
+    }
+
+//! Write a list of strings
+inline void checkpoint_write_strings(std::ostream& out, const std::vector<std::string>& v)
+    {
+    checkpoint_write(out, (unsigned int)v.size());
+    for (unsigned int i = 0; i < v.size(); ++i)
+        checkpoint_write_string(out, v[i]);
+    }
+
+//! Read a list of strings
+inline void checkpoint_read_strings(std::istream& in, std::vector<std::string>& v)
+    {
+    unsigned int n = 0;
+    checkpoint_read(in, n);
+    if (! in.good())
+        return;
+    v.resize(n);
+    for (unsigned int i = 0; i < n; ++i)
+        checkpoint_read_string(in, v[i]);
+    }
+
+//! Read the beginning of a checkpoint manifest, up to the names of the domain files
+/*! \param in Stream to read from
+    \param scalar_size Set to the size of Scalar the checkpoint was written with
+    \param timestep Set to the timestep of the checkpoint
+    \param domain_files Set to the names of the domain files, relative to the directory of the manifest
+    \returns false if \a in does not hold a manifest of this version of the format
+*/
+inline bool checkpoint_read_manifest_header(std::istream& in, unsigned int& scalar_size, uint64_t& timestep,
+    std::vector<std::string>& domain_files)
+    {
+    char magic[sizeof(checkpoint_manifest_magic)];
+    unsigned int version = 0;
+    in.read(magic, sizeof(magic));
+    checkpoint_read(in, version);
+    if (! in.good() || std::string(magic, sizeof(magic)) != std::string(checkpoint_manifest_magic, sizeof(magic)) ||
+        version != checkpoint_version)
+        return false;
+
+    checkpoint_read(in, scalar_size);
+    checkpoint_read(in, timestep);
+    checkpoint_read_strings(in, domain_files);
+    return in.good();
+    }
+
+} // end namespace detail
+} // end namespace hoomd
+
+#endif
@@ -0,0 +1,355 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file CheckpointReader.cc
+    \brief Defines the CheckpointReader class
+*/
+
+#include "CheckpointReader.h"
+#include "CheckpointFormat.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+using namespace std;
+using namespace hoomd::detail;
+namespace py = pybind11;
+
+/*! \param exec_conf Execution configuration
+    \param prefix Prefix of the checkpoint files
+
+    The manifest is read on the root rank and broadcast to all other ranks.
+*/
+CheckpointReader::CheckpointReader(std::shared_ptr<ExecutionConfiguration> exec_conf, const std::string& prefix)
+    : m_exec_conf(exec_conf), m_prefix(prefix), m_timestep(0), m_dimensions(3), m_grid(make_uint3(1,1,1))
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointReader: " << m_prefix << endl;
+
+    const std::string fname = checkpoint_manifest_name(m_prefix);
+    std::string manifest;
+    unsigned int error = 0;
+    if (m_exec_conf->isRoot())
+        {
+        std::ifstream in(fname.c_str(), std::ios::in | std::ios::binary);
+        if (in.good())
+            {
+            std::ostringstream s;
+            s << in.rdbuf();
+            manifest = s.str();
+            }
+        else
+            {
+            m_exec_conf->msg->error() << "init.read_checkpoint: Unable to open " << fname << endl;
+            error = 1;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    bcast(error, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    if (error)
+        throw runtime_error("Error reading checkpoint");
+
+    #ifdef ENABLE_MPI
+    bcast(manifest, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    std::istringstream in(manifest);
+    readManifest(in);
+    }
+
+/*! \param in Stream to read from
+*/
+void CheckpointReader::readManifest(std::istream& in)
+    {
+    const std::string fname = checkpoint_manifest_name(m_prefix);
+
+    unsigned int scalar_size = 0;
+    if (! checkpoint_read_manifest_header(in, scalar_size, m_timestep, m_domain_files))
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " is not a checkpoint manifest" << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    if (scalar_size != sizeof(Scalar))
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " was written in "
+                                  << ((scalar_size == sizeof(float)) ? "single" : "double")
+                                  << " precision, this build of HOOMD-blue cannot read it" << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    unsigned int nranks = 0;
+    checkpoint_read(in, nranks);
+    checkpoint_read(in, m_dimensions);
+
+    Scalar3 lo, hi;
+    Scalar xy, xz, yz;
+    uchar3 periodic;
+    checkpoint_read(in, lo);
+    checkpoint_read(in, hi);
+    checkpoint_read(in, xy);
+    checkpoint_read(in, xz);
+    checkpoint_read(in, yz);
+    checkpoint_read(in, periodic);
+    m_global_box = BoxDim(lo, hi, periodic);
+    m_global_box.setTiltFactors(xy, xz, yz);
+
+    checkpoint_read(in, m_grid);
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        checkpoint_read_vector(in, m_cum_frac[dir]);
+
+    checkpoint_read_strings(in, m_particle_types);
+    checkpoint_read_strings(in, m_bond_types);
+    checkpoint_read_strings(in, m_angle_types);
+    checkpoint_read_strings(in, m_dihedral_types);
+    checkpoint_read_strings(in, m_improper_types);
+    checkpoint_read_strings(in, m_pair_types);
+
+    unsigned int n_integrators = 0;
+    checkpoint_read(in, n_integrators);
+    if (in.good())
+        m_integrator_variables.resize(n_integrators);
+    for (unsigned int i = 0; i < m_integrator_variables.size(); ++i)
+        {
+        checkpoint_read_string(in, m_integrator_variables[i].type);
+        checkpoint_read_vector(in, m_integrator_variables[i].variable);
+        }
+
+    if (! in.good())
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " is truncated" << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    if (nranks != m_exec_conf->getNRanks())
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " was written on " << nranks
+                                  << " ranks, it must be read on the same number of ranks (not "
+                                  << m_exec_conf->getNRanks() << ")" << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+    }
+
+/*! \returns A snapshot without particles or groups
+
+    The snapshot holds the same data on all ranks.
+*/
+std::shared_ptr< SnapshotSystemData<Scalar> > CheckpointReader::getSnapshot() const
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snapshot(new SnapshotSystemData<Scalar>());
+
+    snapshot->dimensions = m_dimensions;
+    snapshot->global_box = m_global_box;
+    snapshot->particle_data.type_mapping = m_particle_types;
+    snapshot->bond_data.type_mapping = m_bond_types;
+    snapshot->angle_data.type_mapping = m_angle_types;
+    snapshot->dihedral_data.type_mapping = m_dihedral_types;
+    snapshot->improper_data.type_mapping = m_improper_types;
+    snapshot->pair_data.type_mapping = m_pair_types;
+    snapshot->integrator_data = m_integrator_variables;
+
+    return snapshot;
+    }
+
+#ifdef ENABLE_MPI
+/*! \returns The domain decomposition the checkpoint was written with, or a null pointer on a single rank
+*/
+std::shared_ptr<DomainDecomposition> CheckpointReader::getDomainDecomposition() const
+    {
+    if (m_exec_conf->getNRanks() == 1)
+        return std::shared_ptr<DomainDecomposition>();
+
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(m_exec_conf, m_global_box.getL(), m_grid.x, m_grid.y, m_grid.z, false));
+
+    const Index3D& di = decomposition->getDomainIndexer();
+    if (di.getW() != m_grid.x || di.getH() != m_grid.y || di.getD() != m_grid.z)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: Unable to create the " << m_grid.x << "x" << m_grid.y
+                                  << "x" << m_grid.z << " domain decomposition of the checkpoint" << endl;
+        throw runtime_error("Error reading checkpoint");
+        }
+
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        decomposition->setCumulativeFractions(dir, m_cum_frac[dir], 0);
+
+    return decomposition;
+    }
+#endif
+
+/*! \param sysdef System definition constructed from getSnapshot() and getDomainDecomposition()
+
+    Every rank reads the file of its domain. This method must be called on all ranks.
+*/
+void CheckpointReader::restore(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    unsigned int domain = 0;
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        uint3 grid_pos = decomposition->getGridPos();
+        domain = decomposition->getDomainIndexer()(grid_pos.x, grid_pos.y, grid_pos.z);
+        }
+    #endif
+
+    // the manifest lists the files of the checkpoint it commits
+    const std::string fname = (domain < m_domain_files.size()) ?
+        checkpoint_dirname(m_prefix) + m_domain_files[domain] : checkpoint_domain_name(m_prefix, m_timestep, domain);
+    std::ifstream in(fname.c_str(), std::ios::in | std::ios::binary);
+
+    char magic[sizeof(checkpoint_domain_magic)];
+    unsigned int version = 0;
+    unsigned int scalar_size = 0;
+    uint64_t timestep = 0;
+    unsigned int file_domain = 0;
+    unsigned int N = 0;
+    unsigned int accel_set = 0;
+    in.read(magic, sizeof(magic));
+    checkpoint_read(in, version);
+    checkpoint_read(in, scalar_size);
+    checkpoint_read(in, timestep);
+    checkpoint_read(in, file_domain);
+    checkpoint_read(in, N);
+    checkpoint_read(in, accel_set);
+
+    // the files of a checkpoint that was interrupted while writing do not match the manifest
+    unsigned int error = 0;
+    if (! in.good() || memcmp(magic, checkpoint_domain_magic, sizeof(magic)) != 0 || version != checkpoint_version ||
+        scalar_size != sizeof(Scalar) || timestep != m_timestep || file_domain != domain)
+        {
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " does not belong to the checkpoint of step "
+                                  << m_timestep << endl;
+        error = 1;
+        }
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (error)
+        throw runtime_error("Error reading checkpoint");
+
+    // read the particles straight into the particle data arrays
+    pdata->beginLocalInitialization(N, m_particle_types);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(pdata->getAccelerations(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(pdata->getCharges(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(pdata->getDiameters(), access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(pdata->getBodies(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(pdata->getOrientationArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(pdata->getAngularMomentumArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::overwrite);
+
+        checkpoint_read_array(in, h_pos.data, N);
+        checkpoint_read_array(in, h_vel.data, N);
+        checkpoint_read_array(in, h_accel.data, N);
+        checkpoint_read_array(in, h_charge.data, N);
+        checkpoint_read_array(in, h_diameter.data, N);
+        checkpoint_read_array(in, h_image.data, N);
+        checkpoint_read_array(in, h_body.data, N);
+        checkpoint_read_array(in, h_orientation.data, N);
+        checkpoint_read_array(in, h_angmom.data, N);
+        checkpoint_read_array(in, h_inertia.data, N);
+        checkpoint_read_array(in, h_tag.data, N);
+        }
+
+    error = in.good() ? 0 : 1;
+    if (error)
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << fname << " is truncated" << endl;
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (error)
+        throw runtime_error("Error reading checkpoint");
+
+    pdata->endLocalInitialization(accel_set);
+
+    readGroups(in, sysdef->getBondData(), m_bond_types);
+    readGroups(in, sysdef->getAngleData(), m_angle_types);
+    readGroups(in, sysdef->getDihedralData(), m_dihedral_types);
+    readGroups(in, sysdef->getImproperData(), m_improper_types);
+    readGroups(in, sysdef->getConstraintData(), std::vector<std::string>());
+    readGroups(in, sysdef->getPairData(), m_pair_types);
+    }
+
+/*! \param in Stream to read from
+    \param gdata Bonded group data to fill
+    \param types Group type names
+
+    This method must be called on all ranks.
+*/
+template<class group_data>
+void CheckpointReader::readGroups(std::istream& in,
+                                  std::shared_ptr<group_data> gdata,
+                                  const std::vector<std::string>& types)
+    {
+    unsigned int n = 0;
+    checkpoint_read(in, n);
+    if (in.good())
+        {
+        gdata->beginLocalInitialization(n, types);
+
+        ArrayHandle<typename group_data::members_t> h_members(gdata->getMembersArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(gdata->getTypeValArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(gdata->getTags(), access_location::host, access_mode::overwrite);
+
+        checkpoint_read_array(in, h_members.data, n);
+        checkpoint_read_array(in, h_typeval.data, n);
+        checkpoint_read_array(in, h_tag.data, n);
+        }
+
+    // every rank must take part in the reduction, even if its own file is broken
+    unsigned int error = in.good() ? 0 : 1;
+    if (error)
+        m_exec_conf->msg->error() << "init.read_checkpoint: " << gdata->getName() << "s in checkpoint are truncated" << endl;
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (error)
+        throw runtime_error("Error reading checkpoint");
+
+    gdata->endLocalInitialization();
+    }
+
+void export_CheckpointReader(py::module& m)
+    {
+    py::class_< CheckpointReader, std::shared_ptr<CheckpointReader> >(m,"CheckpointReader")
+    .def(py::init<std::shared_ptr<ExecutionConfiguration>, const string&>())
+    .def("getTimeStep", &CheckpointReader::getTimeStep)
+    .def("getSnapshot", &CheckpointReader::getSnapshot)
+    #ifdef ENABLE_MPI
+    .def("getDomainDecomposition", &CheckpointReader::getDomainDecomposition)
+    #endif
+    .def("restore", &CheckpointReader::restore)
+    ;
+    }
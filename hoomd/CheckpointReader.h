@@ -0,0 +1,91 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file CheckpointReader.h
+    \brief Declares the CheckpointReader class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_READER_H__
+#define __CHECKPOINT_READER_H__
+
+#include "SystemDefinition.h"
+#include "SnapshotSystemData.h"
+
+#include <istream>
+#include <string>
+#include <memory>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Reads a checkpoint written by CheckpointWriter
+/*! The system is restored in two steps:
+    1. getSnapshot() and getDomainDecomposition() provide an empty system with the box, the type names, the
+       integrator variables and the domain decomposition of the checkpoint, from which the SystemDefinition
+       is constructed.
+    2. restore() fills the SystemDefinition: every rank reads the particles and bonded groups of its own domain
+       directly into the local particle and group arrays, without any communication of particle data.
+
+    The checkpoint must be read on the same number of ranks that it was written on.
+
+    \ingroup data_structs
+*/
+class CheckpointReader
+    {
+    public:
+        //! Read the checkpoint manifest
+        CheckpointReader(std::shared_ptr<ExecutionConfiguration> exec_conf, const std::string& prefix);
+
+        //! Get the timestep of the checkpoint
+        uint64_t getTimeStep() const
+            {
+            return m_timestep;
+            }
+
+        //! Get an empty snapshot with the box, the type names, and the integrator variables
+        std::shared_ptr< SnapshotSystemData<Scalar> > getSnapshot() const;
+
+        #ifdef ENABLE_MPI
+        //! Get the domain decomposition of the checkpoint
+        std::shared_ptr<DomainDecomposition> getDomainDecomposition() const;
+        #endif
+
+        //! Read the local particles and groups
+        void restore(std::shared_ptr<SystemDefinition> sysdef);
+
+    private:
+        std::shared_ptr<ExecutionConfiguration> m_exec_conf;  //!< The execution configuration
+        std::string m_prefix;                                 //!< Prefix of the checkpoint files
+
+        uint64_t m_timestep;                            //!< Timestep of the checkpoint
+        std::vector<std::string> m_domain_files;        //!< Names of the domain files, relative to the manifest
+        unsigned int m_dimensions;                      //!< Dimensionality of the system
+        BoxDim m_global_box;                            //!< Global simulation box
+        uint3 m_grid;                                   //!< Dimensions of the domain decomposition grid
+        std::vector<Scalar> m_cum_frac[3];              //!< Cumulative fractions of the domains along each direction
+        std::vector<std::string> m_particle_types;      //!< Particle type names
+        std::vector<std::string> m_bond_types;          //!< Bond type names
+        std::vector<std::string> m_angle_types;         //!< Angle type names
+        std::vector<std::string> m_dihedral_types;      //!< Dihedral type names
+        std::vector<std::string> m_improper_types;      //!< Improper type names
+        std::vector<std::string> m_pair_types;          //!< Pair type names
+        std::vector<IntegratorVariables> m_integrator_variables;    //!< Integrator variables
+
+        //! Parse the manifest
+        void readManifest(std::istream& in);
+
+        //! Read the local groups of a bonded group data
+        template<class group_data>
+        void readGroups(std::istream& in, std::shared_ptr<group_data> gdata, const std::vector<std::string>& types);
+    };
+
+//! Exports CheckpointReader to python
+void export_CheckpointReader(pybind11::module& m);
+
+#endif
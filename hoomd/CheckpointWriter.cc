@@ -0,0 +1,332 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file CheckpointWriter.cc
+    \brief Defines the CheckpointWriter class
+*/
+
+#include "CheckpointWriter.h"
+#include "CheckpointFormat.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+using namespace std;
+using namespace hoomd::detail;
+namespace py = pybind11;
+
+//! Write the type names of particle or bonded group data
+template<class data>
+static void write_type_names(std::ostream& out, std::shared_ptr<data> d)
+    {
+    std::vector<std::string> type_mapping(d->getNTypes());
+    for (unsigned int i = 0; i < type_mapping.size(); ++i)
+        type_mapping[i] = d->getNameByType(i);
+    checkpoint_write_strings(out, type_mapping);
+    }
+
+/*! \param sysdef SystemDefinition containing the data to write
+    \param prefix Prefix of the checkpoint files
+
+    No file operations are attempted until analyze() is called.
+*/
+CheckpointWriter::CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& prefix)
+    : Analyzer(sysdef), m_prefix(prefix), m_read_committed(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CheckpointWriter: " << m_prefix << endl;
+    }
+
+CheckpointWriter::~CheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CheckpointWriter" << endl;
+    }
+
+/*! Reads the names of the domain files from an existing manifest, so that they can be removed once the first
+    checkpoint of this writer is committed. Missing or unreadable manifests list no files.
+*/
+void CheckpointWriter::readCommittedFiles()
+    {
+    m_committed_files.clear();
+    if (m_exec_conf->isRoot())
+        {
+        std::ifstream in(checkpoint_manifest_name(m_prefix).c_str(), std::ios::in | std::ios::binary);
+        unsigned int scalar_size = 0;
+        uint64_t timestep = 0;
+        if (! in.good() || ! checkpoint_read_manifest_header(in, scalar_size, timestep, m_committed_files))
+            m_committed_files.clear();
+        }
+
+    #ifdef ENABLE_MPI
+    bcast(m_committed_files, 0, m_exec_conf->getMPICommunicator());
+    #endif
+
+    m_read_committed = true;
+    }
+
+/*! \param timestep Current time step of the simulation
+
+    Writes <prefix>.<timestep>.domain<i> on every rank, where i is the index of the rank in the domain decomposition
+    grid, and then <prefix>.manifest on the root rank, which lists the domain files. The manifest is written to a
+    temporary file and renamed over the previous one, which is the only step that replaces the previous checkpoint.
+    The domain files of the previous checkpoint are removed after that. If any step fails, the new domain files are
+    removed and the previous checkpoint stays intact. This method must be called on all ranks.
+*/
+void CheckpointWriter::analyze(unsigned int timestep)
+    {
+    if (m_prof)
+        m_prof->push("Checkpoint");
+
+    if (! m_read_committed)
+        readCommittedFiles();
+
+    unsigned int domain = 0;
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        uint3 grid_pos = decomposition->getGridPos();
+        domain = decomposition->getDomainIndexer()(grid_pos.x, grid_pos.y, grid_pos.z);
+        }
+    #endif
+
+    // the names of the new files are relative to the directory of the manifest
+    const std::string dirname = checkpoint_dirname(m_prefix);
+    const std::string basename = checkpoint_basename(m_prefix);
+    std::vector<std::string> domain_files(m_exec_conf->getNRanks());
+    for (unsigned int i = 0; i < domain_files.size(); ++i)
+        domain_files[i] = checkpoint_domain_name(basename, timestep, i);
+
+    const std::string fname = dirname + domain_files[domain];
+    const std::string tmp_fname = fname + ".tmp";
+
+    // a file of the same name belongs to the committed checkpoint when it is written twice on the same step
+    const bool replaces_committed = domain < m_committed_files.size() && m_committed_files[domain] == domain_files[domain];
+
+    // write the local data, a new file only replaces one of the same step once it is complete
+    unsigned int error = 0;
+        {
+        std::ofstream out(tmp_fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (out.good())
+            {
+            writeDomain(out, timestep, domain);
+            out.close();
+            }
+        error = out.good() ? 0 : 1;
+        }
+
+    if (error || std::rename(tmp_fname.c_str(), fname.c_str()) != 0)
+        {
+        m_exec_conf->msg->error() << "dump.checkpoint: Error writing " << fname << endl;
+        std::remove(tmp_fname.c_str());
+        error = 1;
+        }
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &error, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    // all ranks have finished writing, commit the new checkpoint by replacing the manifest
+    if (! error && m_exec_conf->isRoot())
+        {
+        const std::string manifest_fname = checkpoint_manifest_name(m_prefix);
+        const std::string tmp_manifest_fname = manifest_fname + ".tmp";
+
+            {
+            std::ofstream out(tmp_manifest_fname.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            if (out.good())
+                {
+                writeManifest(out, timestep, domain_files);
+                out.close();
+                }
+            error = out.good() ? 0 : 1;
+            }
+
+        if (error || std::rename(tmp_manifest_fname.c_str(), manifest_fname.c_str()) != 0)
+            {
+            m_exec_conf->msg->error() << "dump.checkpoint: Error writing " << manifest_fname << endl;
+            std::remove(tmp_manifest_fname.c_str());
+            error = 1;
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (decomposition)
+        {
+        bcast(error, 0, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    if (error)
+        {
+        // the manifest still lists the previous checkpoint
+        if (! replaces_committed)
+            std::remove(fname.c_str());
+        throw runtime_error("Error writing checkpoint");
+        }
+
+    // the new checkpoint is committed, remove the files of the previous one that it does not reuse
+    if (domain < m_committed_files.size() && ! replaces_committed)
+        std::remove((dirname + m_committed_files[domain]).c_str());
+
+    // files of domains that no longer exist
+    if (m_exec_conf->isRoot())
+        {
+        for (unsigned int i = domain_files.size(); i < m_committed_files.size(); ++i)
+            std::remove((dirname + m_committed_files[i]).c_str());
+        }
+
+    m_committed_files = domain_files;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param out Stream to write to
+    \param timestep Current time step of the simulation
+    \param domain_files Names of the domain files, relative to the directory of the manifest
+*/
+void CheckpointWriter::writeManifest(std::ostream& out, unsigned int timestep, const std::vector<std::string>& domain_files)
+    {
+    out.write(checkpoint_manifest_magic, sizeof(checkpoint_manifest_magic));
+    checkpoint_write(out, checkpoint_version);
+    checkpoint_write(out, (unsigned int)sizeof(Scalar));
+    checkpoint_write(out, (uint64_t)timestep);
+    checkpoint_write_strings(out, domain_files);
+    checkpoint_write(out, m_exec_conf->getNRanks());
+    checkpoint_write(out, m_sysdef->getNDimensions());
+
+    // global box
+    const BoxDim& box = m_pdata->getGlobalBox();
+    checkpoint_write(out, box.getLo());
+    checkpoint_write(out, box.getHi());
+    checkpoint_write(out, box.getTiltFactorXY());
+    checkpoint_write(out, box.getTiltFactorXZ());
+    checkpoint_write(out, box.getTiltFactorYZ());
+    checkpoint_write(out, box.getPeriodic());
+
+    // domain decomposition
+    uint3 grid = make_uint3(1,1,1);
+    std::vector<Scalar> cum_frac[3];
+    #ifdef ENABLE_MPI
+    std::shared_ptr<DomainDecomposition> decomposition = m_pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        const Index3D& di = decomposition->getDomainIndexer();
+        grid = make_uint3(di.getW(), di.getH(), di.getD());
+        for (unsigned int dir = 0; dir < 3; ++dir)
+            cum_frac[dir] = decomposition->getCumulativeFractions(dir);
+        }
+    #endif
+    checkpoint_write(out, grid);
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        checkpoint_write_vector(out, cum_frac[dir]);
+
+    // type names
+    write_type_names(out, m_pdata);
+    write_type_names(out, m_sysdef->getBondData());
+    write_type_names(out, m_sysdef->getAngleData());
+    write_type_names(out, m_sysdef->getDihedralData());
+    write_type_names(out, m_sysdef->getImproperData());
+    write_type_names(out, m_sysdef->getPairData());
+
+    // integrator variables
+    std::shared_ptr<IntegratorData> integrator_data = m_sysdef->getIntegratorData();
+    unsigned int n_integrators = integrator_data->getNumIntegrators();
+    checkpoint_write(out, n_integrators);
+    for (unsigned int i = 0; i < n_integrators; ++i)
+        {
+        const IntegratorVariables& v = integrator_data->getIntegratorVariables(i);
+        checkpoint_write_string(out, v.type);
+        checkpoint_write_vector(out, v.variable);
+        }
+    }
+
+/*! \param out Stream to write to
+    \param timestep Current time step of the simulation
+    \param domain Index of the local domain
+
+    The particle arrays are written in their native layout, straight from the host copy of the local data.
+*/
+void CheckpointWriter::writeDomain(std::ostream& out, unsigned int timestep, unsigned int domain)
+    {
+    const unsigned int N = m_pdata->getN();
+
+    out.write(checkpoint_domain_magic, sizeof(checkpoint_domain_magic));
+    checkpoint_write(out, checkpoint_version);
+    checkpoint_write(out, (unsigned int)sizeof(Scalar));
+    checkpoint_write(out, (uint64_t)timestep);
+    checkpoint_write(out, domain);
+    checkpoint_write(out, N);
+    checkpoint_write(out, (unsigned int)m_pdata->isAccelSet());
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        checkpoint_write_array(out, h_pos.data, N);
+        checkpoint_write_array(out, h_vel.data, N);
+        checkpoint_write_array(out, h_accel.data, N);
+        checkpoint_write_array(out, h_charge.data, N);
+        checkpoint_write_array(out, h_diameter.data, N);
+        checkpoint_write_array(out, h_image.data, N);
+        checkpoint_write_array(out, h_body.data, N);
+        checkpoint_write_array(out, h_orientation.data, N);
+        checkpoint_write_array(out, h_angmom.data, N);
+        checkpoint_write_array(out, h_inertia.data, N);
+        checkpoint_write_array(out, h_tag.data, N);
+        }
+
+    writeGroups(out, m_sysdef->getBondData());
+    writeGroups(out, m_sysdef->getAngleData());
+    writeGroups(out, m_sysdef->getDihedralData());
+    writeGroups(out, m_sysdef->getImproperData());
+    writeGroups(out, m_sysdef->getConstraintData());
+    writeGroups(out, m_sysdef->getPairData());
+    }
+
+/*! \param out Stream to write to
+    \param gdata Bonded group data to write
+
+    Writes the members, type (or value) and tag of the local groups. Ghost groups are not written.
+*/
+template<class group_data>
+void CheckpointWriter::writeGroups(std::ostream& out, std::shared_ptr<group_data> gdata)
+    {
+    const unsigned int n = gdata->getN();
+    checkpoint_write(out, n);
+
+    ArrayHandle<typename group_data::members_t> h_members(gdata->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(gdata->getTypeValArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(gdata->getTags(), access_location::host, access_mode::read);
+
+    checkpoint_write_array(out, h_members.data, n);
+    checkpoint_write_array(out, h_typeval.data, n);
+    checkpoint_write_array(out, h_tag.data, n);
+    }
+
+void export_CheckpointWriter(py::module& m)
+    {
+    py::class_<CheckpointWriter, std::shared_ptr<CheckpointWriter> >(m,"CheckpointWriter",py::base<Analyzer>())
+        .def(py::init< std::shared_ptr<SystemDefinition>, std::string >())
+    ;
+    }
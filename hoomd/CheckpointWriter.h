@@ -0,0 +1,81 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file CheckpointWriter.h
+    \brief Declares the CheckpointWriter class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CHECKPOINT_WRITER_H__
+#define __CHECKPOINT_WRITER_H__
+
+#include "Analyzer.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Analyzer for writing restart checkpoints
+/*! CheckpointWriter writes the exact state of the system every time analyze() is called. Unlike GSDDumpWriter,
+    it does not gather the system into a snapshot on the root rank. Every rank writes the particles and bonded
+    groups it owns to its own file, straight from the particle data arrays in their native binary layout
+    (positions in full precision, including tags, images, bodies, and accelerations). The root rank writes a small
+    manifest with the global metadata: the timestep, the box, the domain decomposition, the type names, and the
+    integrator variables.
+
+    Every checkpoint writes new domain files named after its timestep, and the manifest lists them. The manifest is
+    written to a temporary file and renamed over the previous one once all ranks have written their domain files.
+    This rename is the only step that replaces the previous checkpoint, and the domain files of the previous
+    checkpoint are only removed after it. The previous checkpoint thus remains readable if the run is interrupted at
+    any point while a new one is written.
+
+    CheckpointReader restores the checkpoint on the same number of ranks and the same domain decomposition. The
+    random number generators used by the integrators are seeded by the particle tag and the timestep, so the restarted
+    run continues the same trajectory as the original one would have.
+
+    \ingroup analyzers
+*/
+class CheckpointWriter : public Analyzer
+    {
+    public:
+        //! Construct the writer
+        CheckpointWriter(std::shared_ptr<SystemDefinition> sysdef, const std::string& prefix);
+
+        //! Destructor
+        ~CheckpointWriter();
+
+        //! Write a checkpoint of the current timestep
+        void analyze(unsigned int timestep);
+
+    private:
+        std::string m_prefix;   //!< Prefix of the checkpoint files
+        std::vector<std::string> m_committed_files; //!< Domain files listed in the current manifest
+        bool m_read_committed;  //!< True once the domain files of an existing manifest have been read
+
+        //! Read the domain files listed in an existing manifest
+        void readCommittedFiles();
+
+        //! Write the manifest
+        void writeManifest(std::ostream& out, unsigned int timestep, const std::vector<std::string>& domain_files);
+
+        //! Write the local particles and groups
+        void writeDomain(std::ostream& out, unsigned int timestep, unsigned int domain);
+
+        //! Write the local groups of a bonded group data
+        template<class group_data>
+        void writeGroups(std::ostream& out, std::shared_ptr<group_data> gdata);
+    };
+
+//! Exports the CheckpointWriter class to python
+void export_CheckpointWriter(pybind11::module& m);
+
+#endif
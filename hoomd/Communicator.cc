@@ -12,6 +12,7 @@
 
 #include "Communicator.h"
 #include "System.h"
+#include "ClockSource.h"
 
 #include <algorithm>
 #include <hoomd/extern/pybind/include/pybind11/stl.h>
@@ -1361,6 +1362,48 @@ void Communicator::communicate(unsigned int timestep)
     m_is_communicating = false;
     }
 
+/*! \param num_iters Number of iterations to average for the benchmark
+    \returns Milliseconds of execution time per communication step
+
+    Forces a particle migration in every iteration, so that the full packing and exchange of the particle and
+    ghost data is benchmarked.
+*/
+double Communicator::benchmark(unsigned int num_iters)
+    {
+    ClockSource t;
+
+    // warm up run
+    forceMigrate();
+    communicate(0);
+
+#ifdef ENABLE_CUDA
+    if(m_exec_conf->isCUDAEnabled())
+        {
+        cudaDeviceSynchronize();
+        CHECK_CUDA_ERROR();
+        }
+#endif
+
+    // benchmark
+    MPI_Barrier(m_exec_conf->getMPICommunicator());
+    uint64_t start_time = t.getTime();
+    for (unsigned int i = 0; i < num_iters; i++)
+        {
+        forceMigrate();
+        communicate(0);
+        }
+
+#ifdef ENABLE_CUDA
+    if(m_exec_conf->isCUDAEnabled())
+        cudaDeviceSynchronize();
+#endif
+    MPI_Barrier(m_exec_conf->getMPICommunicator());
+    uint64_t total_time_ns = t.getTime() - start_time;
+
+    // convert the run time to milliseconds
+    return double(total_time_ns) / 1e6 / double(num_iters);
+    }
+
 //! Transfer particles between neighboring domains
 void Communicator::migrateParticles()
     {
@@ -2883,6 +2926,8 @@ const BoxDim Communicator::getShiftedBox() const
 void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator> >(m,"Communicator")
-    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >());
+    .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition> >())
+    .def("benchmark", &Communicator::benchmark)
+    ;
     }
 #endif // ENABLE_MPI
@@ -283,6 +283,9 @@ class Communicator
 
         //@}
 
+        //! Benchmark the particle migration and ghost exchange
+        double benchmark(unsigned int num_iters);
+
         //! Force particle migration
         void forceMigrate()
             {
@@ -9,7 +9,7 @@
 */
 
 #include "ComputeThermo.h"
-#include "VectorMath.h"
+#include "ComputeThermoMulti.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
@@ -19,6 +19,7 @@
 namespace py = pybind11;
 
 #include <iostream>
+#include <algorithm>
 using namespace std;
 
 /*! \param sysdef System for which to compute thermodynamic properties
@@ -28,7 +29,7 @@ using namespace std;
 ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
                              std::shared_ptr<ParticleGroup> group,
                              const std::string& suffix)
-    : Compute(sysdef), m_group(group), m_ndof(1), m_ndof_rot(0), m_logging_enabled(true)
+    : Compute(sysdef), m_group(group), m_ndof(1), m_ndof_rot(0), m_logging_enabled(true), m_batch(NULL)
     {
     m_exec_conf->msg->notice(5) << "Constructing ComputeThermo" << endl;
 
@@ -57,12 +58,18 @@ ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
 
     #ifdef ENABLE_MPI
     m_properties_reduced = true;
+    m_reduce_pending = false;
     #endif
     }
 
 ComputeThermo::~ComputeThermo()
     {
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermo" << endl;
+
+    #ifdef ENABLE_MPI
+    // complete an outstanding reduction before its buffer is freed
+    waitReduction();
+    #endif
     }
 
 /*! \param ndof Number of degrees of freedom to set
@@ -79,14 +86,25 @@ void ComputeThermo::setNDOF(unsigned int ndof)
     m_ndof = ndof;
     }
 
-/*! Calls computeProperties if the properties need updating
+/*! Calls computeProperties if the properties need updating, or computes the batch this group belongs to
     \param timestep Current time step of the simulation
 */
 void ComputeThermo::compute(unsigned int timestep)
     {
+    bool force = m_force_compute;
     if (!shouldCompute(timestep))
         return;
 
+    if (m_batch)
+        {
+        // compute the properties of all groups in the batch
+        if (force)
+            m_batch->forceCompute(timestep);
+        else
+            m_batch->compute(timestep);
+        return;
+        }
+
     computeProperties();
     }
 
@@ -185,6 +203,9 @@ Scalar ComputeThermo::getLogValue(const std::string& quantity, unsigned int time
     }
 
 /*! Computes all thermodynamic properties of the system in one fell swoop.
+
+    All per-particle sums are accumulated in a single sweep over the group members. The loop-invariant flags select
+    the requested quantities, so that every particle is loaded only once.
 */
 void ComputeThermo::computeProperties()
     {
@@ -199,148 +220,97 @@ void ComputeThermo::computeProperties()
     assert(m_pdata);
     assert(m_ndof != 0);
 
-    // access the particle data
-    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
-
-    // access the net force, pe, and virial
-    const GPUArray< Scalar4 >& net_force = m_pdata->getNetForce();
-    const GPUArray< Scalar >& net_virial = m_pdata->getNetVirial();
-    ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
-    ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
+    #ifdef ENABLE_MPI
+    // the reduction buffer must not be overwritten while a reduction is in flight
+    waitReduction();
+    #endif
 
-    // total kinetic energy
-    double ke_trans_total = 0.0;
+    double sums[thermo_sum::num_sums];
+    for (unsigned int k = 0; k < thermo_sum::num_sums; ++k)
+        sums[k] = 0.0;
 
-    PDataFlags flags = m_pdata->getFlags();
+        {
+        // access the particle data
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
 
-    double pressure_kinetic_xx = 0.0;
-    double pressure_kinetic_xy = 0.0;
-    double pressure_kinetic_xz = 0.0;
-    double pressure_kinetic_yy = 0.0;
-    double pressure_kinetic_yz = 0.0;
-    double pressure_kinetic_zz = 0.0;
+        // access the net force, pe, and virial
+        const GPUArray< Scalar >& net_virial = m_pdata->getNetVirial();
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+
+        PDataFlags flags = m_pdata->getFlags();
+
+        thermo_particle_data data;
+        data.vel = h_vel.data;
+        data.orientation = h_orientation.data;
+        data.angmom = h_angmom.data;
+        data.inertia = h_inertia.data;
+        data.net_force = h_net_force.data;
+        data.net_virial = h_net_virial.data;
+        data.virial_pitch = net_virial.getPitch();
+        data.compute_rotational = flags[pdata_flag::rotational_kinetic_energy];
+        data.compute_potential = flags[pdata_flag::potential_energy];
+        data.compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    if (flags[pdata_flag::pressure_tensor])
-        {
-        // Calculate kinetic part of pressure tensor
         for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            double mass = h_vel.data[j].w;
-            pressure_kinetic_xx += mass*(  (double)h_vel.data[j].x * (double)h_vel.data[j].x );
-            pressure_kinetic_xy += mass*(  (double)h_vel.data[j].x * (double)h_vel.data[j].y );
-            pressure_kinetic_xz += mass*(  (double)h_vel.data[j].x * (double)h_vel.data[j].z );
-            pressure_kinetic_yy += mass*(  (double)h_vel.data[j].y * (double)h_vel.data[j].y );
-            pressure_kinetic_yz += mass*(  (double)h_vel.data[j].y * (double)h_vel.data[j].z );
-            pressure_kinetic_zz += mass*(  (double)h_vel.data[j].z * (double)h_vel.data[j].z );
+            data.add(sums, h_index.data[group_idx]);
             }
-        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
-        ke_trans_total = Scalar(0.5)*(pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
         }
-    else
-        {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            ke_trans_total += (double)h_vel.data[j].w*( (double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                                + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                                + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
 
-            }
+    setLocalProperties(sums);
 
-        ke_trans_total *= Scalar(0.5);
+    #ifdef ENABLE_MPI
+    if (!m_properties_reduced)
+        {
+        // post the reduction now, it is completed when the first consumer reads a value
+        ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
+        m_reduce_buffer.assign(h_properties.data, h_properties.data + thermo_index::num_quantities);
+        #if MPI_VERSION >= 3
+        MPI_Iallreduce(MPI_IN_PLACE, &m_reduce_buffer.front(), thermo_index::num_quantities, MPI_HOOMD_SCALAR,
+            MPI_SUM, m_exec_conf->getMPICommunicator(), &m_reduce_request);
+        m_reduce_pending = true;
+        #endif
         }
+    #endif // ENABLE_MPI
 
-    // total rotational kinetic energy
-    double ke_rot_total = 0.0;
+    if (m_prof) m_prof->pop();
+    }
 
-    if (flags[pdata_flag::rotational_kinetic_energy])
-        {
-        // Calculate rotational part of kinetic energy
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+/*! \param sums Sums over the local group members, indexed by thermo_sum
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            Scalar3 I = h_inertia.data[j];
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            quat<Scalar> s(Scalar(0.5)*conj(q)*p);
-
-            // only if the moment of inertia along one principal axis is non-zero, that axis carries angular momentum
-            if (I.x >= EPSILON)
-                {
-                ke_rot_total += s.v.x*s.v.x/I.x;
-                }
-            if (I.y >= EPSILON)
-                {
-                ke_rot_total += s.v.y*s.v.y/I.y;
-                }
-            if (I.z >= EPSILON)
-                {
-                ke_rot_total += s.v.z*s.v.z/I.z;
-                }
-            }
+    Adds the external contributions, computes the pressure and stores the local values of all properties. In MPI
+    simulations, the properties are marked as not yet reduced.
+*/
+void ComputeThermo::setLocalProperties(const double *sums)
+    {
+    PDataFlags flags = m_pdata->getFlags();
 
-        ke_rot_total /= Scalar(2.0);
-        }
+    // kinetic energy = 1/2 trace of kinetic part of pressure tensor
+    double ke_trans_total = 0.5*(sums[thermo_sum::kinetic_xx] + sums[thermo_sum::kinetic_yy]
+        + sums[thermo_sum::kinetic_zz]);
+    double ke_rot_total = 0.5*sums[thermo_sum::rotational_kinetic_energy];
 
-    // total potential energy
-    double pe_total = 0.0;
+    double pe_total = sums[thermo_sum::potential_energy];
     if (flags[pdata_flag::potential_energy])
-        {
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            pe_total += (double)h_net_force.data[j].w;
-            }
-
         pe_total += m_pdata->getExternalEnergy();
-        }
 
-    double W = 0.0;
-    double virial_xx = m_pdata->getExternalVirial(0);
-    double virial_xy = m_pdata->getExternalVirial(1);
-    double virial_xz = m_pdata->getExternalVirial(2);
-    double virial_yy = m_pdata->getExternalVirial(3);
-    double virial_yz = m_pdata->getExternalVirial(4);
-    double virial_zz = m_pdata->getExternalVirial(5);
-
-    if (flags[pdata_flag::pressure_tensor])
-        {
-        // Calculate upper triangular virial tensor
-        unsigned int virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            virial_xx += (double)h_net_virial.data[j+0*virial_pitch];
-            virial_xy += (double)h_net_virial.data[j+1*virial_pitch];
-            virial_xz += (double)h_net_virial.data[j+2*virial_pitch];
-            virial_yy += (double)h_net_virial.data[j+3*virial_pitch];
-            virial_yz += (double)h_net_virial.data[j+4*virial_pitch];
-            virial_zz += (double)h_net_virial.data[j+5*virial_pitch];
-            }
+    double virial_xx = sums[thermo_sum::virial_xx] + m_pdata->getExternalVirial(0);
+    double virial_xy = sums[thermo_sum::virial_xy] + m_pdata->getExternalVirial(1);
+    double virial_xz = sums[thermo_sum::virial_xz] + m_pdata->getExternalVirial(2);
+    double virial_yy = sums[thermo_sum::virial_yy] + m_pdata->getExternalVirial(3);
+    double virial_yz = sums[thermo_sum::virial_yz] + m_pdata->getExternalVirial(4);
+    double virial_zz = sums[thermo_sum::virial_zz] + m_pdata->getExternalVirial(5);
 
-        if (flags[pdata_flag::isotropic_virial])
-            {
-            // isotropic virial = 1/3 trace of virial tensor
-            W = Scalar(1./3.) * (virial_xx + virial_yy + virial_zz);
-            }
-        }
-     else if (flags[pdata_flag::isotropic_virial])
+    // isotropic virial = 1/3 trace of virial tensor
+    double W = 0.0;
+    if (flags[pdata_flag::isotropic_virial])
         {
-        // only sum up isotropic part of virial tensor
-        unsigned int virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            W += Scalar(1./3.)* ((double)h_net_virial.data[j+0*virial_pitch] +
-                                 (double)h_net_virial.data[j+3*virial_pitch] +
-                                 (double)h_net_virial.data[j+5*virial_pitch] );
-            }
+        W = Scalar(1./3.) * (virial_xx + virial_yy + virial_zz);
         }
 
     // compute the pressure
@@ -366,12 +336,12 @@ void ComputeThermo::computeProperties()
     Scalar pressure =  (2.0 * ke_trans_total / Scalar(D) + W) / volume;
 
     // pressure tensor = (kinetic part + virial) / V
-    Scalar pressure_xx = (pressure_kinetic_xx + virial_xx) / volume;
-    Scalar pressure_xy = (pressure_kinetic_xy + virial_xy) / volume;
-    Scalar pressure_xz = (pressure_kinetic_xz + virial_xz) / volume;
-    Scalar pressure_yy = (pressure_kinetic_yy + virial_yy) / volume;
-    Scalar pressure_yz = (pressure_kinetic_yz + virial_yz) / volume;
-    Scalar pressure_zz = (pressure_kinetic_zz + virial_zz) / volume;
+    Scalar pressure_xx = (sums[thermo_sum::kinetic_xx] + virial_xx) / volume;
+    Scalar pressure_xy = (sums[thermo_sum::kinetic_xy] + virial_xy) / volume;
+    Scalar pressure_xz = (sums[thermo_sum::kinetic_xz] + virial_xz) / volume;
+    Scalar pressure_yy = (sums[thermo_sum::kinetic_yy] + virial_yy) / volume;
+    Scalar pressure_yz = (sums[thermo_sum::kinetic_yz] + virial_yz) / volume;
+    Scalar pressure_zz = (sums[thermo_sum::kinetic_zz] + virial_zz) / volume;
 
     // fill out the GPUArray
     ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
@@ -390,22 +360,48 @@ void ComputeThermo::computeProperties()
     // in MPI, reduce extensive quantities only when they're needed
     m_properties_reduced = !m_pdata->getDomainDecomposition();
     #endif // ENABLE_MPI
-
-    if (m_prof) m_prof->pop();
     }
 
 #ifdef ENABLE_MPI
+/*! Completes the reduction posted by computeProperties() and stores the result in m_properties.
+*/
 void ComputeThermo::reduceProperties()
     {
     if (m_properties_reduced) return;
 
-    // reduce properties
-    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::readwrite);
-    MPI_Allreduce(MPI_IN_PLACE, h_properties.data, thermo_index::num_quantities, MPI_HOOMD_SCALAR,
+    if (m_batch)
+        {
+        // the batch reduces the properties of all its groups at once
+        m_batch->reduceProperties();
+        return;
+        }
+
+    #if MPI_VERSION >= 3
+    waitReduction();
+    #else
+    MPI_Allreduce(MPI_IN_PLACE, &m_reduce_buffer.front(), thermo_index::num_quantities, MPI_HOOMD_SCALAR,
             MPI_SUM, m_exec_conf->getMPICommunicator());
+    #endif
+
+    // copy the reduced values
+    ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::overwrite);
+    std::copy(m_reduce_buffer.begin(), m_reduce_buffer.end(), h_properties.data);
 
     m_properties_reduced = true;
     }
+
+/*! Waits for the reduction posted by computeProperties() to finish, if one is in flight.
+*/
+void ComputeThermo::waitReduction()
+    {
+    #if MPI_VERSION >= 3
+    if (m_reduce_pending)
+        {
+        MPI_Wait(&m_reduce_request, MPI_STATUS_IGNORE);
+        m_reduce_pending = false;
+        }
+    #endif
+    }
 #endif
 
 void export_ComputeThermo(py::module& m)
@@ -11,6 +11,7 @@
 
 #include <memory>
 #include <limits>
+#include <vector>
 
 /*! \file ComputeThermo.h
     \brief Declares a class for computing thermodynamic quantities
@@ -25,6 +26,69 @@
 #ifndef __COMPUTE_THERMO_H__
 #define __COMPUTE_THERMO_H__
 
+#include "VectorMath.h"
+
+class ComputeThermoMulti;
+
+//! Pointers to the particle data needed to accumulate the thermodynamic sums on the CPU
+/*! The loop-invariant flags select which sums are accumulated. ComputeThermo and ComputeThermoMulti share this
+    helper so that single and batched computes produce identical sums.
+*/
+struct thermo_particle_data
+    {
+    const Scalar4 *vel;             //!< Velocities and masses
+    const Scalar4 *orientation;     //!< Orientations
+    const Scalar4 *angmom;          //!< Angular momenta
+    const Scalar3 *inertia;         //!< Moments of inertia
+    const Scalar4 *net_force;       //!< Net force and potential energy
+    const Scalar *net_virial;       //!< Net virial
+    unsigned int virial_pitch;      //!< Pitch of the net virial array
+    bool compute_rotational;        //!< True if the rotational kinetic energy is needed
+    bool compute_potential;         //!< True if the potential energy is needed
+    bool compute_virial;            //!< True if the virial is needed
+
+    //! Add the contributions of particle \a j to \a sums (indexed by thermo_sum)
+    inline void add(double *sums, unsigned int j) const
+        {
+        Scalar4 v = vel[j];
+        double mass = v.w;
+        sums[thermo_sum::kinetic_xx] += mass*( (double)v.x * (double)v.x );
+        sums[thermo_sum::kinetic_xy] += mass*( (double)v.x * (double)v.y );
+        sums[thermo_sum::kinetic_xz] += mass*( (double)v.x * (double)v.z );
+        sums[thermo_sum::kinetic_yy] += mass*( (double)v.y * (double)v.y );
+        sums[thermo_sum::kinetic_yz] += mass*( (double)v.y * (double)v.z );
+        sums[thermo_sum::kinetic_zz] += mass*( (double)v.z * (double)v.z );
+
+        if (compute_rotational)
+            {
+            Scalar3 I = inertia[j];
+            quat<Scalar> q(orientation[j]);
+            quat<Scalar> p(angmom[j]);
+            quat<Scalar> s(Scalar(0.5)*conj(q)*p);
+
+            // only if the moment of inertia along one principal axis is non-zero, that axis carries angular momentum
+            sums[thermo_sum::rotational_kinetic_energy] += (I.x >= EPSILON) ? s.v.x*s.v.x/I.x : Scalar(0.0);
+            sums[thermo_sum::rotational_kinetic_energy] += (I.y >= EPSILON) ? s.v.y*s.v.y/I.y : Scalar(0.0);
+            sums[thermo_sum::rotational_kinetic_energy] += (I.z >= EPSILON) ? s.v.z*s.v.z/I.z : Scalar(0.0);
+            }
+
+        if (compute_potential)
+            {
+            sums[thermo_sum::potential_energy] += (double)net_force[j].w;
+            }
+
+        if (compute_virial)
+            {
+            sums[thermo_sum::virial_xx] += (double)net_virial[j+0*virial_pitch];
+            sums[thermo_sum::virial_xy] += (double)net_virial[j+1*virial_pitch];
+            sums[thermo_sum::virial_xz] += (double)net_virial[j+2*virial_pitch];
+            sums[thermo_sum::virial_yy] += (double)net_virial[j+3*virial_pitch];
+            sums[thermo_sum::virial_yz] += (double)net_virial[j+4*virial_pitch];
+            sums[thermo_sum::virial_zz] += (double)net_virial[j+5*virial_pitch];
+            }
+        }
+    };
+
 //! Computes thermodynamic properties of a group of particles
 /*! ComputeThermo calculates instantaneous thermodynamic properties and provides them for the logger.
     All computed values are stored in a GPUArray so that they can be accessed on the GPU without intermediate copies.
@@ -40,6 +104,10 @@
      - rotational kinetic energy
      - potential energy
 
+    The extensive quantities are summed over the local particles in a single sweep over the group. In MPI
+    simulations, the sum over all ranks is posted as a non-blocking reduction right after the sweep, and only
+    completed when the first value is read.
+
     Values available all the time
      - number of degrees of freedom (ndof)
      - number of particles in the group
@@ -302,6 +370,12 @@ class ComputeThermo : public Compute
             m_logging_enabled = enable;
             }
 
+        //! Returns true if the properties are computed in a batch with other groups
+        bool isBatched() const
+            {
+            return m_batch != NULL;
+            }
+
     protected:
         std::shared_ptr<ParticleGroup> m_group;     //!< Group to compute properties for
         GPUArray<Scalar> m_properties;  //!< Stores the computed properties
@@ -309,16 +383,28 @@ class ComputeThermo : public Compute
         unsigned int m_ndof_rot;        //!< Stores the number of rotational degrees of freedom in the system
         std::vector<std::string> m_logname_list;  //!< Cache all generated logged quantities names
         bool m_logging_enabled;         //!< Set to false to disable communication with the logger
+        ComputeThermoMulti *m_batch;    //!< Batch that computes the properties of this group, if any
 
         //! Does the actual computation
         virtual void computeProperties();
 
+        //! Fill the local properties from the thermodynamic sums over the local group members
+        void setLocalProperties(const double *sums);
+
         #ifdef ENABLE_MPI
         bool m_properties_reduced;      //!< True if properties have been reduced across MPI
+        std::vector<Scalar> m_reduce_buffer; //!< Buffer for the non-blocking reduction of the properties
+        MPI_Request m_reduce_request;   //!< Request of the non-blocking reduction
+        bool m_reduce_pending;          //!< True if a non-blocking reduction has been posted and not completed
 
         //! Reduce properties over MPI
         virtual void reduceProperties();
+
+        //! Wait for an outstanding non-blocking reduction
+        void waitReduction();
         #endif
+
+        friend class ComputeThermoMulti;
     };
 
 //! Exports the ComputeThermo class to python
@@ -0,0 +1,272 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file ComputeThermoMulti.cc
+    \brief Contains code for the ComputeThermoMulti class
+*/
+
+#include "ComputeThermoMulti.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+namespace py = pybind11;
+
+#include <algorithm>
+#include <iostream>
+using namespace std;
+
+/*! \param sysdef System for which to compute thermodynamic properties
+*/
+ComputeThermoMulti::ComputeThermoMulti(std::shared_ptr<SystemDefinition> sysdef)
+    : Compute(sysdef)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ComputeThermoMulti" << endl;
+
+    #ifdef ENABLE_MPI
+    m_reduce_pending = false;
+    m_properties_reduced = true;
+    #endif
+    }
+
+ComputeThermoMulti::~ComputeThermoMulti()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ComputeThermoMulti" << endl;
+
+    #ifdef ENABLE_MPI
+    if (!m_properties_reduced)
+        {
+        #if MPI_VERSION >= 3
+        // completing the posted reduction is a local operation
+        reduceProperties();
+        #else
+        // hand the local properties back, so that every compute can reduce its own
+        for (unsigned int g = 0; g < m_thermos.size(); ++g)
+            {
+            Scalar *row = &m_reduce_buffer[g*thermo_index::num_quantities];
+            m_thermos[g]->m_reduce_buffer.assign(row, row + thermo_index::num_quantities);
+            }
+        #endif
+        }
+    #endif
+
+    for (unsigned int g = 0; g < m_thermos.size(); ++g)
+        m_thermos[g]->m_batch = NULL;
+    }
+
+/*! \param thermo The compute to add
+*/
+void ComputeThermoMulti::addThermo(std::shared_ptr<ComputeThermo> thermo)
+    {
+    if (thermo->m_batch)
+        {
+        m_exec_conf->msg->error() << "compute.thermo: a group can only be part of one batch" << endl;
+        throw runtime_error("Error adding compute.thermo to batch");
+        }
+
+    thermo->m_batch = this;
+    m_thermos.push_back(thermo);
+    }
+
+/*! Calls computeProperties if the properties need updating
+    \param timestep Current time step of the simulation
+*/
+void ComputeThermoMulti::compute(unsigned int timestep)
+    {
+    if (!shouldCompute(timestep))
+        return;
+
+    computeProperties();
+    }
+
+/*! Sums the properties of all groups in a single sweep over the local particles.
+*/
+void ComputeThermoMulti::computeProperties()
+    {
+    unsigned int n_groups = m_thermos.size();
+    if (n_groups == 0)
+        return;
+
+    if (m_prof) m_prof->push("Thermo multi");
+
+    #ifdef ENABLE_MPI
+    // the reduction buffer must not be overwritten while a reduction is in flight
+    waitReduction();
+    #endif
+
+    unsigned int N = m_pdata->getN();
+    unsigned int n_words = (n_groups + 63)/64;
+
+    // mark the groups of every local particle
+    // (this may rebuild the group index lists, so it is done before accessing the particle data)
+    m_membership.assign(N*n_words, 0);
+    for (unsigned int g = 0; g < n_groups; ++g)
+        {
+        std::shared_ptr<ParticleGroup> group = m_thermos[g]->m_group;
+        unsigned int group_size = group->getNumMembers();
+        ArrayHandle<unsigned int> h_index(group->getIndexArray(), access_location::host, access_mode::read);
+
+        unsigned int word = g/64;
+        uint64_t bit = uint64_t(1) << (g % 64);
+        for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+            {
+            m_membership[h_index.data[group_idx]*n_words + word] |= bit;
+            }
+        }
+
+    m_sums.assign(n_groups*thermo_sum::num_sums, 0.0);
+
+        {
+        // access the particle data
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::read);
+
+        // access the net force, pe, and virial
+        const GPUArray< Scalar >& net_virial = m_pdata->getNetVirial();
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
+
+        PDataFlags flags = m_pdata->getFlags();
+
+        thermo_particle_data data;
+        data.vel = h_vel.data;
+        data.orientation = h_orientation.data;
+        data.angmom = h_angmom.data;
+        data.inertia = h_inertia.data;
+        data.net_force = h_net_force.data;
+        data.net_virial = h_net_virial.data;
+        data.virial_pitch = net_virial.getPitch();
+        data.compute_rotational = flags[pdata_flag::rotational_kinetic_energy];
+        data.compute_potential = flags[pdata_flag::potential_energy];
+        data.compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+
+        for (unsigned int j = 0; j < N; ++j)
+            {
+            const uint64_t *mask = &m_membership[j*n_words];
+
+            // contributions of this particle, evaluated once for all of its groups
+            double particle_sums[thermo_sum::num_sums];
+            bool evaluated = false;
+
+            for (unsigned int word = 0; word < n_words; ++word)
+                {
+                uint64_t bits = mask[word];
+                if (!bits)
+                    continue;
+
+                if (!evaluated)
+                    {
+                    for (unsigned int k = 0; k < thermo_sum::num_sums; ++k)
+                        particle_sums[k] = 0.0;
+                    data.add(particle_sums, j);
+                    evaluated = true;
+                    }
+
+                // add to the sums of every group with a set bit
+                while (bits)
+                    {
+                    unsigned int g = word*64 + __builtin_ctzll(bits);
+                    bits &= bits - 1;
+
+                    double *group_sums = &m_sums[g*thermo_sum::num_sums];
+                    for (unsigned int k = 0; k < thermo_sum::num_sums; ++k)
+                        group_sums[k] += particle_sums[k];
+                    }
+                }
+            }
+        }
+
+    // store the local properties of every group
+    for (unsigned int g = 0; g < n_groups; ++g)
+        {
+        // leave the properties of empty groups untouched, as ComputeThermo does
+        if (m_thermos[g]->m_group->getNumMembersGlobal() == 0)
+            continue;
+
+        m_thermos[g]->setLocalProperties(&m_sums[g*thermo_sum::num_sums]);
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // gather the local properties of all groups and reduce them in a single collective
+        m_reduce_buffer.assign(n_groups*thermo_index::num_quantities, Scalar(0.0));
+        for (unsigned int g = 0; g < n_groups; ++g)
+            {
+            if (m_thermos[g]->m_group->getNumMembersGlobal() == 0)
+                continue;
+
+            ArrayHandle<Scalar> h_properties(m_thermos[g]->m_properties, access_location::host, access_mode::read);
+            std::copy(h_properties.data, h_properties.data + thermo_index::num_quantities,
+                m_reduce_buffer.begin() + g*thermo_index::num_quantities);
+            }
+
+        #if MPI_VERSION >= 3
+        MPI_Iallreduce(MPI_IN_PLACE, &m_reduce_buffer.front(), m_reduce_buffer.size(), MPI_HOOMD_SCALAR,
+            MPI_SUM, m_exec_conf->getMPICommunicator(), &m_reduce_request);
+        m_reduce_pending = true;
+        #endif
+
+        m_properties_reduced = false;
+        }
+    #endif // ENABLE_MPI
+
+    if (m_prof) m_prof->pop();
+    }
+
+#ifdef ENABLE_MPI
+/*! Completes the reduction posted by computeProperties() and stores the result in the properties of every compute
+    in the batch.
+*/
+void ComputeThermoMulti::reduceProperties()
+    {
+    if (m_properties_reduced) return;
+
+    #if MPI_VERSION >= 3
+    waitReduction();
+    #else
+    MPI_Allreduce(MPI_IN_PLACE, &m_reduce_buffer.front(), m_reduce_buffer.size(), MPI_HOOMD_SCALAR,
+            MPI_SUM, m_exec_conf->getMPICommunicator());
+    #endif
+
+    for (unsigned int g = 0; g < m_thermos.size(); ++g)
+        {
+        if (m_thermos[g]->m_group->getNumMembersGlobal() == 0)
+            continue;
+
+        ArrayHandle<Scalar> h_properties(m_thermos[g]->m_properties, access_location::host, access_mode::overwrite);
+        std::copy(m_reduce_buffer.begin() + g*thermo_index::num_quantities,
+            m_reduce_buffer.begin() + (g+1)*thermo_index::num_quantities, h_properties.data);
+        m_thermos[g]->m_properties_reduced = true;
+        }
+
+    m_properties_reduced = true;
+    }
+
+/*! Waits for the reduction posted by computeProperties() to finish, if one is in flight.
+*/
+void ComputeThermoMulti::waitReduction()
+    {
+    #if MPI_VERSION >= 3
+    if (m_reduce_pending)
+        {
+        MPI_Wait(&m_reduce_request, MPI_STATUS_IGNORE);
+        m_reduce_pending = false;
+        }
+    #endif
+    }
+#endif
+
+void export_ComputeThermoMulti(py::module& m)
+    {
+    py::class_<ComputeThermoMulti, std::shared_ptr<ComputeThermoMulti> >(m,"ComputeThermoMulti",py::base<Compute>())
+    .def(py::init< std::shared_ptr<SystemDefinition> >())
+    .def("addThermo", &ComputeThermoMulti::addThermo)
+    ;
+    }
@@ -0,0 +1,85 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "Compute.h"
+#include "ComputeThermo.h"
+
+#include <memory>
+#include <vector>
+#include <stdint.h>
+
+/*! \file ComputeThermoMulti.h
+    \brief Declares a class for computing the thermodynamic quantities of many groups at once
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __COMPUTE_THERMO_MULTI_H__
+#define __COMPUTE_THERMO_MULTI_H__
+
+//! Computes the thermodynamic properties of many groups in a single sweep
+/*! Every ComputeThermo walks the index list of its own group and, in MPI simulations, reduces its properties in
+    a separate collective. With tens of groups, this costs more than the dynamics. ComputeThermoMulti computes the
+    properties of a set of ComputeThermo instances together:
+     - A bit mask with one bit per group marks the groups each local particle belongs to.
+     - A single sweep over the local particles evaluates the contributions of every particle once (see
+       thermo_particle_data) and adds them to the sums of all groups the particle is a member of.
+     - The local properties of all groups are reduced in a single collective, which is posted non-blocking and
+       completed when the first value is read.
+
+    ComputeThermo instances added with addThermo() forward their compute() calls to the batch, so integrators and the
+    logger use them as before. All groups in the batch are evaluated when the first of them is requested at a given
+    time step.
+
+    \ingroup computes
+*/
+class ComputeThermoMulti : public Compute
+    {
+    public:
+        //! Constructs the compute
+        ComputeThermoMulti(std::shared_ptr<SystemDefinition> sysdef);
+
+        //! Destructor
+        virtual ~ComputeThermoMulti();
+
+        //! Add a ComputeThermo to the batch
+        void addThermo(std::shared_ptr<ComputeThermo> thermo);
+
+        //! Compute the properties of all groups
+        virtual void compute(unsigned int timestep);
+
+        #ifdef ENABLE_MPI
+        //! Complete the reduction of the properties of all groups
+        void reduceProperties();
+        #endif
+
+    protected:
+        std::vector< std::shared_ptr<ComputeThermo> > m_thermos; //!< The computes in the batch
+        std::vector<uint64_t> m_membership;     //!< Bit mask of the groups each local particle belongs to
+        std::vector<double> m_sums;             //!< Sums over the local members of each group (indexed by thermo_sum)
+
+        #ifdef ENABLE_MPI
+        std::vector<Scalar> m_reduce_buffer;    //!< Buffer for the non-blocking reduction of all properties
+        MPI_Request m_reduce_request;           //!< Request of the non-blocking reduction
+        bool m_reduce_pending;                  //!< True if a non-blocking reduction has been posted and not completed
+        bool m_properties_reduced;              //!< True if the reduced properties have been distributed
+
+        //! Wait for an outstanding non-blocking reduction
+        void waitReduction();
+        #endif
+
+        //! Does the actual computation
+        void computeProperties();
+    };
+
+//! Exports the ComputeThermoMulti class to python
+void export_ComputeThermoMulti(pybind11::module& m);
+
+#endif
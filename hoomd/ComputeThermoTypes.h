@@ -32,6 +32,30 @@ struct thermo_index
         };
     };
 
+//! Enum for indexing the per-particle sums accumulated by ComputeThermo on the CPU
+struct thermo_sum
+    {
+    //! The enum
+    enum Enum
+        {
+        kinetic_xx=0,                   //!< xx component of the kinetic part of the pressure tensor (times V)
+        kinetic_xy,                     //!< xy component of the kinetic part of the pressure tensor (times V)
+        kinetic_xz,                     //!< xz component of the kinetic part of the pressure tensor (times V)
+        kinetic_yy,                     //!< yy component of the kinetic part of the pressure tensor (times V)
+        kinetic_yz,                     //!< yz component of the kinetic part of the pressure tensor (times V)
+        kinetic_zz,                     //!< zz component of the kinetic part of the pressure tensor (times V)
+        rotational_kinetic_energy,      //!< Twice the rotational kinetic energy
+        potential_energy,               //!< Potential energy
+        virial_xx,                      //!< xx component of the virial
+        virial_xy,                      //!< xy component of the virial
+        virial_xz,                      //!< xz component of the virial
+        virial_yy,                      //!< yy component of the virial
+        virial_yz,                      //!< yz component of the virial
+        virial_zz,                      //!< zz component of the virial
+        num_sums                        // final element to count number of sums
+        };
+    };
+
 //! structure for storing the components of the pressure tensor
 struct PressureTensor
     {
@@ -0,0 +1,642 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file DistributedGSDReader.cc
+    \brief Defines the DistributedGSDReader class
+*/
+
+#include "DistributedGSDReader.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+namespace py = pybind11;
+
+namespace
+{
+//! A bonded group sent to the ranks that own its members
+template<class group_data>
+struct group_element
+    {
+    typename group_data::members_t members;  //!< Member tags
+    typeval_t typeval;                       //!< Type or constraint value
+    unsigned int tag;                        //!< Group tag
+    };
+
+//! A particle sent to the rank that owns it, with only the fields read from the file
+struct particle_element
+    {
+    Scalar4 pos;               //!< Position and type
+    Scalar4 vel;               //!< Velocity and mass
+    Scalar4 orientation;       //!< Orientation
+    Scalar4 angmom;            //!< Angular momentum
+    Scalar3 inertia;           //!< Principal moments of inertia
+    int3 image;                //!< Image
+    Scalar charge;             //!< Charge
+    Scalar diameter;           //!< Diameter
+    unsigned int body;         //!< Body id
+    unsigned int tag;          //!< Particle tag
+    };
+
+//! Offsets of the values for every rank in a send buffer packed in rank order
+/*! \param counts Number of values for every rank
+*/
+std::vector<unsigned int> packOffsets(const std::vector<unsigned int>& counts)
+    {
+    std::vector<unsigned int> offsets(counts.size(), 0);
+    for (unsigned int r = 1; r < counts.size(); ++r)
+        offsets[r] = offsets[r-1] + counts[r-1];
+    return offsets;
+    }
+}
+
+/*! \param exec_conf The execution configuration
+    \param name File name to read
+    \param frame Frame index to read from the file
+    \param from_end Count frames back from the end of the file
+
+    Every rank opens the file and reads the frame header.
+*/
+DistributedGSDReader::DistributedGSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                           const std::string &name,
+                                           const uint64_t frame,
+                                           bool from_end)
+    : m_exec_conf(exec_conf), m_name(name), m_frame(frame), m_timestep(0), m_dimensions(3), m_N(0)
+    {
+    m_exec_conf->msg->notice(3) << "init.read_gsd: open gsd file " << name << " on all ranks" << endl;
+    int retval = gsd_open(&m_handle, name.c_str(), GSD_OPEN_READONLY);
+    if (retval == -1)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << strerror(errno) << " - " << name << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -2)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << name << " is not a valid GSD file" << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -3)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Invalid GSD file version in " << name << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -4)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Corrupt GSD file: " << name << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval == -5)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Out of memory opening: " << name << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+    else if (retval != 0)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Unknown error opening: " << name << endl;
+        throw runtime_error("Error opening GSD file");
+        }
+
+    // validate schema
+    if (string(m_handle.header.schema) != string("hoomd") || m_handle.header.schema_version >= gsd_make_version(2,0))
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Invalid schema in " << name << endl;
+        gsd_close(&m_handle);
+        throw runtime_error("Error opening GSD file");
+        }
+
+    // set frame from the end of the file if requested
+    uint64_t nframes = gsd_get_nframes(&m_handle);
+    if (from_end && frame <= nframes)
+        m_frame = nframes - frame;
+
+    // validate number of frames
+    if (m_frame >= nframes)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Cannot read frame " << m_frame << " " << name << " only has " << nframes << " frames" << endl;
+        gsd_close(&m_handle);
+        throw runtime_error("Error opening GSD file");
+        }
+
+    // read the same header data as GSDReader
+    readChunk(&m_timestep, "configuration/step", 8);
+
+    uint8_t dim = 3;
+    readChunk(&dim, "configuration/dimensions", 1);
+    m_dimensions = dim;
+
+    float box[6] = {1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f};
+    readChunk(&box, "configuration/box", 6*4);
+    m_global_box = BoxDim(box[0], box[1], box[2]);
+    m_global_box.setTiltFactors(box[3], box[4], box[5]);
+
+    readChunk(&m_N, "particles/N", 4);
+    if (m_N == 0)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "cannot read a file with 0 particles" << endl;
+        gsd_close(&m_handle);
+        throw runtime_error("Error reading GSD file");
+        }
+
+    m_particle_types = readTypes("particles/types");
+    m_bond_types = readTypes("bonds/types");
+    m_angle_types = readTypes("angles/types");
+    m_dihedral_types = readTypes("dihedrals/types");
+    m_improper_types = readTypes("impropers/types");
+    if (m_handle.header.schema_version >= gsd_make_version(1,1))
+        m_pair_types = readTypes("pairs/types");
+    }
+
+DistributedGSDReader::~DistributedGSDReader()
+    {
+    gsd_close(&m_handle);
+    }
+
+/*! \param name Name of the data chunk
+    \param cur_n Number of rows in the current frame (0 to accept any number)
+    \returns The index entry of the chunk, or NULL if it is not present
+
+    Per the GSD spec, chunks that are not present in the frame are read from frame 0, unless the number of rows in
+    frame 0 does not match the current one.
+*/
+const gsd_index_entry *DistributedGSDReader::findChunk(const char *name, unsigned int cur_n)
+    {
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, name);
+    if (entry == NULL && m_frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
+        {
+        m_exec_conf->msg->notice(10) << "init.read_gsd: chunk not found " << name << endl;
+        return NULL;
+        }
+    return entry;
+    }
+
+/*! \param data Pointer to data to read into
+    \param name Name of the data chunk
+    \param expected_size Expected size of the data chunk in bytes
+    \returns true if the data was read from the file
+*/
+bool DistributedGSDReader::readChunk(void *data, const char *name, size_t expected_size)
+    {
+    const gsd_index_entry *entry = findChunk(name, 0);
+    if (entry == NULL)
+        return false;
+
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (actual_size != expected_size)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Expecting " << expected_size << " bytes in " << name << " but found " << actual_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    checkError(gsd_read_chunk(&m_handle, data, entry));
+    return true;
+    }
+
+/*! \param data Array to read into, holds \a n rows filled with the default values
+    \param name Name of the data chunk
+    \param cur_n Number of rows of the chunk in the current frame
+    \param begin First row to read
+    \param n Number of rows to read
+    \returns true if the data was read from the file
+
+    Only the requested rows are read from the file. If the chunk is not present, \a data is left untouched.
+*/
+template<class T>
+bool DistributedGSDReader::readSlice(std::vector<T>& data,
+                                     const char *name,
+                                     unsigned int cur_n,
+                                     unsigned int begin,
+                                     unsigned int n)
+    {
+    const gsd_index_entry *entry = findChunk(name, cur_n);
+    if (entry == NULL || n == 0)
+        return entry != NULL;
+
+    size_t row_size = entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    if (row_size * n != data.size() * sizeof(T) || begin + n > entry->N)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Expecting " << data.size() * sizeof(T) / n << " bytes per row in " << name
+                                  << " but found " << row_size << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+
+    m_exec_conf->msg->notice(7) << "init.read_gsd: reading rows " << begin << "-" << begin+n-1 << " of chunk " << name << endl;
+
+    // read the slice as a chunk of its own
+    gsd_index_entry slice = *entry;
+    slice.N = n;
+    slice.location += begin * row_size;
+    checkError(gsd_read_chunk(&m_handle, &data[0], &slice));
+    return true;
+    }
+
+/*! \param name Name of the data chunk
+    \returns The type names, or the default per the GSD HOOMD Schema if the chunk is not present
+*/
+std::vector<std::string> DistributedGSDReader::readTypes(const char *name)
+    {
+    std::vector<std::string> type_mapping;
+
+    // set the default particle type mapping per the GSD HOOMD Schema
+    if (std::string(name) == "particles/types")
+        type_mapping.push_back("A");
+
+    const gsd_index_entry *entry = findChunk(name, 0);
+    if (entry == NULL)
+        return type_mapping;
+
+    size_t actual_size = entry->N * entry->M * gsd_sizeof_type((enum gsd_type)entry->type);
+    std::vector<char> data(actual_size);
+    checkError(gsd_read_chunk(&m_handle, &data[0], entry));
+
+    type_mapping.clear();
+    for (unsigned int i = 0; i < entry->N; i++)
+        {
+        size_t l = strnlen(&data[i*entry->M], entry->M);
+        type_mapping.push_back(std::string(&data[i*entry->M], l));
+        }
+
+    return type_mapping;
+    }
+
+/*! \param retval Return value of gsd_read_chunk
+*/
+void DistributedGSDReader::checkError(int retval)
+    {
+    if (retval == -1)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << strerror(errno) << " - " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+    else if (retval == -3)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Invalid GSD file " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+    else if (retval != 0)
+        {
+        m_exec_conf->msg->error() << "init.read_gsd: " << "Unknown error reading: " << m_name << endl;
+        throw runtime_error("Error reading GSD file");
+        }
+    }
+
+/*! \param N Number of rows
+    \returns The first row of the slice of every rank, followed by \a N
+*/
+std::vector<unsigned int> DistributedGSDReader::getSlices(unsigned int N) const
+    {
+    unsigned int nranks = m_exec_conf->getNRanks();
+    std::vector<unsigned int> slices(nranks+1);
+    for (unsigned int i = 0; i <= nranks; ++i)
+        slices[i] = (uint64_t(N) * i) / nranks;
+    return slices;
+    }
+
+/*! \returns A snapshot with the box, the dimensions and the type names, on all ranks
+*/
+std::shared_ptr< SnapshotSystemData<float> > DistributedGSDReader::getSnapshot() const
+    {
+    std::shared_ptr< SnapshotSystemData<float> > snapshot(new SnapshotSystemData<float>());
+
+    snapshot->dimensions = m_dimensions;
+    snapshot->global_box = m_global_box;
+    snapshot->particle_data.type_mapping = m_particle_types;
+    snapshot->bond_data.type_mapping = m_bond_types;
+    snapshot->angle_data.type_mapping = m_angle_types;
+    snapshot->dihedral_data.type_mapping = m_dihedral_types;
+    snapshot->improper_data.type_mapping = m_improper_types;
+    snapshot->pair_data.type_mapping = m_pair_types;
+
+    return snapshot;
+    }
+
+/*! \param sysdef System definition constructed from getSnapshot()
+
+    This method must be called on all ranks.
+*/
+void DistributedGSDReader::readLocal(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    // rank that owns each particle of the local slice
+    std::vector<unsigned int> owner;
+    readParticles(sysdef->getParticleData(), owner);
+
+    readGroups(sysdef->getBondData(), "bonds", m_bond_types, owner);
+    readGroups(sysdef->getAngleData(), "angles", m_angle_types, owner);
+    readGroups(sysdef->getDihedralData(), "dihedrals", m_dihedral_types, owner);
+    readGroups(sysdef->getImproperData(), "impropers", m_improper_types, owner);
+    readGroups(sysdef->getConstraintData(), "constraints", std::vector<std::string>(), owner);
+    if (m_handle.header.schema_version >= gsd_make_version(1,1))
+        readGroups(sysdef->getPairData(), "pairs", m_pair_types, owner);
+    }
+
+/*! \param pdata Particle data to fill
+    \param owner Rank that owns each particle of the local slice (output)
+*/
+void DistributedGSDReader::readParticles(std::shared_ptr<ParticleData> pdata, std::vector<unsigned int>& owner)
+    {
+    std::vector<unsigned int> slices = getSlices(m_N);
+    unsigned int rank = m_exec_conf->getRank();
+    unsigned int begin = slices[rank];
+    unsigned int n = slices[rank+1] - begin;
+
+    // read the slice, with the defaults of the GSD HOOMD Schema
+    std::vector<uint32_t> type(n, 0);
+    std::vector<float> mass(n, 1.0f);
+    std::vector<float> charge(n, 0.0f);
+    std::vector<float> diameter(n, 1.0f);
+    std::vector<uint32_t> body(n, NO_BODY);
+    std::vector<float> inertia(3*n, 0.0f);
+    std::vector<float> pos(3*n, 0.0f);
+    std::vector<float> orientation(4*n, 0.0f);
+    std::vector<float> vel(3*n, 0.0f);
+    std::vector<float> angmom(4*n, 0.0f);
+    std::vector<int32_t> image(3*n, 0);
+    for (unsigned int i = 0; i < n; ++i)
+        orientation[4*i] = 1.0f;
+
+    readSlice(type, "particles/typeid", m_N, begin, n);
+    readSlice(mass, "particles/mass", m_N, begin, n);
+    readSlice(charge, "particles/charge", m_N, begin, n);
+    readSlice(diameter, "particles/diameter", m_N, begin, n);
+    readSlice(body, "particles/body", m_N, begin, n);
+    readSlice(inertia, "particles/moment_inertia", m_N, begin, n);
+    readSlice(pos, "particles/position", m_N, begin, n);
+    readSlice(orientation, "particles/orientation", m_N, begin, n);
+    readSlice(vel, "particles/velocity", m_N, begin, n);
+    readSlice(angmom, "particles/angmom", m_N, begin, n);
+    readSlice(image, "particles/image", m_N, begin, n);
+
+    // find the rank that owns every particle
+    const BoxDim& global_box = pdata->getGlobalBox();
+    std::vector<unsigned int> send_counts(m_exec_conf->getNRanks(), 0);
+    owner.resize(n);
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        if (type[i] >= m_particle_types.size())
+            {
+            m_exec_conf->msg->error() << "init.read_gsd: Particle " << begin+i << " has invalid type " << type[i] << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+
+        unsigned int dest = 0;
+        #ifdef ENABLE_MPI
+        if (pdata->getDomainDecomposition())
+            dest = pdata->getDomainDecomposition()->placeParticle(global_box, make_scalar3(pos[3*i], pos[3*i+1], pos[3*i+2]));
+        #endif
+        owner[i] = dest;
+        send_counts[dest]++;
+        }
+
+    // pack the particles in the order of their owners
+    std::vector<unsigned int> cursor = packOffsets(send_counts);
+    std::vector<particle_element> send(n);
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        particle_element& p = send[cursor[owner[i]]++];
+        p.pos = make_scalar4(pos[3*i], pos[3*i+1], pos[3*i+2], __int_as_scalar(type[i]));
+        p.vel = make_scalar4(vel[3*i], vel[3*i+1], vel[3*i+2], mass[i]);
+        p.charge = charge[i];
+        p.diameter = diameter[i];
+        p.image = make_int3(image[3*i], image[3*i+1], image[3*i+2]);
+        p.body = body[i];
+        p.orientation = make_scalar4(orientation[4*i], orientation[4*i+1], orientation[4*i+2], orientation[4*i+3]);
+        p.angmom = make_scalar4(angmom[4*i], angmom[4*i+1], angmom[4*i+2], angmom[4*i+3]);
+        p.inertia = make_scalar3(inertia[3*i], inertia[3*i+1], inertia[3*i+2]);
+        p.tag = begin + i;
+        }
+
+    std::vector<particle_element> local;
+    #ifdef ENABLE_MPI
+    if (pdata->getDomainDecomposition())
+        {
+        std::vector<unsigned int> recv_counts;
+        all_to_all_v(send, send_counts, local, recv_counts, m_exec_conf->getMPICommunicator());
+        }
+    else
+    #endif
+        {
+        local.swap(send);
+        }
+
+    pdata->beginLocalInitialization(local.size(), m_particle_types);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(pdata->getAccelerations(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(pdata->getCharges(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(pdata->getDiameters(), access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(pdata->getBodies(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(pdata->getOrientationArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(pdata->getAngularMomentumArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int idx = 0; idx < local.size(); ++idx)
+            {
+            const particle_element& p = local[idx];
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_accel.data[idx] = make_scalar3(0.0, 0.0, 0.0);
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
+            h_tag.data[idx] = p.tag;
+            }
+        }
+    pdata->endLocalInitialization(false);
+    }
+
+/*! \param gdata Bonded group data to fill
+    \param prefix Name of the group data in the GSD file
+    \param types Group type names
+    \param owner Rank that owns each particle of the local particle slice
+
+    The ranks that own the members of a group are looked up on the ranks that read the members. This method must be
+    called on all ranks.
+*/
+template<class group_data>
+void DistributedGSDReader::readGroups(std::shared_ptr<group_data> gdata,
+                                      const std::string& prefix,
+                                      const std::vector<std::string>& types,
+                                      const std::vector<unsigned int>& owner)
+    {
+    const unsigned int group_size = group_data::size;
+    unsigned int N = 0;
+    readChunk(&N, (prefix + "/N").c_str(), 4);
+    if (N == 0)
+        return;
+
+    std::vector<unsigned int> slices = getSlices(N);
+    unsigned int rank = m_exec_conf->getRank();
+    unsigned int begin = slices[rank];
+    unsigned int n = slices[rank+1] - begin;
+
+    std::vector<uint32_t> members(group_size*n, 0);
+    readSlice(members, (prefix + "/group").c_str(), N, begin, n);
+
+    std::vector<typeval_t> typeval(n);
+    if (group_data::typemap_val)
+        {
+        std::vector<uint32_t> type(n, 0);
+        readSlice(type, (prefix + "/typeid").c_str(), N, begin, n);
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            if (type[i] >= types.size())
+                {
+                m_exec_conf->msg->error() << "init.read_gsd: " << gdata->getName() << " " << begin+i << " has invalid type " << type[i] << endl;
+                throw runtime_error("Error reading GSD file");
+                }
+            typeval[i].type = type[i];
+            }
+        }
+    else
+        {
+        std::vector<float> val(n, 0.0f);
+        readSlice(val, (prefix + "/value").c_str(), N, begin, n);
+        for (unsigned int i = 0; i < n; ++i)
+            typeval[i].val = val[i];
+        }
+
+    for (unsigned int i = 0; i < group_size*n; ++i)
+        if (members[i] >= m_N)
+            {
+            m_exec_conf->msg->error() << "init.read_gsd: " << gdata->getName() << " " << begin+i/group_size
+                                      << " has invalid member " << members[i] << endl;
+            throw runtime_error("Error reading GSD file");
+            }
+
+    std::vector< group_element<group_data> > local;
+
+    #ifdef ENABLE_MPI
+    if (m_exec_conf->getNRanks() > 1)
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        const unsigned int nranks = m_exec_conf->getNRanks();
+        std::vector<unsigned int> particle_slices = getSlices(m_N);
+
+        // ask the ranks that read the members which rank owns them
+        std::vector<unsigned int> dirs(group_size*n);
+        std::vector<unsigned int> request_counts(nranks, 0);
+        for (unsigned int i = 0; i < group_size*n; ++i)
+            {
+            dirs[i] = std::upper_bound(particle_slices.begin(), particle_slices.end(), members[i]) - particle_slices.begin() - 1;
+            request_counts[dirs[i]]++;
+            }
+
+        std::vector<unsigned int> requests(group_size*n);
+        std::vector<unsigned int> cursor = packOffsets(request_counts);
+        for (unsigned int i = 0; i < group_size*n; ++i)
+            requests[cursor[dirs[i]]++] = members[i];
+
+        std::vector<unsigned int> recv_requests;
+        std::vector<unsigned int> recv_request_counts;
+        all_to_all_v(requests, request_counts, recv_requests, recv_request_counts, mpi_comm);
+        std::vector<unsigned int>().swap(requests);
+
+        // answer in the order of the requests
+        std::vector<unsigned int> replies(recv_requests.size());
+        for (unsigned int k = 0; k < recv_requests.size(); ++k)
+            replies[k] = owner[recv_requests[k] - particle_slices[rank]];
+        std::vector<unsigned int>().swap(recv_requests);
+
+        std::vector<unsigned int> recv_replies;
+        std::vector<unsigned int> reply_counts;
+        all_to_all_v(replies, recv_request_counts, recv_replies, reply_counts, mpi_comm);
+        std::vector<unsigned int>().swap(replies);
+
+        // every group goes to all ranks that own one of its members, mark the duplicates with nranks
+        cursor = packOffsets(reply_counts);
+        std::vector<unsigned int> send_counts(nranks, 0);
+        std::vector<unsigned int> ranks(group_size*n);
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            for (unsigned int j = 0; j < group_size; ++j)
+                {
+                unsigned int r = recv_replies[cursor[dirs[group_size*i+j]]++];
+                bool duplicate = false;
+                for (unsigned int k = 0; k < j; ++k)
+                    duplicate = duplicate || (ranks[group_size*i+k] == r);
+                if (! duplicate)
+                    {
+                    ranks[group_size*i+j] = r;
+                    send_counts[r]++;
+                    }
+                else
+                    ranks[group_size*i+j] = nranks;
+                }
+            }
+
+        // pack the groups in the order of the destination ranks
+        unsigned int n_send = 0;
+        for (unsigned int r = 0; r < nranks; ++r)
+            n_send += send_counts[r];
+        std::vector< group_element<group_data> > send(n_send);
+        cursor = packOffsets(send_counts);
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            group_element<group_data> g;
+            for (unsigned int j = 0; j < group_size; ++j)
+                g.members.tag[j] = members[group_size*i+j];
+            g.typeval = typeval[i];
+            g.tag = begin + i;
+
+            for (unsigned int j = 0; j < group_size; ++j)
+                if (ranks[group_size*i+j] != nranks)
+                    send[cursor[ranks[group_size*i+j]]++] = g;
+            }
+
+        std::vector<unsigned int> recv_counts;
+        all_to_all_v(send, send_counts, local, recv_counts, mpi_comm);
+        }
+    else
+    #endif
+        {
+        local.resize(n);
+        for (unsigned int i = 0; i < n; ++i)
+            {
+            for (unsigned int j = 0; j < group_size; ++j)
+                local[i].members.tag[j] = members[group_size*i+j];
+            local[i].typeval = typeval[i];
+            local[i].tag = begin + i;
+            }
+        }
+
+    gdata->beginLocalInitialization(local.size(), types);
+        {
+        ArrayHandle<typename group_data::members_t> h_members(gdata->getMembersArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(gdata->getTypeValArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(gdata->getTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int idx = 0; idx < local.size(); ++idx)
+            {
+            h_members.data[idx] = local[idx].members;
+            h_typeval.data[idx] = local[idx].typeval;
+            h_tag.data[idx] = local[idx].tag;
+            }
+        }
+    gdata->endLocalInitialization();
+    }
+
+void export_DistributedGSDReader(py::module& m)
+    {
+    py::class_< DistributedGSDReader, std::shared_ptr<DistributedGSDReader> >(m,"DistributedGSDReader")
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, const string&, const uint64_t, bool>())
+    .def("getTimeStep", &DistributedGSDReader::getTimeStep)
+    .def("getSnapshot", &DistributedGSDReader::getSnapshot)
+    .def("readLocal", &DistributedGSDReader::readLocal)
+    ;
+    }
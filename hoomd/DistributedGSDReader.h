@@ -0,0 +1,120 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file DistributedGSDReader.h
+    \brief Declares the DistributedGSDReader class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __DISTRIBUTED_GSD_READER_H__
+#define __DISTRIBUTED_GSD_READER_H__
+
+#include "SystemDefinition.h"
+#include "SnapshotSystemData.h"
+#include "hoomd/extern/gsd.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Reads a GSD file in parallel, without a global snapshot
+/*! GSDReader reads the whole frame into a snapshot on the root rank, which then scatters it to the other ranks.
+    The memory of the root rank limits the size of the system, and the time to initialize grows with the number of
+    particles. DistributedGSDReader instead initializes the system in two steps:
+
+    1. The constructor reads the header of the frame (timestep, box, particle and group counts, and type names) on
+       all ranks. getSnapshot() returns a snapshot without particles that holds this data, from which the
+       SystemDefinition is constructed.
+    2. readLocal() fills the SystemDefinition. Every rank reads an equal contiguous slice of every particle and
+       group chunk of the frame and sends each particle to the rank whose domain contains it. Bonded groups are
+       sent to all ranks that own one of their members. The particle tags are the indices in the file, as they are
+       with GSDReader.
+
+    No rank holds more than its share of the system plus its slice of the file at any time. The file names, chunks
+    and default values follow GSDReader.
+
+    \ingroup data_structs
+*/
+class DistributedGSDReader
+    {
+    public:
+        //! Open the file and read the frame header
+        DistributedGSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                             const std::string &name,
+                             const uint64_t frame,
+                             bool from_end);
+
+        //! Destructor
+        ~DistributedGSDReader();
+
+        //! Returns the timestep of the frame
+        uint64_t getTimeStep() const
+            {
+            return m_timestep;
+            }
+
+        //! Get a snapshot with the box and the type names, but without particles or groups
+        std::shared_ptr< SnapshotSystemData<float> > getSnapshot() const;
+
+        //! Read the local particles and groups
+        void readLocal(std::shared_ptr<SystemDefinition> sysdef);
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+        std::string m_name;                                          //!< Cached file name
+        uint64_t m_frame;                                            //!< Frame to read
+        gsd_handle m_handle;                                         //!< Handle to the file
+
+        uint64_t m_timestep;                            //!< Timestep at the selected frame
+        unsigned int m_dimensions;                      //!< Dimensionality of the system
+        BoxDim m_global_box;                            //!< Global simulation box
+        unsigned int m_N;                               //!< Global number of particles
+        std::vector<std::string> m_particle_types;      //!< Particle type names
+        std::vector<std::string> m_bond_types;          //!< Bond type names
+        std::vector<std::string> m_angle_types;         //!< Angle type names
+        std::vector<std::string> m_dihedral_types;      //!< Dihedral type names
+        std::vector<std::string> m_improper_types;      //!< Improper type names
+        std::vector<std::string> m_pair_types;          //!< Pair type names
+
+        //! Find a data chunk in the frame, or in frame 0
+        const gsd_index_entry *findChunk(const char *name, unsigned int cur_n);
+
+        //! Read a small data chunk
+        bool readChunk(void *data, const char *name, size_t expected_size);
+
+        //! Read a slice of the rows of a data chunk
+        template<class T>
+        bool readSlice(std::vector<T>& data, const char *name, unsigned int cur_n, unsigned int begin, unsigned int n);
+
+        //! Read a type list
+        std::vector<std::string> readTypes(const char *name);
+
+        //! Check the return value of gsd_read_chunk
+        void checkError(int retval);
+
+        //! Get the first row of the slice of each rank
+        std::vector<unsigned int> getSlices(unsigned int N) const;
+
+        //! Read the local particles
+        void readParticles(std::shared_ptr<ParticleData> pdata, std::vector<unsigned int>& owner);
+
+        //! Read the local groups of a bonded group data
+        template<class group_data>
+        void readGroups(std::shared_ptr<group_data> gdata,
+                        const std::string& prefix,
+                        const std::vector<std::string>& types,
+                        const std::vector<unsigned int>& owner);
+    };
+
+//! Exports DistributedGSDReader to python
+void export_DistributedGSDReader(pybind11::module& m);
+
+#endif
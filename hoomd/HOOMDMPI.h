@@ -22,7 +22,9 @@
 
 #include <mpi.h>
 
+#include <climits>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 #include <cereal/types/set.hpp>
@@ -416,6 +418,60 @@ void all_gather_v(const T& in_value, std::vector<T> & out_values, const MPI_Comm
     delete[] rbuf;
     }
 
+//! Wrapper around MPI_Alltoallv for plain data types
+/*! \param send_values Values to send, packed contiguously in the order of the destination ranks
+    \param send_counts Number of values to send to every rank
+    \param recv_values Values received from all ranks, concatenated in rank order (output)
+    \param recv_counts Number of values received from every rank (output)
+    \param mpi_comm MPI communicator
+
+    Unlike the other wrappers, the values are sent as raw bytes without serialization, so \a T must be trivially
+    copyable. This avoids the serialization overhead for large arrays of particle data. Counts and displacements
+    are given in units of whole values, so the byte size of the exchange is not limited by the range of int.
+*/
+template<typename T>
+void all_to_all_v(const std::vector<T>& send_values,
+                  const std::vector<unsigned int>& send_counts,
+                  std::vector<T>& recv_values,
+                  std::vector<unsigned int>& recv_counts,
+                  const MPI_Comm mpi_comm)
+    {
+    int size;
+    MPI_Comm_size(mpi_comm, &size);
+    assert(send_counts.size() == (unsigned int)size);
+
+    // exchange the number of values
+    recv_counts.resize(size);
+    MPI_Alltoall((void *)&send_counts[0], 1, MPI_UNSIGNED, &recv_counts[0], 1, MPI_UNSIGNED, mpi_comm);
+
+    std::vector<int> send_ints(size), send_displs(size), recv_ints(size), recv_displs(size);
+    unsigned long long n_send = 0;
+    unsigned long long n_recv = 0;
+    for (unsigned int i = 0; i < (unsigned int)size; i++)
+        {
+        send_ints[i] = send_counts[i];
+        recv_ints[i] = recv_counts[i];
+        send_displs[i] = n_send;
+        recv_displs[i] = n_recv;
+        n_send += send_counts[i];
+        n_recv += recv_counts[i];
+        }
+    assert(n_send == send_values.size());
+    if (n_send > INT_MAX || n_recv > INT_MAX)
+        throw std::runtime_error("Too many values in all_to_all_v");
+
+    MPI_Datatype mpi_type;
+    MPI_Type_contiguous(sizeof(T), MPI_BYTE, &mpi_type);
+    MPI_Type_commit(&mpi_type);
+
+    recv_values.resize(n_recv);
+    MPI_Alltoallv(n_send ? (void *)&send_values[0] : NULL, &send_ints[0], &send_displs[0], mpi_type,
+                  n_recv ? (void *)&recv_values[0] : NULL, &recv_ints[0], &recv_displs[0], mpi_type,
+                  mpi_comm);
+
+    MPI_Type_free(&mpi_type);
+    }
+
 //! Wrapper around MPI_Send that handles any serializable object
 template<typename T>
 void send(const T& val,const unsigned int dest, const MPI_Comm mpi_comm)
@@ -986,6 +986,129 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_num_types_signal.emit();
     }
 
+//! Begin a direct initialization of the local particles
+/*! \param N Number of local particles
+    \param type_mapping Names of the particle types (must be the same on all ranks)
+
+    Prepares the particle data to hold \a N local particles and nothing else. The caller then fills the particle
+    arrays (including the tags) through the array accessors, and calls endLocalInitialization(). Unlike
+    initializeFromSnapshot(), no particle data is sent between ranks, so every rank must only provide particles
+    inside its local box.
+*/
+void ParticleData::beginLocalInitialization(unsigned int N, const std::vector<std::string>& type_mapping)
+    {
+    m_exec_conf->msg->notice(4) << "ParticleData: initializing " << N << " local particles" << std::endl;
+
+    if (type_mapping.size() == 0)
+        {
+        m_exec_conf->msg->error() << "Number of particle types must be greater than 0." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    // remove all ghost particles
+    removeAllGhostParticles();
+
+    // clear set of active tags and reservoir of recycled tags
+    m_tag_set.clear();
+    while (! m_recycled_tags.empty())
+        m_recycled_tags.pop();
+    m_invalid_cached_tags = true;
+
+    m_type_mapping = type_mapping;
+    resize(N);
+
+    #ifdef ENABLE_MPI
+    if (N > 0)
+        {
+        ArrayHandle< unsigned int > h_comm_flag(m_comm_flags, access_location::host, access_mode::overwrite);
+        std::fill(h_comm_flag.data, h_comm_flag.data + N, 0);
+        }
+    #endif
+    }
+
+//! Finish a direct initialization of the local particles
+/*! \param accel_set True if the accelerations of the local particles have been set
+
+    Rebuilds the reverse-lookup table and the set of active tags from the tags of the local particles of all
+    ranks. Tags up to the largest tag that are not used on any rank are recycled. This method must be called on
+    all ranks.
+*/
+void ParticleData::endLocalInitialization(bool accel_set)
+    {
+    unsigned int ntags = 0;
+    unsigned int nglobal = m_nparticles;
+        {
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < m_nparticles; ++idx)
+            ntags = std::max(ntags, h_tag.data[idx]+1);
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &ntags, 1, MPI_UNSIGNED, MPI_MAX, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    // mark the tags that are in use on any rank
+    std::vector<unsigned char> in_use(ntags, 0);
+        {
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::read);
+        for (unsigned int idx = 0; idx < m_nparticles; ++idx)
+            in_use[h_tag.data[idx]] = 1;
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_decomposition && ntags > 0)
+        {
+        MPI_Allreduce(MPI_IN_PLACE, &in_use[0], ntags, MPI_UNSIGNED_CHAR, MPI_BOR, m_exec_conf->getMPICommunicator());
+        }
+    #endif
+
+    // every particle must have its own tag
+    unsigned int n_in_use = std::count(in_use.begin(), in_use.end(), 1);
+    if (n_in_use != nglobal)
+        {
+        m_exec_conf->msg->error() << "init.*: " << nglobal << " particles share " << n_in_use << " tags." << endl;
+        throw std::runtime_error("Error initializing ParticleData");
+        }
+
+    for (unsigned int tag = 0; tag < ntags; ++tag)
+        {
+        if (in_use[tag])
+            m_tag_set.insert(tag);
+        else
+            m_recycled_tags.push(tag);
+        }
+
+    // rebuild the reverse-lookup table
+    m_rtag.resize(ntags);
+        {
+        ArrayHandle< unsigned int > h_tag(m_tag, access_location::host, access_mode::read);
+        ArrayHandle< unsigned int > h_rtag(m_rtag, access_location::host, access_mode::overwrite);
+        std::fill(h_rtag.data, h_rtag.data + ntags, NOT_LOCAL);
+        for (unsigned int idx = 0; idx < m_nparticles; ++idx)
+            h_rtag.data[h_tag.data[idx]] = idx;
+        }
+    m_invalid_cached_tags = true;
+
+    m_accel_set = accel_set;
+
+    // set global number of particles
+    setNGlobal(nglobal);
+
+    // notify listeners about resorting of local particles
+    notifyParticleSort();
+
+    // zero the origin
+    m_origin = make_scalar3(0,0,0);
+    m_o_image = make_int3(0,0,0);
+
+    // notify listeners that number of types has changed
+    m_num_types_signal.emit();
+    }
+
 //! take a particle data snapshot
 /* \param snapshot The snapshot to write to
    \returns a map to lookup the snapshot index from a particle tag
@@ -2028,56 +2151,18 @@ unsigned int ParticleData::addParticle(unsigned int type)
     // resize array of global reverse lookup tags
     m_rtag.resize(getMaximumTag()+1);
 
-        {
-        // update reverse-lookup table
-        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
-        assert(h_rtag.data[tag] = NOT_LOCAL);
-        if (m_exec_conf->getRank() == 0)
-            {
-            // we add the particle at the end
-            h_rtag.data[tag] = getN();
-            }
-        else
-            {
-            // not on this processor
-            h_rtag.data[tag] = NOT_LOCAL;
-            }
-        }
-
     assert(tag <= m_recycled_tags.size() + getNGlobal());
 
     if (m_exec_conf->getRank() == 0)
         {
-        // resize particle data using amortized O(1) array resizing
-        // and update particle number
-        unsigned int old_nparticles = getN();
-        resize(old_nparticles+1);
-
-        // access particle data arrays
-        ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar3> h_accel(getAccelerations(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar> h_charge(getCharges(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar> h_diameter(getDiameters(), access_location::host, access_mode::readwrite);
-        ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_body(getBodies(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_orientation(getOrientationArray(), access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags, access_location::host, access_mode::readwrite);
-
-        unsigned int idx = old_nparticles;
-
-        // initialize to some sensible default values
-        h_pos.data[idx] = make_scalar4(0,0,0,__int_as_scalar(type));
-        h_vel.data[idx] = make_scalar4(0,0,0,1.0);
-        h_accel.data[idx] = make_scalar3(0,0,0);
-        h_charge.data[idx] = 0.0;
-        h_diameter.data[idx] = 0.0;
-        h_image.data[idx] = make_int3(0,0,0);
-        h_body.data[idx] = NO_BODY;
-        h_orientation.data[idx] = make_scalar4(1.0,0.0,0.0,0.0);
-        h_tag.data[idx] = tag;
-        h_comm_flag.data[idx] = 0;
+        // we add the particle at the end
+        addLocalParticle(tag, type);
+        }
+    else
+        {
+        // not on this processor
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+        h_rtag.data[tag] = NOT_LOCAL;
         }
 
     // update global number of particles
@@ -2147,42 +2232,7 @@ void ParticleData::removeParticle(unsigned int tag)
 
     if (is_local)
         {
-        unsigned int size = getN();
-
-        // If the particle is not the last element of the particle data, move the last element to
-        // to the position of the removed element
-        if (idx < (size-1))
-            {
-            // access particle data arrays
-            ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar3> h_accel(getAccelerations(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar> h_charge(getCharges(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar> h_diameter(getDiameters(), access_location::host, access_mode::readwrite);
-            ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
-            ArrayHandle<unsigned int> h_body(getBodies(), access_location::host, access_mode::readwrite);
-            ArrayHandle<Scalar4> h_orientation(getOrientationArray(), access_location::host, access_mode::readwrite);
-            ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
-            ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::readwrite);
-            ArrayHandle<unsigned int> h_comm_flag(m_comm_flags, access_location::host, access_mode::readwrite);
-
-            h_pos.data[idx] = h_pos.data[size-1];
-            h_vel.data[idx] = h_vel.data[size-1];
-            h_accel.data[idx] = h_accel.data[size-1];
-            h_charge.data[idx] = h_charge.data[size-1];
-            h_diameter.data[idx] = h_diameter.data[size-1];
-            h_image.data[idx] = h_image.data[size-1];
-            h_body.data[idx] = h_body.data[size-1];
-            h_orientation.data[idx] = h_orientation.data[size-1];
-            h_tag.data[idx] = h_tag.data[size-1];
-            h_comm_flag.data[idx] = h_comm_flag.data[size-1];
-
-            unsigned int last_tag = h_tag.data[size-1];
-            h_rtag.data[last_tag] = idx;
-            }
-
-        // update particle number
-        resize(getN()-1);
+        removeLocalParticle(idx);
         }
 
     // remove from set of active tags
@@ -2201,6 +2251,185 @@ void ParticleData::removeParticle(unsigned int tag)
     notifyParticleSort();
     }
 
+/*! \param remove_tags Tags of the particles to remove, identical on all ranks
+    \param n_insert Number of particles to insert on every rank, identical on all ranks
+    \param types Types of the particles to insert on this rank
+    \returns the tags of the particles inserted on this rank, in the order of \a types
+
+    Unlike addParticle() and removeParticle(), this method does not communicate. The caller is responsible for
+    providing the same \a remove_tags and \a n_insert on all ranks, e.g. after a single MPI_Allgather. Every rank
+    then updates the global tag bookkeeping in the same order. Particles in \a remove_tags are removed from the rank
+    that owns them, and the new particles are appended to the local arrays of the rank that inserts them with default
+    values. Their positions have to be set by the caller to a point inside the local domain, since they are not
+    migrated.
+*/
+std::vector<unsigned int> ParticleData::insertRemoveParticles(const std::vector<unsigned int>& remove_tags,
+    const std::vector<unsigned int>& n_insert, const std::vector<unsigned int>& types)
+    {
+    unsigned int my_rank = m_exec_conf->getRank();
+    assert(my_rank < n_insert.size());
+    assert(types.size() == n_insert[my_rank]);
+
+    // we are changing the local number of particles, so remove ghosts
+    removeAllGhostParticles();
+
+    unsigned int nglobal = getNGlobal();
+
+    for (unsigned int i = 0; i < remove_tags.size(); ++i)
+        {
+        unsigned int tag = remove_tags[i];
+
+        if (tag >= m_rtag.size() || m_tag_set.count(tag) == 0)
+            {
+            m_exec_conf->msg->error() << "Trying to remove particle " << tag << " which does not exist!" << endl;
+            throw runtime_error("Error removing particle");
+            }
+
+        unsigned int idx = m_rtag[tag];
+        m_rtag[tag] = NOT_LOCAL;
+
+        if (idx < getN())
+            {
+            removeLocalParticle(idx);
+            }
+
+        m_tag_set.erase(tag);
+        m_recycled_tags.push(tag);
+        nglobal--;
+        }
+
+    std::vector<unsigned int> tags;
+    tags.reserve(types.size());
+
+    for (unsigned int rank = 0; rank < n_insert.size(); ++rank)
+        {
+        for (unsigned int i = 0; i < n_insert[rank]; ++i)
+            {
+            // assign tags in the same order as addParticle(), on all ranks
+            unsigned int tag;
+            if (m_recycled_tags.size())
+                {
+                tag = m_recycled_tags.top();
+                m_recycled_tags.pop();
+                }
+            else
+                {
+                tag = nglobal;
+                }
+            nglobal++;
+
+            m_tag_set.insert(tag);
+            m_rtag.resize(getMaximumTag()+1);
+
+            if (rank == my_rank)
+                {
+                addLocalParticle(tag, types[tags.size()]);
+                tags.push_back(tag);
+                }
+            else
+                {
+                m_rtag[tag] = NOT_LOCAL;
+                }
+            }
+        }
+
+    m_invalid_cached_tags = true;
+
+    // update global number of particles
+    setNGlobal(nglobal);
+
+    // local particle number has changed
+    notifyParticleSort();
+
+    return tags;
+    }
+
+/*! \param tag Global tag of the new particle
+    \param type Type of the new particle
+*/
+void ParticleData::addLocalParticle(unsigned int tag, unsigned int type)
+    {
+    // resize particle data using amortized O(1) array resizing
+    // and update particle number
+    unsigned int old_nparticles = getN();
+    resize(old_nparticles+1);
+
+    // access particle data arrays
+    ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar3> h_accel(getAccelerations(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_charge(getCharges(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(getDiameters(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_body(getBodies(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_comm_flag(m_comm_flags, access_location::host, access_mode::readwrite);
+
+    unsigned int idx = old_nparticles;
+
+    // initialize to some sensible default values
+    h_pos.data[idx] = make_scalar4(0,0,0,__int_as_scalar(type));
+    h_vel.data[idx] = make_scalar4(0,0,0,1.0);
+    h_accel.data[idx] = make_scalar3(0,0,0);
+    h_charge.data[idx] = 0.0;
+    h_diameter.data[idx] = 0.0;
+    h_image.data[idx] = make_int3(0,0,0);
+    h_body.data[idx] = NO_BODY;
+    h_orientation.data[idx] = make_scalar4(1.0,0.0,0.0,0.0);
+    h_tag.data[idx] = tag;
+    h_comm_flag.data[idx] = 0;
+
+    // update reverse-lookup table
+    h_rtag.data[tag] = idx;
+    }
+
+/*! \param idx Local index of the particle to remove
+
+    The last local particle takes its place. The reverse-lookup tag of the removed particle is not modified.
+*/
+void ParticleData::removeLocalParticle(unsigned int idx)
+    {
+    unsigned int size = getN();
+    assert(idx < size);
+
+    // If the particle is not the last element of the particle data, move the last element to
+    // to the position of the removed element
+    if (idx < (size-1))
+        {
+        // access particle data arrays
+        ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_accel(getAccelerations(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(getCharges(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(getDiameters(), access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(getBodies(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(getOrientationArray(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(getRTags(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags, access_location::host, access_mode::readwrite);
+
+        h_pos.data[idx] = h_pos.data[size-1];
+        h_vel.data[idx] = h_vel.data[size-1];
+        h_accel.data[idx] = h_accel.data[size-1];
+        h_charge.data[idx] = h_charge.data[size-1];
+        h_diameter.data[idx] = h_diameter.data[size-1];
+        h_image.data[idx] = h_image.data[size-1];
+        h_body.data[idx] = h_body.data[size-1];
+        h_orientation.data[idx] = h_orientation.data[size-1];
+        h_tag.data[idx] = h_tag.data[size-1];
+        h_comm_flag.data[idx] = h_comm_flag.data[size-1];
+
+        unsigned int last_tag = h_tag.data[size-1];
+        h_rtag.data[last_tag] = idx;
+        }
+
+    // update particle number
+    resize(size-1);
+    }
+
 //! Return the nth active global tag
 /*! \param n Index of bond in global bond table
  */
@@ -971,6 +971,12 @@ class ParticleData
         template <class Real>
         std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real> &snapshot);
 
+        //! Begin a direct initialization of the local particles
+        void beginLocalInitialization(unsigned int N, const std::vector<std::string>& type_mapping);
+
+        //! Finish a direct initialization of the local particles
+        void endLocalInitialization(bool accel_set);
+
         //! Add ghost particles at the end of the local particle data
         void addGhostParticles(const unsigned int nghosts);
 
@@ -1049,6 +1055,10 @@ class ParticleData
         //! Remove a particle from the simulation
         void removeParticle(unsigned int tag);
 
+        //! Insert and remove many particles on all ranks at once
+        std::vector<unsigned int> insertRemoveParticles(const std::vector<unsigned int>& remove_tags,
+            const std::vector<unsigned int>& n_insert, const std::vector<unsigned int>& types);
+
         //! Return the nth active global tag
         unsigned int getNthTag(unsigned int n);
 
@@ -1193,6 +1203,12 @@ class ParticleData
         //! Helper function to rebuild the active tag cache if necessary
         void maybe_rebuild_tag_cache();
 
+        //! Helper function to append a particle with default values to the local arrays
+        void addLocalParticle(unsigned int tag, unsigned int type);
+
+        //! Helper function to remove a particle from the local arrays
+        void removeLocalParticle(unsigned int idx);
+
         //! Helper function to check that particles of a snapshot are in the box
         /*! \return true If and only if all particles are in the simulation box
          * \param Snapshot to check
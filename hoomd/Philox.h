@@ -0,0 +1,305 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file hoomd/Philox.h
+ * \brief Implementation of the Philox4x32-10 counter-based random number generator.
+ */
+
+#ifndef HOOMD_PHILOX_H_
+#define HOOMD_PHILOX_H_
+
+// pull in uint2 and uint4 types
+#include "HOOMDMath.h"
+
+#ifdef NVCC
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif // NVCC
+
+namespace hoomd
+{
+namespace detail
+{
+
+//! Philox4x32-10 random number generator
+/*!
+ * Philox is a counter-based pseudo-random number generator. It is a keyed bijection that maps a 128-bit
+ * counter and a 64-bit key to 128 random bits, so there is no state to carry from one draw to the next.
+ * Philox4x32-10 passes TestU01's BigCrush. See
+ *
+ * J.K. Salmon, M.A. Moraes, R.O. Dror, and D.E. Shaw. "Parallel random numbers: as easy as 1, 2, 3",
+ * Proceedings of the International Conference for High Performance Computing, Networking, Storage and
+ * Analysis (SC11), 16:1-16:12 (2011).
+ *
+ * The generator is used like Saru: it is seeded with the particle tag, the timestep and a user-defined
+ * seed, and the random numbers for a given particle on a given step do not depend on the order in which
+ * particles are processed, the number of threads, the domain decomposition, or whether they are drawn on
+ * the CPU or the GPU. Each call to operator()() returns four 32-bit integers and advances the counter,
+ * so every call yields four uniform or four normal variates without any rejection loop. The absence of
+ * data-dependent branches lets compilers vectorize loops that draw numbers for many particles at once
+ * (see philox_uniform4() and philox_normal4()).
+ */
+class Philox4x32
+    {
+    public:
+        //! Three-seed constructor
+        HOSTDEVICE inline Philox4x32(unsigned int seed1, unsigned int seed2, unsigned int seed3);
+
+        //! Four-seed constructor
+        HOSTDEVICE inline Philox4x32(unsigned int seed1, unsigned int seed2, unsigned int seed3, unsigned int seed4);
+
+        //! Skip ahead \a blocks blocks of four random numbers
+        /*!
+         * \param blocks Number of blocks to skip
+         */
+        HOSTDEVICE inline void advance(unsigned int blocks)
+            {
+            m_ctr.z += blocks;
+            }
+
+        //! Draw four random 32-bit unsigned integers
+        HOSTDEVICE inline uint4 operator()();
+
+        //! Draw four random values uniformly distributed between \a a and \a b
+        template<class Real>
+        HOSTDEVICE inline void uniform4(Real a, Real b, Real& r0, Real& r1, Real& r2, Real& r3);
+
+        //! Draw four normally distributed random values with mean 0 and standard deviation \a sigma
+        template<class Real>
+        HOSTDEVICE inline void normal4(Real sigma, Real& r0, Real& r1, Real& r2, Real& r3);
+
+        //! Compute one Philox4x32-10 block
+        HOSTDEVICE static inline uint4 block(uint4 ctr, uint2 key);
+
+    private:
+        uint4 m_ctr;    //!< Counter
+        uint2 m_key;    //!< Key
+
+        static const unsigned int PHILOX_M0 = 0xD2511F53;   //!< Multiplier of the first word pair
+        static const unsigned int PHILOX_M1 = 0xCD9E8D57;   //!< Multiplier of the second word pair
+        static const unsigned int PHILOX_W0 = 0x9E3779B9;   //!< Weyl increment of the first key word (golden ratio)
+        static const unsigned int PHILOX_W1 = 0xBB67AE85;   //!< Weyl increment of the second key word (sqrt(3)-1)
+
+        //! Compute the high 32 bits of the 64-bit product a*b
+        HOSTDEVICE static inline unsigned int mulhi(unsigned int a, unsigned int b);
+
+        //! Apply a single Philox round
+        HOSTDEVICE static inline uint4 round(uint4 ctr, uint2 key);
+    };
+
+//! Convert a random 32-bit integer to a floating-point value in (0,1]
+/*!
+ * \param u Random 32-bit integer
+ * \returns A value that is never 0, so that it can be passed to log()
+ */
+template<class Real>
+HOSTDEVICE inline Real u32_to_u01(unsigned int u)
+    {
+    return (Real(u) + Real(1.0)) * Real(2.3283064365386963e-10); // 2^-32
+    }
+
+//! Transform two uniform random integers into two independent normal variates
+/*!
+ * \param u0 First random 32-bit integer
+ * \param u1 Second random 32-bit integer
+ * \param n0 First normal variate (output)
+ * \param n1 Second normal variate (output)
+ *
+ * Uses the Box-Muller transform, which, unlike the polar method in gaussian_rng(), needs no rejection loop.
+ */
+template<class Real>
+HOSTDEVICE inline void box_muller(unsigned int u0, unsigned int u1, Real& n0, Real& n1)
+    {
+    Real r = fast::sqrt(Real(-2.0) * fast::log(u32_to_u01<Real>(u0)));
+    Real theta = Real(2.0 * M_PI) * u32_to_u01<Real>(u1);
+    n0 = r * fast::cos(theta);
+    n1 = r * fast::sin(theta);
+    }
+
+/*!
+ * \param seed1 First seed (typically the particle tag)
+ * \param seed2 Second seed (typically the timestep)
+ * \param seed3 Third seed (typically the user-defined seed)
+ */
+HOSTDEVICE inline Philox4x32::Philox4x32(unsigned int seed1, unsigned int seed2, unsigned int seed3)
+    {
+    m_ctr = make_uint4(seed1, seed2, 0, 0);
+    m_key = make_uint2(seed3, 0);
+    }
+
+/*!
+ * \param seed1 First seed (typically the particle tag)
+ * \param seed2 Second seed (typically the timestep)
+ * \param seed3 Third seed (typically the user-defined seed)
+ * \param seed4 Fourth seed, use it to draw independent streams for the same particle and timestep
+ */
+HOSTDEVICE inline Philox4x32::Philox4x32(unsigned int seed1, unsigned int seed2, unsigned int seed3, unsigned int seed4)
+    {
+    m_ctr = make_uint4(seed1, seed2, 0, 0);
+    m_key = make_uint2(seed3, seed4);
+    }
+
+/*!
+ * \returns Four random 32-bit unsigned integers
+ */
+HOSTDEVICE inline uint4 Philox4x32::operator()()
+    {
+    uint4 r = block(m_ctr, m_key);
+    m_ctr.z++;
+    return r;
+    }
+
+/*!
+ * \param a Lower bound
+ * \param b Upper bound
+ * \param r0 First random value (output)
+ * \param r1 Second random value (output)
+ * \param r2 Third random value (output)
+ * \param r3 Fourth random value (output)
+ */
+template<class Real>
+HOSTDEVICE inline void Philox4x32::uniform4(Real a, Real b, Real& r0, Real& r1, Real& r2, Real& r3)
+    {
+    uint4 u = (*this)();
+    Real scale = b - a;
+    r0 = a + scale * u32_to_u01<Real>(u.x);
+    r1 = a + scale * u32_to_u01<Real>(u.y);
+    r2 = a + scale * u32_to_u01<Real>(u.z);
+    r3 = a + scale * u32_to_u01<Real>(u.w);
+    }
+
+/*!
+ * \param sigma Standard deviation
+ * \param r0 First random value (output)
+ * \param r1 Second random value (output)
+ * \param r2 Third random value (output)
+ * \param r3 Fourth random value (output)
+ */
+template<class Real>
+HOSTDEVICE inline void Philox4x32::normal4(Real sigma, Real& r0, Real& r1, Real& r2, Real& r3)
+    {
+    uint4 u = (*this)();
+    box_muller<Real>(u.x, u.y, r0, r1);
+    box_muller<Real>(u.z, u.w, r2, r3);
+    r0 *= sigma;
+    r1 *= sigma;
+    r2 *= sigma;
+    r3 *= sigma;
+    }
+
+/*!
+ * \param a First factor
+ * \param b Second factor
+ * \returns The high 32 bits of a*b
+ */
+HOSTDEVICE inline unsigned int Philox4x32::mulhi(unsigned int a, unsigned int b)
+    {
+    #ifdef __CUDA_ARCH__
+    return __umulhi(a, b);
+    #else
+    return (unsigned int)(((unsigned long long)a * (unsigned long long)b) >> 32);
+    #endif
+    }
+
+/*!
+ * \param ctr Counter
+ * \param key Key
+ * \returns The counter after one round
+ */
+HOSTDEVICE inline uint4 Philox4x32::round(uint4 ctr, uint2 key)
+    {
+    unsigned int hi0 = mulhi(PHILOX_M0, ctr.x);
+    unsigned int lo0 = PHILOX_M0 * ctr.x;
+    unsigned int hi1 = mulhi(PHILOX_M1, ctr.z);
+    unsigned int lo1 = PHILOX_M1 * ctr.z;
+    return make_uint4(hi1 ^ ctr.y ^ key.x, lo1, hi0 ^ ctr.w ^ key.y, lo0);
+    }
+
+/*!
+ * \param ctr Counter
+ * \param key Key
+ * \returns 128 random bits
+ */
+HOSTDEVICE inline uint4 Philox4x32::block(uint4 ctr, uint2 key)
+    {
+    for (unsigned int i = 0; i < 9; ++i)
+        {
+        ctr = round(ctr, key);
+        key.x += PHILOX_W0;
+        key.y += PHILOX_W1;
+        }
+    return round(ctr, key);
+    }
+
+#ifndef NVCC
+//! Draw uniform random values for a list of particles
+/*!
+ * \param out Output array, one Scalar4 of random values per entry in \a idx
+ * \param idx Particle indices
+ * \param tag Particle tags, indexed by particle index
+ * \param n Number of particles
+ * \param timestep Current timestep
+ * \param seed User-defined seed
+ * \param a Lower bound
+ * \param b Upper bound
+ *
+ * out[i] holds the values that Philox4x32(tag[idx[i]], timestep, seed).uniform4(a, b, ...) draws. The loop has
+ * no dependencies between iterations, so the compiler can vectorize it.
+ */
+inline void philox_uniform4(Scalar4 *out,
+                            const unsigned int *idx,
+                            const unsigned int *tag,
+                            unsigned int n,
+                            unsigned int timestep,
+                            unsigned int seed,
+                            Scalar a,
+                            Scalar b)
+    {
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        Philox4x32 rng(tag[idx[i]], timestep, seed);
+        rng.uniform4<Scalar>(a, b, out[i].x, out[i].y, out[i].z, out[i].w);
+        }
+    }
+
+//! Draw normal random values for a list of particles
+/*!
+ * \param out Output array, one Scalar4 of random values per entry in \a idx
+ * \param idx Particle indices
+ * \param tag Particle tags, indexed by particle index
+ * \param n Number of particles
+ * \param timestep Current timestep
+ * \param seed User-defined seed
+ * \param block Index of the block in the stream of each particle
+ *
+ * out[i] holds the values with mean 0 and standard deviation 1 that Philox4x32(tag[idx[i]], timestep, seed) draws
+ * with normal4() after advance(block). Use a different \a block for every set of random numbers drawn for
+ * the same particle on the same step (philox_uniform4() uses block 0).
+ */
+inline void philox_normal4(Scalar4 *out,
+                           const unsigned int *idx,
+                           const unsigned int *tag,
+                           unsigned int n,
+                           unsigned int timestep,
+                           unsigned int seed,
+                           unsigned int block)
+    {
+    for (unsigned int i = 0; i < n; ++i)
+        {
+        uint4 u = Philox4x32::block(make_uint4(tag[idx[i]], timestep, block, 0), make_uint2(seed, 0));
+        box_muller<Scalar>(u.x, u.y, out[i].x, out[i].y);
+        box_muller<Scalar>(u.z, u.w, out[i].z, out[i].w);
+        }
+    }
+#endif
+
+} // end namespace detail
+} // end namespace hoomd
+
+#undef HOSTDEVICE
+
+#endif // HOOMD_PHILOX_H_
@@ -0,0 +1,332 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file ReplicatedSnapshotReader.cc
+    \brief Defines the ReplicatedSnapshotReader class
+*/
+
+#include "ReplicatedSnapshotReader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+namespace py = pybind11;
+
+/*! \param exec_conf The execution configuration
+    \param unit_cell The unit cell to replicate (must be the same on all ranks)
+    \param nx Number of replicas along the first box vector
+    \param ny Number of replicas along the second box vector
+    \param nz Number of replicas along the third box vector
+*/
+template <class Real>
+ReplicatedSnapshotReader<Real>::ReplicatedSnapshotReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                                         std::shared_ptr< SnapshotSystemData<Real> > unit_cell,
+                                                         unsigned int nx,
+                                                         unsigned int ny,
+                                                         unsigned int nz)
+    : m_exec_conf(exec_conf), m_unit_cell(unit_cell), m_n(make_uint3(nx, ny, nz))
+    {
+    if (nx == 0 || ny == 0 || nz == 0)
+        {
+        m_exec_conf->msg->error() << "init.*: The number of replicas must be positive" << endl;
+        throw runtime_error("Error initializing");
+        }
+
+    if (unit_cell->dimensions == 2 && nz != 1)
+        {
+        m_exec_conf->msg->error() << "init.*: 2D systems can only be replicated once along z" << endl;
+        throw runtime_error("Error initializing");
+        }
+
+    if (unit_cell->particle_data.size == 0)
+        {
+        m_exec_conf->msg->error() << "init.*: The unit cell has no particles" << endl;
+        throw runtime_error("Error initializing");
+        }
+
+    if (uint64_t(unit_cell->particle_data.size) * nx * ny * nz > uint64_t(NOT_LOCAL))
+        {
+        m_exec_conf->msg->error() << "init.*: Too many particles" << endl;
+        throw runtime_error("Error initializing");
+        }
+
+    // the replicated box, as in SnapshotSystemData::replicate()
+    m_global_box = unit_cell->global_box;
+    Scalar3 L = m_global_box.getL();
+    L.x *= (Scalar) nx;
+    L.y *= (Scalar) ny;
+    L.z *= (Scalar) nz;
+    m_global_box.setL(L);
+    }
+
+/*! \returns A snapshot with the replicated box and the type names of the unit cell
+*/
+template <class Real>
+std::shared_ptr< SnapshotSystemData<Real> > ReplicatedSnapshotReader<Real>::getSnapshot() const
+    {
+    std::shared_ptr< SnapshotSystemData<Real> > snapshot(new SnapshotSystemData<Real>());
+
+    snapshot->dimensions = m_unit_cell->dimensions;
+    snapshot->global_box = m_global_box;
+    snapshot->particle_data.type_mapping = m_unit_cell->particle_data.type_mapping;
+    snapshot->bond_data.type_mapping = m_unit_cell->bond_data.type_mapping;
+    snapshot->angle_data.type_mapping = m_unit_cell->angle_data.type_mapping;
+    snapshot->dihedral_data.type_mapping = m_unit_cell->dihedral_data.type_mapping;
+    snapshot->improper_data.type_mapping = m_unit_cell->improper_data.type_mapping;
+    snapshot->pair_data.type_mapping = m_unit_cell->pair_data.type_mapping;
+
+    return snapshot;
+    }
+
+/*! \param sysdef System definition constructed from getSnapshot()
+
+    This method must be called on all ranks.
+*/
+template <class Real>
+void ReplicatedSnapshotReader<Real>::readLocal(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    const SnapshotParticleData<Real>& unit = m_unit_cell->particle_data;
+    const BoxDim& old_box = m_unit_cell->global_box;
+    const unsigned int old_size = unit.size;
+
+    // fractional extent of the local domain
+    Scalar lo[3] = {0, 0, 0};
+    Scalar hi[3] = {1, 1, 1};
+    std::shared_ptr<DomainDecomposition> decomposition;
+    #ifdef ENABLE_MPI
+    decomposition = pdata->getDomainDecomposition();
+    if (decomposition)
+        {
+        uint3 grid_pos = decomposition->getGridPos();
+        unsigned int pos[3] = {grid_pos.x, grid_pos.y, grid_pos.z};
+        for (unsigned int d = 0; d < 3; ++d)
+            {
+            std::vector<Scalar> cum_frac = decomposition->getCumulativeFractions(d);
+            lo[d] = cum_frac[pos[d]];
+            hi[d] = cum_frac[pos[d]+1];
+            }
+        }
+    #endif
+
+    // range of replica cells (after wrapping) that overlap the local domain, with one cell of margin for round-off
+    unsigned int n[3] = {m_n.x, m_n.y, m_n.z};
+    int cell_begin[3], cell_end[3];
+    for (unsigned int d = 0; d < 3; ++d)
+        {
+        cell_begin[d] = std::max(int(floor(lo[d]*n[d])) - 1, 0);
+        cell_end[d] = std::min(int(ceil(hi[d]*n[d])) + 1, int(n[d]));
+        }
+
+    std::vector<pdata_element> local;
+    for (unsigned int i = 0; i < old_size; ++i)
+        {
+        // unwrap position of particle i in old box using image flags
+        vec3<Real> p = unit.pos[i];
+        int3 img = unit.image[i];
+        p = vec3<Real>(old_box.shift(vec3<Scalar>(p), img));
+        vec3<Real> f = old_box.makeFraction(p);
+
+        // replica l lands in cell (l + floor(f)) mod n after wrapping
+        int shift[3] = {int(floor(f.x)), int(floor(f.y)), int(floor(f.z))};
+
+        for (int cx = cell_begin[0]; cx < cell_end[0]; ++cx)
+            for (int cy = cell_begin[1]; cy < cell_end[1]; ++cy)
+                for (int cz = cell_begin[2]; cz < cell_end[2]; ++cz)
+                    {
+                    unsigned int l = ((cx - shift[0]) % int(n[0]) + n[0]) % n[0];
+                    unsigned int m = ((cy - shift[1]) % int(n[1]) + n[1]) % n[1];
+                    unsigned int k = ((cz - shift[2]) % int(n[2]) + n[2]) % n[2];
+                    unsigned int j = (l*n[1] + m)*n[2] + k;
+
+                    // same expressions as SnapshotParticleData::replicate()
+                    Scalar3 f_new;
+                    f_new.x = f.x/(Real)n[0] + (Real)l/(Real)n[0];
+                    f_new.y = f.y/(Real)n[1] + (Real)m/(Real)n[1];
+                    f_new.z = f.z/(Real)n[2] + (Real)k/(Real)n[2];
+
+                    Scalar3 q = m_global_box.makeCoordinates(f_new);
+                    int3 image = m_global_box.getImage(q);
+                    int3 negimg = make_int3(-image.x, -image.y, -image.z);
+                    q = m_global_box.shift(q, negimg);
+                    m_global_box.wrap(q, image);
+
+                    // round to the precision of the snapshot
+                    vec3<Scalar> pos = vec3<Scalar>(vec3<Real>(q));
+
+                    #ifdef ENABLE_MPI
+                    if (decomposition && decomposition->placeParticle(m_global_box, vec_to_scalar3(pos)) != m_exec_conf->getRank())
+                        continue;
+                    #endif
+
+                    pdata_element e;
+                    memset(&e, 0, sizeof(pdata_element));
+                    e.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(unit.type[i]));
+                    e.vel = make_scalar4(unit.vel[i].x, unit.vel[i].y, unit.vel[i].z, unit.mass[i]);
+                    e.accel = vec_to_scalar3(unit.accel[i]);
+                    e.charge = unit.charge[i];
+                    e.diameter = unit.diameter[i];
+                    e.image = image;
+                    e.body = (unit.body[i] != NO_BODY ? j*old_size + unit.body[i] : NO_BODY);
+                    e.orientation = quat_to_scalar4(unit.orientation[i]);
+                    e.angmom = quat_to_scalar4(unit.angmom[i]);
+                    e.inertia = vec_to_scalar3(unit.inertia[i]);
+                    e.tag = j*old_size + i;
+                    local.push_back(e);
+                    }
+        }
+
+    pdata->beginLocalInitialization(local.size(), unit.type_mapping);
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_accel(pdata->getAccelerations(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_charge(pdata->getCharges(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_diameter(pdata->getDiameters(), access_location::host, access_mode::overwrite);
+        ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_body(pdata->getBodies(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_orientation(pdata->getOrientationArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar4> h_angmom(pdata->getAngularMomentumArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_inertia(pdata->getMomentsOfInertiaArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int idx = 0; idx < local.size(); ++idx)
+            {
+            const pdata_element& e = local[idx];
+            h_pos.data[idx] = e.pos;
+            h_vel.data[idx] = e.vel;
+            h_accel.data[idx] = e.accel;
+            h_charge.data[idx] = e.charge;
+            h_diameter.data[idx] = e.diameter;
+            h_image.data[idx] = e.image;
+            h_body.data[idx] = e.body;
+            h_orientation.data[idx] = e.orientation;
+            h_angmom.data[idx] = e.angmom;
+            h_inertia.data[idx] = e.inertia;
+            h_tag.data[idx] = e.tag;
+            }
+        }
+    pdata->endLocalInitialization(unit.is_accel_set);
+
+    readGroups(sysdef->getBondData(), m_unit_cell->bond_data, pdata);
+    readGroups(sysdef->getAngleData(), m_unit_cell->angle_data, pdata);
+    readGroups(sysdef->getDihedralData(), m_unit_cell->dihedral_data, pdata);
+    readGroups(sysdef->getImproperData(), m_unit_cell->improper_data, pdata);
+    readGroups(sysdef->getConstraintData(), m_unit_cell->constraint_data, pdata);
+    readGroups(sysdef->getPairData(), m_unit_cell->pair_data, pdata);
+    }
+
+/*! \param gdata Bonded group data to fill
+    \param unit_groups The bonded groups of the unit cell
+    \param pdata The particle data, already filled with the local particles
+
+    Replicas of a group only bond particles of the same replica, as in BondedGroupData::Snapshot::replicate(). A
+    rank generates the replicas of the groups that contain one of its local particles. A group is generated from
+    the first of its members that is local, so that every rank generates it once.
+*/
+template <class Real>
+template <class group_data>
+void ReplicatedSnapshotReader<Real>::readGroups(std::shared_ptr<group_data> gdata,
+                                                const typename group_data::Snapshot& unit_groups,
+                                                std::shared_ptr<ParticleData> pdata)
+    {
+    const unsigned int group_size = group_data::size;
+    const unsigned int old_size = m_unit_cell->particle_data.size;
+    const unsigned int old_n_groups = unit_groups.size;
+    if (old_n_groups == 0)
+        return;
+
+    // groups of the unit cell that each particle of the unit cell is a member of, with its position in the group
+    std::vector< std::vector<uint2> > particle_groups(old_size);
+    for (unsigned int g = 0; g < old_n_groups; ++g)
+        for (unsigned int k = 0; k < group_size; ++k)
+            {
+            unsigned int i = unit_groups.groups[g].tag[k];
+            if (i >= old_size)
+                {
+                m_exec_conf->msg->error() << "init.*: " << group_data::getName() << " " << g << " has invalid member " << i << endl;
+                throw runtime_error("Error initializing");
+                }
+            particle_groups[i].push_back(make_uint2(g, k));
+            }
+
+    std::vector<typename group_data::members_t> members;
+    std::vector<typeval_t> typeval;
+    std::vector<unsigned int> tags;
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(), access_location::host, access_mode::read);
+        const unsigned int N = pdata->getN();
+
+        for (unsigned int idx = 0; idx < N; ++idx)
+            {
+            unsigned int j = h_tag.data[idx] / old_size;
+            unsigned int i = h_tag.data[idx] % old_size;
+
+            for (unsigned int p = 0; p < particle_groups[i].size(); ++p)
+                {
+                unsigned int g = particle_groups[i][p].x;
+                unsigned int pos = particle_groups[i][p].y;
+
+                typename group_data::members_t h;
+                bool first = true;
+                for (unsigned int k = 0; k < group_size; ++k)
+                    {
+                    h.tag[k] = unit_groups.groups[g].tag[k] + old_size*j;
+                    if (k < pos && h_rtag.data[h.tag[k]] < N)
+                        first = false;
+                    }
+                if (! first)
+                    continue;
+
+                typeval_t t;
+                if (group_data::typemap_val)
+                    t.type = unit_groups.type_id[g];
+                else
+                    t.val = unit_groups.val[g];
+
+                members.push_back(h);
+                typeval.push_back(t);
+                tags.push_back(old_n_groups*j + g);
+                }
+            }
+        }
+
+    gdata->beginLocalInitialization(members.size(), unit_groups.type_mapping);
+        {
+        ArrayHandle<typename group_data::members_t> h_members(gdata->getMembersArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_typeval(gdata->getTypeValArray(), access_location::host, access_mode::overwrite);
+        ArrayHandle<unsigned int> h_tag(gdata->getTags(), access_location::host, access_mode::overwrite);
+
+        for (unsigned int idx = 0; idx < members.size(); ++idx)
+            {
+            h_members.data[idx] = members[idx];
+            h_typeval.data[idx] = typeval[idx];
+            h_tag.data[idx] = tags[idx];
+            }
+        }
+    gdata->endLocalInitialization();
+    }
+
+void export_ReplicatedSnapshotReader(py::module& m)
+    {
+    py::class_< ReplicatedSnapshotReader<float>, std::shared_ptr< ReplicatedSnapshotReader<float> > >(m,"ReplicatedSnapshotReader_float")
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, std::shared_ptr< SnapshotSystemData<float> >, unsigned int, unsigned int, unsigned int>())
+    .def("getSnapshot", &ReplicatedSnapshotReader<float>::getSnapshot)
+    .def("readLocal", &ReplicatedSnapshotReader<float>::readLocal)
+    ;
+
+    py::class_< ReplicatedSnapshotReader<double>, std::shared_ptr< ReplicatedSnapshotReader<double> > >(m,"ReplicatedSnapshotReader_double")
+    .def(py::init<std::shared_ptr<const ExecutionConfiguration>, std::shared_ptr< SnapshotSystemData<double> >, unsigned int, unsigned int, unsigned int>())
+    .def("getSnapshot", &ReplicatedSnapshotReader<double>::getSnapshot)
+    .def("readLocal", &ReplicatedSnapshotReader<double>::readLocal)
+    ;
+    }
+
+template class ReplicatedSnapshotReader<float>;
+template class ReplicatedSnapshotReader<double>;
@@ -0,0 +1,78 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+/*! \file ReplicatedSnapshotReader.h
+    \brief Declares the ReplicatedSnapshotReader class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __REPLICATED_SNAPSHOT_READER_H__
+#define __REPLICATED_SNAPSHOT_READER_H__
+
+#include "SystemDefinition.h"
+#include "SnapshotSystemData.h"
+
+#include <memory>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+//! Initializes a system that replicates a unit cell, without a global snapshot
+/*! SnapshotSystemData::replicate() builds the whole replicated system on the root rank, which then scatters it to
+    the other ranks. ReplicatedSnapshotReader instead keeps only the unit cell and the number of replicas, and every
+    rank generates the particles that fall in its own domain:
+
+    1. getSnapshot() returns a snapshot without particles that holds the replicated box and the type names, from
+       which the SystemDefinition is constructed.
+    2. readLocal() fills the SystemDefinition. Every rank loops only over the replicas of the unit cell that overlap
+       its domain, and keeps the particles that DomainDecomposition::placeParticle() assigns to it. The bonded
+       groups of the unit cell are then replicated for the local particles only.
+
+    Positions, images, tags, body ids, and group members are computed with the same expressions as SnapshotSystemData::replicate(),
+    so the resulting system is identical to the one initialized from the replicated snapshot. In particular, the tag
+    of particle i in replica (l,m,n) is ((l*ny + m)*nz + n)*N + i, where N is the number of particles in the unit
+    cell. Tags are therefore known without any communication.
+
+    The unit cell must be the same on all ranks.
+
+    \ingroup data_structs
+*/
+template <class Real>
+class ReplicatedSnapshotReader
+    {
+    public:
+        //! Constructor
+        ReplicatedSnapshotReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                                 std::shared_ptr< SnapshotSystemData<Real> > unit_cell,
+                                 unsigned int nx,
+                                 unsigned int ny,
+                                 unsigned int nz);
+
+        //! Get a snapshot with the replicated box and the type names, but without particles
+        std::shared_ptr< SnapshotSystemData<Real> > getSnapshot() const;
+
+        //! Generate the local particles
+        void readLocal(std::shared_ptr<SystemDefinition> sysdef);
+
+    private:
+        std::shared_ptr<const ExecutionConfiguration> m_exec_conf;    //!< The execution configuration
+        std::shared_ptr< SnapshotSystemData<Real> > m_unit_cell;      //!< The unit cell
+        uint3 m_n;                                                    //!< Number of replicas in each direction
+        BoxDim m_global_box;                                          //!< The replicated box
+
+        //! Generate the local replicas of the bonded groups of the unit cell
+        template <class group_data>
+        void readGroups(std::shared_ptr<group_data> gdata,
+                        const typename group_data::Snapshot& unit_groups,
+                        std::shared_ptr<ParticleData> pdata);
+    };
+
+//! Exports ReplicatedSnapshotReader to python
+void export_ReplicatedSnapshotReader(pybind11::module& m);
+
+#endif
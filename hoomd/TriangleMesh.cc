@@ -0,0 +1,217 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TriangleMesh.cc
+    \brief Defines the TriangleMesh class
+*/
+
+#include "TriangleMesh.h"
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+using namespace hpmc::detail;
+namespace py = pybind11;
+
+/*! \param vertices Vertices of the mesh
+    \param triangles Indices into \a vertices, three per triangle
+*/
+TriangleMesh::TriangleMesh(const std::vector< vec3<Scalar> >& vertices, const std::vector<unsigned int>& triangles)
+    : m_tol(0.0)
+    {
+    if (triangles.size() % 3 != 0)
+        {
+        throw runtime_error("The number of triangle vertex indices must be a multiple of three");
+        }
+
+    vec3<Scalar> lower(vertices.size() ? vertices[0] : vec3<Scalar>());
+    vec3<Scalar> upper(lower);
+
+    for (unsigned int i = 0; i < triangles.size(); i += 3)
+        {
+        vec3<Scalar> v[3];
+        for (unsigned int k = 0; k < 3; ++k)
+            {
+            if (triangles[i+k] >= vertices.size())
+                {
+                ostringstream oss;
+                oss << "Invalid vertex index " << triangles[i+k] << " in triangle " << i/3;
+                throw runtime_error(oss.str());
+                }
+            v[k] = vertices[triangles[i+k]];
+
+            lower = vec3<Scalar>(std::min(lower.x, v[k].x), std::min(lower.y, v[k].y), std::min(lower.z, v[k].z));
+            upper = vec3<Scalar>(std::max(upper.x, v[k].x), std::max(upper.y, v[k].y), std::max(upper.z, v[k].z));
+            }
+
+        // skip degenerate triangles, they have no normal
+        vec3<Scalar> n = cross(v[1] - v[0], v[2] - v[0]);
+        Scalar n_len = sqrt(dot(n,n));
+        if (n_len == Scalar(0.0))
+            continue;
+
+        for (unsigned int k = 0; k < 3; ++k)
+            m_vertices.push_back(v[k]);
+        m_normals.push_back(n / n_len);
+        }
+
+    if (m_normals.size() == 0)
+        {
+        throw runtime_error("The mesh has no triangles with nonzero area");
+        }
+
+    // points closer than this are the same vertex or edge of neighboring triangles
+    vec3<Scalar> diagonal = upper - lower;
+    m_tol = Scalar(1e-6)*sqrt(dot(diagonal, diagonal));
+
+    buildTree();
+    }
+
+void TriangleMesh::buildTree()
+    {
+    unsigned int N = getNumTriangles();
+
+    AABB *aabbs;
+    int retval = posix_memalign((void**)&aabbs, 32, std::max(N,1u)*sizeof(AABB));
+    if (retval != 0)
+        {
+        throw runtime_error("Error allocating AABB memory");
+        }
+
+    for (unsigned int i = 0; i < N; ++i)
+        {
+        const vec3<Scalar>* v = &m_vertices[3*i];
+        vec3<Scalar> lower(std::min(v[0].x, std::min(v[1].x, v[2].x)),
+                           std::min(v[0].y, std::min(v[1].y, v[2].y)),
+                           std::min(v[0].z, std::min(v[1].z, v[2].z)));
+        vec3<Scalar> upper(std::max(v[0].x, std::max(v[1].x, v[2].x)),
+                           std::max(v[0].y, std::max(v[1].y, v[2].y)),
+                           std::max(v[0].z, std::max(v[1].z, v[2].z)));
+        aabbs[i] = AABB(lower, upper);
+        }
+
+    m_tree.buildTree(aabbs, N);
+    free(aabbs);
+    }
+
+/*! \param p Query point
+    \param r_max Only points on the mesh closer than r_max are considered, may be infinite
+    \param dx Set to the vector from \a p to the nearest point on the mesh
+    \param n Set to the unit pseudo-normal of the mesh at the nearest point
+    \returns true if a point on the mesh is closer than \a r_max, and false otherwise
+
+    The tree is traversed in order. Nodes that are farther away from \a p than the nearest point found so far are
+    skipped. All triangles that share the nearest point contribute their normals to the pseudo-normal, weighted by
+    their angle at the point when it is one of their vertices.
+*/
+bool TriangleMesh::findNearest(const vec3<Scalar>& p, Scalar r_max, vec3<Scalar>& dx, vec3<Scalar>& n) const
+    {
+    Scalar r_min = r_max;
+    Scalar rsq_min = r_max*r_max;
+    bool found = false;
+
+    vec3<Scalar> nearest;
+    vec3<Scalar> n_sum;
+
+    for (unsigned int cur_node_idx = 0; cur_node_idx < m_tree.getNumNodes(); cur_node_idx++)
+        {
+        const AABBNode& node = m_tree.getNode(cur_node_idx);
+
+        // distance of p to the box of this node
+        vec3<Scalar> lower = node.aabb.getLower();
+        vec3<Scalar> upper = node.aabb.getUpper();
+        vec3<Scalar> d(std::max(lower.x - p.x, std::max(p.x - upper.x, Scalar(0.0))),
+                       std::max(lower.y - p.y, std::max(p.y - upper.y, Scalar(0.0))),
+                       std::max(lower.z - p.z, std::max(p.z - upper.z, Scalar(0.0))));
+
+        Scalar r_skip = r_min + m_tol;
+        if (dot(d,d) > r_skip*r_skip)
+            {
+            cur_node_idx += node.skip;
+            continue;
+            }
+
+        for (unsigned int j = 0; j < node.num_particles; ++j)
+            {
+            unsigned int i = node.particles[j];
+            const vec3<Scalar>* v = &m_vertices[3*i];
+
+            triangle_feature feature;
+            vec3<Scalar> c = closestPointOnTriangle(p, v[0], v[1], v[2], feature);
+            vec3<Scalar> pc = c - p;
+            Scalar rsq = dot(pc, pc);
+
+            // weight the normal by the angle of the triangle at the nearest point
+            Scalar weight(M_PI);
+            if (feature <= triangle_vertex_c)
+                {
+                vec3<Scalar> e1 = v[(feature+1) % 3] - v[feature];
+                vec3<Scalar> e2 = v[(feature+2) % 3] - v[feature];
+                Scalar cos_angle = dot(e1,e2)/sqrt(dot(e1,e1)*dot(e2,e2));
+                weight = acos(std::max(Scalar(-1.0), std::min(Scalar(1.0), cos_angle)));
+                }
+
+            vec3<Scalar> cn = c - nearest;
+            if (found && dot(cn,cn) <= m_tol*m_tol)
+                {
+                // another triangle sharing the nearest vertex or edge
+                n_sum += weight*m_normals[i];
+                }
+            else if (rsq < rsq_min)
+                {
+                found = true;
+                nearest = c;
+                rsq_min = rsq;
+                r_min = sqrt(rsq);
+                n_sum = weight*m_normals[i];
+                }
+            }
+        }
+
+    if (!found)
+        return false;
+
+    dx = nearest - p;
+    n = n_sum / sqrt(dot(n_sum, n_sum));
+    return true;
+    }
+
+//! Helper function to build a TriangleMesh from python
+/*! \param vertices List of vertices, each a list of three coordinates
+    \param triangles List of triangles, each a list of three indices into \a vertices
+*/
+std::shared_ptr<TriangleMesh> make_triangle_mesh(py::list vertices, py::list triangles)
+    {
+    std::vector< vec3<Scalar> > verts;
+    for (unsigned int i = 0; i < len(vertices); ++i)
+        {
+        py::list v = py::cast<py::list>(vertices[i]);
+        verts.push_back(vec3<Scalar>(py::cast<Scalar>(v[0]), py::cast<Scalar>(v[1]), py::cast<Scalar>(v[2])));
+        }
+
+    std::vector<unsigned int> tris;
+    for (unsigned int i = 0; i < len(triangles); ++i)
+        {
+        py::list t = py::cast<py::list>(triangles[i]);
+        if (len(t) != 3)
+            {
+            throw runtime_error("Every triangle must have three vertices");
+            }
+        for (unsigned int k = 0; k < 3; ++k)
+            tris.push_back(py::cast<unsigned int>(t[k]));
+        }
+
+    return std::shared_ptr<TriangleMesh>(new TriangleMesh(verts, tris));
+    }
+
+void export_TriangleMesh(py::module& m)
+    {
+    py::class_< TriangleMesh, std::shared_ptr<TriangleMesh> >(m,"TriangleMesh")
+    .def("getNumTriangles", &TriangleMesh::getNumTriangles)
+    ;
+
+    m.def("make_triangle_mesh", &make_triangle_mesh);
+    }
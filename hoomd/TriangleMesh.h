@@ -0,0 +1,178 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TriangleMesh.h
+    \brief Declares the TriangleMesh class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "HOOMDMath.h"
+#include "VectorMath.h"
+#include "AABBTree.h"
+
+#include <vector>
+#include <memory>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+
+#ifndef __TRIANGLE_MESH_H__
+#define __TRIANGLE_MESH_H__
+
+//! Feature of a triangle that contains the closest point to a query point
+enum triangle_feature
+    {
+    triangle_vertex_a = 0,
+    triangle_vertex_b,
+    triangle_vertex_c,
+    triangle_edge_ab,
+    triangle_edge_bc,
+    triangle_edge_ca,
+    triangle_face
+    };
+
+//! Find the point on a triangle closest to a given point
+/*! \param p Query point
+    \param a First vertex of the triangle
+    \param b Second vertex of the triangle
+    \param c Third vertex of the triangle
+    \param feature Set to the vertex, edge or face of the triangle that contains the closest point
+    \returns the point on the triangle closest to \a p
+
+    From Real-time Collision Detection (Christer Ericson)
+*/
+inline vec3<Scalar> closestPointOnTriangle(const vec3<Scalar>& p, const vec3<Scalar>& a, const vec3<Scalar>& b,
+    const vec3<Scalar>& c, triangle_feature& feature)
+    {
+    vec3<Scalar> ab = b - a;
+    vec3<Scalar> ac = c - a;
+    vec3<Scalar> ap = p - a;
+
+    // vertex region outside a
+    Scalar d1 = dot(ab, ap);
+    Scalar d2 = dot(ac, ap);
+    if (d1 <= Scalar(0.0) && d2 <= Scalar(0.0))
+        {
+        feature = triangle_vertex_a;
+        return a;
+        }
+
+    // vertex region outside b
+    vec3<Scalar> bp = p - b;
+    Scalar d3 = dot(ab, bp);
+    Scalar d4 = dot(ac, bp);
+    if (d3 >= Scalar(0.0) && d4 <= d3)
+        {
+        feature = triangle_vertex_b;
+        return b;
+        }
+
+    // edge region of ab
+    Scalar vc = d1*d4 - d3*d2;
+    if (vc <= Scalar(0.0) && d1 >= Scalar(0.0) && d3 <= Scalar(0.0))
+        {
+        feature = triangle_edge_ab;
+        return a + d1 / (d1 - d3) * ab;
+        }
+
+    // vertex region outside c
+    vec3<Scalar> cp = p - c;
+    Scalar d5 = dot(ab, cp);
+    Scalar d6 = dot(ac, cp);
+    if (d6 >= Scalar(0.0) && d5 <= d6)
+        {
+        feature = triangle_vertex_c;
+        return c;
+        }
+
+    // edge region of ca
+    Scalar vb = d5*d2 - d1*d6;
+    if (vb <= Scalar(0.0) && d2 >= Scalar(0.0) && d6 <= Scalar(0.0))
+        {
+        feature = triangle_edge_ca;
+        return a + d2 / (d2 - d6) * ac;
+        }
+
+    // edge region of bc
+    Scalar va = d3*d6 - d5*d4;
+    if (va <= Scalar(0.0) && (d4 - d3) >= Scalar(0.0) && (d5 - d6) >= Scalar(0.0))
+        {
+        feature = triangle_edge_bc;
+        return b + (d4 - d3) / ((d4 - d3) + (d5 - d6)) * (c - b);
+        }
+
+    // inside the face
+    feature = triangle_face;
+    Scalar denom = Scalar(1.0) / (va + vb + vc);
+    return a + ab * (vb * denom) + ac * (vc * denom);
+    }
+
+//! A closed or open surface made of triangles
+/*! TriangleMesh stores the vertices of a triangle mesh and an AABBTree of its triangles. It finds the point on the
+    mesh nearest to a query point in O(log N) time, along with the angle weighted pseudo-normal of the vertex, edge or
+    face that contains it (Baerentzen and Aanaes, IEEE TVCG 11, 243 (2005)). The sign of the dot product of the
+    pseudo-normal with the vector from the nearest point to the query point tells on which side of a closed mesh the
+    query point is.
+
+    The vertices of each triangle are ordered counterclockwise when viewed from the side its normal points to. For a
+    closed mesh with outward normals, as in STL files, points with a negative dot product are inside the mesh.
+
+    Degenerate triangles with zero area are ignored.
+*/
+class PYBIND11_EXPORT TriangleMesh
+    {
+    public:
+        //! Construct a mesh
+        /*! \param vertices Vertices of the mesh
+            \param triangles Indices into \a vertices, three per triangle
+        */
+        TriangleMesh(const std::vector< vec3<Scalar> >& vertices, const std::vector<unsigned int>& triangles);
+
+        //! Get the number of triangles
+        unsigned int getNumTriangles() const
+            {
+            return m_normals.size();
+            }
+
+        //! Get the three vertices of a triangle
+        void getTriangle(unsigned int i, vec3<Scalar>& a, vec3<Scalar>& b, vec3<Scalar>& c) const
+            {
+            a = m_vertices[3*i];
+            b = m_vertices[3*i+1];
+            c = m_vertices[3*i+2];
+            }
+
+        //! Get the unit normal of a triangle
+        const vec3<Scalar>& getNormal(unsigned int i) const
+            {
+            return m_normals[i];
+            }
+
+        //! Find the point on the mesh nearest to a given point
+        bool findNearest(const vec3<Scalar>& p, Scalar r_max, vec3<Scalar>& dx, vec3<Scalar>& n) const;
+
+        //! Find the triangles whose bounding boxes overlap a given box
+        /*! \param hits Indices of the triangles are appended to this list
+            \param aabb Query box
+        */
+        void query(std::vector<unsigned int>& hits, const hpmc::detail::AABB& aabb) const
+            {
+            m_tree.query(hits, aabb);
+            }
+
+    private:
+        std::vector< vec3<Scalar> > m_vertices;    //!< Vertices of the triangles, three per triangle
+        std::vector< vec3<Scalar> > m_normals;     //!< Unit normal of each triangle
+        hpmc::detail::AABBTree m_tree;             //!< Bounding box tree of the triangles
+        Scalar m_tol;                              //!< Distance below which two points are considered equal
+
+        //! Build the bounding box tree
+        void buildTree();
+    };
+
+//! Exports TriangleMesh to python
+void export_TriangleMesh(pybind11::module& m);
+
+#endif
@@ -6,9 +6,24 @@
 R""" Benchmark utilities
 
 Commands that help in benchmarking HOOMD-blue performance.
+
+:py:func:`series()` measures the performance of the current simulation. :py:class:`suite` runs a set of
+reproducible, canonical workloads at several system sizes, measures the time steps per second of each one together
+with microbenchmarks of its main components, and writes the results with metadata about the hardware and the build
+to a JSON report. Compare reports across releases and build options to track performance regressions.
 """
 
 import hoomd
+import datetime
+import json
+import math
+import os
+import platform
+import socket
+import time
+
+# time.perf_counter is not available in python 2.7
+_clock = getattr(time, 'perf_counter', time.time);
 
 def series(warmup=100000, repeat=20, steps=10000, limit_hours=None):
     R""" Perform a series of benchmark runs.
@@ -36,3 +51,346 @@ def series(warmup=100000, repeat=20, steps=10000, limit_hours=None):
         tps_list.append(hoomd.context.current.system.getLastTPS());
 
     return tps_list;
+
+def metadata():
+    R""" Describe the hardware and the build.
+
+    Returns:
+        A dictionary with the HOOMD-blue version, the build options, the execution configuration, and the host.
+
+    .. versionadded:: 2.3
+    """
+    hoomd.context._verify_init();
+
+    exec_conf = hoomd.context.exec_conf;
+    meta = dict(hoomd_version=hoomd.__version__,
+                git_sha1=hoomd._hoomd.__git_sha1__,
+                git_refspec=hoomd._hoomd.__git_refspec__,
+                compiler=hoomd._hoomd.__compiler_version__,
+                compile_flags=hoomd._hoomd.hoomd_compile_flags(),
+                mode='gpu' if exec_conf.isCUDAEnabled() else 'cpu',
+                num_ranks=hoomd.comm.get_num_ranks(),
+                num_threads=exec_conf.getNumThreads(),
+                hostname=socket.gethostname(),
+                platform=platform.platform(),
+                processor=platform.processor(),
+                python=platform.python_version(),
+                date=datetime.datetime.utcnow().isoformat());
+
+    if exec_conf.isCUDAEnabled():
+        meta['gpu'] = exec_conf.getGPUName();
+
+    return meta;
+
+## \internal
+# \brief Time a function call in milliseconds, averaged over all calls and synchronized across ranks
+def _time(func, repeat):
+    func();
+    hoomd.comm.barrier();
+    start = _clock();
+    for i in range(repeat):
+        func();
+    hoomd.comm.barrier();
+    return (_clock() - start) * 1000.0 / repeat;
+
+## \internal
+# \brief Set up an LJ liquid at density 0.844 and kT=1.2 from an fcc lattice
+def _lj_liquid(N, seed):
+    from hoomd import md
+
+    n = max(2, int(round((N / 4.0)**(1.0/3.0))));
+    hoomd.init.create_lattice(unitcell=hoomd.lattice.fcc(a=(4 / 0.844)**(1.0/3.0)), n=n);
+
+    nl = md.nlist.cell();
+    lj = md.pair.lj(r_cut=2.5, nlist=nl);
+    lj.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+
+    md.integrate.mode_standard(dt=0.005);
+    integrator = md.integrate.nvt(group=hoomd.group.all(), kT=1.2, tau=0.5);
+    integrator.randomize_velocities(seed=seed);
+    return dict(nlist=nl, pair=lj);
+
+## \internal
+# \brief Set up a Kremer-Grest melt of chains of 10 beads at density 0.85
+def _polymer_melt(N, seed):
+    from hoomd import md
+
+    # one straight chain per unit cell, the chains form a simple cubic lattice of beads
+    b = (1 / 0.85)**(1.0/3.0);
+    unit_cell = hoomd.data.make_snapshot(N=10, box=hoomd.data.boxdim(Lx=10*b, Ly=b, Lz=b), bond_types=['backbone']);
+    if hoomd.comm.get_rank() == 0:
+        unit_cell.particles.position[:] = [[(i - 4.5) * b, 0, 0] for i in range(10)];
+        unit_cell.bonds.resize(9);
+        unit_cell.bonds.group[:] = [[i, i+1] for i in range(9)];
+
+    m = max(1, int(round((N / 1000.0)**(1.0/3.0))));
+    hoomd.init.read_snapshot(unit_cell, replicate=[m, 10*m, 10*m]);
+
+    nl = md.nlist.cell();
+    wca = md.pair.lj(r_cut=2**(1.0/6.0), nlist=nl);
+    wca.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+    wca.set_params(mode='shift');
+    fene = md.bond.fene();
+    fene.bond_coeff.set('backbone', k=30.0, r0=1.5, sigma=1.0, epsilon=1.0);
+
+    md.integrate.mode_standard(dt=0.005);
+    integrator = md.integrate.nvt(group=hoomd.group.all(), kT=1.0, tau=0.5);
+    integrator.randomize_velocities(seed=seed);
+    return dict(nlist=nl, pair=wca);
+
+## \internal
+# \brief Set up a charged LJ liquid of monovalent ions with PPPM electrostatics
+def _pppm_electrolyte(N, seed):
+    from hoomd import md
+
+    # CsCl structure of cations and anions
+    a = (2 / 0.844)**(1.0/3.0);
+    uc = hoomd.lattice.unitcell(N=2, a1=[a,0,0], a2=[0,a,0], a3=[0,0,a],
+                                position=[[0,0,0], [a/2,a/2,a/2]],
+                                type_name=['P', 'N'],
+                                charge=[1.0, -1.0]);
+    n = max(2, int(round((N / 2.0)**(1.0/3.0))));
+    s = hoomd.init.create_lattice(unitcell=uc, n=n);
+
+    nl = md.nlist.cell();
+    lj = md.pair.lj(r_cut=2.5, nlist=nl);
+    lj.pair_coeff.set(['P', 'N'], ['P', 'N'], epsilon=1.0, sigma=1.0);
+
+    # power of two grid with a spacing of about one particle diameter
+    grid = max(8, 2**int(round(math.log(n * a, 2))));
+    pppm = md.charge.pppm(group=hoomd.group.charged(), nlist=nl);
+    pppm.set_params(Nx=grid, Ny=grid, Nz=grid, order=6, rcut=2.5);
+
+    md.integrate.mode_standard(dt=0.002);
+    integrator = md.integrate.nvt(group=hoomd.group.all(), kT=1.2, tau=0.5);
+    integrator.randomize_velocities(seed=seed);
+    return dict(nlist=nl, pair=lj, pppm=pppm);
+
+## \internal
+# \brief Set up a dense fluid of hard cubes
+def _hpmc_polyhedra(N, seed):
+    from hoomd import hpmc
+
+    n = max(2, int(round(N**(1.0/3.0))));
+    hoomd.init.create_lattice(unitcell=hoomd.lattice.sc(a=1.2), n=n);
+
+    mc = hpmc.integrate.convex_polyhedron(seed=seed, d=0.1, a=0.1);
+    mc.shape_param.set('A', vertices=[[x/2, y/2, z/2] for x in (-1,1) for y in (-1,1) for z in (-1,1)]);
+    return dict(mc=mc);
+
+## \internal
+# \brief Set up a bulk SRD solvent with 10 particles per cell
+def _mpcd_solvent(N, seed):
+    from hoomd import mpcd
+
+    L = max(4, int(round((N / 10.0)**(1.0/3.0))));
+    hoomd.init.read_snapshot(hoomd.data.make_snapshot(N=0, box=hoomd.data.boxdim(L=L)));
+
+    s = mpcd.init.make_random(N=10*L**3, kT=1.0, seed=seed);
+    s.sorter.set_period(period=25);
+    mpcd.integrator(dt=0.1);
+    mpcd.stream.bulk(period=1);
+    mpcd.collide.srd(seed=seed, period=1, angle=130., kT=1.0);
+    return dict(N=10*L**3);
+
+## \internal
+# \brief Set up a liquid of rigid dimers
+def _rigid_bodies(N, seed):
+    from hoomd import md
+
+    # one body per lattice site, N counts constituent particles
+    uc = hoomd.lattice.unitcell(N=1, a1=[2,0,0], a2=[0,1.5,0], a3=[0,0,1.5],
+                                type_name=['R'],
+                                mass=[2.0],
+                                moment_inertia=[[0, 0.5, 0.5]]);
+    n = max(2, int(round((N / 2.0)**(1.0/3.0))));
+    system = hoomd.init.create_lattice(unitcell=uc, n=n);
+    system.particles.types.add('A');
+
+    rigid = md.constrain.rigid();
+    rigid.set_param('R', types=['A', 'A'], positions=[(-0.5,0,0), (0.5,0,0)]);
+    rigid.create_bodies();
+
+    nl = md.nlist.cell();
+    nl.reset_exclusions(exclusions=['body']);
+    wca = md.pair.lj(r_cut=2**(1.0/6.0), nlist=nl);
+    wca.pair_coeff.set('A', 'A', epsilon=1.0, sigma=1.0);
+    wca.pair_coeff.set('R', ['R', 'A'], epsilon=0.0, sigma=1.0, r_cut=False);
+    wca.set_params(mode='shift');
+
+    md.integrate.mode_standard(dt=0.005);
+    integrator = md.integrate.nvt(group=hoomd.group.rigid_center(), kT=1.0, tau=0.5);
+    integrator.randomize_velocities(seed=seed);
+    return dict(nlist=nl, pair=wca);
+
+#: Canonical workloads: name -> (component, setup function)
+workloads = dict(lj_liquid=('md', _lj_liquid),
+                 polymer_melt=('md', _polymer_melt),
+                 pppm_electrolyte=('md', _pppm_electrolyte),
+                 hpmc_polyhedra=('hpmc', _hpmc_polyhedra),
+                 mpcd_solvent=('mpcd', _mpcd_solvent),
+                 rigid_bodies=('md', _rigid_bodies));
+
+class suite:
+    R""" Run the canonical benchmark workloads.
+
+    Args:
+        workloads (list): Names of the workloads to run (all workloads when None).
+        sizes (list): Approximate numbers of particles of each workload.
+        warmup (int): Number of time steps to run before measuring.
+        repeat (int): Number of times to repeat the measurement of *steps* time steps.
+        steps (int): Number of time steps to run at each measurement.
+        micro_repeat (int): Number of iterations to average in each microbenchmark.
+        seed (int): Random number seed of the workloads.
+
+    The workloads set up reproducible systems from lattices, so that each one is the same in every run:
+
+    * ``lj_liquid``: Lennard-Jones liquid at density 0.844 and kT=1.2 (MD).
+    * ``polymer_melt``: Kremer-Grest melt of chains of 10 beads (MD).
+    * ``pppm_electrolyte``: Lennard-Jones liquid of monovalent ions with PPPM electrostatics (MD).
+    * ``hpmc_polyhedra``: dense fluid of hard cubes (HPMC).
+    * ``mpcd_solvent``: bulk SRD solvent with 10 particles per cell (MPCD).
+    * ``rigid_bodies``: liquid of rigid dimers (MD).
+
+    Workloads of components that are not built are skipped. Each workload is run at each of the *sizes*, in a new
+    context. After :py:func:`series()` measures the time steps per second (TPS), :py:class:`suite` times the
+    components of the workload separately, in milliseconds per call:
+
+    * ``cell_list``: cell list build.
+    * ``neighbor_list``: neighbor list build.
+    * ``pair``: pair force kernel.
+    * ``pppm``: PPPM force.
+    * ``hpmc_overlaps``: overlap check of all particles.
+    * ``communicator``: particle migration and ghost exchange (MPI runs only).
+    * ``gsd_write``: writing a frame of all particles to a GSD file.
+
+    Example::
+
+        b = benchmark.suite(workloads=['lj_liquid', 'polymer_melt'], sizes=[10000, 100000]);
+        b.run();
+        b.write('benchmark.json');
+
+    .. versionadded:: 2.3
+    """
+    def __init__(self, workloads=None, sizes=[1000, 10000, 100000], warmup=1000, repeat=5, steps=1000, micro_repeat=100, seed=12345):
+        hoomd.util.print_status_line();
+
+        if workloads is None:
+            workloads = sorted(globals()['workloads'].keys());
+
+        for name in workloads:
+            if name not in globals()['workloads']:
+                hoomd.context.msg.error("benchmark.suite: Unknown workload " + str(name) + "\n");
+                raise RuntimeError("Error creating benchmark suite");
+
+        self.workloads = list(workloads);
+        self.sizes = [int(N) for N in sizes];
+        self.warmup = warmup;
+        self.repeat = repeat;
+        self.steps = steps;
+        self.micro_repeat = micro_repeat;
+        self.seed = seed;
+        self.results = [];
+
+    def run(self):
+        R""" Run all workloads at all sizes.
+
+        Returns:
+            The list of results, which is also stored in :py:attr:`results`.
+        """
+        hoomd.util.print_status_line();
+
+        for name in self.workloads:
+            component, setup = workloads[name];
+            try:
+                __import__('hoomd.' + component);
+            except ImportError:
+                hoomd.context.msg.notice(1, "benchmark.suite: Skipping " + name + ", hoomd." + component + " is not available\n");
+                continue;
+
+            for N in self.sizes:
+                self.results.append(self._run_workload(name, setup, N));
+
+        return self.results;
+
+    def write(self, filename):
+        R""" Write the report to a JSON file.
+
+        Args:
+            filename (str): Name of the file to write.
+
+        The report contains the :py:func:`metadata()` of the run, the parameters of the suite, and the results. Only
+        the root rank writes the file.
+        """
+        hoomd.util.print_status_line();
+
+        report = dict(metadata=metadata(),
+                      parameters=dict(warmup=self.warmup, repeat=self.repeat, steps=self.steps,
+                                      micro_repeat=self.micro_repeat, seed=self.seed),
+                      results=self.results);
+
+        if hoomd.comm.get_rank() == 0:
+            with open(filename, 'w') as f:
+                json.dump(report, f, indent=2, sort_keys=True);
+
+    ## \internal
+    # \brief Set up one workload in a new context and benchmark it
+    def _run_workload(self, name, setup, N):
+        hoomd.context.initialize();
+        hoomd.util.quiet_status();
+        objects = setup(N, self.seed);
+        hoomd.util.unquiet_status();
+
+        tps = series(warmup=self.warmup, repeat=self.repeat, steps=self.steps);
+        mean = sum(tps) / len(tps);
+        std = math.sqrt(sum((t - mean)**2 for t in tps) / len(tps));
+
+        result = dict(workload=name,
+                      N=objects.get('N', hoomd.context.current.system_definition.getParticleData().getNGlobal()),
+                      tps=tps,
+                      tps_mean=mean,
+                      tps_std=std,
+                      microbenchmarks=self._microbenchmarks(name, objects));
+
+        hoomd.context.msg.notice(1, "benchmark.suite: {0} N={1}: {2:.2f} +- {3:.2f} TPS\n".format(name, result['N'], mean, std));
+        return result;
+
+    ## \internal
+    # \brief Time the components of a workload
+    def _microbenchmarks(self, name, objects):
+        r = self.micro_repeat;
+        times = dict();
+
+        nl = objects.get('nlist');
+        if nl is not None:
+            if hasattr(nl, 'cpp_cl'):
+                times['cell_list'] = nl.cpp_cl.benchmark(r);
+            times['neighbor_list'] = nl.cpp_nlist.benchmark(r);
+
+        if 'pair' in objects:
+            times['pair'] = objects['pair'].cpp_force.benchmark(r);
+
+        if 'pppm' in objects:
+            times['pppm'] = objects['pppm'].cpp_force.benchmark(r);
+
+        if 'mc' in objects:
+            mc = objects['mc'];
+            step = hoomd.get_step();
+            times['hpmc_overlaps'] = _time(lambda: mc.cpp_integrator.countOverlaps(step, False), r);
+
+        if hoomd.comm.get_num_ranks() > 1:
+            times['communicator'] = hoomd.context.current.system.getCommunicator().benchmark(r);
+
+        # write to a file that is unique to this workload and removed afterwards
+        filename = 'benchmark_{0}.gsd'.format(name);
+        hoomd.util.quiet_status();
+        gsd = hoomd.dump.gsd(filename=filename, period=None, group=hoomd.group.all(), overwrite=True,
+                             dynamic=['attribute', 'momentum', 'topology']);
+        hoomd.util.unquiet_status();
+        step = hoomd.get_step();
+        times['gsd_write'] = _time(lambda: gsd.cpp_analyzer.analyze(step), min(r, 10));
+        hoomd.comm.barrier();
+        if hoomd.comm.get_rank() == 0:
+            os.remove(filename);
+
+        return times;
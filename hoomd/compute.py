@@ -266,6 +266,55 @@ class thermo(_compute):
 
         hoomd.context.current.thermo.append(self)
 
+class thermo_batch(_compute):
+    R""" Compute thermodynamic properties of many groups of particles at once.
+
+    Args:
+        groups (list): List of :py:mod:`hoomd.group` to compute thermodynamic properties for.
+
+    :py:class:`hoomd.compute.thermo_batch` creates a :py:class:`hoomd.compute.thermo` for every group in *groups*
+    (or reuses an existing one) and computes all of them in a single pass over the particles. This is faster than
+    computing each group separately when many groups are logged, for example a group per molecule type or per slab
+    of the box, because the velocities, forces and virials of each particle are read only once. In MPI simulations, the
+    properties of all groups are reduced with a single collective.
+
+    The quantities of each group are logged under the names of its :py:class:`hoomd.compute.thermo`, and
+    the individual computes are available in the list :py:attr:`thermos`.
+
+    Note:
+        Groups are only batched on the CPU. On the GPU, every group is computed independently.
+
+    Examples::
+
+        g1 = group.type(name='typeA', type='A')
+        g2 = group.type(name='typeB', type='B')
+        compute.thermo_batch(groups=[g1, g2])
+    """
+
+    def __init__(self, groups):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        _compute.__init__(self);
+
+        # create the c++ mirror class
+        if not hoomd.context.exec_conf.isCUDAEnabled():
+            self.cpp_compute = _hoomd.ComputeThermoMulti(hoomd.context.current.system_definition);
+            hoomd.context.current.system.addCompute(self.cpp_compute, self.compute_name);
+        else:
+            self.cpp_compute = None;
+
+        # create the thermo computes of the individual groups
+        self.thermos = [];
+        for g in groups:
+            t = _get_unique_thermo(g);
+            if self.cpp_compute is not None:
+                self.cpp_compute.addThermo(t.cpp_compute);
+            self.thermos.append(t);
+
+        # save the groups for later referencing
+        self.groups = list(groups);
+
 ## \internal
 # \brief Returns the previously created compute.thermo with the same group, if created. Otherwise, creates a new
 # compute.thermo
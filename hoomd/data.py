@@ -2305,6 +2305,81 @@ def gsd_snapshot(filename, frame=0):
     reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
     return reader.getSnapshot();
 
+def read_mesh(filename):
+    R""" Read a triangle mesh from an OBJ or STL file.
+
+    Args:
+        filename (str): File to read the mesh from. Files ending in ``.obj`` are read as Wavefront OBJ files, all other
+                        files as ASCII or binary STL files.
+
+    Returns:
+        A tuple (vertices, faces), where *vertices* is a list of (x,y,z) tuples and *faces* a list of triangles, each a
+        list of three indices into *vertices*.
+
+    Faces with more than three vertices are split into triangles around their first vertex. Identical vertices in STL
+    files are merged. The order of the vertices of each face is kept, so that the normals of a mesh exported with
+    outward facing normals point out of the mesh.
+
+    Use the result to define mesh walls, for example with :py:class:`hoomd.md.wall.mesh`.
+
+    .. versionadded:: 2.3
+    """
+    import struct;
+
+    vertices = [];
+    faces = [];
+
+    if filename.lower().endswith('.obj'):
+        with open(filename, 'r') as f:
+            for line in f:
+                fields = line.split();
+                if len(fields) == 0:
+                    continue;
+                if fields[0] == 'v':
+                    vertices.append(tuple(float(x) for x in fields[1:4]));
+                elif fields[0] == 'f':
+                    # indices start at 1, negative indices count from the end, texture and normal indices are ignored
+                    idx = [int(x.split('/')[0]) for x in fields[1:]];
+                    idx = [i-1 if i > 0 else len(vertices)+i for i in idx];
+                    for k in range(1,len(idx)-1):
+                        faces.append([idx[0], idx[k], idx[k+1]]);
+    else:
+        with open(filename, 'rb') as f:
+            data = f.read();
+
+        # merge vertices that appear in several triangles
+        index = {};
+        def add_vertex(v):
+            if v not in index:
+                index[v] = len(vertices);
+                vertices.append(v);
+            return index[v];
+
+        # binary files may also start with 'solid', so check the size given in the header first
+        n = struct.unpack('<I', data[80:84])[0] if len(data) >= 84 else 0;
+        if len(data) == 84 + 50*n:
+            for i in range(n):
+                values = struct.unpack('<12f', data[84+50*i:84+50*i+48]);
+                faces.append([add_vertex(values[3*k:3*k+3]) for k in range(1,4)]);
+        else:
+            face = [];
+            for line in data.decode('ascii', 'replace').splitlines():
+                fields = line.split();
+                if len(fields) == 0:
+                    continue;
+                if fields[0] == 'vertex':
+                    face.append(add_vertex(tuple(float(x) for x in fields[1:4])));
+                elif fields[0] == 'endloop':
+                    for k in range(1,len(face)-1):
+                        faces.append([face[0], face[k], face[k+1]]);
+                    face = [];
+
+    if len(faces) == 0:
+        hoomd.context.msg.error("No triangles found in " + filename + "\n");
+        raise RuntimeError("Error reading mesh");
+
+    return (vertices, faces);
+
 
 # Note: SnapshotParticleData should never be instantiated, it is a placeholder to generate sphinx documentation,
 # as the real SnapshotParticleData lives in c++.
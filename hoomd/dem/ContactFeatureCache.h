@@ -0,0 +1,192 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ContactFeatureCache.h
+  \brief Declares the ContactFeatureCache class
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __CONTACTFEATURECACHE_H__
+#define __CONTACTFEATURECACHE_H__
+
+#include "VectorMath.h"
+
+#include <algorithm>
+#include <vector>
+
+//! Kinds of pairs of shape features that can be in contact
+enum contact_feature_kind
+    {
+    contact_vertex_face = 0, //!< vertex of i, face of j
+    contact_face_vertex,     //!< vertex of j, face of i
+    contact_vertex_edge,     //!< vertex of i, edge of j
+    contact_edge_vertex,     //!< vertex of j, edge of i
+    contact_edge_edge,       //!< edge of i, edge of j
+    contact_vertex_vertex    //!< vertex of i, vertex of j
+    };
+
+//! A pair of features of particles i and j that may be in contact
+struct contact_feature
+    {
+    unsigned int kind;   //!< contact_feature_kind of the pair
+    unsigned int first;  //!< Index of the first feature named by kind
+    unsigned int second; //!< Index of the second feature named by kind
+    };
+
+//! Sphere enclosing a shape feature in the body frame of a particle
+template<typename Real>
+struct feature_sphere
+    {
+    vec3<Real> center; //!< Center of the sphere
+    Real radius;       //!< Radius of the sphere
+    };
+
+//! Find a sphere enclosing a set of points
+/*! \param points Vertices of the feature
+    \returns a sphere centered on the centroid of \a points that contains all of them
+*/
+template<typename Real>
+feature_sphere<Real> makeFeatureSphere(const std::vector<vec3<Real> >& points)
+    {
+    feature_sphere<Real> result;
+    result.radius = 0;
+
+    for (unsigned int i = 0; i < points.size(); ++i)
+        result.center += points[i];
+    if (points.size())
+        result.center /= Real(points.size());
+
+    for (unsigned int i = 0; i < points.size(); ++i)
+        {
+        const vec3<Real> r(points[i] - result.center);
+        result.radius = std::max(result.radius, Real(sqrt(dot(r, r))));
+        }
+
+    return result;
+    }
+
+//! Persistent lists of the shape features near contact for each neighbor pair
+/*! Testing every vertex-face, vertex-edge and edge-edge combination of two polyhedra on every step is wasteful, as
+  only few features of a pair are ever close enough to interact. ContactFeatureCache stores, for each slot in the
+  neighbor list, the feature pairs whose bounding spheres were within the potential cutoff plus a skin distance when
+  the list was built. The force computes then evaluate only those.
+
+  A list stays valid as long as no feature can have moved by more than the skin relative to the other particle. The
+  bound on the motion is the change in the center of mass separation plus, for each particle, the largest
+  displacement of a point at the circumsphere radius of the shape under the rotation since the list was built.
+  Lists are rebuilt one pair at a time when they become invalid, and all at once when the neighbor list is rebuilt.
+*/
+template<typename Real>
+class ContactFeatureCache
+    {
+    public:
+        //! Constructor
+        ContactFeatureCache() : m_skin(0) {}
+
+        //! Mark all lists as invalid
+        /*! \param n_slots Number of slots in the neighbor list
+            \param skin Distance features may move before a list is rebuilt
+        */
+        void reset(unsigned int n_slots, Real skin)
+            {
+            m_skin = skin;
+            m_pairs.resize(n_slots);
+            for (unsigned int i = 0; i < n_slots; ++i)
+                m_pairs[i].valid = false;
+            }
+
+        //! Get the number of neighbor list slots the lists were reset for
+        unsigned int getNumSlots() const
+            {
+            return m_pairs.size();
+            }
+
+        //! Test if the list of a pair can be used for the current configuration
+        /*! \param slot Index of the pair in the neighbor list
+            \param dx Current separation of the centers of mass
+            \param quat_i Current orientation of particle i
+            \param quat_j Current orientation of particle j
+            \param radius_i Circumsphere radius of the shape of particle i
+            \param radius_j Circumsphere radius of the shape of particle j
+            \param r_feature Current distance between features below which they interact
+        */
+        bool isValid(unsigned int slot, const vec3<Real>& dx, const quat<Real>& quat_i, const quat<Real>& quat_j,
+            Real radius_i, Real radius_j, Real r_feature) const
+            {
+            const pair_state& state = m_pairs[slot];
+            if (!state.valid)
+                return false;
+
+            const vec3<Real> ddx(dx - state.dx);
+            const Real displacement = sqrt(dot(ddx, ddx)) +
+                Real(2.0)*radius_i*rotationBound(quat_i, state.quat_i) +
+                Real(2.0)*radius_j*rotationBound(quat_j, state.quat_j);
+
+            return r_feature + displacement <= state.limit;
+            }
+
+        //! Start a new list for a pair
+        /*! \param slot Index of the pair in the neighbor list
+            \param dx Current separation of the centers of mass
+            \param quat_i Current orientation of particle i
+            \param quat_j Current orientation of particle j
+            \param r_feature Current distance between features below which they interact
+            \returns the distance between the bounding spheres of features below which they must be added
+        */
+        Real beginPair(unsigned int slot, const vec3<Real>& dx, const quat<Real>& quat_i, const quat<Real>& quat_j,
+            Real r_feature)
+            {
+            pair_state& state = m_pairs[slot];
+            state.dx = dx;
+            state.quat_i = quat_i;
+            state.quat_j = quat_j;
+            state.limit = r_feature + m_skin;
+            state.valid = true;
+            state.features.clear();
+            return state.limit;
+            }
+
+        //! Add a feature pair to the list of a pair
+        void addFeature(unsigned int slot, unsigned int kind, unsigned int first, unsigned int second)
+            {
+            contact_feature f;
+            f.kind = kind;
+            f.first = first;
+            f.second = second;
+            m_pairs[slot].features.push_back(f);
+            }
+
+        //! Get the list of feature pairs of a pair
+        const std::vector<contact_feature>& getFeatures(unsigned int slot) const
+            {
+            return m_pairs[slot].features;
+            }
+
+    private:
+        //! Cached state of one neighbor pair
+        struct pair_state
+            {
+            vec3<Real> dx;                          //!< Separation when the list was built
+            quat<Real> quat_i;                      //!< Orientation of particle i when the list was built
+            quat<Real> quat_j;                      //!< Orientation of particle j when the list was built
+            Real limit;                             //!< Feature cutoff plus skin when the list was built
+            bool valid;                             //!< True if the list has been built
+            std::vector<contact_feature> features;  //!< Feature pairs near contact
+            };
+
+        std::vector<pair_state> m_pairs; //!< State of each slot in the neighbor list
+        Real m_skin;                     //!< Distance features may move before a list is rebuilt
+
+        //! Largest displacement of a point at unit distance from the center under the rotation from q0 to q, halved
+        static Real rotationBound(const quat<Real>& q, const quat<Real>& q0)
+            {
+            const Real d = q.s*q0.s + dot(q.v, q0.v);
+            const Real cos_sq = d*d/(norm2(q)*norm2(q0));
+            return sqrt(std::max(Real(0.0), Real(1.0) - cos_sq));
+            }
+    };
+
+#endif // __CONTACTFEATURECACHE_H__
@@ -35,7 +35,8 @@ DEM2DForceCompute<Real, Real4, Potential>::DEM2DForceCompute(
     std::shared_ptr<NeighborList> nlist,
     Real r_cut, Potential potential)
     : ForceCompute(sysdef), m_nlist(nlist), m_r_cut(r_cut),
-      m_evaluator(potential), m_shapes()
+      m_evaluator(potential), m_shapes(), m_typeRadius(),
+      m_contactCache(), m_resetContacts(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing DEM2DForceCompute" << endl;
 
@@ -91,6 +92,81 @@ void DEM2DForceCompute<Real, Real4, Potential>::setParams(
         }
 
     m_shapes[type] = points;
+
+    m_typeRadius.resize(m_shapes.size(), Real(0));
+    m_typeRadius[type] = 0;
+    for(size_t i(0); i < points.size(); ++i)
+        m_typeRadius[type] = max(m_typeRadius[type], Real(sqrt(dot(points[i], points[i]))));
+
+    m_resetContacts = true;
+    }
+
+/*! findContactFeatures: Rebuild the list of vertex-edge pairs of two particles whose bounding spheres are within the
+  feature cutoff plus the skin. Feature pairs are added in the order computeForces evaluated all of them in before, so
+  that the sums of forces and torques do not depend on the caching.
+
+  \param slot Index of the pair in the neighbor list
+  \param typei Type of particle i
+  \param typej Type of particle j
+  \param dx Separation of the centers of mass
+  \param quati Orientation of particle i
+  \param quatj Orientation of particle j
+  \param r_feature Distance between features below which they interact
+*/
+template<typename Real, typename Real4, typename Potential>
+void DEM2DForceCompute<Real, Real4, Potential>::findContactFeatures(
+    unsigned int slot, unsigned int typei, unsigned int typej,
+    const vec2<Real> &dx, const quat<Real> &quati, const quat<Real> &quatj, Real r_feature)
+    {
+    const Real limit(m_contactCache.beginPair(slot, vec3<Real>(dx.x, dx.y, 0), quati, quatj, r_feature));
+
+    // place all vertices in the frame of particle i
+    vector<vec2<Real> > vertsi(m_shapes[typei]), vertsj(m_shapes[typej]);
+    for(size_t vertIdx(0); vertIdx < vertsi.size(); ++vertIdx)
+        vertsi[vertIdx] = rotate(quati, vertsi[vertIdx]);
+    for(size_t vertIdx(0); vertIdx < vertsj.size(); ++vertIdx)
+        vertsj[vertIdx] = dx + rotate(quatj, vertsj[vertIdx]);
+
+    // edge e runs from vertex e to vertex e + 1; only polygons have the closing edge
+    const size_t nEdgesi(vertsi.size() > 2 ? vertsi.size() : vertsi.size() - 1);
+    const size_t nEdgesj(vertsj.size() > 2 ? vertsj.size() : vertsj.size() - 1);
+
+    // vertices of i against the edges of j
+    if (vertsj.size() > 1)
+        {
+        for(size_t vertIdx(0); vertIdx < vertsi.size(); ++vertIdx)
+            {
+            for(size_t edgeIdx(0); edgeIdx < nEdgesj; ++edgeIdx)
+                {
+                const vec2<Real> p0(vertsj[edgeIdx]), p1(vertsj[(edgeIdx + 1) % vertsj.size()]);
+                const vec2<Real> r(Real(0.5)*(p0 + p1) - vertsi[vertIdx]);
+                if(sqrt(dot(r, r)) - Real(0.5)*sqrt(dot(p1 - p0, p1 - p0)) <= limit)
+                    m_contactCache.addFeature(slot, contact_vertex_edge, vertIdx, edgeIdx);
+                }
+            }
+        }
+
+    // vertices of j against the edges of i
+    if (vertsi.size() > 1)
+        {
+        for(size_t vertIdx(0); vertIdx < vertsj.size(); ++vertIdx)
+            {
+            for(size_t edgeIdx(0); edgeIdx < nEdgesi; ++edgeIdx)
+                {
+                const vec2<Real> p0(vertsi[edgeIdx]), p1(vertsi[(edgeIdx + 1) % vertsi.size()]);
+                const vec2<Real> r(Real(0.5)*(p0 + p1) - vertsj[vertIdx]);
+                if(sqrt(dot(r, r)) - Real(0.5)*sqrt(dot(p1 - p0, p1 - p0)) <= limit)
+                    m_contactCache.addFeature(slot, contact_edge_vertex, vertIdx, edgeIdx);
+                }
+            }
+        }
+    // both are disks
+    else if(vertsj.size() <= 1)
+        {
+        const vec2<Real> r(vertsj[0] - vertsi[0]);
+        if(sqrt(dot(r, r)) <= limit)
+            m_contactCache.addFeature(slot, contact_vertex_vertex, 0, 0);
+        }
     }
 
 /*! DEM2DForceCompute provides
@@ -133,6 +209,14 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     // start the profile for this compute
     if (m_prof) m_prof->push("DEM2D pair");
 
+    // the feature pairs near contact are found again whenever the neighbor list is rebuilt
+    const unsigned int n_slots(m_nlist->getNListArray().getNumElements());
+    if(m_resetContacts || m_nlist->hasBeenUpdated(timestep) || m_contactCache.getNumSlots() != n_slots)
+        {
+        m_contactCache.reset(n_slots, m_nlist->getRBuff());
+        m_resetContacts = false;
+        }
+
     // grab handles for particle data
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar4> h_torque(m_torque,access_location::host, access_mode::overwrite);
@@ -261,66 +345,42 @@ void DEM2DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 vec2<Real> forceij, forceji;
                 Real torqueij(0), torqueji(0), potentialij(0);
 
-                // Make a local copy for the rotated vertices for particle j
-                vector<vec2<Real> > vertices_j(m_shapes[typej]);
-                for(typename vector<vec2<Real> >::iterator vertIter(vertices_j.begin());
-                    vertIter != vertices_j.end(); ++vertIter)
-                    *vertIter = rotate(quatj, *vertIter);
+                // only the feature pairs near contact can interact
+                const unsigned int slot(myHead + j);
+                const Real r_feature(m_evaluator.getFeatureRcut());
+                if(!m_contactCache.isValid(slot, vec3<Real>(dx.x, dx.y, 0), quati, quatj,
+                        m_typeRadius[typei], m_typeRadius[typej], r_feature))
+                    findContactFeatures(slot, typei, typej, dx, quati, quatj, r_feature);
 
-                // Iterate over each vertex of particle i, if particle j has any edges
-                if (vertices_j.size()>1)
+                const vector<vec2<Real> > &shape_j(m_shapes[typej]);
+                const std::vector<contact_feature> &features(m_contactCache.getFeatures(slot));
+                for(size_t featureIdx(0); featureIdx < features.size(); ++featureIdx)
                     {
-                    for(typename vector<vec2<Real> >::const_iterator viIter(vertices_i.begin());
-                        viIter != vertices_i.end(); ++viIter)
+                    const contact_feature &feature(features[featureIdx]);
+
+                    switch(feature.kind)
                         {
-                        // iterate over each edge of particle j
-                        for(typename vector<vec2<Real> >::const_iterator vjIter(vertices_j.begin());
-                            vjIter + 1 != vertices_j.end(); ++vjIter)
-                            {
-                            m_evaluator.vertexEdge(dx, *viIter, *vjIter, *(vjIter + 1),
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
-                            }
-                        // evaluate for the last edge, but only if we
-                        // didn't just evaluate that edge (i.e. the
-                        // shape isn't a spherocylinder)
-                        if(vertices_j.size() > 2)
-                            m_evaluator.vertexEdge(dx, *viIter, vertices_j.back(), vertices_j.front(),
+                        case contact_vertex_edge:
+                            m_evaluator.vertexEdge(dx, vertices_i[feature.first],
+                                rotate(quatj, shape_j[feature.second]),
+                                rotate(quatj, shape_j[(feature.second + 1) % shape_j.size()]),
                                 potentialij, forceij, torqueij,
                                 forceji, torqueji);
-                        }
-                    }
-                // iterate over each vertex of particle j, if vi has any edges
-                if (vertices_i.size()>1)
-                    {
-                    for(typename vector<vec2<Real> >::const_iterator vjIter(vertices_j.begin());
-                        vjIter != vertices_j.end(); ++vjIter)
-                        {
-                        // iterate over each edge of particle i
-                        for(typename vector<vec2<Real> >::const_iterator viIter(vertices_i.begin());
-                            viIter + 1 != vertices_i.end(); ++viIter)
-                            {
-                            m_evaluator.vertexEdge(-dx, *vjIter, *viIter, *(viIter + 1),
-                                potentialij, forceji, torqueji,
-                                forceij, torqueij);
-                            }
-                        // evaluate for the last edge, but only if we
-                        // didn't just evaluate that edge (i.e. the
-                        // shape isn't a spherocylinder)
-                        if(vertices_i.size() > 2)
-                            m_evaluator.vertexEdge(-dx, *vjIter, vertices_i.back(), vertices_i.front(),
+                            break;
+                        case contact_edge_vertex:
+                            m_evaluator.vertexEdge(-dx, rotate(quatj, shape_j[feature.first]),
+                                vertices_i[feature.second],
+                                vertices_i[(feature.second + 1) % vertices_i.size()],
                                 potentialij, forceji, torqueji,
                                 forceij, torqueij);
+                            break;
+                        case contact_vertex_vertex:
+                            m_evaluator.vertexVertex(dx, vertices_i[0], dx + rotate(quatj, shape_j[0]),
+                                potentialij, forceij, torqueij,
+                                forceji, torqueji);
+                            break;
                         }
                     }
-                // if i doesn't have any edges and j doesn't have any
-                // edges, both are disks
-                else if(vertices_j.size() <= 1)
-                    {
-                    m_evaluator.vertexVertex(dx, vertices_i[0], dx + vertices_j[0],
-                        potentialij, forceij, torqueij,
-                        forceji, torqueji);
-                    }
 
                 // compute the pair energy and virial (FLOPS: 6)
                 Scalar pair_virial[6];
@@ -11,6 +11,7 @@
 #include <memory>
 
 #include "DEMEvaluator.h"
+#include "ContactFeatureCache.h"
 
 /*! \file DEM2DForceCompute.h
   \brief Declares the DEM2DForceCompute class
@@ -35,6 +36,9 @@
   Forces can be computed directly by calling compute() and then retrieved with a call to acquire(), but
   a more typical usage will be to add the force compute to NVEUpdater or NVTUpdater.
 
+  The vertex-edge combinations of each neighbor pair that are near contact are kept in a ContactFeatureCache, and
+  only they are evaluated on each step.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -86,6 +90,13 @@ class DEM2DForceCompute : public ForceCompute
         Real m_r_cut;         //!< Cutoff radius beyond which the force is set to 0
         DEMEvaluator<Real, Real4, Potential> m_evaluator; //!< Object holding parameters and computation method for the potential
         std::vector<std::vector<vec2<Real> > > m_shapes; //!< Vertices for each type
+        std::vector<Real> m_typeRadius; //!< Circumsphere radius of each type
+        ContactFeatureCache<Real> m_contactCache; //!< Feature pairs near contact for each neighbor pair
+        bool m_resetContacts; //!< True if the feature pairs must be rebuilt for all neighbor pairs
+
+        //! Find the feature pairs of two particles near contact
+        void findContactFeatures(unsigned int slot, unsigned int typei, unsigned int typej,
+            const vec2<Real> &dx, const quat<Real> &quati, const quat<Real> &quatj, Real r_feature);
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -46,7 +46,8 @@ DEM3DForceCompute<Real, Real4, Potential>::DEM3DForceCompute(
       m_numTypeEdges(0, this->m_exec_conf), m_numTypeFaces(0, this->m_exec_conf),
       m_vertexConnectivity(0, this->m_exec_conf), m_edges(0, this->m_exec_conf),
       m_faceRcutSq(0, this->m_exec_conf), m_edgeRcutSq(0, this->m_exec_conf),
-      m_verts(0, this->m_exec_conf), m_vertsVec(), m_facesVec()
+      m_verts(0, this->m_exec_conf), m_vertsVec(), m_facesVec(),
+      m_contactCache(), m_resetContacts(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing DEM3DForceCompute" << endl;
 
@@ -354,6 +355,147 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
         const unsigned int faceSize(m_facesVec[shapeIdx].size());
         h_numTypeFaces.data[shapeIdx] = faceSize;
         }
+
+    // build the bounding spheres of the features, used to find the features near contact
+    m_typeRadius.assign(nTypes, Real(0));
+    m_faceIndexVec.assign(nTypes, vector<unsigned int>());
+    m_faceSpheresVec.assign(nTypes, vector<feature_sphere<Real> >());
+    m_edgeSpheresVec.assign(nTypes, vector<feature_sphere<Real> >());
+    for(size_t shapeIdx(0); shapeIdx < m_facesVec.size(); ++shapeIdx)
+        {
+        for(size_t vertIdx(0); vertIdx < m_vertsVec[shapeIdx].size(); ++vertIdx)
+            {
+            const vec3<Real> point(m_vertsVec[shapeIdx][vertIdx]);
+            m_typeRadius[shapeIdx] = max(m_typeRadius[shapeIdx], Real(sqrt(dot(point, point))));
+            }
+
+        for(size_t faceIdx(shapeIdx), vecIdx(0);
+            vecIdx < m_facesVec[shapeIdx].size();
+            faceIdx = h_nextFace.data[faceIdx], ++vecIdx)
+            {
+            vector<vec3<Real> > points;
+            for(size_t vertIdx(0); vertIdx < m_facesVec[shapeIdx][vecIdx].size(); ++vertIdx)
+                points.push_back(m_vertsVec[shapeIdx][m_facesVec[shapeIdx][vecIdx][vertIdx]]);
+
+            m_faceIndexVec[shapeIdx].push_back(faceIdx);
+            m_faceSpheresVec[shapeIdx].push_back(makeFeatureSphere(points));
+            }
+
+        for(size_t edgeIdx(0); edgeIdx < h_numTypeEdges.data[shapeIdx]; ++edgeIdx)
+            {
+            vector<vec3<Real> > points;
+            points.push_back(vec3<Real>(h_verts.data[h_edges.data[2*(edgeIdx + h_firstTypeEdge.data[shapeIdx])]]));
+            points.push_back(vec3<Real>(h_verts.data[h_edges.data[2*(edgeIdx + h_firstTypeEdge.data[shapeIdx]) + 1]]));
+            m_edgeSpheresVec[shapeIdx].push_back(makeFeatureSphere(points));
+            }
+        }
+
+    m_resetContacts = true;
+    }
+
+/*! findContactFeatures: Rebuild the list of feature pairs of two particles whose bounding spheres are within the
+  feature cutoff plus the skin. Feature pairs are added in the order computeForces evaluated all of them in before, so
+  that the sums of forces and torques do not depend on the caching.
+
+  \param slot Index of the pair in the neighbor list
+  \param typei Type of particle i
+  \param typej Type of particle j
+  \param dx Separation of the centers of mass
+  \param quati Orientation of particle i
+  \param quatj Orientation of particle j
+  \param r_feature Distance between features below which they interact
+*/
+template<typename Real, typename Real4, typename Potential>
+void DEM3DForceCompute<Real, Real4, Potential>::findContactFeatures(
+    unsigned int slot, unsigned int typei, unsigned int typej,
+    const vec3<Real> &dx, const quat<Real> &quati, const quat<Real> &quatj, Real r_feature)
+    {
+    const Real limit(m_contactCache.beginPair(slot, dx, quati, quatj, r_feature));
+
+    // place all features in the frame of particle i
+    vector<vec3<Real> > vertsi, vertsj;
+    for(size_t vertIdx(0); vertIdx < m_vertsVec[typei].size(); ++vertIdx)
+        vertsi.push_back(rotate(quati, m_vertsVec[typei][vertIdx]));
+    for(size_t vertIdx(0); vertIdx < m_vertsVec[typej].size(); ++vertIdx)
+        vertsj.push_back(dx + rotate(quatj, m_vertsVec[typej][vertIdx]));
+
+    vector<feature_sphere<Real> > facesi(m_faceSpheresVec[typei]), facesj(m_faceSpheresVec[typej]);
+    for(size_t faceIdx(0); faceIdx < facesi.size(); ++faceIdx)
+        facesi[faceIdx].center = rotate(quati, facesi[faceIdx].center);
+    for(size_t faceIdx(0); faceIdx < facesj.size(); ++faceIdx)
+        facesj[faceIdx].center = dx + rotate(quatj, facesj[faceIdx].center);
+
+    vector<feature_sphere<Real> > edgesi(m_edgeSpheresVec[typei]), edgesj(m_edgeSpheresVec[typej]);
+    for(size_t edgeIdx(0); edgeIdx < edgesi.size(); ++edgeIdx)
+        edgesi[edgeIdx].center = rotate(quati, edgesi[edgeIdx].center);
+    for(size_t edgeIdx(0); edgeIdx < edgesj.size(); ++edgeIdx)
+        edgesj[edgeIdx].center = dx + rotate(quatj, edgesj[edgeIdx].center);
+
+    // vertices of i against the faces, edges or vertices of j
+    for(size_t vertIdx(0); vertIdx < vertsi.size(); ++vertIdx)
+        {
+        if(facesj.size())
+            {
+            for(size_t faceIdx(0); faceIdx < facesj.size(); ++faceIdx)
+                {
+                const vec3<Real> r(facesj[faceIdx].center - vertsi[vertIdx]);
+                if(sqrt(dot(r, r)) - facesj[faceIdx].radius <= limit)
+                    m_contactCache.addFeature(slot, contact_vertex_face, vertIdx, m_faceIndexVec[typej][faceIdx]);
+                }
+            }
+        else if(edgesj.size())
+            {
+            for(size_t edgeIdx(0); edgeIdx < edgesj.size(); ++edgeIdx)
+                {
+                const vec3<Real> r(edgesj[edgeIdx].center - vertsi[vertIdx]);
+                if(sqrt(dot(r, r)) - edgesj[edgeIdx].radius <= limit)
+                    m_contactCache.addFeature(slot, contact_vertex_edge, vertIdx, edgeIdx);
+                }
+            }
+        else
+            {
+            for(size_t vertj(0); vertj < vertsj.size(); ++vertj)
+                {
+                const vec3<Real> r(vertsj[vertj] - vertsi[vertIdx]);
+                if(sqrt(dot(r, r)) <= limit)
+                    m_contactCache.addFeature(slot, contact_vertex_vertex, vertIdx, vertj);
+                }
+            }
+        }
+
+    // vertices of j against the faces or edges of i
+    for(size_t vertIdx(0); vertIdx < vertsj.size(); ++vertIdx)
+        {
+        if(facesi.size())
+            {
+            for(size_t faceIdx(0); faceIdx < facesi.size(); ++faceIdx)
+                {
+                const vec3<Real> r(facesi[faceIdx].center - vertsj[vertIdx]);
+                if(sqrt(dot(r, r)) - facesi[faceIdx].radius <= limit)
+                    m_contactCache.addFeature(slot, contact_face_vertex, vertIdx, m_faceIndexVec[typei][faceIdx]);
+                }
+            }
+        else if(edgesi.size())
+            {
+            for(size_t edgeIdx(0); edgeIdx < edgesi.size(); ++edgeIdx)
+                {
+                const vec3<Real> r(edgesi[edgeIdx].center - vertsj[vertIdx]);
+                if(sqrt(dot(r, r)) - edgesi[edgeIdx].radius <= limit)
+                    m_contactCache.addFeature(slot, contact_edge_vertex, vertIdx, edgeIdx);
+                }
+            }
+        }
+
+    // all pairs of edges
+    for(size_t edgei(0); edgei < edgesi.size(); ++edgei)
+        {
+        for(size_t edgej(0); edgej < edgesj.size(); ++edgej)
+            {
+            const vec3<Real> r(edgesj[edgej].center - edgesi[edgei].center);
+            if(sqrt(dot(r, r)) - edgesi[edgei].radius - edgesj[edgej].radius <= limit)
+                m_contactCache.addFeature(slot, contact_edge_edge, edgei, edgej);
+            }
+        }
     }
 
 /*!
@@ -505,6 +647,14 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
     // start the profile for this compute
     if (m_prof) m_prof->push("DEM3D pair");
 
+    // the feature pairs near contact are found again whenever the neighbor list is rebuilt
+    const unsigned int n_slots(m_nlist->getNListArray().getNumElements());
+    if(m_resetContacts || m_nlist->hasBeenUpdated(timestep) || m_contactCache.getNumSlots() != n_slots)
+        {
+        m_contactCache.reset(n_slots, m_nlist->getRBuff());
+        m_resetContacts = false;
+        }
+
     // grab handles for particle data
     ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar4> h_torque(m_torque,access_location::host, access_mode::overwrite);
@@ -660,124 +810,104 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(unsigned int times
                 vec3<Real> torqueij, torqueji;
                 Real potentialij(0);
 
-                // iterate over each vertex in particle i
-                for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
+                // only the feature pairs near contact can interact
+                const unsigned int slot(myHead + j);
+                const Real r_feature(m_evaluator.getFeatureRcut());
+                if(!m_contactCache.isValid(slot, dx, quati, quatj,
+                        m_typeRadius[typei], m_typeRadius[typej], r_feature))
+                    findContactFeatures(slot, typei, typej, dx, quati, quatj, r_feature);
+
+                const std::vector<contact_feature> &features(m_contactCache.getFeatures(slot));
+                for(size_t featureIdx(0); featureIdx < features.size(); ++featureIdx)
                     {
-                    const vec3<Real> vertex0(
-                        rotate(quati, vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + vertIndex])));
+                    const contact_feature &feature(features[featureIdx]);
 
-                    // iterate over each face in particle j
-                    size_t faceIndex(typej);
-                    if(h_numTypeFaces.data[typej] > 0)
+                    switch(feature.kind)
                         {
-                        do
+                        case contact_vertex_face:
                             {
+                            const vec3<Real> vertex0(
+                                rotate(quati, vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + feature.first])));
+
                             m_evaluator.vertexFace(dx, vertex0, quatj,
                                 h_verts.data,
                                 h_realVertIndex.data,
                                 h_nextFaceVert.data,
-                                h_firstFaceVert.data[faceIndex],
+                                h_firstFaceVert.data[feature.second],
                                 potentialij,
                                 forceij, torqueij,
                                 forceji, torqueji);
-                            faceIndex = h_nextFace.data[faceIndex];
+                            break;
                             }
-                        while(faceIndex != typej);
-                        }
-                    // no faces; is it a spherocylinder?
-                    else if(h_numTypeEdges.data[typej] > 0)
-                        {
-                        // iterate over all edges of j
-                        for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
+                        case contact_face_vertex:
                             {
-                            vec3<Real> p10(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
-                            vec3<Real> p11(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
-                            p10 = rotate(quatj, p10);
-                            p11 = rotate(quatj, p11);
+                            const vec3<Real> vertex0(
+                                rotate(quatj, vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + feature.first])));
 
-                            m_evaluator.vertexEdge(dx, vertex0, p10, p11,
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
-                            }
-                        }
-                    // no edges either; must be a sphere
-                    else
-                        {
-                        // all pairs of vertices
-                        for(size_t vertj(0); vertj < h_numTypeVerts.data[typej]; ++vertj)
-                            {
-                            vec3<Real> vertex1(h_verts.data[h_firstTypeVert.data[typej] + vertj]);
-                            vertex1 = rotate(quatj, vertex1);
-
-                            m_evaluator.vertexVertex(dx, vertex0, dx + vertex1,
-                                potentialij, forceij, torqueij,
-                                forceji, torqueji);
-                            }
-                        }
-                    }
-
-                // iterate over each vertex in particle j
-                for(size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typej]; ++vertIndex)
-                    {
-                    const vec3<Real> vertex0(
-                        rotate(quatj, vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + vertIndex])));
-
-                    // iterate over each face in particle i
-                    size_t faceIndex(typei);
-                    if(h_numTypeFaces.data[typei] > 0)
-                        {
-                        do
-                            {
                             m_evaluator.vertexFace(-dx, vertex0, quati,
                                 h_verts.data,
                                 h_realVertIndex.data,
                                 h_nextFaceVert.data,
-                                h_firstFaceVert.data[faceIndex],
+                                h_firstFaceVert.data[feature.second],
                                 potentialij,
                                 forceji, torqueji,
                                 forceij, torqueij);
-                            faceIndex = h_nextFace.data[faceIndex];
+                            break;
                             }
-                        while(faceIndex != typei);
-                        }
-                    // no faces; is it a spherocylinder?
-                    else if(h_numTypeEdges.data[typei] > 0)
-                        {
-                        // iterate over all edges of i
-                        for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
+                        case contact_vertex_edge:
                             {
-                            vec3<Real> p10(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
-                            vec3<Real> p11(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
+                            const vec3<Real> vertex0(
+                                rotate(quati, vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + feature.first])));
+                            vec3<Real> p10(h_verts.data[h_edges.data[2*(feature.second + h_firstTypeEdge.data[typej])]]);
+                            vec3<Real> p11(h_verts.data[h_edges.data[2*(feature.second + h_firstTypeEdge.data[typej]) + 1]]);
+                            p10 = rotate(quatj, p10);
+                            p11 = rotate(quatj, p11);
+
+                            m_evaluator.vertexEdge(dx, vertex0, p10, p11,
+                                potentialij, forceij, torqueij,
+                                forceji, torqueji);
+                            break;
+                            }
+                        case contact_edge_vertex:
+                            {
+                            const vec3<Real> vertex0(
+                                rotate(quatj, vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + feature.first])));
+                            vec3<Real> p10(h_verts.data[h_edges.data[2*(feature.second + h_firstTypeEdge.data[typei])]]);
+                            vec3<Real> p11(h_verts.data[h_edges.data[2*(feature.second + h_firstTypeEdge.data[typei]) + 1]]);
                             p10 = rotate(quati, p10);
                             p11 = rotate(quati, p11);
 
                             m_evaluator.vertexEdge(-dx, vertex0, p10, p11,
                                 potentialij, forceji, torqueji,
                                 forceij, torqueij);
+                            break;
                             }
-                        }
-                    // if it is a sphere, the vertex/vertex check was
-                    // done above while iterating over vertices in
-                    // particle i so we don't need another one here
-                    }
-
-                // iterate over all pairs of edges
-                for(size_t edgei(0); edgei < h_numTypeEdges.data[typei]; ++edgei)
-                    {
-                    vec3<Real> p00(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei])]]);
-                    vec3<Real> p01(h_verts.data[h_edges.data[2*(edgei + h_firstTypeEdge.data[typei]) + 1]]);
-                    p00 = rotate(quati, p00);
-                    p01 = rotate(quati, p01);
+                        case contact_edge_edge:
+                            {
+                            vec3<Real> p00(h_verts.data[h_edges.data[2*(feature.first + h_firstTypeEdge.data[typei])]]);
+                            vec3<Real> p01(h_verts.data[h_edges.data[2*(feature.first + h_firstTypeEdge.data[typei]) + 1]]);
+                            p00 = rotate(quati, p00);
+                            p01 = rotate(quati, p01);
+                            vec3<Real> p10(h_verts.data[h_edges.data[2*(feature.second + h_firstTypeEdge.data[typej])]]);
+                            vec3<Real> p11(h_verts.data[h_edges.data[2*(feature.second + h_firstTypeEdge.data[typej]) + 1]]);
+                            p10 = rotate(quatj, p10);
+                            p11 = rotate(quatj, p11);
 
-                    // iterate over all edges of j
-                    for(size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
-                        {
-                        vec3<Real> p10(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej])]]);
-                        vec3<Real> p11(h_verts.data[h_edges.data[2*(edgej + h_firstTypeEdge.data[typej]) + 1]]);
-                        p10 = rotate(quatj, p10);
-                        p11 = rotate(quatj, p11);
+                            m_evaluator.edgeEdge(dx, p00, p01, dx + p10, dx + p11, potentialij, forceij, torqueij, forceji, torqueji);
+                            break;
+                            }
+                        case contact_vertex_vertex:
+                            {
+                            const vec3<Real> vertex0(
+                                rotate(quati, vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + feature.first])));
+                            vec3<Real> vertex1(h_verts.data[h_firstTypeVert.data[typej] + feature.second]);
+                            vertex1 = rotate(quatj, vertex1);
 
-                        m_evaluator.edgeEdge(dx, p00, p01, dx + p10, dx + p11, potentialij, forceij, torqueij, forceji, torqueji);
+                            m_evaluator.vertexVertex(dx, vertex0, dx + vertex1,
+                                potentialij, forceij, torqueij,
+                                forceji, torqueji);
+                            break;
+                            }
                         }
                     }
 
@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "DEMEvaluator.h"
+#include "ContactFeatureCache.h"
 
 /*! \file DEM3DForceCompute.h
   \brief Declares the DEM3DForceCompute class
@@ -56,6 +57,10 @@
   - Vertices (3D points) are stored consecutively for a shape
   - Edges (pairs of vertex indices) are stored consecutively for a shape
 
+  On the CPU, the vertex-face, vertex-edge and edge-edge combinations that are near contact are kept in a
+  ContactFeatureCache for each neighbor pair. They are found by testing bounding spheres of the features, using the
+  neighbor list buffer as the skin, and only they are evaluated on each step.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -138,10 +143,20 @@ class DEM3DForceCompute : public ForceCompute
         GPUArray<Real4> m_verts; //! Vertices for each real index
         std::vector<std::vector<vec3<Real> > > m_vertsVec; //!< Vertices for each type
         std::vector<std::vector<std::vector<unsigned int> > > m_facesVec; //!< Faces for each type
+        std::vector<Real> m_typeRadius; //!< Circumsphere radius of each type
+        std::vector<std::vector<unsigned int> > m_faceIndexVec; //!< Face indices of each type, in iteration order
+        std::vector<std::vector<feature_sphere<Real> > > m_faceSpheresVec; //!< Face bounding spheres of each type
+        std::vector<std::vector<feature_sphere<Real> > > m_edgeSpheresVec; //!< Edge bounding spheres of each type
+        ContactFeatureCache<Real> m_contactCache; //!< Feature pairs near contact for each neighbor pair
+        bool m_resetContacts; //!< True if the feature pairs must be rebuilt for all neighbor pairs
 
         //! Re-send the list of vertices and links to the GPU
         void createGeometry();
 
+        //! Find the feature pairs of two particles near contact
+        void findContactFeatures(unsigned int slot, unsigned int typei, unsigned int typej,
+            const vec3<Real> &dx, const quat<Real> &quati, const quat<Real> &quatj, Real r_feature);
+
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
     };
@@ -41,6 +41,9 @@ class DEMEvaluator
 
         Real getRcutSq() const {return m_potential.getRcutSq();}
 
+        //! Get the distance between two features below which they interact
+        Real getFeatureRcut() const {return m_potential.getFeatureRcut();}
+
         /*! Evaluate the force and torque contributions for particles i
           and j, with centers of mass separated by rij. The appropriate
           forces and torques for particles i and j will be added to
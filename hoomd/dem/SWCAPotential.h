@@ -50,6 +50,9 @@ class SWCAPotential
             m_rcutsq = radius*radius*4*pow(2.0, 1./3.0);
             }
 
+        // Get the distance between two features below which they interact, for the diameters last set
+        Real getFeatureRcut() const {return sqrt(m_rcutsq) + m_delta;}
+
         /*! evaluate the potential between two points */
         template<typename Vec, typename Torque>
         DEVICE inline void evaluate(
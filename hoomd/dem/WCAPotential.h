@@ -54,6 +54,9 @@ class WCAPotential
         // Get this potential's cutoff radius
         Real getRcutSq() const {return m_rcutsq;}
 
+        // Get the distance between two features below which they interact
+        Real getFeatureRcut() const {return sqrt(m_rcutsq);}
+
         // Mutate this object by adjusting its lengthscale
         void scale(Real factor)
             {
@@ -6,6 +6,7 @@ import hoomd.dem;
 hoomd.context.initialize();
 
 import itertools
+import numpy
 import unittest
 
 def not_on_mpi(f):
@@ -243,5 +244,78 @@ class shape_shape(unittest.TestCase):
     def tearDown(self):
         hoomd.comm.barrier();
 
+class rotated_shape(unittest.TestCase):
+
+    def test_potential_wca_2d(self):
+        self._test_potential(hoomd.dem.pair.WCA, twoD=True, radius=.5);
+
+    def test_potential_wca_3d(self):
+        self._test_potential(hoomd.dem.pair.WCA, twoD=False, radius=.5);
+
+    def _run(self, typ, twoD, orientation, rotate_after=None, **params):
+        box = hoomd.data.boxdim(L=80, dimensions=(2 if twoD else 3));
+        snap = hoomd.data.make_snapshot(N=2, box=box);
+
+        if hoomd.comm.get_rank() == 0:
+            snap.particles.position[0] = (0, 0, 0);
+            snap.particles.position[1] = (6.5, 0, 0);
+            snap.particles.orientation[1] = orientation;
+
+        system = hoomd.init.read_snapshot(snap);
+        nl = hoomd.md.nlist.cell(r_buff=0.8);
+
+        potential = typ(nlist=nl, **params);
+        nve = hoomd.md.integrate.nve(group=hoomd.group.all());
+        mode = hoomd.md.integrate.mode_standard(dt=0);
+
+        if twoD:
+            vertices = [[2.5, 2.5], [-2.5, 2.5], [-2.5, -2.5], [2.5, -2.5]];
+            potential.setParams('A', vertices, center=False);
+        else:
+            vertices = list(itertools.product(*(3*[[-2.5,2.5]])));
+            faces = [[4, 0, 2, 6],
+                     [1, 0, 4, 5],
+                     [5, 4, 6, 7],
+                     [2, 0, 1, 3],
+                     [6, 2, 3, 7],
+                     [3, 1, 5, 7]];
+            potential.setParams('A', vertices, faces, center=False);
+
+        hoomd.run(1);
+
+        # rotating in place does not rebuild the neighbor list, the cached features near contact must be found again
+        if rotate_after is not None:
+            system.particles[1].orientation = rotate_after;
+            hoomd.run(1);
+
+        energies = [p.net_energy for p in system.particles];
+
+        potential.disable();
+        del potential;
+        del system;
+        hoomd.context.initialize();
+
+        return energies;
+
+    def _test_potential(self, typ, twoD, **params):
+        # a rotation by 45 degrees about z brings the corners of particle 1 in contact with particle 0
+        rotated = (numpy.cos(numpy.pi/8), 0, 0, numpy.sin(numpy.pi/8));
+
+        apart = self._run(typ, twoD, (1, 0, 0, 0), **params);
+        self.assertAlmostEqual(apart[0], 0);
+
+        expected = self._run(typ, twoD, rotated, **params);
+        self.assertGreater(expected[0], 0);
+
+        energies = self._run(typ, twoD, (1, 0, 0, 0), rotate_after=rotated, **params);
+        for (U, U_expected) in zip(energies, expected):
+            self.assertAlmostEqual(U, U_expected);
+
+    def setUp(self):
+        hoomd.context.initialize();
+
+    def tearDown(self):
+        hoomd.comm.barrier();
+
 if __name__ == '__main__':
     unittest.main(argv = ['test_potentials.py', '-v']);
@@ -566,9 +566,11 @@ class gsd(hoomd.analyze._analyzer):
     :py:class:`gsd` can save internal state data for the following hoomd objects:
 
         * :py:class:`HPMC integrators <hoomd.hpmc.integrate.mode_hpmc>`
+        * :py:class:`MPCD systems <hoomd.mpcd.data.system>` (see :py:meth:`hoomd.mpcd.data.system.dump_gsd`)
 
-    Call :py:meth:`dump_state` with the object as an argument to enable saving its state. State saved in this way
-    can be restored after initializing the system with :py:meth:`hoomd.init.read_gsd`.
+    Call :py:meth:`dump_state` with the object as an argument to enable saving its state. HPMC integrator state
+    saved in this way can be restored after initializing the system with :py:meth:`hoomd.init.read_gsd`. The MPCD data
+    is only written for analysis, HOOMD does not read it back from GSD files.
 
     Examples::
 
@@ -666,3 +668,58 @@ class gsd(hoomd.analyze._analyzer):
             obj._connect_gsd(self);
         else:
             hoomd.context.msg.warning("GSD is not currently support for {name}".format(obj.__name__));
+
+class checkpoint(hoomd.analyze._analyzer):
+    R""" Writes restart checkpoints.
+
+    Args:
+        prefix (str): Prefix of the checkpoint file names
+        period (int): Number of time steps between checkpoints, or None to write a single checkpoint immediately.
+        phase (int): When -1, start on the current time step. When >= 0, execute on steps where *(step + phase) % period == 0*.
+
+    :py:class:`checkpoint` saves the exact state of the system so that a run can be restarted with
+    :py:func:`hoomd.init.read_checkpoint`. Every MPI rank writes the particles, bonds, angles, dihedrals,
+    impropers, constraints, and pairs it owns in full precision to its own file, without gathering the system
+    on the root rank. Each checkpoint writes the files *prefix*.<step>.domain0, *prefix*.<step>.domain1, ... and
+    then replaces *prefix*.manifest, which lists them. Replacing the manifest is the only step that commits the new
+    checkpoint, and the files of the previous checkpoint are removed only after that. If a write fails or the job is
+    interrupted, *prefix*.manifest still refers to the complete previous checkpoint.
+
+    The files store the raw binary data of each rank. They can only be read back by
+    :py:func:`hoomd.init.read_checkpoint` on the same number of MPI ranks, with a build of HOOMD-blue of the same
+    precision. Use :py:class:`gsd` to store trajectories and portable restart files.
+
+    Examples::
+
+        dump.checkpoint(prefix="restart", period=100000)
+        ckpt = dump.checkpoint(prefix="restart", period=None)
+
+    .. versionadded:: 2.3
+    """
+    def __init__(self, prefix, period, phase=0):
+        hoomd.util.print_status_line();
+
+        # initialize base class
+        hoomd.analyze._analyzer.__init__(self);
+
+        self.cpp_analyzer = _hoomd.CheckpointWriter(hoomd.context.current.system_definition, prefix);
+
+        if period is not None:
+            self.setupAnalyzer(period, phase);
+        else:
+            self.cpp_analyzer.analyze(hoomd.context.current.system.getCurrentTimeStep());
+
+        # store metadata
+        self.prefix = prefix
+        self.period = period
+        self.phase = phase
+        self.metadata_fields = ['prefix','period','phase']
+
+    def write(self):
+        """ Write a checkpoint at the current time step.
+
+        Call :py:meth:`write` at the end of a simulation to save its final state.
+        """
+        hoomd.util.print_status_line();
+
+        self.cpp_analyzer.analyze(hoomd.context.current.system.getCurrentTimeStep());
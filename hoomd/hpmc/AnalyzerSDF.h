@@ -31,19 +31,13 @@ namespace detail
 //! Local helper function to test ovelap of two particles with scale
 template < class Shape >
 bool test_scaled_overlap(const vec3<Scalar>& r_ij,
-                         const quat<Scalar>& orientation_i,
-                         const quat<Scalar>& orientation_j,
-                         const typename Shape::param_type& params_i,
-                         const typename Shape::param_type& params_j,
+                         const Shape& shape_i,
+                         const Shape& shape_j,
                          Scalar lambda)
     {
     // need a dummy error counter
     unsigned int dummy = 0;
 
-    // instantiate the shapes
-    Shape shape_i(orientation_i, params_i);
-    Shape shape_j(orientation_j, params_j);
-
     vec3<Scalar> r_ij_scaled = r_ij * (Scalar(1.0) - lambda);
     return check_circumsphere_overlap(r_ij_scaled, shape_i, shape_j) && test_overlap(r_ij_scaled, shape_i, shape_j, dummy);
     }
@@ -69,9 +63,11 @@ bool test_scaled_overlap(const vec3<Scalar>& r_ij,
 
     \b Computing \f$ \lambda \f$ <br>
 
-    In the initial version of the code, a completely general way of computing *\f$ \lambda \f$* is implemented.
-    It uses a binary search tree and the existing test_overlap code to find wich bin a given pair of particles sits in.
-    Future versions of the code may use shape specific data to compute *\f$ \lambda \f$* directly.
+    Pairs whose circumspheres do not touch even when scaled by *lmax* are skipped. For the remaining pairs,
+    find_contact_scale() computes *\f$ \lambda \f$* directly where the shape implements it: in closed form for
+    spheres, and by ray casting through the Minkowski difference with the support functions for convex polyhedra and
+    convex spheropolyhedra. For all other shapes, a binary search with the existing test_overlap code finds which bin
+    a given pair of particles sits in.
 
     Outside of that AnalyzerSDF is a pretty basic histogramming code. The only other notable features in the design
     are:
@@ -158,10 +154,8 @@ class AnalyzerSDF : public Analyzer
 
         //! Determine the s bin of a given particle pair
         int computeBin(const vec3<Scalar>& r_ij,
-                       const quat<Scalar>& orientation_i,
-                       const quat<Scalar>& orientation_j,
-                       const typename Shape::param_type& params_i,
-                       const typename Shape::param_type& params_j);
+                       const Shape& shape_i,
+                       const Shape& shape_j);
     };
 
 
@@ -343,6 +337,14 @@ void AnalyzerSDF<Shape>::countHistogram(unsigned int timestep)
 
     const std::vector<param_type, managed_allocator<param_type> > & params = m_mc->getParams();
 
+    // circumsphere diameter of each type
+    std::vector<Scalar> circumsphere_diameter(m_pdata->getNTypes());
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); ++typ)
+        {
+        Shape shape(quat<Scalar>(), params[typ]);
+        circumsphere_diameter[typ] = shape.getCircumsphereDiameter();
+        }
+
     // loop through N particles
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
@@ -382,17 +384,19 @@ void AnalyzerSDF<Shape>::countHistogram(unsigned int timestep)
                                 continue;
 
                             Scalar4 postype_j = h_postype.data[j];
-                            Scalar4 orientation_j = h_orientation.data[j];
 
                             // put particles in coordinate system of particle i
                             vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
 
+                            // skip pairs that cannot touch when scaled by lmax
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            Scalar DaDb = shape_i.getCircumsphereDiameter() + circumsphere_diameter[typ_j];
+                            Scalar r_scaled = Scalar(1.0) - m_lmax;
+                            if (dot(r_ij, r_ij)*r_scaled*r_scaled*Scalar(4.0) > DaDb*DaDb)
+                                continue;
 
-                            int bin = computeBin(r_ij,
-                                                 quat<Scalar>(orientation_i),
-                                                 quat<Scalar>(orientation_j),
-                                                 params[__scalar_as_int(postype_i.w)],
-                                                 params[__scalar_as_int(postype_j.w)]);
+                            Shape shape_j(quat<Scalar>(h_orientation.data[j]), params[typ_j]);
+                            int bin = computeBin(r_ij, shape_i, shape_j);
 
                             if (bin >= 0)
                                 min_bin = std::min(min_bin, bin);
@@ -415,36 +419,46 @@ void AnalyzerSDF<Shape>::countHistogram(unsigned int timestep)
     }
 
 /*! \param r_ij Vector pointing from particle i to j (already wrapped into the box)
-    \param orientation_i Orientation of the particle i
-    \param orientation_j Orientation of particle j
-    \param params_i Parameters for particle i
-    \param params_j Parameters for particle j
+    \param shape_i Shape of particle i
+    \param shape_j Shape of particle j
 
     \returns s bin index
 
-    In the first general version, computeBin uses a binary search tree to determine
-    the bin. In this way, only a test_overlap method is needed, no extra math. The
-    binary search works by first ensuring that the particle does not overlap at the
-    left boundary and does overlap a the right. Then it picks a new point halfway between
-    the left and right, ensuring that the same assumption holds. Once right=left+1, the
-    correct bin has been found.
+    Shapes that implement find_contact_scale() provide the bin directly. It is resolved to a hundredth of a bin.
+
+    For all other shapes, computeBin uses a binary search tree to determine the bin. In this way, only a test_overlap
+    method is needed, no extra math. The binary search works by first ensuring that the particle does not overlap at
+    the left boundary and does overlap a the right. Then it picks a new point halfway between the left and right,
+    ensuring that the same assumption holds. Once right=left+1, the correct bin has been found.
 */
 template < class Shape >
 int AnalyzerSDF<Shape>:: computeBin(const vec3<Scalar>& r_ij,
-                             const quat<Scalar>& orientation_i,
-                             const quat<Scalar>& orientation_j,
-                             const typename Shape::param_type& params_i,
-                             const typename Shape::param_type& params_j)
+                             const Shape& shape_i,
+                             const Shape& shape_j)
     {
     unsigned int L=0;
     unsigned int R=m_hist.size();
 
+    OverlapReal lambda;
+    if (find_contact_scale(r_ij, shape_i, shape_j, OverlapReal(0.01*m_dl), OverlapReal(R*m_dl), lambda))
+        {
+        // the particles already overlap a the left boundary
+        if (lambda <= OverlapReal(0.0))
+            return -1;
+
+        // the particles do not overlap a the right boundary
+        if (lambda >= OverlapReal(R*m_dl))
+            return m_hist.size();
+
+        return std::min((unsigned int)(lambda / m_dl), R-1);
+        }
+
     // if the particles already overlap a the left boundary, return an out of range value
-    if (detail::test_scaled_overlap<Shape>(r_ij, orientation_i, orientation_j, params_i, params_j, L*m_dl))
+    if (detail::test_scaled_overlap<Shape>(r_ij, shape_i, shape_j, L*m_dl))
         return -1;
 
     // if the particles do not overlap a the right boundary, return an out of range value
-    if (!detail::test_scaled_overlap<Shape>(r_ij, orientation_i, orientation_j, params_i, params_j, R*m_dl))
+    if (!detail::test_scaled_overlap<Shape>(r_ij, shape_i, shape_j, R*m_dl))
         return m_hist.size();
 
     // progressively narrow the search window by halves
@@ -452,7 +466,7 @@ int AnalyzerSDF<Shape>:: computeBin(const vec3<Scalar>& r_ij,
         {
         unsigned int m = (L+R)/2;
 
-        if (detail::test_scaled_overlap<Shape>(r_ij, orientation_i, orientation_j, params_i, params_j, m*m_dl))
+        if (detail::test_scaled_overlap<Shape>(r_ij, shape_i, shape_j, m*m_dl))
             R = m;
         else
             L = m;
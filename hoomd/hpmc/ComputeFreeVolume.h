@@ -12,6 +12,13 @@
 #include "HPMCPrecisionSetup.h"
 #include "IntegratorHPMCMono.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
 
 /*! \file ComputeFreeVolume.h
     \brief Defines the template class for an approximate free volume integration
@@ -29,7 +36,16 @@ namespace hpmc
 {
 
 //! Template class for a free volume integration analyzer
-/*!
+/*! Test particles are placed at random in the box, and the fraction that does not overlap any particle estimates the
+    free volume.
+
+    Most test particles are classified without any shape overlap test. On every call, the box is divided into voxels
+    and each voxel is marked as free when no circumsphere of a particle, expanded by the circumsphere of the test
+    particle, reaches it, and as occupied when it lies entirely inside the insphere of a particle expanded by the
+    insphere of the test particle. Only test particles in the remaining voxels are checked against their neighbors in
+    the AABB tree. The result is the same as that of testing every test particle, as both bounds are exact. Inspheres
+    are only used when both shapes implement getInsphereRadius().
+
     \ingroup hpmc_integrators
 */
 template< class Shape >
@@ -87,6 +103,20 @@ class ComputeFreeVolume : public Compute
         const std::string m_suffix;                              //!< Log suffix
 
         GPUArray<unsigned int> m_n_overlap_all;                  //!< Number of overlap volume particles in box
+
+        //! State of a voxel of the occupancy grid
+        enum voxel_state
+            {
+            voxel_free = 0,   //!< No test particle in the voxel overlaps a particle
+            voxel_ambiguous,  //!< Test particles in the voxel need to be checked
+            voxel_occupied    //!< Every test particle in the voxel overlaps a particle
+            };
+
+        std::vector<unsigned char> m_voxels;                     //!< State of each voxel in the occupancy grid
+        uint3 m_voxel_dim;                                       //!< Number of voxels along each box direction
+
+        //! Classify the voxels of the local box
+        void buildOccupancyGrid(const std::vector<vec3<Scalar> >& image_list);
     };
 
 
@@ -134,7 +164,6 @@ template<class Shape>
 void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
     {
     unsigned int overlap_count = 0;
-    unsigned int err_count = 0;
 
     this->m_exec_conf->msg->notice(5) << "HPMC computing free volume " << timestep << std::endl;
 
@@ -149,6 +178,9 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
     // only check if AABB tree is populated
     if (m_pdata->getN() + m_pdata->getNGhosts())
         {
+        // classify voxels, before acquiring the particle data and interaction matrix here
+        buildOccupancyGrid(image_list);
+
         // access particle data and system box
         ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
@@ -167,7 +199,12 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
         n_sample /= this->m_exec_conf->getNRanks();
         #endif
 
-        for (unsigned int i = 0; i < n_sample; i++)
+        // samples in ambiguous voxels are tested against shapes
+        const uint3 dim = m_voxel_dim;
+        const Index3D voxel_idx(dim.x, dim.y, dim.z);
+
+        // test a single random depletant against the neighbors of its position
+        auto test_sample = [&](unsigned int i) -> bool
             {
             // select a random particle coordinate in the box
             hoomd::detail::Saru rng_i(i, m_seed + m_exec_conf->getRank(), timestep);
@@ -176,6 +213,14 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
             Scalar yrand = rng_i.f();
             Scalar zrand = rng_i.f();
 
+            // look up the voxel of the sample
+            unsigned int vx = std::min((unsigned int)(xrand*dim.x), dim.x-1);
+            unsigned int vy = std::min((unsigned int)(yrand*dim.y), dim.y-1);
+            unsigned int vz = std::min((unsigned int)(zrand*dim.z), dim.z-1);
+            unsigned char state = m_voxels[voxel_idx(vx, vy, vz)];
+            if (state != voxel_ambiguous)
+                return state == voxel_occupied;
+
             Scalar3 f = make_scalar3(xrand, yrand, zrand);
             vec3<Scalar> pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
@@ -186,7 +231,7 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
                 }
 
             // check for overlaps with neighboring particle's positions
-            bool overlap=false;
+            unsigned int err_count = 0;
             detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
 
             // All image boxes (including the primary)
@@ -226,8 +271,7 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
                                     && check_circumsphere_overlap(r_ij, shape_i, shape_j)
                                     && test_overlap(r_ij, shape_i, shape_j, err_count))
                                     {
-                                    overlap = true;
-                                    break;
+                                    return true;
                                     }
                                 }
                             }
@@ -237,20 +281,33 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
                         // skip ahead
                         cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
                         }
-
-                    if (overlap)
-                        break;
                     }  // end loop over AABB nodes
-
-                if (overlap)
-                    break;
                 } // end loop over images
 
-            if (overlap)
+            return false;
+            };
+
+        #ifdef ENABLE_TBB
+        overlap_count = tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, n_sample), 0u,
+            [&](const tbb::blocked_range<unsigned int>& r, unsigned int count) -> unsigned int
+                {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                    {
+                    if (test_sample(i))
+                        count++;
+                    }
+                return count;
+                },
+            std::plus<unsigned int>());
+        #else
+        for (unsigned int i = 0; i < n_sample; i++)
+            {
+            if (test_sample(i))
                 {
                 overlap_count++;
                 }
-            } // end loop through all particles
+            } // end loop through all samples
+        #endif
 
         } // end lexical scope
 
@@ -267,6 +324,148 @@ void ComputeFreeVolume<Shape>::computeFreeVolume(unsigned int timestep)
     *h_n_overlap_all.data = overlap_count;
     }
 
+/*! \param image_list Translations of the periodic images, as used for the test particles
+
+    The voxels are parallelepipeds spanned by fractions of the lattice vectors of the local box. A voxel is bounded
+    by the sphere around its center with half the length of its longest diagonal, and every particle and periodic
+    image marks the voxels whose bounding spheres intersect its expanded circumsphere as ambiguous, and those whose
+    bounding spheres lie inside its expanded insphere as occupied.
+*/
+template<class Shape>
+void ComputeFreeVolume<Shape>::buildOccupancyGrid(const std::vector<vec3<Scalar> >& image_list)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    const std::vector<typename Shape::param_type, managed_allocator<typename Shape::param_type> > & params = m_mc->getParams();
+    ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+    const unsigned int ntypes = m_pdata->getNTypes();
+
+    // radii of the test particle added to those of each type, negative if the type does not interact with it
+    Shape shape_test(quat<Scalar>(), params[m_type]);
+    const Scalar R_test = Scalar(0.5)*shape_test.getCircumsphereDiameter();
+    const Scalar r_test = shape_test.getInsphereRadius();
+
+    std::vector<Scalar> R_sum(ntypes, Scalar(-1.0));
+    std::vector<Scalar> r_sum(ntypes, Scalar(-1.0));
+    Scalar r_min = Scalar(-1.0);
+    Scalar R_min = Scalar(-1.0);
+    for (unsigned int typ = 0; typ < ntypes; ++typ)
+        {
+        if (!h_overlaps.data[overlap_idx(m_type, typ)])
+            continue;
+
+        Shape shape(quat<Scalar>(), params[typ]);
+        R_sum[typ] = R_test + Scalar(0.5)*shape.getCircumsphereDiameter();
+        R_min = (R_min < Scalar(0.0)) ? R_sum[typ] : std::min(R_min, R_sum[typ]);
+
+        Scalar r = shape.getInsphereRadius();
+        if (r_test > Scalar(0.0) && r > Scalar(0.0))
+            {
+            r_sum[typ] = r_test + r;
+            r_min = (r_min < Scalar(0.0)) ? r_sum[typ] : std::min(r_min, r_sum[typ]);
+            }
+        }
+
+    // resolve the smallest expanded insphere with a few voxels, and cap the memory of the grid
+    const unsigned int max_voxels = 1 << 24;
+    Scalar width = Scalar(0.5)*((r_min > Scalar(0.0)) ? r_min : std::max(R_min, Scalar(0.0)));
+    Scalar3 L = box.getNearestPlaneDistance();
+    const bool two_d = m_sysdef->getNDimensions() == 2;
+
+    uint3 dim = make_uint3(1,1,1);
+    if (width > Scalar(0.0))
+        {
+        Scalar volume = L.x*L.y*(two_d ? width : L.z);
+        Scalar n_voxels = volume/(width*width*width);
+        if (n_voxels > Scalar(max_voxels))
+            width *= pow(n_voxels/Scalar(max_voxels), Scalar(1.0/3.0));
+
+        dim.x = std::max((unsigned int)(L.x/width), 1u);
+        dim.y = std::max((unsigned int)(L.y/width), 1u);
+        dim.z = two_d ? 1 : std::max((unsigned int)(L.z/width), 1u);
+        }
+    m_voxel_dim = dim;
+
+    Index3D voxel_idx(dim.x, dim.y, dim.z);
+    m_voxels.assign(voxel_idx.getNumElements(), voxel_free);
+
+    if (R_min < Scalar(0.0))
+        {
+        // no type interacts with the test particle
+        return;
+        }
+
+    // half of the longest diagonal of a voxel
+    vec3<Scalar> e1 = vec3<Scalar>(box.getLatticeVector(0))/Scalar(dim.x);
+    vec3<Scalar> e2 = vec3<Scalar>(box.getLatticeVector(1))/Scalar(dim.y);
+    vec3<Scalar> e3 = vec3<Scalar>(box.getLatticeVector(2))/Scalar(dim.z);
+    Scalar h = Scalar(0.0);
+    for (int s2 = -1; s2 <= 1; s2 += 2)
+        for (int s3 = -1; s3 <= 1; s3 += 2)
+            {
+            vec3<Scalar> d = e1 + Scalar(s2)*e2 + Scalar(s3)*e3;
+            h = std::max(h, Scalar(0.5)*sqrt(dot(d,d)));
+            }
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    const unsigned int n_particles = m_pdata->getN() + m_pdata->getNGhosts();
+    const unsigned int n_images = image_list.size();
+
+    for (unsigned int j = 0; j < n_particles; ++j)
+        {
+        Scalar4 postype_j = h_postype.data[j];
+        unsigned int typ_j = __scalar_as_int(postype_j.w);
+        if (R_sum[typ_j] < Scalar(0.0))
+            continue;
+
+        const Scalar R_out = R_sum[typ_j] + h;
+        const Scalar r_in = r_sum[typ_j] - h;
+
+        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            {
+            // the test particles see this particle at its position minus the image translation
+            vec3<Scalar> pos_j = vec3<Scalar>(postype_j) - image_list[cur_image];
+            Scalar3 f = box.makeFraction(vec_to_scalar3(pos_j));
+
+            // range of voxels the expanded circumsphere can reach, there is a single layer in 2D
+            int lo[3] = {0, 0, 0};
+            int hi[3] = {0, 0, 0};
+            Scalar fc[3] = {f.x, f.y, f.z};
+            Scalar ext[3] = {R_out/L.x, R_out/L.y, R_out/L.z};
+            unsigned int n[3] = {dim.x, dim.y, dim.z};
+            bool outside = false;
+            for (unsigned int k = 0; k < (two_d ? 2u : 3u); ++k)
+                {
+                lo[k] = std::max((int)floor((fc[k] - ext[k])*n[k]), 0);
+                hi[k] = std::min((int)floor((fc[k] + ext[k])*n[k]), (int)n[k]-1);
+                outside = outside || lo[k] > hi[k];
+                }
+            if (outside)
+                continue;
+
+            for (int vz = lo[2]; vz <= hi[2]; ++vz)
+                for (int vy = lo[1]; vy <= hi[1]; ++vy)
+                    for (int vx = lo[0]; vx <= hi[0]; ++vx)
+                        {
+                        unsigned char& voxel = m_voxels[voxel_idx(vx, vy, vz)];
+                        if (voxel == voxel_occupied)
+                            continue;
+
+                        Scalar3 f_center = make_scalar3((Scalar(vx)+Scalar(0.5))/Scalar(dim.x),
+                                                        (Scalar(vy)+Scalar(0.5))/Scalar(dim.y),
+                                                        (Scalar(vz)+Scalar(0.5))/Scalar(dim.z));
+                        vec3<Scalar> dr = vec3<Scalar>(box.makeCoordinates(f_center)) - pos_j;
+                        Scalar rsq = dot(dr,dr);
+
+                        if (r_in > Scalar(0.0) && rsq < r_in*r_in)
+                            voxel = voxel_occupied;
+                        else if (rsq < R_out*R_out)
+                            voxel = voxel_ambiguous;
+                        }
+            }
+        }
+    }
+
 /*! \param quantity Name of the log quantity to get
     \param timestep Current time step of the simulation
     \return the requested log quantity.
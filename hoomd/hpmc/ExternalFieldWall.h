@@ -10,6 +10,7 @@
 #include "hoomd/Compute.h"
 #include "hoomd/Saru.h"
 #include "hoomd/VectorMath.h"
+#include "hoomd/TriangleMesh.h"
 
 #include "IntegratorHPMCMono.h"
 #include "ExternalField.h"
@@ -117,6 +118,26 @@ struct PlaneWall
     OverlapReal          d;      // ax + by + cz + d =  0
     };
 
+struct MeshWall
+    {
+    MeshWall(std::shared_ptr<TriangleMesh> m, bool ins = true) : mesh(m), scale_factor(1.0), inside(ins), verts(new detail::poly3d_verts(3,false))
+        {
+        verts->N = 3;
+        }
+    MeshWall(const MeshWall& src) : mesh(src.mesh), scale_factor(src.scale_factor), inside(src.inside), verts(new detail::poly3d_verts(*src.verts)) {}
+    // scale all distances associated with the mesh wall by some factor alpha
+    void scale(const OverlapReal& alpha)
+        {
+        // the mesh may be shared with python or other walls and is never modified, queries apply the factor instead
+        scale_factor *= alpha;
+        }
+
+    std::shared_ptr<TriangleMesh>   mesh;   // closed mesh with outward normals, in the units of the initial box
+    Scalar          scale_factor; // scale from mesh coordinates to the current box
+    bool            inside; // true if particles must be inside the mesh
+    std::shared_ptr<detail::poly3d_verts >    verts; // scratch space for the triangle tested against a particle
+    };
+
 template <class WallShape, class ParticleShape>
 DEVICE inline bool test_confined(const WallShape& wall, const ParticleShape& shape, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
     {
@@ -396,6 +417,90 @@ DEVICE inline bool test_confined(const PlaneWall& wall, const ShapeConvexPolyhed
     return accept;
     }
 
+// Mesh Walls and Spheres
+template < >
+inline bool test_confined<MeshWall, ShapeSphere>(const MeshWall& wall, const ShapeSphere& shape, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos(box.minImage(vec_to_scalar3(position - box_origin)));
+
+    // the nearest point in mesh coordinates, the distance is compared in the current box
+    vec3<Scalar> dx, n;
+    wall.mesh->findNearest(shifted_pos / wall.scale_factor, std::numeric_limits<Scalar>::infinity(), dx, n);
+    bool in_mesh = dot(dx, n) >= Scalar(0.0); // the normals point out of the mesh
+    if (in_mesh != wall.inside)
+        return false;
+
+    OverlapReal r = shape.getCircumsphereDiameter()/OverlapReal(2.0);
+    dx *= wall.scale_factor;
+    return dot(dx, dx) > r*r;
+    }
+
+//! Test a convex particle against the triangles of a mesh wall
+/*! The center of the particle must be on the correct side of the mesh. Only the triangles in the bounding box of the
+    circumsphere are tested for overlap, and only when the mesh is closer than the circumsphere radius.
+*/
+template <class ParticleShape>
+inline bool test_confined_mesh(const MeshWall& wall, const ParticleShape& shape, const detail::poly3d_verts& part_verts, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos(box.minImage(vec_to_scalar3(position - box_origin)));
+
+    // query the mesh in its own coordinates and scale the results to the current box
+    const Scalar alpha = wall.scale_factor;
+    vec3<Scalar> mesh_pos = shifted_pos / alpha;
+
+    OverlapReal r = shape.getCircumsphereDiameter()/OverlapReal(2.0);
+    vec3<Scalar> dx, n;
+    wall.mesh->findNearest(mesh_pos, std::numeric_limits<Scalar>::infinity(), dx, n);
+    bool in_mesh = dot(dx, n) >= Scalar(0.0); // the normals point out of the mesh
+    if (in_mesh != wall.inside)
+        return false;
+    dx *= alpha;
+    if (dot(dx, dx) > r*r)
+        return true;
+
+    std::vector<unsigned int> hits;
+    Scalar r_mesh = r / alpha;
+    wall.mesh->query(hits, detail::AABB(mesh_pos - vec3<Scalar>(r_mesh,r_mesh,r_mesh), mesh_pos + vec3<Scalar>(r_mesh,r_mesh,r_mesh)));
+
+    ShapeSpheropolyhedron part_shape(quat<OverlapReal>(shape.orientation), part_verts);
+    for (unsigned int k = 0; k < hits.size(); ++k)
+        {
+        // place the triangle around its centroid so that its circumsphere is tight
+        vec3<Scalar> a, b, c;
+        wall.mesh->getTriangle(hits[k], a, b, c);
+        a *= alpha; b *= alpha; c *= alpha;
+        vec3<Scalar> centroid = (a + b + c)/Scalar(3.0);
+        vec3<Scalar> v[3] = {a - centroid, b - centroid, c - centroid};
+
+        detail::poly3d_verts& tri = *wall.verts;
+        OverlapReal rsq_max(0.0);
+        for (unsigned int i = 0; i < 3; ++i)
+            {
+            tri.x[i] = v[i].x; tri.y[i] = v[i].y; tri.z[i] = v[i].z;
+            rsq_max = std::max(rsq_max, OverlapReal(dot(v[i],v[i])));
+            }
+        tri.diameter = OverlapReal(2.0)*sqrt(rsq_max);
+
+        unsigned int err = 0;
+        ShapeSpheropolyhedron tri_shape(quat<OverlapReal>(), tri);
+        if (test_overlap(vec3<OverlapReal>(shifted_pos - centroid), tri_shape, part_shape, err))
+            return false;
+        }
+    return true;
+    }
+
+// Mesh Walls and Convex Polyhedra
+inline bool test_confined(const MeshWall& wall, const ShapeConvexPolyhedron& shape, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    return test_confined_mesh(wall, shape, shape.verts, position, box_origin, box);
+    }
+
+// Mesh Walls and Convex Spheropolyhedra
+inline bool test_confined(const MeshWall& wall, const ShapeSpheropolyhedron& shape, const vec3<Scalar>& position, const vec3<Scalar>& box_origin, const BoxDim& box)
+    {
+    return test_confined_mesh(wall, shape, shape.verts, position, box_origin, box);
+    }
+
 template< class Shape >
 class ExternalFieldWall : public ExternalFieldMono<Shape>
     {
@@ -447,6 +552,14 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
                     }
                 }
 
+            for(size_t i = 0; i < m_Meshes.size(); i++)
+                {
+                if(!test_confined(m_Meshes[i], shape_new, position_new, origin, box))
+                    {
+                    return INFINITY;
+                    }
+                }
+
             return double(0.0);
             }
 
@@ -502,6 +615,11 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
                 m_Planes[i].scale(alpha);
                 }
 
+            for(size_t i = 0; i < m_Meshes.size(); i++)
+                {
+                m_Meshes[i].scale(alpha);
+                }
+
 
             m_box = newBox;
             }
@@ -647,6 +765,11 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             m_Planes.push_back(wall);
             }
 
+        void AddMeshWall(const MeshWall& wall)
+            {
+            m_Meshes.push_back(wall);
+            }
+
         // is this messy ...
         void RemoveSphereWall(size_t index)
             {
@@ -665,6 +788,11 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
             m_Planes.erase(m_Planes.begin()+index);
             }
 
+        void RemoveMeshWall(size_t index)
+            {
+            m_Meshes.erase(m_Meshes.begin()+index);
+            }
+
         virtual std::vector< std::string > getProvidedLogQuantities()
             {
             std::vector<std::string> m_WallLogQuantities;
@@ -756,6 +884,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
         unsigned int getNumSphereWalls() {return m_Spheres.size(); }
         unsigned int getNumCylinderWalls() {return m_Cylinders.size(); }
         unsigned int getNumPlaneWalls() {return m_Planes.size(); }
+        unsigned int getNumMeshWalls() {return m_Meshes.size(); }
 
         bool hasVolume() { return true; }
 
@@ -806,6 +935,7 @@ class ExternalFieldWall : public ExternalFieldMono<Shape>
         std::vector<SphereWall>     m_Spheres;
         std::vector<CylinderWall>   m_Cylinders;
         std::vector<PlaneWall>      m_Planes;
+        std::vector<MeshWall>       m_Meshes;
         std::vector<std::string>    m_SphereLogQuantities;
         std::vector<std::string>    m_CylinderLogQuantities;
         Scalar                      m_Volume;
@@ -827,15 +957,18 @@ void export_ExternalFieldWall(pybind11::module& m, const std::string& name)
     .def("AddSphereWall", &ExternalFieldWall<Shape>::AddSphereWall)
     .def("AddCylinderWall", &ExternalFieldWall<Shape>::AddCylinderWall)
     .def("AddPlaneWall", &ExternalFieldWall<Shape>::AddPlaneWall)
+    .def("AddMeshWall", &ExternalFieldWall<Shape>::AddMeshWall)
     .def("RemoveSphereWall", &ExternalFieldWall<Shape>::RemoveSphereWall)
     .def("RemoveCylinderWall", &ExternalFieldWall<Shape>::RemoveCylinderWall)
     .def("RemovePlaneWall", &ExternalFieldWall<Shape>::RemovePlaneWall)
+    .def("RemoveMeshWall", &ExternalFieldWall<Shape>::RemoveMeshWall)
     .def("countOverlaps", &ExternalFieldWall<Shape>::countOverlaps)
     .def("setVolume", &ExternalFieldWall<Shape>::setVolume)
     .def("getVolume", &ExternalFieldWall<Shape>::getVolume)
     .def("getNumSphereWalls", &ExternalFieldWall<Shape>::getNumSphereWalls)
     .def("getNumCylinderWalls", &ExternalFieldWall<Shape>::getNumCylinderWalls)
     .def("getNumPlaneWalls", &ExternalFieldWall<Shape>::getNumPlaneWalls)
+    .def("getNumMeshWalls", &ExternalFieldWall<Shape>::getNumMeshWalls)
     .def("GetSphereWallParametersPy", &ExternalFieldWall<Shape>::GetSphereWallParametersPy)
     .def("GetCylinderWallParametersPy", &ExternalFieldWall<Shape>::GetCylinderWallParametersPy)
     .def("GetPlaneWallParametersPy", &ExternalFieldWall<Shape>::GetPlaneWallParametersPy)
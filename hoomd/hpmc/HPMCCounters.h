@@ -32,6 +32,10 @@ struct hpmc_counters_t
     unsigned long long int rotate_reject_count;         //!< Count of rejected rotation moves
     unsigned long long int overlap_checks;              //!< Count of the number of overlap checks
     unsigned int overlap_err_count;                     //!< Count of the number of times overlap checks encounter errors
+    unsigned long long int overlap_insphere_count;      //!< Count of overlap checks resolved by overlapping inspheres
+    unsigned long long int overlap_circumsphere_count;  //!< Count of overlap checks resolved by disjoint circumspheres
+    unsigned long long int overlap_obb_count;           //!< Count of overlap checks resolved by disjoint bounding boxes
+    unsigned long long int overlap_exact_count;         //!< Count of overlap checks that needed the exact shape test
 
     //! Construct a zero set of counters
     hpmc_counters_t()
@@ -42,6 +46,10 @@ struct hpmc_counters_t
         rotate_reject_count = 0;
         overlap_checks = 0;
         overlap_err_count = 0;
+        overlap_insphere_count = 0;
+        overlap_circumsphere_count = 0;
+        overlap_obb_count = 0;
+        overlap_exact_count = 0;
         }
 
     //! Get the translate acceptance
@@ -85,6 +93,10 @@ DEVICE inline hpmc_counters_t operator-(const hpmc_counters_t& a, const hpmc_cou
     result.rotate_reject_count = a.rotate_reject_count - b.rotate_reject_count;
     result.overlap_checks = a.overlap_checks - b.overlap_checks;
     result.overlap_err_count = a.overlap_err_count - b.overlap_err_count;
+    result.overlap_insphere_count = a.overlap_insphere_count - b.overlap_insphere_count;
+    result.overlap_circumsphere_count = a.overlap_circumsphere_count - b.overlap_circumsphere_count;
+    result.overlap_obb_count = a.overlap_obb_count - b.overlap_obb_count;
+    result.overlap_exact_count = a.overlap_exact_count - b.overlap_exact_count;
     return result;
     }
 
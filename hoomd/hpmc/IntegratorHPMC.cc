@@ -303,6 +303,10 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
         MPI_Allreduce(MPI_IN_PLACE, &result.rotate_reject_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         MPI_Allreduce(MPI_IN_PLACE, &result.overlap_checks, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         MPI_Allreduce(MPI_IN_PLACE, &result.overlap_err_count, 1, MPI_UNSIGNED, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &result.overlap_insphere_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &result.overlap_circumsphere_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &result.overlap_obb_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE, &result.overlap_exact_count, 1, MPI_LONG_LONG_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
         }
 #endif
     return result;
@@ -337,6 +341,10 @@ void export_IntegratorHPMC(py::module& m)
     .def_readwrite("rotate_accept_count", &hpmc_counters_t::rotate_accept_count)
     .def_readwrite("rotate_reject_count", &hpmc_counters_t::rotate_reject_count)
     .def_readwrite("overlap_checks", &hpmc_counters_t::overlap_checks)
+    .def_readwrite("overlap_insphere_count", &hpmc_counters_t::overlap_insphere_count)
+    .def_readwrite("overlap_circumsphere_count", &hpmc_counters_t::overlap_circumsphere_count)
+    .def_readwrite("overlap_obb_count", &hpmc_counters_t::overlap_obb_count)
+    .def_readwrite("overlap_exact_count", &hpmc_counters_t::overlap_exact_count)
     .def("getTranslateAcceptance", &hpmc_counters_t::getTranslateAcceptance)
     .def("getRotateAcceptance", &hpmc_counters_t::getRotateAcceptance)
     .def("getNMoves", &hpmc_counters_t::getNMoves)
@@ -14,6 +14,7 @@
 #include "hoomd/CellList.h"
 
 #include "HPMCCounters.h"
+#include "HPMCPrecisionSetup.h"
 #include "ExternalField.h"
 
 #ifndef NVCC
@@ -70,8 +71,212 @@ class PatchEnergy
         return 0;
         }
 
+    //! evaluate the energy of the patch interaction for a batch of pairs that share particle i
+    /*! \param n Number of pairs in the batch
+        \param r_ij Vectors pointing from particle i to each particle j (length \a n)
+        \param type_i Integer type index of particle i
+        \param q_i Orientation quaternion of particle i
+        \param d_i Diameter of particle i
+        \param charge_i Charge of particle i
+        \param type_j Integer type indices of the j particles (length \a n)
+        \param q_j Orientation quaternions of the j particles (length \a n)
+        \param d_j Diameters of the j particles (length \a n)
+        \param charge_j Charges of the j particles (length \a n)
+        \param energy Output array of the \a n pair energies
+
+        The default implementation calls energy() once per pair. Evaluators that can process many pairs at once
+        override this method to avoid the per pair call overhead.
+    */
+    virtual void energy_batch(unsigned int n,
+        const vec3<float> *r_ij,
+        unsigned int type_i,
+        const quat<float>& q_i,
+        float d_i,
+        float charge_i,
+        const unsigned int *type_j,
+        const quat<float> *q_j,
+        const float *d_j,
+        const float *charge_j,
+        float *energy)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            energy[k] = this->energy(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k], q_j[k], d_j[k], charge_j[k]);
+        }
+    };
+
+namespace detail
+{
+
+//! Collects the neighbors of a trial move for a single batched patch energy evaluation
+/*! IntegratorHPMCMono gathers all candidate neighbors within the patch cutoff while it traverses the AABB tree,
+    and evaluates their energies with one call to PatchEnergy::energy_batch() after the traversal. The storage is
+    kept between trial moves so that no memory is allocated in the inner loop.
+*/
+class PatchEnergyBatch
+    {
+    public:
+        //! Remove all pairs from the batch
+        void clear()
+            {
+            m_r_ij.clear();
+            m_type_j.clear();
+            m_q_j.clear();
+            m_d_j.clear();
+            m_charge_j.clear();
+            }
+
+        //! Get the number of pairs in the batch
+        unsigned int size() const
+            {
+            return m_r_ij.size();
+            }
+
+        //! Add a j particle to the batch
+        void push_back(const vec3<float>& r_ij, unsigned int type_j, const quat<float>& q_j, float d_j, float charge_j)
+            {
+            m_r_ij.push_back(r_ij);
+            m_type_j.push_back(type_j);
+            m_q_j.push_back(q_j);
+            m_d_j.push_back(d_j);
+            m_charge_j.push_back(charge_j);
+            }
+
+        //! Evaluate the total energy of all pairs in the batch
+        /*! \param patch The patch energy evaluator
+            \param type_i Integer type index of particle i
+            \param q_i Orientation quaternion of particle i
+            \param d_i Diameter of particle i
+            \param charge_i Charge of particle i
+            \returns Sum of the pair energies
+        */
+        double energy(PatchEnergy& patch, unsigned int type_i, const quat<float>& q_i, float d_i, float charge_i)
+            {
+            unsigned int n = size();
+            if (n == 0)
+                return 0.0;
+
+            m_energy.resize(n);
+            patch.energy_batch(n, &m_r_ij.front(), type_i, q_i, d_i, charge_i, &m_type_j.front(), &m_q_j.front(),
+                               &m_d_j.front(), &m_charge_j.front(), &m_energy.front());
+
+            double sum = 0.0;
+            for (unsigned int k = 0; k < n; k++)
+                sum += m_energy[k];
+            return sum;
+            }
+
+    private:
+        std::vector< vec3<float> > m_r_ij;      //!< Vectors pointing from i to j
+        std::vector< unsigned int > m_type_j;   //!< Types of the j particles
+        std::vector< quat<float> > m_q_j;       //!< Orientations of the j particles
+        std::vector< float > m_d_j;             //!< Diameters of the j particles
+        std::vector< float > m_charge_j;        //!< Charges of the j particles
+        std::vector< float > m_energy;          //!< Output pair energies
     };
 
+//! Remembers the separating axes of particle pairs between trial moves
+/*! In dense systems, the same pairs are tested for overlaps over and over with small displacements. A separating axis
+    found by one check is likely to still separate the pair in the next one, and testing it takes a single support
+    function evaluation instead of a full XenoCollide or separating planes search (see test_overlap_separating_axis()).
+
+    Pairs are identified by their particle tags. The cache is a direct mapped table: each pair hashes to one slot and
+    a newer pair simply evicts the older one. Because every cached axis is verified before it is used, stale or evicted
+    entries only cost performance, never correctness.
+
+    Axes are stored for the pair in ascending tag order. An axis that separates b - a is negated for a - b.
+*/
+class SeparatingAxisCache
+    {
+    public:
+        //! Constructor
+        SeparatingAxisCache()
+            : m_shift(64)
+            { }
+
+        //! Size the cache for a number of particles
+        /*! \param N Number of particles (including ghosts) that may be tested against each other
+            Reserves four slots per particle. The cache is cleared only when it grows.
+        */
+        void resize(unsigned int N)
+            {
+            unsigned int bits = 2;
+            while ((size_t(1) << bits) < size_t(N)*4)
+                bits++;
+
+            if ((size_t(1) << bits) > m_entries.size())
+                {
+                m_entries.assign(size_t(1) << bits, Entry());
+                m_shift = 64 - bits;
+                }
+            }
+
+        //! Remove all entries
+        void clear()
+            {
+            m_entries.assign(m_entries.size(), Entry());
+            }
+
+        //! Get the cached axis of a pair
+        /*! \param tag_a Tag of the first particle
+            \param tag_b Tag of the second particle
+            \returns The separating axis of b - a, or the zero vector if the pair is not cached
+        */
+        vec3<OverlapReal> get(unsigned int tag_a, unsigned int tag_b) const
+            {
+            unsigned long long int key = getKey(tag_a, tag_b);
+            const Entry& e = m_entries[getSlot(key)];
+            if (e.key != key)
+                return vec3<OverlapReal>(0,0,0);
+
+            return (tag_a <= tag_b) ? e.axis : -e.axis;
+            }
+
+        //! Store the axis of a pair
+        /*! \param tag_a Tag of the first particle
+            \param tag_b Tag of the second particle
+            \param axis Separating axis of b - a
+        */
+        void set(unsigned int tag_a, unsigned int tag_b, const vec3<OverlapReal>& axis)
+            {
+            unsigned long long int key = getKey(tag_a, tag_b);
+            Entry& e = m_entries[getSlot(key)];
+            e.key = key;
+            e.axis = (tag_a <= tag_b) ? axis : -axis;
+            }
+
+    private:
+        //! A cached pair
+        struct Entry
+            {
+            //! Construct an empty entry
+            Entry()
+                : key(0xffffffffffffffffULL), axis(0,0,0)
+                { }
+
+            unsigned long long int key;     //!< Tags of the pair, the smaller one in the upper 32 bits
+            vec3<OverlapReal> axis;         //!< Separating axis of the pair
+            };
+
+        std::vector<Entry> m_entries;       //!< The table
+        unsigned int m_shift;               //!< Shift applied to the hash to obtain the slot
+
+        //! Combine two tags into a key that does not depend on their order
+        static unsigned long long int getKey(unsigned int tag_a, unsigned int tag_b)
+            {
+            if (tag_a > tag_b)
+                std::swap(tag_a, tag_b);
+            return ((unsigned long long int)tag_a << 32) | tag_b;
+            }
+
+        //! Get the slot of a key (Fibonacci hashing)
+        size_t getSlot(unsigned long long int key) const
+            {
+            return (key * 0x9e3779b97f4a7c15ULL) >> m_shift;
+            }
+    };
+
+} // end namespace detail
+
 class IntegratorHPMC : public Integrator
     {
     public:
@@ -332,6 +332,56 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
 
+        detail::PatchEnergyBatch m_patch_batch;     //!< Pairs collected for batched patch energy evaluation
+        detail::SeparatingAxisCache m_separating_axes;  //!< Separating axes of recently tested pairs
+
+        //! Test a pair for overlaps in tiers of increasing cost
+        /*! \param r_ij Vector pointing from particle i to j
+            \param shape_i Shape of particle i
+            \param shape_j Shape of particle j
+            \param tag_i Tag of particle i
+            \param tag_j Tag of particle j
+            \param counters Counters that record which tier resolved the check
+            \returns true if the shapes overlap
+
+            1. Overlapping inspheres imply an overlap.
+            2. Disjoint circumspheres imply no overlap.
+            3. Disjoint bounding boxes imply no overlap (only shapes that specialize check_obb_overlap()).
+            4. The exact test_overlap(), which first tries the last separating axis of the pair.
+        */
+        inline bool testOverlap(const vec3<Scalar>& r_ij, const Shape& shape_i, const Shape& shape_j,
+                                unsigned int tag_i, unsigned int tag_j, hpmc_counters_t& counters)
+            {
+            if (check_insphere_overlap(r_ij, shape_i, shape_j))
+                {
+                counters.overlap_insphere_count++;
+                return true;
+                }
+
+            if (!check_circumsphere_overlap(r_ij, shape_i, shape_j))
+                {
+                counters.overlap_circumsphere_count++;
+                return false;
+                }
+
+            if (!check_obb_overlap(r_ij, shape_i, shape_j))
+                {
+                counters.overlap_obb_count++;
+                return false;
+                }
+
+            counters.overlap_exact_count++;
+            if (!Shape::hasSeparatingAxis())
+                return test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count);
+
+            vec3<OverlapReal> axis = m_separating_axes.get(tag_i, tag_j);
+            if (test_overlap_separating_axis(r_ij, shape_i, shape_j, counters.overlap_err_count, axis))
+                return true;
+
+            m_separating_axes.set(tag_i, tag_j, axis);
+            return false;
+            }
+
         //! Set the nominal width appropriate for looped moves
         virtual void updateCellWidth();
 
@@ -527,6 +577,10 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // make room for the separating axes of all pairs of local and ghost particles
+    if (Shape::hasSeparatingAxis())
+        m_separating_axes.resize(m_pdata->getN() + m_pdata->getNGhosts());
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
         {
@@ -535,6 +589,7 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
         ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
         ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
         ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
         //access move sizes
         ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
@@ -602,6 +657,7 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
+            m_patch_batch.clear();
 
             // check for overlaps with neighboring particle's positions (also calculate the new energy)
             // All image boxes (including the primary)
@@ -657,24 +713,16 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
 
                                 counters.overlap_checks++;
                                 if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                    && testOverlap(r_ij, shape_i, shape_j, h_tag.data[i], h_tag.data[j], counters))
                                     {
                                     overlap = true;
                                     break;
                                     }
-                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch) // If there is no overlap and m_patch is not NULL, calculate energy
+                                else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch) // If there is no overlap and m_patch is not NULL, collect the pair
                                     {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               h_diameter.data[i],
-                                                               h_charge.data[i],
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               h_diameter.data[j],
-                                                               h_charge.data[j]
-                                                               );
+                                    // the energy of the new configuration is evaluated in one batch after the search
+                                    m_patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j),
+                                                            h_diameter.data[j], h_charge.data[j]);
                                     }
                                 }
                             }
@@ -696,6 +744,13 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
             // calculate old patch energy only if m_patch not NULL and no overlaps
             if (m_patch && !m_patch_log && !overlap)
                 {
+                // deltaU = U_old - U_new: subtract energy of new configuration
+                patch_field_energy_diff -= m_patch_batch.energy(*m_patch, typ_i,
+                                                                quat<float>(shape_i.orientation),
+                                                                h_diameter.data[i],
+                                                                h_charge.data[i]);
+                m_patch_batch.clear();
+
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
@@ -742,18 +797,10 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                                     // put particles in coordinate system of particle i
                                     vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
                                     unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                    Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
-                                    // deltaU = U_old - U_new: add energy of old configuration
+                                    // collect the pairs of the old configuration
                                     if (dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   h_diameter.data[i],
-                                                                   h_charge.data[i],
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   h_diameter.data[j],
-                                                                   h_charge.data[j]);
+                                        m_patch_batch.push_back(r_ij, typ_j, quat<float>(orientation_j),
+                                                                h_diameter.data[j], h_charge.data[j]);
                                     }
                                 }
                             }
@@ -764,6 +811,12 @@ void IntegratorHPMCMono<Shape>::update(unsigned int timestep)
                             }
                         }  // end loop over AABB nodes
                     } // end loop over images
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                patch_field_energy_diff += m_patch_batch.energy(*m_patch, typ_i,
+                                                                quat<float>(orientation_i),
+                                                                h_diameter.data[i],
+                                                                h_charge.data[i]);
                 } // end if (m_patch)
 
             // Add external energetic contribution
@@ -7,6 +7,8 @@
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/VectorMath.h"
 #include <vector>
+#include <algorithm>
+#include <cfloat>
 #include <stack>
 
 #include "HPMCPrecisionSetup.h"
@@ -294,7 +296,9 @@ inline bool compare_proj(const std::pair<OverlapReal,unsigned int> &lhs, const s
 
     buildNode is the main driver of the smart OBB tree build algorithm. Each call produces a node, given a set of
     OBBs. If there are fewer OBBs than fit in a leaf, a leaf is generated. If there are too many, the total OBB
-    is computed and split on the largest length axis. The total tree is built by recursive splitting.
+    is computed and the OBBs are sorted along its largest length axis. They are split at the position that minimizes
+    the surface area heuristic, the sum over both sides of the number of OBBs times the surface area of the box
+    enclosing them. The total tree is built by recursive splitting.
 
     The obbs and idx lists are passed in by reference. Each node is given a subrange of the list to own (start to
     start + len). When building the node, it partitions it's subrange into two sides (like quick sort).
@@ -366,37 +370,85 @@ inline unsigned int OBBTree::buildNode(OBB *obbs,
         }
     else
         {
-        // the x-axis has largest covariance by construction, so split along that axis
-
-        // Object mean
-        OverlapReal split_proj(0.0);
+        // the x-axis has largest covariance by construction, so sort the OBBs along that axis
+        std::vector< std::pair<OverlapReal, unsigned int> > proj(len);
         for (unsigned int i = 0; i < len; ++i)
             {
-            split_proj += dot(obbs[start+i].center-my_obb.center,my_axes.row0)/len;
+            proj[i] = std::make_pair(dot(obbs[start+i].center-my_obb.center,my_axes.row0), i);
             }
+        std::sort(proj.begin(), proj.end(), compare_proj);
 
-        // split on x direction according to object mean
-        for (unsigned int i = 0; i < start_right; i++)
+        // extents of every OBB's internal coordinates in the frame of this node, in sorted order
+        std::vector< vec3<OverlapReal> > lower(len), upper(len);
+        for (unsigned int k = 0; k < len; ++k)
             {
-            OverlapReal proj = dot(obbs[start+i].center-my_obb.center,my_axes.row0);
-            if (proj < split_proj)
+            unsigned int i = start + proj[k].second;
+            lower[k] = vec3<OverlapReal>(FLT_MAX,FLT_MAX,FLT_MAX);
+            upper[k] = vec3<OverlapReal>(-FLT_MAX,-FLT_MAX,-FLT_MAX);
+
+            for (unsigned int j = 0; j < internal_coordinates[i].size(); ++j)
                 {
-                // if on the left side, everything is happy, just continue on
+                vec3<OverlapReal> v = internal_coordinates[i][j] - my_obb.center;
+                vec3<OverlapReal> x(dot(v,my_axes.row0), dot(v,my_axes.row1), dot(v,my_axes.row2));
+                OverlapReal r = vertex_radii[i][j];
+                lower[k] = vec3<OverlapReal>(std::min(lower[k].x, x.x-r), std::min(lower[k].y, x.y-r),
+                    std::min(lower[k].z, x.z-r));
+                upper[k] = vec3<OverlapReal>(std::max(upper[k].x, x.x+r), std::max(upper[k].y, x.y+r),
+                    std::max(upper[k].z, x.z+r));
                 }
-            else
+            }
+
+        // surface area of the boxes enclosing the last len-k OBBs
+        std::vector<OverlapReal> area_right(len);
+        vec3<OverlapReal> lo = lower[len-1];
+        vec3<OverlapReal> hi = upper[len-1];
+        for (unsigned int k = len; k-- > 0;)
+            {
+            lo = vec3<OverlapReal>(std::min(lo.x,lower[k].x), std::min(lo.y,lower[k].y), std::min(lo.z,lower[k].z));
+            hi = vec3<OverlapReal>(std::max(hi.x,upper[k].x), std::max(hi.y,upper[k].y), std::max(hi.z,upper[k].z));
+            vec3<OverlapReal> e = hi - lo;
+            area_right[k] = e.x*e.y + e.y*e.z + e.z*e.x;
+            }
+
+        // choose the split with the lowest surface area heuristic (SAH) cost, the expected number of
+        // children tested by a query that hits this node
+        OverlapReal min_cost = FLT_MAX;
+        start_right = len/2;
+        lo = lower[0];
+        hi = upper[0];
+        for (unsigned int k = 1; k < len; ++k)
+            {
+            lo = vec3<OverlapReal>(std::min(lo.x,lower[k-1].x), std::min(lo.y,lower[k-1].y), std::min(lo.z,lower[k-1].z));
+            hi = vec3<OverlapReal>(std::max(hi.x,upper[k-1].x), std::max(hi.y,upper[k-1].y), std::max(hi.z,upper[k-1].z));
+            vec3<OverlapReal> e = hi - lo;
+            OverlapReal cost = (e.x*e.y + e.y*e.z + e.z*e.x)*OverlapReal(k) + area_right[k]*OverlapReal(len-k);
+            if (cost < min_cost)
                 {
-                // if on the right side, need to swap the current obb with the one at start_right-1, subtract
-                // one off of start_right to indicate the addition of one to the right side and subtrace 1
-                // from i to look at the current index (new obb). This is quick and easy to write, but will
-                // randomize indices - might need to look into a stable partitioning algorithm!
-                std::swap(obbs[start+i], obbs[start+start_right-1]);
-                std::swap(idx[start+i], idx[start+start_right-1]);
-                std::swap(internal_coordinates[start+i], internal_coordinates[start+start_right-1]);
-                std::swap(vertex_radii[start+i], vertex_radii[start+start_right-1]);
-                start_right--;
-                i--;
+                min_cost = cost;
+                start_right = k;
                 }
             }
+
+        // reorder the OBBs so the left child owns the first start_right of them
+        std::vector<OBB> sorted_obbs(len);
+        std::vector<unsigned int> sorted_idx(len);
+        std::vector<std::vector<vec3<OverlapReal> > > sorted_coordinates(len);
+        std::vector<std::vector<OverlapReal> > sorted_radii(len);
+        for (unsigned int k = 0; k < len; ++k)
+            {
+            unsigned int i = start + proj[k].second;
+            sorted_obbs[k] = obbs[i];
+            sorted_idx[k] = idx[i];
+            sorted_coordinates[k].swap(internal_coordinates[i]);
+            sorted_radii[k].swap(vertex_radii[i]);
+            }
+        for (unsigned int k = 0; k < len; ++k)
+            {
+            obbs[start+k] = sorted_obbs[k];
+            idx[start+k] = sorted_idx[k];
+            internal_coordinates[start+k].swap(sorted_coordinates[k]);
+            vertex_radii[start+k].swap(sorted_radii[k]);
+            }
         }
     // sanity check. The left or right tree may have ended up empty. If so, just borrow one particle from it
     if (start_right == len)
@@ -47,6 +47,7 @@ struct poly2d_verts : param_base
         : N(0),
           diameter(OverlapReal(0)),
           sweep_radius(OverlapReal(0)),
+          insphere_radius(OverlapReal(0)),
           ignore(0)
         {
         for (unsigned int i=0; i < MAX_POLY2D_VERTS; i++)
@@ -68,6 +69,7 @@ struct poly2d_verts : param_base
     unsigned int N;                     //!< Number of vertices
     OverlapReal diameter;               //!< Precomputed diameter
     OverlapReal sweep_radius;           //!< Radius of the sphere sweep (used for spheropolygons)
+    OverlapReal insphere_radius;        //!< Radius of a circle around the origin that is inside the shape
     unsigned int ignore;                //!< Bitwise ignore flag for stats, overlaps. 1 will ignore, 0 will not ignore
                                         //   First bit is ignore overlaps, Second bit is ignore statistics
     } __attribute__((aligned(32)));
@@ -294,8 +296,7 @@ struct ShapeConvexPolygon
     //! Get the in-circle radius
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        return verts.insphere_radius;
         }
 
     //! Return the bounding box of the shape in world coordinates
@@ -326,6 +327,9 @@ struct ShapeConvexPolygon
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel() { return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return true; }
+
     quat<Scalar> orientation;    //!< Orientation of the polygon
 
     const detail::poly2d_verts& verts;     //!< Vertices
@@ -370,6 +374,7 @@ DEVICE inline bool is_outside(const poly2d_verts& verts, const vec2<OverlapReal>
     \param b Second polygon
     \param ab_t Vector pointing from a's center to b's center, rotated by conj(qb) (see description for why)
     \param ab_r quaternion that rotates from *a*'s orientation into *b*'s.
+    \param n_sep Set to the outward normal of the separating edge, in *b*'s frame
     \returns true if any edge in *a* separates shapes *a* and *b*
 
     Shape *a* is at the origin. (in other words, we are solving this in the frame of *a*). Normal vectors can be rotated
@@ -396,7 +401,8 @@ DEVICE inline bool is_outside(const poly2d_verts& verts, const vec2<OverlapReal>
 DEVICE inline bool find_separating_plane(const poly2d_verts& a,
                                          const poly2d_verts& b,
                                          const vec2<OverlapReal>& ab_t,
-                                         const quat<OverlapReal>& ab_r)
+                                         const quat<OverlapReal>& ab_r,
+                                         vec2<OverlapReal>& n_sep)
     {
     bool separating = false;
 
@@ -422,6 +428,7 @@ DEVICE inline bool find_separating_plane(const poly2d_verts& a,
         // is this a separating plane?
         if (is_outside(b, p, n))
             {
+            n_sep = n;
             return true;        // runs faster on the cpu with the early return
             }
 
@@ -439,8 +446,11 @@ DEVICE inline bool find_separating_plane(const poly2d_verts& a,
     \param ab_t Vector pointing from a's center to b's center, in the space frame
     \param qa Orientation of first polygon
     \param qb Orientation of second polygon
+    \param n_sep Set to a separating axis in the space frame when the polygons are disjoint
     \returns true when the two polygons overlap
 
+    The support of the Minkowski difference b - a is negative in the direction \a n_sep.
+
     \pre Polygon vertices are in **counter-clockwise** order
     \pre The shape is convex and contains no internal vertices
 
@@ -450,21 +460,81 @@ DEVICE inline bool test_overlap_separating_planes(const poly2d_verts& a,
                                                   const poly2d_verts& b,
                                                   const vec2<OverlapReal>& ab_t,
                                                   const quat<OverlapReal>& qa,
-                                                  const quat<OverlapReal>& qb)
+                                                  const quat<OverlapReal>& qb,
+                                                  vec2<OverlapReal>& n_sep)
     {
     // construct a quaternion that rotates from a's coordinate system into b's
     quat<OverlapReal> ab_r = conj(qb) * qa;
+    vec2<OverlapReal> n;
 
     // see if we can find a separating plane from a's edges, or from b's edges, or else the shapes overlap
-    if (find_separating_plane(a, b, rotate(conj(qb), ab_t), ab_r))
+    if (find_separating_plane(a, b, rotate(conj(qb), ab_t), ab_r, n))
+        {
+        // b lies outside of an edge of a
+        n_sep = -rotate(qb, n);
         return false;
+        }
 
-    if (find_separating_plane(b, a, rotate(conj(qa), -ab_t), conj(ab_r)))
+    if (find_separating_plane(b, a, rotate(conj(qa), -ab_t), conj(ab_r), n))
+        {
+        // a lies outside of an edge of b
+        n_sep = rotate(qa, n);
         return false;
+        }
 
     return true;
     }
 
+//! Test the overlap of two polygons via separating planes
+/*! \param a First polygon
+    \param b Second polygon
+    \param ab_t Vector pointing from a's center to b's center, in the space frame
+    \param qa Orientation of first polygon
+    \param qb Orientation of second polygon
+    \returns true when the two polygons overlap
+
+    \pre Polygon vertices are in **counter-clockwise** order
+    \pre The shape is convex and contains no internal vertices
+
+    \ingroup overlap
+*/
+DEVICE inline bool test_overlap_separating_planes(const poly2d_verts& a,
+                                                  const poly2d_verts& b,
+                                                  const vec2<OverlapReal>& ab_t,
+                                                  const quat<OverlapReal>& qa,
+                                                  const quat<OverlapReal>& qb)
+    {
+    vec2<OverlapReal> n_sep;
+    return test_overlap_separating_planes(a, b, ab_t, qa, qb, n_sep);
+    }
+
+//! Test if a direction separates two polygons
+/*! \param a First polygon
+    \param b Second polygon
+    \param ab_t Vector pointing from a's center to b's center, in the space frame
+    \param qa Orientation of first polygon
+    \param qb Orientation of second polygon
+    \param n Candidate direction, in the space frame
+    \returns true when the support of the Minkowski difference b - a in direction \a n is negative
+
+    \ingroup overlap
+*/
+DEVICE inline bool is_separating_axis(const poly2d_verts& a,
+                                      const poly2d_verts& b,
+                                      const vec2<OverlapReal>& ab_t,
+                                      const quat<OverlapReal>& qa,
+                                      const quat<OverlapReal>& qb,
+                                      const vec2<OverlapReal>& n)
+    {
+    // support of each polygon, evaluated in its own frame
+    vec2<OverlapReal> na = rotate(conj(qa), n);
+    vec2<OverlapReal> nb = rotate(conj(qb), n);
+    OverlapReal hb = dot(SupportFuncConvexPolygon(b)(nb), nb);
+    OverlapReal ha = dot(SupportFuncConvexPolygon(a)(-na), na);
+
+    return hb + dot(ab_t, n) - ha < OverlapReal(0.0);
+    }
+
 }; // end namespace detail
 
 //! Check if circumspheres overlap
@@ -518,6 +588,44 @@ DEVICE inline bool test_overlap<ShapeConvexPolygon,ShapeConvexPolygon>(const vec
     #endif
     }
 
+//! Convex polygon overlap test with a separating axis
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \param axis in/out: separating axis of the pair in the space frame, or the zero vector if none is known
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    Two support function evaluations along \a axis prove that the polygons are disjoint. Only when \a axis no
+    longer separates them are the edges of both polygons checked, which then provide the new axis.
+
+    \ingroup shape
+*/
+DEVICE inline bool test_overlap_separating_axis(const vec3<Scalar>& r_ab,
+                                                const ShapeConvexPolygon& a,
+                                                const ShapeConvexPolygon& b,
+                                                unsigned int& err,
+                                                vec3<OverlapReal>& axis)
+    {
+    #ifdef NVCC
+    return test_overlap(r_ab, a, b, err);
+    #else
+    vec2<OverlapReal> dr(r_ab.x,r_ab.y);
+    quat<OverlapReal> qa(a.orientation);
+    quat<OverlapReal> qb(b.orientation);
+
+    vec2<OverlapReal> n(axis.x, axis.y);
+    if (dot(n, n) > OverlapReal(0.0) && detail::is_separating_axis(a.verts, b.verts, dr, qa, qb, n))
+        return false;
+
+    if (detail::test_overlap_separating_planes(a.verts, b.verts, dr, qa, qb, n))
+        return true;
+
+    axis = vec3<OverlapReal>(n.x, n.y, 0);
+    return false;
+    #endif
+    }
+
 }; // end namespace hpmc
 
 #endif //__SHAPE_CONVEX_POLYGON_H__
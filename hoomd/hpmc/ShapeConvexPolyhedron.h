@@ -47,13 +47,14 @@ struct poly3d_verts : param_base
         : N(0),
           diameter(OverlapReal(0)),
           sweep_radius(OverlapReal(0)),
+          insphere_radius(OverlapReal(0)),
           ignore(0)
         { }
 
     #ifndef NVCC
     //! Shape constructor
     poly3d_verts(unsigned int _N, bool _managed)
-        : N(_N), diameter(0.0), sweep_radius(0.0), ignore(0)
+        : N(_N), diameter(0.0), sweep_radius(0.0), insphere_radius(0.0), ignore(0)
         {
         unsigned int align_size = 8; //for AVX
         unsigned int N_align =((N + align_size - 1)/align_size)*align_size;
@@ -94,6 +95,7 @@ struct poly3d_verts : param_base
     unsigned int N;                         //!< Number of vertices
     OverlapReal diameter;                   //!< Circumsphere diameter
     OverlapReal sweep_radius;               //!< Radius of the sphere sweep (used for spheropolyhedra)
+    OverlapReal insphere_radius;            //!< Radius of a sphere around the origin that is inside the shape
     unsigned int ignore;                    //!< Bitwise ignore flag for stats, overlaps. 1 will ignore, 0 will not ignore
                                             //   First bit is ignore overlaps, Second bit is ignore statistics
     } __attribute__((aligned(32)));
@@ -333,8 +335,7 @@ struct ShapeConvexPolyhedron
     //! Get the in-sphere radius
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        return verts.insphere_radius;
         }
 
     //! Return the bounding box of the shape in world coordinates
@@ -368,6 +369,9 @@ struct ShapeConvexPolyhedron
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel() { return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return true; }
+
     quat<Scalar> orientation;    //!< Orientation of the polyhedron
 
     const detail::poly3d_verts& verts;     //!< Vertices
@@ -425,6 +429,76 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+//! Convex polyhedron overlap test with a separating axis
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \param axis in/out: separating axis of the pair in the space frame, or the zero vector if none is known
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    A single support function evaluation along \a axis proves that the shapes are disjoint. Only when \a axis no
+    longer separates them is the full XenoCollide check performed, which then provides the new axis.
+
+    \ingroup shape
+*/
+DEVICE inline bool test_overlap_separating_axis(const vec3<Scalar>& r_ab,
+                                                const ShapeConvexPolyhedron& a,
+                                                const ShapeConvexPolyhedron& b,
+                                                unsigned int& err,
+                                                vec3<OverlapReal>& axis)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    quat<OverlapReal> qa(a.orientation);
+    detail::SupportFuncConvexPolyhedron sa(a.verts);
+    detail::SupportFuncConvexPolyhedron sb(b.verts);
+    vec3<OverlapReal> ab_t = rotate(conj(qa), dr);
+    quat<OverlapReal> q = conj(qa) * quat<OverlapReal>(b.orientation);
+
+    // the axis is stored in the space frame, the support functions work in frame A
+    if (dot(axis, axis) > OverlapReal(0.0) && detail::xenocollide_3d_separated(sa, sb, ab_t, q, rotate(conj(qa), axis)))
+        return false;
+
+    vec3<OverlapReal> n_sep;
+    if (detail::xenocollide_3d(sa, sb, ab_t, q, DaDb/2.0, err, n_sep))
+        return true;
+
+    axis = rotate(qa, n_sep);
+    return false;
+    }
+
+//! Convex polyhedron contact scale
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param tol Absolute tolerance of \a lambda
+    \param lambda_max Values of \a lambda above this need not be resolved
+    \param lambda Set to the smallest value for which *a* and *b* overlap when b is at (1 - lambda) * r_ab
+    \returns true if \a lambda was computed
+
+    \ingroup shape
+*/
+DEVICE inline bool find_contact_scale(const vec3<Scalar>& r_ab,
+                                      const ShapeConvexPolyhedron& a,
+                                      const ShapeConvexPolyhedron& b,
+                                      OverlapReal tol,
+                                      OverlapReal lambda_max,
+                                      OverlapReal& lambda)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    quat<OverlapReal> qa(a.orientation);
+
+    return detail::xenocollide_3d_contact_scale(detail::SupportFuncConvexPolyhedron(a.verts),
+                                                detail::SupportFuncConvexPolyhedron(b.verts),
+                                                rotate(conj(qa), dr),
+                                                conj(qa) * quat<OverlapReal>(b.orientation),
+                                                tol,
+                                                lambda_max,
+                                                lambda);
+    }
+
 }; // end namespace hpmc
 
 #endif //__SHAPE_CONVEX_POLYHEDRON_H__
@@ -90,8 +90,8 @@ struct ShapeEllipsoid
     //! Get the in-sphere radius
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        // return the minimum of the 3 axes
+        return detail::min(axes.x, detail::min(axes.y, axes.z));
         }
 
     //! Support function of the shape (in local coordinates), used in getAABB
@@ -133,6 +133,9 @@ struct ShapeEllipsoid
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel() { return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return false; }
+
     quat<Scalar> orientation;    //!< Orientation of the polygon
 
     ell_params axes;     //!< Radii of major axesI
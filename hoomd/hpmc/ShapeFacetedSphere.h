@@ -268,6 +268,9 @@ struct ShapeFacetedSphere
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel() { return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return false; }
+
     /*!
      * Generate the intersections points of polyhedron edges with the sphere
      */
@@ -189,6 +189,9 @@ struct ShapePolyhedron
         #endif
         }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return false; }
+
     quat<Scalar> orientation;    //!< Orientation of the polyhedron
 
     const detail::poly3d_data& data;     //!< Vertices
@@ -434,6 +437,33 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return (rsq*OverlapReal(4.0) <= DaDb * DaDb);
     }
 
+//! Check if the bounding boxes of two polyhedra overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns false if the root OBBs of the face trees are disjoint, which implies that the polyhedra are disjoint
+
+    The root OBB encloses all faces (including the sweep radius) and therefore the whole polyhedron. When it is disjoint,
+    both the tree traversal and the containment test of test_overlap() can be skipped.
+
+    \ingroup shape
+*/
+DEVICE inline bool check_obb_overlap(const vec3<Scalar>& r_ab, const ShapePolyhedron& a,
+    const ShapePolyhedron &b)
+    {
+    if (a.tree.getNumNodes() == 0 || b.tree.getNumNodes() == 0)
+        return true;
+
+    // transform a into the frame of b, as in test_overlap()
+    vec3<OverlapReal> dr_rot(rotate(conj(b.orientation),-r_ab));
+    quat<OverlapReal> q(conj(b.orientation)*a.orientation);
+
+    detail::OBB obb_a = a.tree.getOBB(0);
+    obb_a.affineTransform(q, dr_rot);
+
+    return detail::overlap(obb_a, b.tree.getOBB(0));
+    }
+
 
 // compute shortest distance between two triangles
 // Returns square of shortest distance
@@ -549,6 +579,8 @@ DEVICE inline bool test_narrow_phase_overlap( vec3<OverlapReal> dr,
     unsigned int na = a.tree.getNumParticles(cur_node_a);
     unsigned int nb = b.tree.getNumParticles(cur_node_b);
 
+    quat<OverlapReal> q(conj(quat<OverlapReal>(b.orientation))*quat<OverlapReal>(a.orientation));
+
     for (unsigned int i= 0; i< na; i++)
         {
         unsigned int iface = a.tree.getParticle(cur_node_a, i);
@@ -560,7 +592,8 @@ DEVICE inline bool test_narrow_phase_overlap( vec3<OverlapReal> dr,
 
         float U[3][3];
 
-        quat<OverlapReal> q(conj(quat<OverlapReal>(b.orientation))*quat<OverlapReal>(a.orientation));
+        // bounding box of the triangle of a, in the frame of b
+        float U_lower[3], U_upper[3];
 
         if (nverts_a > 2)
             {
@@ -571,6 +604,12 @@ DEVICE inline bool test_narrow_phase_overlap( vec3<OverlapReal> dr,
                 v = rotate(q,v) + dr;
                 U[ivert][0] = v.x; U[ivert][1] = v.y; U[ivert][2] = v.z;
                 }
+
+            for (unsigned int k = 0; k < 3; ++k)
+                {
+                U_lower[k] = detail::min(U[0][k], detail::min(U[1][k], U[2][k])) - abs_tol;
+                U_upper[k] = detail::max(U[0][k], detail::max(U[1][k], U[2][k])) + abs_tol;
+                }
             }
 
         // loop through faces of cur_node_b
@@ -598,8 +637,16 @@ DEVICE inline bool test_narrow_phase_overlap( vec3<OverlapReal> dr,
                     V[ivert][0] = v.x; V[ivert][1] = v.y; V[ivert][2] = v.z;
                     }
 
+                // the triangles are disjoint if their bounding boxes are, which is cheaper to test
+                bool disjoint = false;
+                for (unsigned int k = 0; k < 3; ++k)
+                    {
+                    disjoint |= detail::min(V[0][k], detail::min(V[1][k], V[2][k])) > U_upper[k];
+                    disjoint |= detail::max(V[0][k], detail::max(V[1][k], V[2][k])) < U_lower[k];
+                    }
+
                 // check collision between triangles
-                if (NoDivTriTriIsect(V[0],V[1],V[2],U[0],U[1],U[2],abs_tol))
+                if (!disjoint && NoDivTriTriIsect(V[0],V[1],V[2],U[0],U[1],U[2],abs_tol))
                     {
                     return true;
                     }
@@ -733,6 +780,45 @@ DEVICE inline bool IntersectRayTriangle(const vec3<OverlapReal>& p, const vec3<O
     return true;
     }
 
+//! Test a ray against a triangle of either orientation
+/*! \param p origin of the ray
+    \param q point on the ray, the ray points from p towards q
+    \param a first vertex of the triangle
+    \param b second vertex of the triangle
+    \param c third vertex of the triangle
+    \returns true if the ray intersects the triangle
+
+    This is equivalent to IntersectRayTriangle(p,q,a,b,c) || IntersectRayTriangle(p,q,c,b,a), but computes
+    the triangle normal only once.
+ */
+DEVICE inline bool IntersectRayTriangleTwoSided(const vec3<OverlapReal>& p, const vec3<OverlapReal>& q,
+     const vec3<OverlapReal>& a, const vec3<OverlapReal>& b, const vec3<OverlapReal>& c)
+    {
+    vec3<OverlapReal> ab = b - a;
+    vec3<OverlapReal> ac = c - a;
+    vec3<OverlapReal> qp = p - q;
+
+    vec3<OverlapReal> n = cross(ab, ac);
+
+    // flip the triangle so that it faces p
+    OverlapReal d = dot(qp, n);
+    OverlapReal sign = (d < OverlapReal(0.0)) ? OverlapReal(-1.0) : OverlapReal(1.0);
+    d *= sign;
+    if (d <= OverlapReal(0.0)) return false;
+
+    vec3<OverlapReal> ap = p - a;
+    OverlapReal t = sign*dot(ap, n);
+    if (t < OverlapReal(0.0)) return false;
+
+    vec3<OverlapReal> e = cross(qp, ap);
+    OverlapReal v = sign*dot(ac, e);
+    if (v < OverlapReal(0.0) || v > d) return false;
+    OverlapReal w = -sign*dot(ab, e);
+    if (w < OverlapReal(0.0) || v + w > d) return false;
+
+    return true;
+    }
+
 #ifndef NVCC
 //! Traverse the bounding volume test tree recursively
 inline bool BVHCollision(const ShapePolyhedron& a, const ShapePolyhedron &b,
@@ -745,43 +831,31 @@ inline bool BVHCollision(const ShapePolyhedron& a, const ShapePolyhedron &b,
 
     if (!overlap(obb_a, obb_b)) return false;
 
-    if (a.tree.isLeaf(cur_node_a))
+    bool leaf_a = a.tree.isLeaf(cur_node_a);
+    bool leaf_b = b.tree.isLeaf(cur_node_b);
+
+    if (leaf_a && leaf_b)
         {
-        if (b.tree.isLeaf(cur_node_b))
-            {
-            return test_narrow_phase_overlap(dr, a, b, cur_node_a, cur_node_b, err, abs_tol);
-            }
-        else
-            {
-            unsigned int left_b = b.tree.getLeftChild(cur_node_b);
-            unsigned int right_b = b.tree.getEscapeIndex(left_b);
+        return test_narrow_phase_overlap(dr, a, b, cur_node_a, cur_node_b, err, abs_tol);
+        }
 
-            return BVHCollision(a, b, cur_node_a, left_b, q, dr, err, abs_tol)
-                || BVHCollision(a, b, cur_node_a, right_b, q, dr, err, abs_tol);
-            }
+    // descend into the larger of the two nodes only, so that every pair of nodes costs a single OBB test
+    // and both trees are refined at the same rate
+    if (leaf_b || (!leaf_a && obb_a.getVolume() >= obb_b.getVolume()))
+        {
+        unsigned int left_a = a.tree.getLeftChild(cur_node_a);
+        unsigned int right_a = a.tree.getEscapeIndex(left_a);
+
+        return BVHCollision(a, b, left_a, cur_node_b, q, dr, err, abs_tol)
+            || BVHCollision(a, b, right_a, cur_node_b, q, dr, err, abs_tol);
         }
     else
         {
-        if (b.tree.isLeaf(cur_node_b))
-            {
-            unsigned int left_a = a.tree.getLeftChild(cur_node_a);
-            unsigned int right_a = a.tree.getEscapeIndex(left_a);
+        unsigned int left_b = b.tree.getLeftChild(cur_node_b);
+        unsigned int right_b = b.tree.getEscapeIndex(left_b);
 
-            return BVHCollision(a, b, left_a, cur_node_b, q, dr, err, abs_tol)
-                || BVHCollision(a, b, right_a, cur_node_b, q, dr, err, abs_tol);
-            }
-        else
-            {
-            unsigned int left_a = a.tree.getLeftChild(cur_node_a);
-            unsigned int right_a = a.tree.getEscapeIndex(left_a);
-            unsigned int left_b = b.tree.getLeftChild(cur_node_b);
-            unsigned int right_b = b.tree.getEscapeIndex(left_b);
-
-            return BVHCollision(a, b, left_a, left_b, q, dr, err, abs_tol)
-                || BVHCollision(a, b, left_a, right_b, q, dr, err, abs_tol)
-                || BVHCollision(a, b, right_a, left_b, q, dr, err, abs_tol)
-                || BVHCollision(a, b, right_a, right_b, q, dr, err, abs_tol);
-            }
+        return BVHCollision(a, b, cur_node_a, left_b, q, dr, err, abs_tol)
+            || BVHCollision(a, b, cur_node_a, right_b, q, dr, err, abs_tol);
         }
     }
 #endif
@@ -979,11 +1053,8 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
                     idx_v = s1.data.face_verts[offs_b + 2];
                     v_b[2] = s1.data.verts[idx_v];
 
-                    OverlapReal u,v,w,t;
-
                     // two-sided triangle test
-                    if (IntersectRayTriangle(p, q, v_b[0], v_b[1], v_b[2],u,v,w,t)
-                     || IntersectRayTriangle(p, q, v_b[2], v_b[1], v_b[0],u,v,w,t))
+                    if (IntersectRayTriangleTwoSided(p, q, v_b[0], v_b[1], v_b[2]))
                         {
                         n_overlap++;
                         }
@@ -23,6 +23,8 @@
 #include <hoomd/extern/pybind/include/pybind11/stl.h>
 
 #include "hoomd/extern/quickhull/QuickHull.hpp"
+
+#include <cfloat>
 #endif
 
 namespace hpmc{
@@ -119,6 +121,133 @@ sph_params make_sph_params(OverlapReal radius, bool ignore_stats, bool orientabl
     return result;
     }
 
+//! Relative tolerance by which insphere radii are reduced to remain conservative under round-off
+const OverlapReal INSPHERE_TOLERANCE = 1e-5;
+
+//! Compute the radius of the largest circle around the origin that is inside a (sphero)polygon
+/*! \param verts Polygon vertices, with N and sweep_radius set
+    \returns The insphere radius
+
+    The polygon may be concave. When the origin is inside the polygon, the radius is the distance to the closest edge
+    plus the sweep radius. Otherwise, only the part of the sweep around the closest edge can contain a circle around
+    the origin.
+*/
+inline OverlapReal compute_poly2d_insphere_radius(const poly2d_verts& verts)
+    {
+    if (verts.N == 0)
+        return OverlapReal(0.0);
+
+    bool inside = false;
+    OverlapReal dsq_min = FLT_MAX;
+    unsigned int prev = verts.N-1;
+    for (unsigned int cur = 0; cur < verts.N; cur++)
+        {
+        vec2<OverlapReal> a(verts.x[prev], verts.y[prev]);
+        vec2<OverlapReal> b(verts.x[cur], verts.y[cur]);
+
+        // closest point of the edge to the origin
+        vec2<OverlapReal> e = b - a;
+        OverlapReal t(0.0);
+        if (dot(e,e) > OverlapReal(0.0))
+            t = detail::min(detail::max(-dot(a,e)/dot(e,e), OverlapReal(0.0)), OverlapReal(1.0));
+        vec2<OverlapReal> c = a + t*e;
+        dsq_min = detail::min(dsq_min, dot(c,c));
+
+        // count crossings of the edge with a ray from the origin along +x
+        if ((a.y > OverlapReal(0.0)) != (b.y > OverlapReal(0.0))
+            && a.x - a.y*(b.x - a.x)/(b.y - a.y) > OverlapReal(0.0))
+            inside = !inside;
+
+        prev = cur;
+        }
+
+    OverlapReal d_min = sqrt(dsq_min);
+    OverlapReal r = inside ? d_min + verts.sweep_radius : detail::max(verts.sweep_radius - d_min, OverlapReal(0.0));
+    return r*(OverlapReal(1.0) - INSPHERE_TOLERANCE);
+    }
+
+//! Compute the radius of the largest sphere around the origin that is inside a convex (sphero)polyhedron
+/*! \param verts Polyhedron vertices, with N, sweep_radius and diameter set
+    \returns The insphere radius
+
+    When the origin is inside the convex hull of the vertices, the radius is the distance to the closest facet of the
+    hull plus the sweep radius. For flat or degenerate vertex sets, or when the origin is outside, only the sweep around
+    the closest vertex is used.
+*/
+inline OverlapReal compute_poly3d_insphere_radius(const poly3d_verts& verts)
+    {
+    if (verts.N == 0)
+        return OverlapReal(0.0);
+
+    // conservative value from the sphere swept around the closest vertex
+    OverlapReal dsq_min = FLT_MAX;
+    for (unsigned int i = 0; i < verts.N; i++)
+        {
+        vec3<OverlapReal> v(verts.x[i], verts.y[i], verts.z[i]);
+        dsq_min = detail::min(dsq_min, dot(v,v));
+        }
+    OverlapReal r_vertex = detail::max(verts.sweep_radius - sqrt(dsq_min), OverlapReal(0.0));
+    r_vertex *= OverlapReal(1.0) - INSPHERE_TOLERANCE;
+
+    if (verts.N < 4)
+        return r_vertex;
+
+    // compute convex hull of vertices
+    typedef quickhull::Vector3<OverlapReal> vec;
+
+    std::vector<vec> qh_pts;
+    for (unsigned int i = 0; i < verts.N; i++)
+        qh_pts.push_back(vec(verts.x[i], verts.y[i], verts.z[i]));
+
+    quickhull::QuickHull<OverlapReal> qh;
+    auto hull = qh.getConvexHull(qh_pts, true, false);
+    auto indexBuffer = hull.getIndexBuffer();
+    auto vertexBuffer = hull.getVertexBuffer();
+
+    if (vertexBuffer.size() == 0 || indexBuffer.size() == 0)
+        return r_vertex;
+
+    // the centroid of the hull vertices is an interior point
+    vec3<OverlapReal> centroid(0,0,0);
+    for (unsigned int i = 0; i < vertexBuffer.size(); ++i)
+        centroid += vec3<OverlapReal>(vertexBuffer[i].x, vertexBuffer[i].y, vertexBuffer[i].z);
+    centroid = centroid / OverlapReal(vertexBuffer.size());
+
+    const OverlapReal tol = INSPHERE_TOLERANCE*verts.diameter;
+    OverlapReal d_min = FLT_MAX;
+    for (unsigned int i = 0; i < indexBuffer.size(); i+=3)
+        {
+        // triangle vertices
+        vec3<OverlapReal> p(vertexBuffer[indexBuffer[i]].x, vertexBuffer[indexBuffer[i]].y, vertexBuffer[indexBuffer[i]].z);
+        vec3<OverlapReal> q(vertexBuffer[indexBuffer[i+1]].x, vertexBuffer[indexBuffer[i+1]].y, vertexBuffer[indexBuffer[i+1]].z);
+        vec3<OverlapReal> r(vertexBuffer[indexBuffer[i+2]].x, vertexBuffer[indexBuffer[i+2]].y, vertexBuffer[indexBuffer[i+2]].z);
+
+        vec3<OverlapReal> n = cross(q-p, r-p);
+        OverlapReal n_len = sqrt(dot(n,n));
+        if (n_len <= tol*tol)
+            continue;
+        n = n / n_len;
+
+        // orient the normal outward, a flat hull has no interior
+        OverlapReal h = dot(n, p - centroid);
+        if (fabs(h) <= tol)
+            return r_vertex;
+        if (h < OverlapReal(0.0))
+            n = -n;
+
+        // distance of the origin to the facet plane, negative when the origin is outside
+        OverlapReal d = dot(n, p);
+        if (d < OverlapReal(0.0))
+            return r_vertex;
+        d_min = detail::min(d_min, d);
+        }
+
+    if (d_min == FLT_MAX)
+        return r_vertex;
+
+    return (d_min + verts.sweep_radius)*(OverlapReal(1.0) - INSPHERE_TOLERANCE);
+    }
+
 //! Helper function to build poly2d_verts from python
 poly2d_verts make_poly2d_verts(pybind11::list verts, OverlapReal sweep_radius, bool ignore_stats)
     {
@@ -148,6 +277,7 @@ poly2d_verts make_poly2d_verts(pybind11::list verts, OverlapReal sweep_radius, b
 
     // set the diameter
     result.diameter = 2*(sqrt(radius_sq)+sweep_radius);
+    result.insphere_radius = compute_poly2d_insphere_radius(result);
 
     return result;
     }
@@ -302,6 +432,7 @@ poly3d_verts make_poly3d_verts(pybind11::list verts, OverlapReal sweep_radius, b
 
     // set the diameter
     result.diameter = 2*(sqrt(radius_sq) + sweep_radius);
+    result.insphere_radius = compute_poly3d_insphere_radius(result);
 
     return result;
     }
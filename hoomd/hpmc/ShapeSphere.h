@@ -187,6 +187,9 @@ struct ShapeSphere
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel() { return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return false; }
+
     quat<Scalar> orientation;    //!< Orientation of the sphere (unused)
 
     const sph_params &params;        //!< Sphere and ignore flags
@@ -207,6 +210,43 @@ DEVICE inline bool check_circumsphere_overlap(const vec3<Scalar>& r_ab, const Sh
     return true;
     }
 
+//! Check if inspheres overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns true if the inspheres of both shapes overlap, which implies that the shapes overlap
+
+    Shapes that do not implement getInsphereRadius() return a radius of zero, and this check never succeeds for them.
+
+    \ingroup shape
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline bool check_insphere_overlap(const vec3<Scalar>& r_ab, const ShapeA& a, const ShapeB& b)
+    {
+    vec3<OverlapReal> dr(r_ab);
+
+    OverlapReal rsq = dot(dr,dr);
+    OverlapReal RaRb = OverlapReal(a.getInsphereRadius()) + OverlapReal(b.getInsphereRadius());
+    return (rsq < RaRb * RaRb);
+    }
+
+//! Check if the bounding boxes of two shapes overlap
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \returns false if the shapes are guaranteed to be disjoint
+
+    The default implementation always returns true. Shapes with a bounding volume hierarchy specialize it to test
+    the oriented bounding boxes at the root of their trees.
+
+    \ingroup shape
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline bool check_obb_overlap(const vec3<Scalar>& r_ab, const ShapeA& a, const ShapeB& b)
+    {
+    return true;
+    }
+
 //! Define the general overlap function
 /*! This is just a convenient spot to put this to make sure it is defined early
     \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
@@ -222,6 +262,51 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab, const ShapeA &a, const
     return true;
     }
 
+//! Define the general overlap function with a separating axis
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err Incremented if there is an error condition. Left unchanged otherwise.
+    \param axis in/out: separating axis of the pair in the space frame, or the zero vector if none is known
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    Shapes that return true from hasSeparatingAxis() first check whether \a axis still separates *a* and *b*, and
+    otherwise fall back to test_overlap(). When the shapes are disjoint, \a axis is set to a direction in which the
+    support of the Minkowski difference b - a is negative. The default implementation ignores \a axis.
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline bool test_overlap_separating_axis(const vec3<Scalar>& r_ab,
+                                                const ShapeA &a,
+                                                const ShapeB& b,
+                                                unsigned int& err,
+                                                vec3<OverlapReal>& axis)
+    {
+    return test_overlap(r_ab, a, b, err);
+    }
+
+//! Find the scale factor of the separation at which two shapes touch
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param tol Absolute tolerance of \a lambda
+    \param lambda_max Values of \a lambda above this need not be resolved
+    \param lambda Set to the smallest value for which *a* and *b* overlap when b is at (1 - lambda) * r_ab
+    \returns true if \a lambda was computed
+
+    A result of zero or less means that the shapes overlap at their current separation. The default implementation
+    returns false, and callers need to bisect with test_overlap() instead.
+*/
+template <class ShapeA, class ShapeB>
+DEVICE inline bool find_contact_scale(const vec3<Scalar>& r_ab,
+                                      const ShapeA& a,
+                                      const ShapeB& b,
+                                      OverlapReal tol,
+                                      OverlapReal lambda_max,
+                                      OverlapReal& lambda)
+    {
+    return false;
+    }
+
 //! Sphere-Sphere overlap
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
@@ -248,6 +333,35 @@ DEVICE inline bool test_overlap<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_
         }
     }
 
+//! Sphere-Sphere contact scale
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param tol Absolute tolerance of \a lambda (unused)
+    \param lambda_max Values of \a lambda above this need not be resolved (unused)
+    \param lambda Set to the smallest value for which *a* and *b* overlap when b is at (1 - lambda) * r_ab
+    \returns true
+
+    \ingroup shape
+*/
+template <>
+DEVICE inline bool find_contact_scale<ShapeSphere, ShapeSphere>(const vec3<Scalar>& r_ab,
+                                                                const ShapeSphere& a,
+                                                                const ShapeSphere& b,
+                                                                OverlapReal tol,
+                                                                OverlapReal lambda_max,
+                                                                OverlapReal& lambda)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal r = fast::sqrt(dot(dr,dr));
+
+    if (r == OverlapReal(0.0))
+        lambda = OverlapReal(-1.0);
+    else
+        lambda = OverlapReal(1.0) - (a.params.radius + b.params.radius) / r;
+    return true;
+    }
+
 }; // end namespace hpmc
 
 #endif //__SHAPE_SPHERE_H__
@@ -117,8 +117,7 @@ struct ShapeSpheropolygon
     //! Get the in-circle radius
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        return verts.insphere_radius;
         }
 
     //! Return the bounding box of the shape in world coordinates
@@ -130,6 +129,9 @@ struct ShapeSpheropolygon
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel() { return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return false; }
+
     quat<Scalar> orientation;    //!< Orientation of the polygon
 
     const detail::poly2d_verts& verts;     //!< Vertices
@@ -125,8 +125,7 @@ struct ShapeSpheropolyhedron
     //! Get the in-sphere radius
     DEVICE OverlapReal getInsphereRadius() const
         {
-        // not implemented
-        return OverlapReal(0.0);
+        return verts.insphere_radius;
         }
 
     //! Return the bounding box of the shape in world coordinates
@@ -159,6 +158,9 @@ struct ShapeSpheropolyhedron
     //! Returns true if this shape splits the overlap check over several threads of a warp using threadIdx.x
     HOSTDEVICE static bool isParallel() { return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return true; }
+
     quat<Scalar> orientation;    //!< Orientation of the polyhedron
 
     const detail::poly3d_verts& verts;     //!< Vertices
@@ -217,6 +219,76 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     */
     }
 
+//! Convex spheropolyhedron overlap test with a separating axis
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \param axis in/out: separating axis of the pair in the space frame, or the zero vector if none is known
+    \returns true when *a* and *b* overlap, and false when they are disjoint
+
+    A single support function evaluation along \a axis proves that the shapes are disjoint. Only when \a axis no
+    longer separates them is the full XenoCollide check performed, which then provides the new axis.
+
+    \ingroup shape
+*/
+DEVICE inline bool test_overlap_separating_axis(const vec3<Scalar>& r_ab,
+                                                const ShapeSpheropolyhedron& a,
+                                                const ShapeSpheropolyhedron& b,
+                                                unsigned int& err,
+                                                vec3<OverlapReal>& axis)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    quat<OverlapReal> qa(a.orientation);
+    detail::SupportFuncSpheropolyhedron sa(a.verts);
+    detail::SupportFuncSpheropolyhedron sb(b.verts);
+    vec3<OverlapReal> ab_t = rotate(conj(qa), dr);
+    quat<OverlapReal> q = conj(qa) * quat<OverlapReal>(b.orientation);
+
+    // the axis is stored in the space frame, the support functions work in frame A
+    if (dot(axis, axis) > OverlapReal(0.0) && xenocollide_3d_separated(sa, sb, ab_t, q, rotate(conj(qa), axis)))
+        return false;
+
+    vec3<OverlapReal> n_sep;
+    if (xenocollide_3d(sa, sb, ab_t, q, DaDb/2.0, err, n_sep))
+        return true;
+
+    axis = rotate(qa, n_sep);
+    return false;
+    }
+
+//! Convex spheropolyhedron contact scale
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param tol Absolute tolerance of \a lambda
+    \param lambda_max Values of \a lambda above this need not be resolved
+    \param lambda Set to the smallest value for which *a* and *b* overlap when b is at (1 - lambda) * r_ab
+    \returns true if \a lambda was computed
+
+    \ingroup shape
+*/
+DEVICE inline bool find_contact_scale(const vec3<Scalar>& r_ab,
+                                      const ShapeSpheropolyhedron& a,
+                                      const ShapeSpheropolyhedron& b,
+                                      OverlapReal tol,
+                                      OverlapReal lambda_max,
+                                      OverlapReal& lambda)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    quat<OverlapReal> qa(a.orientation);
+
+    return detail::xenocollide_3d_contact_scale(detail::SupportFuncSpheropolyhedron(a.verts),
+                                        detail::SupportFuncSpheropolyhedron(b.verts),
+                                        rotate(conj(qa), dr),
+                                        conj(qa) * quat<OverlapReal>(b.orientation),
+                                        tol,
+                                        lambda_max,
+                                        lambda);
+    }
+
 }; // end namespace hpmc
 
 #endif //__SHAPE_SPHEROPOLYHEDRON_H__
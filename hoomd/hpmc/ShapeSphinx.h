@@ -141,6 +141,9 @@ struct ShapeSphinx
     //!Ignore flag for overlaps
     HOSTDEVICE static bool isParallel() {return false; }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return false; }
+
     quat<Scalar> orientation;                   //!< Orientation of the sphinx
 
     unsigned int n;              //!< Number of spheres
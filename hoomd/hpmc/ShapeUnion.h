@@ -169,6 +169,9 @@ struct ShapeUnion
         #endif
         }
 
+    //! Returns true if test_overlap_separating_axis() can reuse a separating axis found by a previous overlap check
+    HOSTDEVICE static bool hasSeparatingAxis() { return false; }
+
     quat<Scalar> orientation;    //!< Orientation of the particle
 
     const param_type& members;     //!< member data
@@ -10,8 +10,9 @@
 #include "hoomd/Updater.h"
 #include "hoomd/Saru.h"
 
-#include <set>
+#include <algorithm>
 #include <list>
+#include <map>
 
 #include "Moves.h"
 #include "HPMCCounters.h"
@@ -27,159 +28,129 @@ namespace hpmc
 namespace detail
 {
 
-// Graph class represents a undirected graph
-// using adjacency list representation
-class Graph
+//! Disjoint set forest to label the connected components of an undirected graph
+/*! Edges may be merged in any order and, with TBB, from any number of threads at once. Every set is represented by
+    its smallest vertex: a merge links the root with the larger index below the other root with a compare-and-swap,
+    and retries if another thread changed that root in the meantime, so no locks are needed (cf. Anderson and Woll,
+    STOC 1991). Finding a root halves the path to it.
+*/
+class UnionFind
     {
     public:
-        Graph() {}      //!< Default constructor
-
-        inline Graph(unsigned int V);   // Constructor
+        UnionFind() {}      //!< Default constructor
 
+        //! Reset to V vertices without edges
         inline void resize(unsigned int V);
 
-        inline void addEdge(unsigned int v, unsigned int w);
+        //! Add an undirected edge
+        inline void merge(unsigned int v, unsigned int w);
 
-        #ifdef ENABLE_TBB
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
-        inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
+        //! Find the representative of the set of a vertex
+        inline unsigned int find(unsigned int v);
+
+        //! Gather the connected components
+        inline void connectedComponents(std::vector<unsigned int>& members, std::vector<unsigned int>& offsets);
 
     private:
-        #ifndef ENABLE_TBB
-        std::multimap<unsigned int,unsigned int> adj;
+        #ifdef ENABLE_TBB
+        std::vector<tbb::atomic<unsigned int> > m_parent; //!< Parent of every vertex, roots are their own parent
         #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
+        std::vector<unsigned int> m_parent;               //!< Parent of every vertex, roots are their own parent
         #endif
+    };
 
-        // don't use a std::vector<bool> here bc it is not thread safe
-        std::vector<unsigned int> visited;
+void UnionFind::resize(unsigned int V)
+    {
+    m_parent.resize(V);
+    for (unsigned int v = 0; v < V; ++v)
+        m_parent[v] = v;
+    }
 
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
+unsigned int UnionFind::find(unsigned int v)
+    {
+    while (true)
+        {
+        unsigned int p = m_parent[v];
+        if (p == v)
+            return v;
 
-        #ifdef ENABLE_TBB
-        class DFSTask : public tbb::task
+        unsigned int gp = m_parent[p];
+        if (gp != p)
             {
-            public:
-                DFSTask(unsigned int _root, std::vector<unsigned int>& _visited, tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    visited[root] = 1;
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
-
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor])
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
+            // path halving, a concurrent merge may only have moved the parent closer to the root
+            #ifdef ENABLE_TBB
+            m_parent[v].compare_and_swap(gp, p);
+            #else
+            m_parent[v] = gp;
+            #endif
+            }
+        v = gp;
+        }
+    }
 
-                        recycle_as_safe_continuation();
-                        }
+void UnionFind::merge(unsigned int v, unsigned int w)
+    {
+    while (true)
+        {
+        v = find(v);
+        w = find(w);
+        if (v == w)
+            return;
 
-                    return NULL;
-                    }
+        // link the larger root below the smaller one
+        if (v < w)
+            std::swap(v, w);
 
-            private:
-                unsigned int root;
-                std::vector<unsigned int> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB
+        #ifdef ENABLE_TBB
+        if (m_parent[v].compare_and_swap(w, v) == v)
+            return;
+        #else
+        m_parent[v] = w;
+        return;
+        #endif
+        }
+    }
 
-    };
+/*! \param members Set to the vertices of all components, in order of increasing vertex index within a component
+    \param offsets Set to the index of the first member of every component in \a members, plus the total size
 
-// Gather connected components in an undirected graph
-#ifdef ENABLE_TBB
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
-void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
+    Components are ordered by their smallest vertex.
+*/
+void UnionFind::connectedComponents(std::vector<unsigned int>& members, std::vector<unsigned int>& offsets)
     {
-    std::fill(visited.begin(), visited.end(), 0);
+    const unsigned int V = m_parent.size();
 
-    #ifdef ENABLE_TBB
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    // number the components in order of their roots, every root precedes the other vertices in its set
+    std::vector<unsigned int> component(V);
+    offsets.clear();
+    for (unsigned int v = 0; v < V; ++v)
         {
-        if (! visited[v])
+        unsigned int root = find(v);
+        if (root == v)
             {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
-        }
-    #else
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
-        {
-        if (visited[v] == false)
-            {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
+            component[v] = offsets.size();
+            offsets.push_back(0);
             }
+        else
+            component[v] = component[root];
+
+        offsets[component[v]]++;
         }
-    #endif
-    }
 
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
-    {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
+    // exclusive prefix sum of the component sizes
+    unsigned int n = 0;
+    for (unsigned int c = 0; c < offsets.size(); ++c)
         {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
+        unsigned int size = offsets[c];
+        offsets[c] = n;
+        n += size;
         }
-    }
-
-Graph::Graph(unsigned int V)
-    {
-    visited.resize(V, 0);
-    }
-
-void Graph::resize(unsigned int V)
-    {
-    visited.resize(V, 0);
-    adj.clear();
-    }
+    offsets.push_back(n);
 
-// method to add an undirected edge
-void Graph::addEdge(unsigned int v, unsigned int w)
-    {
-    adj.insert(std::make_pair(v,w));
-    adj.insert(std::make_pair(w,v));
+    std::vector<unsigned int> fill(offsets.begin(), offsets.end()-1);
+    members.resize(V);
+    for (unsigned int v = 0; v < V; ++v)
+        members[fill[component[v]]++] = v;
     }
 } // end namespace detail
 
@@ -357,13 +328,10 @@ class UpdaterClusters : public Updater
         Scalar m_swap_move_ratio;                   //!< Type swap / geometric move ratio
         Scalar m_flip_probability;                  //!< Cluster flip probability
 
-        #ifdef ENABLE_TBB
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
-        std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
+        std::vector<unsigned int> m_cluster_members;  //!< Particles of all clusters, one cluster after the other
+        std::vector<unsigned int> m_cluster_offsets;  //!< Index of the first particle of every cluster, plus the total
 
-        detail::Graph m_G; //!< The graph
+        detail::UnionFind m_G; //!< Cluster labels of the bond graph
 
         unsigned int m_n_particles_old;                //!< Number of local particles in the old configuration
         detail::AABBTree m_aabb_tree_old;              //!< Locality lookup for old configuration
@@ -375,29 +343,27 @@ class UpdaterClusters : public Updater
 
         std::vector<unsigned int> m_tag_backup;             //!< Old local tags
 
+        // Pairs and rejected particles are appended to flat lists, duplicates are harmless
         #ifndef ENABLE_TBB
         std::vector<std::pair<unsigned int, unsigned int> > m_overlap;   //!< A local vector of particle pairs due to overlap
         std::vector<std::pair<unsigned int, unsigned int> > m_interact_old_old;  //!< Pairs interacting old-old
         std::vector<std::pair<unsigned int, unsigned int> > m_interact_new_old;  //!< Pairs interacting new-old
+        std::vector<std::pair<unsigned int, unsigned int> > m_interact_new_new;  //!< Pairs interacting new-new
+        std::vector<unsigned int> m_local_reject;                //!< Particles whose clusters moves are rejected
 
-        std::set<std::pair<unsigned int, unsigned int> > m_interact_new_new;  //!< Pairs interacting new-old
-        std::set<unsigned int> m_local_reject;                   //!< Set of particles whose clusters moves are rejected
-
-        std::map<std::pair<unsigned int, unsigned int>,float > m_energy_old_old;    //!< Energy of interaction old-old
-        std::map<std::pair<unsigned int, unsigned int>,float > m_energy_new_old;    //!< Energy of interaction old-old
-        std::set<unsigned int> m_ptl_reject;              //!< List of ptls that are not transformed
+        std::vector<std::pair<std::pair<unsigned int, unsigned int>, float> > m_energy_old_old; //!< Energy contributions old-old
+        std::vector<std::pair<std::pair<unsigned int, unsigned int>, float> > m_energy_new_old; //!< Energy contributions new-old
         #else
         tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > m_overlap;
         tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > m_interact_old_old;
         tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > m_interact_new_old;
+        tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > m_interact_new_new;
+        tbb::concurrent_vector<unsigned int> m_local_reject;
 
-        tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > m_interact_new_new;
-        tbb::concurrent_unordered_set<unsigned int> m_local_reject;
-
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float > m_energy_old_old;
-        tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float > m_energy_new_old;
-        tbb::concurrent_unordered_set<unsigned int> m_ptl_reject;              //!< List of ptls that are not transformed
+        tbb::concurrent_vector<std::pair<std::pair<unsigned int, unsigned int>, float> > m_energy_old_old;
+        tbb::concurrent_vector<std::pair<std::pair<unsigned int, unsigned int>, float> > m_energy_new_old;
         #endif
+        std::vector<unsigned int> m_ptl_reject;        //!< Flags of particles that are not transformed, by snapshot index
 
         #ifdef ENABLE_TBB
         tbb::concurrent_vector<vec3<Scalar> > m_random_position;
@@ -419,10 +385,27 @@ class UpdaterClusters : public Updater
             \param pivot The current pivot point
             \param q The current line reflection axis
             \param line True if this is a line reflection
-            \param map Map to lookup new tag from old tag
+            \param map New tag of every old tag
         */
         virtual void findInteractions(unsigned int timestep, vec3<Scalar> pivot, quat<Scalar> q, bool swap,
-            bool line, const std::map<unsigned int, unsigned int>& map);
+            bool line, const std::vector<unsigned int>& map);
+
+        //! Add bonds between all pairs in a list to the cluster graph
+        template<class PairList>
+        void mergePairs(const PairList& pairs)
+            {
+            #ifdef ENABLE_TBB
+            tbb::parallel_for((unsigned int)0, (unsigned int)pairs.size(), [&](unsigned int k)
+            #else
+            for (unsigned int k = 0; k < pairs.size(); ++k)
+            #endif
+                {
+                m_G.merge(pairs[k].first, pairs[k].second);
+                }
+            #ifdef ENABLE_TBB
+                );
+            #endif
+            }
 
         //! Helper function to get interaction range
         virtual Scalar getNominalWidth()
@@ -456,7 +439,7 @@ UpdaterClusters<Shape>::~UpdaterClusters()
 
 template< class Shape >
 void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar> pivot, quat<Scalar> q, bool swap,
-    bool line, const std::map<unsigned int, unsigned int>& map)
+    bool line, const std::vector<unsigned int>& map)
     {
     if (m_prof) m_prof->push(m_exec_conf,"Interactions");
 
@@ -557,30 +540,12 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                 if (rsq_ij <= r_cut_patch*r_cut_patch)
                                     {
                                     // the particle pair
-                                    unsigned int new_tag_i;
-                                        {
-                                        auto it = map.find(m_tag_backup[i]);
-                                        assert(it != map.end());
-                                        new_tag_i = it->second;
-                                        }
-
-                                    unsigned int new_tag_j;
-                                        {
-                                        auto it = map.find(m_tag_backup[j]);
-                                        assert(it!=map.end());
-                                        new_tag_j = it->second;
-                                        }
+                                    unsigned int new_tag_i = map[m_tag_backup[i]];
+                                    unsigned int new_tag_j = map[m_tag_backup[j]];
                                     auto p = std::make_pair(new_tag_i,new_tag_j);
 
-                                    // if particle interacts in different image already, add to that energy
-                                    float U = 0.0;
-                                        {
-                                        auto it_energy = m_energy_old_old.find(p);
-                                        if (it_energy != m_energy_old_old.end())
-                                            U = it_energy->second;
-                                        }
-
-                                    U += patch->energy(r_ij, typ_i,
+                                    // contributions of different images are summed up later
+                                    float U = patch->energy(r_ij, typ_i,
                                                         quat<float>(orientation_i),
                                                         d_i,
                                                         charge_i,
@@ -589,15 +554,14 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                                         m_diameter_backup[j],
                                                         m_charge_backup[j]);
 
-                                    // update map
-                                    m_energy_old_old[p] = U;
+                                    m_energy_old_old.push_back(std::make_pair(p, U));
 
                                     int3 delta_img = -image_hkl[cur_image] + m_image_backup[i] - m_image_backup[j];
                                     if (line && !swap && (delta_img.x || delta_img.y || delta_img.z))
                                         {
                                         // if interaction across PBC, reject cluster move
-                                        m_local_reject.insert(new_tag_i);
-                                        m_local_reject.insert(new_tag_j);
+                                        m_local_reject.push_back(new_tag_i);
+                                        m_local_reject.push_back(new_tag_j);
                                         }
                                     } // end if overlap
 
@@ -661,12 +625,7 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                             // read in its position and orientation
                             unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
 
-                            unsigned int new_tag_j;
-                                {
-                                auto it = map.find(m_tag_backup[j]);
-                                assert(it != map.end());
-                                new_tag_j = it->second;
-                                }
+                            unsigned int new_tag_j = map[m_tag_backup[j]];
 
                             if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
 
@@ -702,8 +661,8 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                     if (reject)
                                         {
                                         // if interaction across PBC, reject cluster move
-                                        m_local_reject.insert(h_tag.data[i]);
-                                        m_local_reject.insert(new_tag_j);
+                                        m_local_reject.push_back(h_tag.data[i]);
+                                        m_local_reject.push_back(new_tag_j);
                                         }
                                     } // end if overlap
                                 }
@@ -746,12 +705,7 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                 // read in its position and orientation
                                 unsigned int j = m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
 
-                                unsigned int new_tag_j;
-                                    {
-                                    auto it = map.find(m_tag_backup[j]);
-                                    assert(it != map.end());
-                                    new_tag_j = it->second;
-                                    }
+                                unsigned int new_tag_j = map[m_tag_backup[j]];
 
                                 if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
 
@@ -768,15 +722,8 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                     {
                                     auto p = std::make_pair(h_tag.data[i], new_tag_j);
 
-                                    // if particle interacts in different image already, add to that energy
-                                    float U = 0.0;
-                                        {
-                                        auto it_energy = m_energy_new_old.find(p);
-                                        if (it_energy != m_energy_new_old.end())
-                                            U = it_energy->second;
-                                        }
-
-                                    U += patch->energy(r_ij, typ_i,
+                                    // contributions of different images are summed up later
+                                    float U = patch->energy(r_ij, typ_i,
                                                             quat<float>(shape_i.orientation),
                                                             h_diameter.data[i],
                                                             h_charge.data[i],
@@ -785,15 +732,14 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                                             m_diameter_backup[j],
                                                             m_charge_backup[j]);
 
-                                    // update map
-                                    m_energy_new_old[p] = U;
+                                    m_energy_new_old.push_back(std::make_pair(p, U));
 
                                     int3 delta_img = -image_hkl[cur_image] + h_image.data[i] - m_image_backup[j];
                                     if (line && !swap && (delta_img.x || delta_img.y || delta_img.z))
                                         {
                                         // if interaction across PBC, reject cluster move
-                                        m_local_reject.insert(h_tag.data[i]);
-                                        m_local_reject.insert(new_tag_j);
+                                        m_local_reject.push_back(h_tag.data[i]);
+                                        m_local_reject.push_back(new_tag_j);
                                         }
                                     }
                                 } // end loop over AABB tree leaf
@@ -888,10 +834,10 @@ void UpdaterClusters<Shape>::findInteractions(unsigned int timestep, vec3<Scalar
                                     if (delta_img.x || delta_img.y || delta_img.z)
                                         {
                                         // add to reject list
-                                        m_local_reject.insert(h_tag.data[i]);
-                                        m_local_reject.insert(h_tag.data[j]);
+                                        m_local_reject.push_back(h_tag.data[i]);
+                                        m_local_reject.push_back(h_tag.data[j]);
 
-                                        m_interact_new_new.insert(std::make_pair(h_tag.data[i],h_tag.data[j]));
+                                        m_interact_new_new.push_back(std::make_pair(h_tag.data[i],h_tag.data[j]));
                                         }
                                     } // end if overlap
 
@@ -1041,7 +987,16 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
 
     // reset origin, so that snapshot positions match AABB tree positions
     m_pdata->resetOrigin();
-    auto map = m_pdata->takeSnapshot(snap);
+    std::map<unsigned int, unsigned int> snap_map = m_pdata->takeSnapshot(snap);
+
+    // flat lookup of the snapshot index of every tag
+    std::vector<unsigned int> map;
+    if (! snap_map.empty())
+        {
+        map.resize(snap_map.rbegin()->first+1, 0);
+        for (auto it = snap_map.begin(); it != snap_map.end(); ++it)
+            map[it->first] = it->second;
+        }
 
     #ifdef ENABLE_MPI
     if (m_comm)
@@ -1066,8 +1021,8 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
         range.z = 0;
         }
 
-    // reset list of rejected particles
-    m_ptl_reject.clear();
+    // reset flags of rejected particles
+    m_ptl_reject.assign(snap.size, 0);
 
     // keep a backup copy
     SnapshotParticleData<Scalar> snap_old = snap;
@@ -1099,7 +1054,7 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
                 // if the particle falls outside the active volume of global_box_nonperiodic, reject
                 if (!isActive(vec_to_scalar3(snap.pos[i]), global_box_nonperiodic, range))
                     {
-                    m_ptl_reject.insert(i);
+                    m_ptl_reject[i] = 1;
                     }
 
                 if (!line)
@@ -1118,7 +1073,7 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
                 // reject if outside active volume of box at new position
                 if (!isActive(vec_to_scalar3(snap.pos[i]), global_box_nonperiodic, range))
                     {
-                    m_ptl_reject.insert(i);
+                    m_ptl_reject[i] = 1;
                     }
 
                 // wrap particle back into box
@@ -1154,20 +1109,20 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
     std::vector< std::vector<std::pair<unsigned int, unsigned int> > > all_overlap;
     std::vector< std::vector<std::pair<unsigned int, unsigned int> > > all_interact_old_old;
     std::vector< std::vector<std::pair<unsigned int, unsigned int> > > all_interact_new_old;
-    std::vector< std::set<std::pair<unsigned int, unsigned int> > > all_interact_new_new;
-    std::vector< std::set<unsigned int> > all_local_reject;
+    std::vector< std::vector<std::pair<unsigned int, unsigned int> > > all_interact_new_new;
+    std::vector< std::vector<unsigned int> > all_local_reject;
 
-    std::vector< std::map<std::pair<unsigned int, unsigned int>, float> > all_energy_old_old;
-    std::vector< std::map<std::pair<unsigned int, unsigned int>, float> > all_energy_new_old;
+    std::vector< std::vector<std::pair<std::pair<unsigned int, unsigned int>, float> > > all_energy_old_old;
+    std::vector< std::vector<std::pair<std::pair<unsigned int, unsigned int>, float> > > all_energy_new_old;
     #else
     std::vector< tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > > all_overlap;
     std::vector< tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > > all_interact_old_old;
     std::vector< tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > > all_interact_new_old;
-    std::vector< tbb::concurrent_unordered_set<std::pair<unsigned int, unsigned int> > > all_interact_new_new;
-    std::vector< tbb::concurrent_unordered_set<unsigned int> > all_local_reject;
+    std::vector< tbb::concurrent_vector<std::pair<unsigned int, unsigned int> > > all_interact_new_new;
+    std::vector< tbb::concurrent_vector<unsigned int> > all_local_reject;
 
-    std::vector< tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>, float> > all_energy_old_old;
-    std::vector< tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>, float> > all_energy_new_old;
+    std::vector< tbb::concurrent_vector<std::pair<std::pair<unsigned int, unsigned int>, float> > > all_energy_old_old;
+    std::vector< tbb::concurrent_vector<std::pair<std::pair<unsigned int, unsigned int>, float> > > all_energy_new_old;
     #endif
 
     #ifdef ENABLE_MPI
@@ -1204,13 +1159,12 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
         if (m_prof)
             m_prof->push("realloc");
 
-        // resize the number of graph nodes in place
+        // reset the cluster labels in place
         m_G.resize(snap.size);
 
         if (m_prof)
             m_prof->pop();
 
-
         #ifdef ENABLE_MPI
         if (m_comm)
             {
@@ -1219,357 +1173,144 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
                 {
                 for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
                     {
-                    m_ptl_reject.insert(*it_j);
-                    }
-                }
-            }
-        #endif
-
-        if (line && !swap)
-            {
-            if (m_prof)
-                m_prof->push("new new");
-
-            #ifdef ENABLE_MPI
-            if (m_comm)
-                {
-                for (auto it_i = all_interact_new_new.begin(); it_i != all_interact_new_new.end(); ++it_i)
-                    {
-                    for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                        {
-                        unsigned int i = it_j->first;
-                        unsigned int j = it_j->second;
-
-                        m_G.addEdge(i, j);
-                        }
-                    }
-                }
-            else
-            #endif
-                {
-                #ifdef ENABLE_TBB
-                tbb::parallel_for(m_interact_new_new.range(), [&] (decltype(m_interact_new_new.range()) r)
-                #else
-                auto &r = m_interact_new_new;
-                #endif
-                    {
-                    for (auto it = r.begin(); it != r.end(); ++it)
-                        {
-                        unsigned int i = it->first;
-                        unsigned int j = it->second;
-
-                        m_G.addEdge(i,j);
-                        }
-                    }
-                #ifdef ENABLE_TBB
-                    );
-                #endif
-                }
-
-            if (m_prof)
-                m_prof->pop();
-            }
-
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            for (auto it_i = all_interact_new_old.begin(); it_i != all_interact_new_old.end(); ++it_i)
-                {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
-
-                    m_G.addEdge(i, j);
+                    m_ptl_reject[*it_j] = 1;
                     }
                 }
             }
         else
         #endif
             {
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(m_interact_new_old.range(), [&] (decltype(m_interact_new_old.range()) r)
-            #else
-            auto &r = m_interact_new_old;
-            #endif
+            // without domain decomposition, only interactions across the boundaries reject cluster moves
+            std::fill(m_ptl_reject.begin(), m_ptl_reject.end(), 0);
+            for (auto it = m_local_reject.begin(); it != m_local_reject.end(); ++it)
                 {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    unsigned int i = it->first;
-                    unsigned int j = it->second;
-
-                    m_G.addEdge(i,j);
-                    }
+                m_ptl_reject[*it] = 1;
                 }
-            #ifdef ENABLE_TBB
-                );
-            #endif
             }
 
-
         if (m_prof)
-            m_prof->push("overlap");
+            m_prof->push("bonds");
 
+        // bonds due to interactions in the new configuration across the boundaries, overlaps of the new with the
+        // old configuration, and hard depletant-excluded volume overlaps (not used in base class)
         #ifdef ENABLE_MPI
         if (m_comm)
             {
-            for (auto it_i = all_overlap.begin(); it_i != all_overlap.end(); ++it_i)
+            for (unsigned int rank = 0; rank < all_overlap.size(); ++rank)
                 {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
-
-                    m_G.addEdge(i,j);
-                    }
+                if (line && !swap)
+                    mergePairs(all_interact_new_new[rank]);
+                mergePairs(all_interact_new_old[rank]);
+                mergePairs(all_overlap[rank]);
+                mergePairs(all_interact_old_old[rank]);
                 }
             }
         else
         #endif
             {
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(m_overlap.range(), [&] (decltype(m_overlap.range()) r)
-            #else
-            auto &r = m_overlap;
-            #endif
-                {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    unsigned int i = it->first;
-                    unsigned int j = it->second;
-
-                    m_G.addEdge(i,j);
-                    }
-                }
-            #ifdef ENABLE_TBB
-                );
-            #endif
+            if (line && !swap)
+                mergePairs(m_interact_new_new);
+            mergePairs(m_interact_new_old);
+            mergePairs(m_overlap);
+            mergePairs(m_interact_old_old);
             }
 
         if (m_prof)
             m_prof->pop();
 
-
-        // interactions due to hard depletant-excluded volume overlaps (not used in base class)
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            for (auto it_i = all_interact_old_old.begin(); it_i != all_interact_old_old.end(); ++it_i)
-                {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
-
-                    m_G.addEdge(i, j);
-                    }
-                }
-            }
-        else
-        #endif
-            {
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(m_interact_old_old.range(), [&] (decltype(m_interact_old_old.range()) r)
-            #else
-            auto &r = m_interact_old_old;
-            #endif
-                {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    unsigned int i = it->first;
-                    unsigned int j = it->second;
-
-                    m_G.addEdge(i,j);
-                    }
-                }
-            #ifdef ENABLE_TBB
-                );
-            #endif
-            }
-
-        #ifdef ENABLE_MPI
-        if (m_comm)
-            {
-            for (auto it_i = all_interact_new_old.begin(); it_i != all_interact_new_old.end(); ++it_i)
-                {
-                for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                    {
-                    unsigned int i = it_j->first;
-                    unsigned int j = it_j->second;
-
-                    m_G.addEdge(i, j);
-                    }
-                }
-            }
-        else
-        #endif
-            {
-            #ifdef ENABLE_TBB
-            tbb::parallel_for(m_interact_new_old.range(), [&] (decltype(m_interact_new_old.range()) r)
-            #else
-            auto &r = m_interact_new_old;
-            #endif
-                {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    unsigned int i = it->first;
-                    unsigned int j = it->second;
-
-                    m_G.addEdge(i,j);
-                    }
-                }
-            #ifdef ENABLE_TBB
-                );
-            #endif
-            }
-
         if (m_mc->getPatchInteraction())
             {
-            // sum up interaction energies
-            #ifdef ENABLE_TBB
-            tbb::concurrent_unordered_map< std::pair<unsigned int, unsigned int>, float> delta_U;
-            #else
-            std::map< std::pair<unsigned int, unsigned int>, float> delta_U;
-            #endif
+            if (m_prof)
+                m_prof->push("patch");
+
+            // collect the energy differences of all pairs, the contributions of all images and ranks are summed below
+            std::vector<std::pair<std::pair<unsigned int, unsigned int>, float> > delta_U;
 
             #ifdef ENABLE_MPI
             if (m_comm)
                 {
                 for (auto it_i = all_energy_old_old.begin(); it_i != all_energy_old_old.end(); ++it_i)
-                    {
                     for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                        {
-                        float delU = -it_j->second;
-                        unsigned int i = it_j->first.first;
-                        unsigned int j = it_j->first.second;
-
-                        auto p = std::make_pair(i,j);
+                        delta_U.push_back(std::make_pair(it_j->first, -it_j->second));
 
-                        // add to energy
-                        auto it = delta_U.find(p);
-                        if (it != delta_U.end())
-                            delU += it->second;
-
-                        // update map with new interaction energy
-                        delta_U[p] = delU;
-                        }
-                    }
+                for (auto it_i = all_energy_new_old.begin(); it_i != all_energy_new_old.end(); ++it_i)
+                    for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
+                        delta_U.push_back(*it_j);
                 }
             else
             #endif
                 {
                 for (auto it = m_energy_old_old.begin(); it != m_energy_old_old.end(); ++it)
-                    {
-                    float delU = -it->second;
-                    unsigned int i = it->first.first;
-                    unsigned int j = it->first.second;
-
-                    auto p = std::make_pair(i,j);
-
-                    // add to energy
-                    auto itj = delta_U.find(p);
-                    if (itj != delta_U.end())
-                        delU += itj->second;
+                    delta_U.push_back(std::make_pair(it->first, -it->second));
 
-                    // update map with new interaction energy
-                    delta_U[p] = delU;
-                    }
+                for (auto it = m_energy_new_old.begin(); it != m_energy_new_old.end(); ++it)
+                    delta_U.push_back(*it);
                 }
 
-            #ifdef ENABLE_MPI
-            if (m_comm)
-                {
-                for (auto it_i = all_energy_new_old.begin(); it_i != all_energy_new_old.end(); ++it_i)
+            // sort by particle pair, and sum up the contributions to every pair in place
+            std::sort(delta_U.begin(), delta_U.end(),
+                [](const std::pair<std::pair<unsigned int, unsigned int>, float>& a,
+                   const std::pair<std::pair<unsigned int, unsigned int>, float>& b)
                     {
-                    for (auto it_j = it_i->begin(); it_j != it_i->end(); ++it_j)
-                        {
-                        float delU = it_j->second;
-                        unsigned int i = it_j->first.first;
-                        unsigned int j = it_j->first.second;
-
-                        // consider each pair uniquely
-                        auto p = std::make_pair(i,j);
+                    return a.first < b.first;
+                    });
 
-                        // add to energy
-                        auto it = delta_U.find(p);
-                        if (it != delta_U.end())
-                            delU += it->second;
-
-                        // update map with new interaction energy
-                        delta_U[p] = delU;
-                        }
-                    }
-                }
-            else
-            #endif
+            unsigned int n_pairs = 0;
+            for (unsigned int k = 0; k < delta_U.size(); ++k)
                 {
-                for (auto it = m_energy_new_old.begin(); it != m_energy_new_old.end(); ++it)
-                    {
-                    float delU = it->second;
-                    unsigned int i = it->first.first;
-                    unsigned int j = it->first.second;
-
-                    auto p = std::make_pair(i,j);
-
-                    // add to energy
-                    auto itj = delta_U.find(p);
-                    if (itj != delta_U.end())
-                        delU += itj->second;
-
-                    // update map with new interaction energy
-                    delta_U[p] = delU;
-                    }
+                if (n_pairs && delta_U[n_pairs-1].first == delta_U[k].first)
+                    delta_U[n_pairs-1].second += delta_U[k].second;
+                else
+                    delta_U[n_pairs++] = delta_U[k];
                 }
+            delta_U.resize(n_pairs);
 
             #ifdef ENABLE_TBB
-            tbb::parallel_for(delta_U.range(), [&] (decltype(delta_U.range()) r)
+            tbb::parallel_for((unsigned int)0, n_pairs, [&](unsigned int k)
             #else
-            auto &r = delta_U;
+            for (unsigned int k = 0; k < n_pairs; ++k)
             #endif
                 {
-                for (auto it = r.begin(); it != r.end(); ++it)
-                    {
-                    float delU = it->second;
-                    unsigned int i = it->first.first;
-                    unsigned int j = it->first.second;
+                float delU = delta_U[k].second;
+                unsigned int i = delta_U[k].first.first;
+                unsigned int j = delta_U[k].first.second;
 
-                    // create a RNG specific to this particle pair
-                    hoomd::detail::Saru rng_ij(timestep+this->m_seed, std::min(i,j), std::max(i,j));
+                // create a RNG specific to this particle pair
+                hoomd::detail::Saru rng_ij(timestep+this->m_seed, std::min(i,j), std::max(i,j));
 
-                    float pij = 1.0f-exp(-delU);
-                    if (rng_ij.f() <= pij) // GCA
-                        {
-                        // add bond
-                        m_G.addEdge(i,j);
-                        }
+                float pij = 1.0f-exp(-delU);
+                if (rng_ij.f() <= pij) // GCA
+                    {
+                    // add bond
+                    m_G.merge(i,j);
                     }
                 }
             #ifdef ENABLE_TBB
                 );
             #endif
+
+            if (m_prof)
+                m_prof->pop();
             } // end if (patch)
 
         if (this->m_prof) this->m_prof->push("connected components");
         // compute connected components
-        m_clusters.clear();
-        m_G.connectedComponents(m_clusters);
+        m_G.connectedComponents(m_cluster_members, m_cluster_offsets);
         if (this->m_prof) this->m_prof->pop();
 
         if (this->m_prof) this->m_prof->push("reject");
         // move every cluster independently
-        for (unsigned int icluster = 0; icluster < m_clusters.size(); icluster++)
+        for (unsigned int icluster = 0; icluster + 1 < m_cluster_offsets.size(); icluster++)
             {
+            // particles in the cluster
+            auto cluster_begin = m_cluster_members.begin() + m_cluster_offsets[icluster];
+            auto cluster_end = m_cluster_members.begin() + m_cluster_offsets[icluster+1];
+
             // if any particle in the cluster is rejected, the cluster is not transformed
             bool reject = false;
-            for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+            for (auto it = cluster_begin; it != cluster_end; ++it)
                 {
-                bool mpi = false;
-                #ifdef ENABLE_MPI
-                mpi = (bool)m_comm;
-                if (mpi && m_ptl_reject.find(*it) != m_ptl_reject.end())
-                    reject = true;
-                #endif
-                if (!mpi && m_local_reject.find(*it) != m_local_reject.end())
+                if (m_ptl_reject[*it])
                     reject = true;
                 }
 
@@ -1581,7 +1322,7 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
                 int n_A_old = 0, n_A_new = 0;
                 int n_B_old = 0, n_B_new = 0;
 
-                for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+                for (auto it = cluster_begin; it != cluster_end; ++it)
                     {
                     unsigned int i = *it;
                     if (snap.type[i] == m_ab_types[0])
@@ -1603,7 +1344,7 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
             if (reject || !flip)
                 {
                 // revert cluster
-                for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+                for (auto it = cluster_begin; it != cluster_end; ++it)
                     {
                     // particle index
                     unsigned int i = *it;
@@ -1632,7 +1373,7 @@ void UpdaterClusters<Shape>::update(unsigned int timestep)
                 }
             else if (flip)
                 {
-                for (auto it = m_clusters[icluster].begin(); it != m_clusters[icluster].end(); ++it)
+                for (auto it = cluster_begin; it != cluster_end; ++it)
                     {
                     // particle index
                     unsigned int i = *it;
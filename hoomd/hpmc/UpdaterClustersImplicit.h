@@ -73,16 +73,16 @@ class UpdaterClustersImplicit : public UpdaterClusters<Shape>
             \param pivot The current pivot point
             \param q The current line reflection axis
             \param line True if this is a line reflection
-            \param map Map to lookup new tag from old tag
+            \param map New tag of every old tag
         */
         virtual void findInteractions(unsigned int timestep, vec3<Scalar> pivot, quat<Scalar> q, bool swap, bool line,
-            const std::map<unsigned int, unsigned int>& map);
+            const std::vector<unsigned int>& map);
 
     };
 
 template< class Shape, class Integrator >
 void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int timestep, vec3<Scalar> pivot,
-    quat<Scalar> q, bool swap, bool line, const std::map<unsigned int, unsigned int>& map)
+    quat<Scalar> q, bool swap, bool line, const std::vector<unsigned int>& map)
     {
     // call base class method
     UpdaterClusters<Shape>::findInteractions(timestep, pivot, q, swap, line, map);
@@ -181,18 +181,8 @@ void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int ti
                                 h_overlaps.data[overlap_idx(typ_j,depletant_type)] &&
                                 rsq_ij <= RaRb*RaRb)
                                 {
-                                unsigned int new_tag_i;
-                                    {
-                                    auto it = map.find(this->m_tag_backup[i]);
-                                    assert(it != map.end());
-                                    new_tag_i = it->second;
-                                    }
-                                unsigned int new_tag_j;
-                                    {
-                                    auto it = map.find(this->m_tag_backup[j]);
-                                    assert(it!=map.end());
-                                    new_tag_j = it->second;
-                                    }
+                                unsigned int new_tag_i = map[this->m_tag_backup[i]];
+                                unsigned int new_tag_j = map[this->m_tag_backup[j]];
 
                                 this->m_interact_old_old.push_back(std::make_pair(new_tag_i,new_tag_j));
 
@@ -200,8 +190,8 @@ void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int ti
                                 if (line && !swap && (delta_img.x || delta_img.y || delta_img.z))
                                     {
                                     // if interaction across PBC, reject cluster move
-                                    this->m_local_reject.insert(new_tag_i);
-                                    this->m_local_reject.insert(new_tag_j);
+                                    this->m_local_reject.push_back(new_tag_i);
+                                    this->m_local_reject.push_back(new_tag_j);
                                     }
                                 } // end if overlap
 
@@ -264,12 +254,7 @@ void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int ti
                             // read in its position and orientation
                             unsigned int j = this->m_aabb_tree_old.getNodeParticle(cur_node_idx, cur_p);
 
-                            unsigned int new_tag_j;
-                                {
-                                auto it = map.find(this->m_tag_backup[j]);
-                                assert(it != map.end());
-                                new_tag_j = it->second;
-                                }
+                            unsigned int new_tag_j = map[this->m_tag_backup[j]];
 
                             if (h_tag.data[i] == new_tag_j && cur_image == 0) continue;
 
@@ -295,8 +280,8 @@ void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int ti
                                 if (line && !swap &&  (delta_img.x || delta_img.y || delta_img.z))
                                     {
                                     // if interaction across PBC, reject cluster move
-                                    this->m_local_reject.insert(h_tag.data[i]);
-                                    this->m_local_reject.insert(new_tag_j);
+                                    this->m_local_reject.push_back(h_tag.data[i]);
+                                    this->m_local_reject.push_back(new_tag_j);
                                     }
                                 }
                             } // end loop over AABB tree leaf
@@ -387,10 +372,10 @@ void UpdaterClustersImplicit<Shape,Integrator>::findInteractions(unsigned int ti
                                     if (delta_img.x || delta_img.y || delta_img.z)
                                         {
                                         // add to list
-                                        this->m_local_reject.insert(h_tag.data[i]);
-                                        this->m_local_reject.insert(h_tag.data[j]);
+                                        this->m_local_reject.push_back(h_tag.data[i]);
+                                        this->m_local_reject.push_back(h_tag.data[j]);
 
-                                        this->m_interact_new_new.insert(std::make_pair(h_tag.data[i],h_tag.data[j]));
+                                        this->m_interact_new_new.push_back(std::make_pair(h_tag.data[i],h_tag.data[j]));
                                         }
                                     } // end if overlap
 
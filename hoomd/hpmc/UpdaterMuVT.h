@@ -21,6 +21,12 @@ namespace hpmc
  * This class implements an Updater for simulations in the grand-canonical ensemble (mu-V-T).
  *
  * Gibbs ensemble integration between two MPI partitions is also supported.
+ *
+ * By default, a single insertion or removal is attempted per update, which requires several collective
+ * operations in MPI simulations. With setBatchSize(), every rank instead attempts a batch of insertions and removals
+ * of its own inside the active region of its domain. The active region excludes a layer of the width of the ghost
+ * layer at the upper domain boundaries, as in the HPMC integrator, so that changes on different ranks never interact.
+ * The changes of all ranks are exchanged with one collective call at the end of the batch.
  */
 template<class Shape>
 class UpdaterMuVT : public Updater
@@ -74,6 +80,22 @@ class UpdaterMuVT : public Updater
             m_transfer_ratio = transfer_ratio;
             }
 
+        //! Set the number of insertions and removals per rank and update (grand canonical ensemble only)
+        /*! \param batch Number of moves attempted on every rank, or 0 to attempt a single move per update
+         */
+        void setBatchSize(unsigned int batch)
+            {
+            if (batch && m_gibbs)
+                {
+                throw std::runtime_error("Batched insertions and removals are not supported in the Gibbs ensemble.\n");
+                }
+            if (batch && !supportsBatch())
+                {
+                throw std::runtime_error("Batched insertions and removals are not supported with depletants.\n");
+                }
+            m_batch = batch;
+            }
+
         //! List of types that are inserted/removed/transfered
         void setTransferTypes(std::vector<unsigned int>& transfer_types)
             {
@@ -152,6 +174,7 @@ class UpdaterMuVT : public Updater
         Scalar m_max_vol_rescale;                             //!< Maximum volume ratio rescaling factor
         Scalar m_move_ratio;                                  //!< Ratio between exchange/transfer and volume moves
         Scalar m_transfer_ratio;                              //!< Ratio between transfer and exchange moves
+        unsigned int m_batch;                                 //!< Number of local moves per rank and update (0 to disable)
 
         unsigned int m_gibbs_other;                           //!< The root-rank of the other partition
 
@@ -167,6 +190,11 @@ class UpdaterMuVT : public Updater
         GPUVector<Scalar> m_charge_backup;           //!< Backup of particle charges for volume move
         GPUVector<Scalar> m_diameter_backup;         //!< Backup of particle diameters for volume move
 
+        std::vector<unsigned int> m_batch_removed;           //!< Flags of local particles removed in the current batch
+        std::vector<unsigned int> m_batch_insert_type;       //!< Types of particles inserted in the current batch
+        std::vector< vec3<Scalar> > m_batch_insert_pos;      //!< Positions of particles inserted in the current batch
+        std::vector< quat<Scalar> > m_batch_insert_orientation; //!< Orientations of particles inserted in the current batch
+
         /*! Check for overlaps of a fictituous particle
          * \param timestep Current time step
          * \param type Type of particle to test
@@ -223,6 +251,33 @@ class UpdaterMuVT : public Updater
         //! Get number of particles of a given type
         unsigned int getNumParticlesType(unsigned int type);
 
+        //! Perform a batch of insertions and removals in the active region of the local domain
+        void updateBatch(unsigned int timestep);
+
+        //! Returns true if the updater supports batched insertions and removals
+        virtual bool supportsBatch() const
+            {
+            return true;
+            }
+
+        /*! Compute the interaction of a particle with its surroundings in the current batch
+         * \param type Type of the particle
+         * \param pos Position of the particle
+         * \param orientation Orientation of the particle
+         * \param diameter Diameter of the particle
+         * \param charge Charge of the particle
+         * \param check_overlaps True if overlaps should be detected
+         * \param skip_idx Local index of the particle itself, or UINT_MAX
+         * \param skip_insert Index of the particle itself among the insertions of the batch, or UINT_MAX
+         * \param energy Patch energy of the particle (return value)
+         * \returns False if the particle overlaps with another one
+         *
+         * Particles removed earlier in the batch are ignored, particles inserted earlier in the batch are included.
+         */
+        bool computeBatchInteraction(unsigned int type, const vec3<Scalar>& pos, const quat<Scalar>& orientation,
+            Scalar diameter, Scalar charge, bool check_overlaps, unsigned int skip_idx, unsigned int skip_insert,
+            Scalar& energy);
+
     private:
         //! Handle MaxParticleNumberChange signal
         /*! Resize the m_pos_backup array
@@ -247,6 +302,7 @@ template < class Shape > void export_UpdaterMuVT(pybind11::module& m, const std:
           .def("setMoveRatio", &UpdaterMuVT<Shape>::setMoveRatio)
           .def("setTransferRatio", &UpdaterMuVT<Shape>::setTransferRatio)
           .def("setTransferTypes", &UpdaterMuVT<Shape>::setTransferTypes)
+          .def("setBatchSize", &UpdaterMuVT<Shape>::setBatchSize)
           ;
     }
 
@@ -262,7 +318,7 @@ UpdaterMuVT<Shape>::UpdaterMuVT(std::shared_ptr<SystemDefinition> sysdef,
     unsigned int seed,
     unsigned int npartition)
     : Updater(sysdef), m_mc(mc), m_seed(seed), m_npartition(npartition), m_gibbs(false),
-      m_max_vol_rescale(0.1), m_move_ratio(0.5), m_transfer_ratio(1.0), m_gibbs_other(0)
+      m_max_vol_rescale(0.1), m_move_ratio(0.5), m_transfer_ratio(1.0), m_batch(0), m_gibbs_other(0)
     {
     // broadcast the seed from rank 0 to all other ranks.
     #ifdef ENABLE_MPI
@@ -494,6 +550,23 @@ void UpdaterMuVT<Shape>::update(unsigned int timestep)
 
     m_exec_conf->msg->notice(10) << "UpdaterMuVT update: " << timestep << std::endl;
 
+    if (m_batch)
+        {
+        // independent insertions and removals on every rank
+        updateBatch(timestep);
+
+        #ifdef ENABLE_MPI
+        if (m_comm)
+            {
+            // We have inserted or removed particles, so update ghosts
+            m_mc->communicate(false);
+            }
+        #endif
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+
     // initialize random number generator
     #ifdef ENABLE_MPI
     unsigned int group = (m_exec_conf->getPartition()/m_npartition);
@@ -1613,6 +1686,468 @@ bool UpdaterMuVT<Shape>::tryInsertParticle(unsigned int timestep, unsigned int t
     return !overlap;
     }
 
+template<class Shape>
+bool UpdaterMuVT<Shape>::computeBatchInteraction(unsigned int type, const vec3<Scalar>& pos,
+    const quat<Scalar>& orientation, Scalar diameter, Scalar charge, bool check_overlaps, unsigned int skip_idx,
+    unsigned int skip_insert, Scalar& energy)
+    {
+    energy = Scalar(0.0);
+
+    // do we have to compute energetic contribution?
+    auto patch = m_mc->getPatchInteraction();
+
+    // if not, removals always succeed
+    if (!check_overlaps && !patch) return true;
+
+    unsigned int nptl_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // update the aabb tree, we cannot rely on a valid AABB tree when there are 0 particles
+    const detail::AABBTree *aabb_tree = nptl_local ? &m_mc->buildAABBTree() : NULL;
+
+    // update the image list
+    const std::vector<vec3<Scalar> >&image_list = m_mc->updateImageList();
+
+    ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(), access_location::host, access_mode::read);
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    const std::vector<typename Shape::param_type, managed_allocator<typename Shape::param_type> > & params = m_mc->getParams();
+
+    Shape shape(orientation, params[type]);
+
+    OverlapReal r_cut_patch(0.0);
+    if (patch) r_cut_patch = patch->getRCut();
+
+    unsigned int err_count = 0;
+
+    OverlapReal R_query = std::max(check_overlaps ? shape.getCircumsphereDiameter()/OverlapReal(2.0) : OverlapReal(0.0),
+        r_cut_patch - m_mc->getMinCoreDiameter()/(OverlapReal)2.0);
+    detail::AABB aabb_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
+
+    const unsigned int n_images = image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_image = pos + image_list[cur_image];
+
+        if (cur_image != 0)
+            {
+            // check for self-overlap with all images except the original
+            vec3<Scalar> r_ij = pos - pos_image;
+            if (check_overlaps && h_overlaps.data[overlap_idx(type, type)]
+                && check_circumsphere_overlap(r_ij, shape, shape)
+                && test_overlap(r_ij, shape, shape, err_count))
+                {
+                return false;
+                }
+
+            // self-energy
+            if (patch && dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch)
+                {
+                energy += patch->energy(r_ij,
+                    type,
+                    quat<float>(orientation),
+                    diameter,
+                    charge,
+                    type,
+                    quat<float>(orientation),
+                    diameter,
+                    charge);
+                }
+            }
+
+        // particles inserted earlier in this batch
+        for (unsigned int k = 0; k < m_batch_insert_type.size(); ++k)
+            {
+            unsigned int typ_j = m_batch_insert_type[k];
+
+            // skip the particle itself and withdrawn insertions
+            if (k == skip_insert || typ_j == UINT_MAX) continue;
+
+            vec3<Scalar> r_ij = m_batch_insert_pos[k] - pos_image;
+            Shape shape_j(m_batch_insert_orientation[k], params[typ_j]);
+
+            if (check_overlaps && h_overlaps.data[overlap_idx(type, typ_j)]
+                && check_circumsphere_overlap(r_ij, shape, shape_j)
+                && test_overlap(r_ij, shape, shape_j, err_count))
+                {
+                return false;
+                }
+            else if (patch && dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch)
+                {
+                energy += patch->energy(r_ij,
+                    type,
+                    quat<float>(orientation),
+                    diameter,
+                    charge,
+                    typ_j,
+                    quat<float>(m_batch_insert_orientation[k]),
+                    1.0, // diameter j
+                    0.0); // charge j
+                }
+            }
+
+        if (! aabb_tree) continue;
+
+        detail::AABB aabb = aabb_local;
+        aabb.translate(pos_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree->getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(aabb_tree->getNodeAABB(cur_node_idx), aabb))
+                {
+                if (aabb_tree->isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0; cur_p < aabb_tree->getNodeNumParticles(cur_node_idx); cur_p++)
+                        {
+                        unsigned int j = aabb_tree->getNodeParticle(cur_node_idx, cur_p);
+
+                        // skip the particle itself and particles removed earlier in this batch
+                        if (j == skip_idx || m_batch_removed[j]) continue;
+
+                        // read in its position and orientation
+                        Scalar4 postype_j = h_postype.data[j];
+                        Scalar4 orientation_j = h_orientation.data[j];
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_image;
+
+                        unsigned int typ_j = __scalar_as_int(postype_j.w);
+                        Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
+
+                        if (check_overlaps && h_overlaps.data[overlap_idx(type, typ_j)]
+                            && check_circumsphere_overlap(r_ij, shape, shape_j)
+                            && test_overlap(r_ij, shape, shape_j, err_count))
+                            {
+                            return false;
+                            }
+                        else if (patch && dot(r_ij,r_ij) <= r_cut_patch*r_cut_patch)
+                            {
+                            energy += patch->energy(r_ij,
+                                type,
+                                quat<float>(orientation),
+                                diameter,
+                                charge,
+                                typ_j,
+                                quat<float>(orientation_j),
+                                h_diameter.data[j],
+                                h_charge.data[j]);
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += aabb_tree->getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        } // end loop over images
+
+    return true;
+    }
+
+/*! Every rank attempts m_batch insertions and removals of the transfer types inside the active region of its domain,
+    using the volume of the active region and the number of particles in it in the acceptance criterion. The active
+    regions of different ranks are separated by at least the ghost layer width, so the moves are independent and the
+    grand-canonical distribution of every region is sampled with the rest of the system held fixed. The random grid
+    shift of the integrator moves the regions between updates.
+
+    Accepted changes are first recorded locally. At the end of the batch, the counters of all ranks are exchanged with
+    MPI_Allgather and the tags of the removed particles with MPI_Allgatherv, and the changes are applied with
+    ParticleData::insertRemoveParticles().
+*/
+template<class Shape>
+void UpdaterMuVT<Shape>::updateBatch(unsigned int timestep)
+    {
+    // every rank draws its own moves
+    hoomd::detail::Saru rng(timestep, this->m_seed, 0x6b1f30a7^m_exec_conf->getRank());
+
+    const BoxDim& box = m_pdata->getBox();
+    uchar3 periodic = box.getPeriodic();
+
+    // compute the width of the inactive region
+    Scalar3 ghost_fraction = make_scalar3(0,0,0);
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        Scalar3 npd = box.getNearestPlaneDistance();
+        ghost_fraction = m_mc->getGhostLayerWidth(0) / npd;
+        }
+    #endif
+
+    // fractional extent and volume of the active region
+    Scalar3 active = make_scalar3(periodic.x ? Scalar(1.0) : std::max(Scalar(0.0), Scalar(1.0) - ghost_fraction.x),
+                                  periodic.y ? Scalar(1.0) : std::max(Scalar(0.0), Scalar(1.0) - ghost_fraction.y),
+                                  periodic.z ? Scalar(1.0) : std::max(Scalar(0.0), Scalar(1.0) - ghost_fraction.z));
+    Scalar V = box.getVolume()*active.x*active.y*active.z;
+
+    unsigned int ntypes = m_pdata->getNTypes();
+    unsigned int N = m_pdata->getN();
+
+    // local indices of the particles in the active region, and indices of the insertions in this batch, per type
+    std::vector< std::vector<unsigned int> > active_idx(ntypes);
+    std::vector< std::vector<unsigned int> > insert_idx(ntypes);
+
+    m_batch_removed.assign(N + m_pdata->getNGhosts(), 0);
+    m_batch_insert_type.clear();
+    m_batch_insert_pos.clear();
+    m_batch_insert_orientation.clear();
+
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < N; ++i)
+            {
+            Scalar4 postype_i = h_postype.data[i];
+            if (isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
+                {
+                active_idx[__scalar_as_int(postype_i.w)].push_back(i);
+                }
+            }
+        }
+
+    const std::vector<typename Shape::param_type, managed_allocator<typename Shape::param_type> > & params = m_mc->getParams();
+
+    std::vector<unsigned int> remove_tags;
+    unsigned int insert_accept = 0;
+    unsigned int insert_reject = 0;
+    unsigned int remove_accept = 0;
+    unsigned int remove_reject = 0;
+
+    assert(m_transfer_types.size() > 0);
+
+    for (unsigned int i_move = 0; i_move < m_batch; ++i_move)
+        {
+        // choose a random particle type out of those being inserted or removed
+        unsigned int type = m_transfer_types[rand_select(rng, m_transfer_types.size()-1)];
+
+        // get fugacity value
+        Scalar fugacity = m_fugacity[type]->getValue(timestep);
+
+        // sanity check
+        if (fugacity <= Scalar(0.0))
+            {
+            m_exec_conf->msg->error() << "Fugacity has to be greater than zero." << std::endl;
+            throw std::runtime_error("Error in UpdaterMuVT");
+            }
+
+        // number of particles of that type in the active region
+        unsigned int nptl_type = active_idx[type].size() + insert_idx[type].size();
+
+        bool insert = rand_select(rng,1);
+
+        if (insert)
+            {
+            // Propose a random position uniformly in the active region
+            Scalar3 f;
+            f.x = rng.template s<Scalar>(Scalar(0.0), active.x);
+            f.y = rng.template s<Scalar>(Scalar(0.0), active.y);
+            f.z = rng.template s<Scalar>(Scalar(0.0), active.z);
+            vec3<Scalar> pos_test = vec3<Scalar>(box.makeCoordinates(f));
+
+            Shape shape_test(quat<Scalar>(), params[type]);
+            if (shape_test.hasOrientation())
+                {
+                // set particle orientation
+                shape_test.orientation = generateRandomOrientation(rng);
+                }
+
+            bool accept = false;
+            Scalar energy(0.0);
+            if (V > Scalar(0.0) && computeBatchInteraction(type, pos_test, shape_test.orientation, 1.0, 0.0, true,
+                UINT_MAX, UINT_MAX, energy))
+                {
+                // acceptance probability
+                Scalar lnboltzmann = log(fugacity*V/(Scalar)(nptl_type+1)) - energy;
+                accept = (rng.template s<Scalar>() < exp(lnboltzmann));
+                }
+
+            if (accept)
+                {
+                insert_idx[type].push_back(m_batch_insert_type.size());
+                m_batch_insert_type.push_back(type);
+                m_batch_insert_pos.push_back(pos_test);
+                m_batch_insert_orientation.push_back(shape_test.orientation);
+                insert_accept++;
+                }
+            else
+                {
+                insert_reject++;
+                }
+            }
+        else
+            {
+            bool accept = false;
+
+            if (nptl_type)
+                {
+                // choose a random particle of that type in the active region
+                unsigned int type_offset = rand_select(rng, nptl_type-1);
+
+                Scalar lnboltzmann = log((Scalar)nptl_type/(fugacity*V));
+                Scalar energy(0.0);
+
+                if (type_offset < active_idx[type].size())
+                    {
+                    // remove a particle that existed before the batch
+                    unsigned int idx = active_idx[type][type_offset];
+
+                    vec3<Scalar> pos;
+                    quat<Scalar> orientation;
+                    Scalar diameter, charge;
+                    unsigned int tag;
+                        {
+                        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+                        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+                        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+                        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+                        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+                        pos = vec3<Scalar>(h_postype.data[idx]);
+                        orientation = quat<Scalar>(h_orientation.data[idx]);
+                        diameter = h_diameter.data[idx];
+                        charge = h_charge.data[idx];
+                        tag = h_tag.data[idx];
+                        }
+
+                    computeBatchInteraction(type, pos, orientation, diameter, charge, false, idx, UINT_MAX, energy);
+                    accept = (rng.template s<Scalar>() < exp(lnboltzmann + energy));
+
+                    if (accept)
+                        {
+                        m_batch_removed[idx] = 1;
+                        remove_tags.push_back(tag);
+                        active_idx[type][type_offset] = active_idx[type].back();
+                        active_idx[type].pop_back();
+                        }
+                    }
+                else
+                    {
+                    // withdraw an insertion of this batch
+                    unsigned int offs = type_offset - active_idx[type].size();
+                    unsigned int k = insert_idx[type][offs];
+
+                    computeBatchInteraction(type, m_batch_insert_pos[k], m_batch_insert_orientation[k], 1.0, 0.0,
+                        false, UINT_MAX, k, energy);
+                    accept = (rng.template s<Scalar>() < exp(lnboltzmann + energy));
+
+                    if (accept)
+                        {
+                        m_batch_insert_type[k] = UINT_MAX;
+                        insert_idx[type][offs] = insert_idx[type].back();
+                        insert_idx[type].pop_back();
+                        }
+                    }
+                }
+
+            if (accept)
+                {
+                remove_accept++;
+                }
+            else
+                {
+                remove_reject++;
+                }
+            }
+        }
+
+    // the insertions that remain at the end of the batch
+    std::vector<unsigned int> insert_types;
+    std::vector<unsigned int> insert_list;
+    for (unsigned int k = 0; k < m_batch_insert_type.size(); ++k)
+        {
+        if (m_batch_insert_type[k] != UINT_MAX)
+            {
+            insert_types.push_back(m_batch_insert_type[k]);
+            insert_list.push_back(k);
+            }
+        }
+
+    std::vector<unsigned int> n_insert(1, insert_types.size());
+    std::vector<unsigned int> all_remove_tags(remove_tags);
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        // exchange the counters of all ranks, then the tags of the removed particles
+        unsigned int nranks = m_exec_conf->getNRanks();
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+
+        unsigned int counters[6];
+        counters[0] = insert_accept;
+        counters[1] = insert_reject;
+        counters[2] = remove_accept;
+        counters[3] = remove_reject;
+        counters[4] = insert_types.size();
+        counters[5] = remove_tags.size();
+
+        std::vector<unsigned int> all_counters(6*nranks);
+        MPI_Allgather(counters, 6, MPI_UNSIGNED, &all_counters.front(), 6, MPI_UNSIGNED, mpi_comm);
+
+        insert_accept = insert_reject = remove_accept = remove_reject = 0;
+        n_insert.resize(nranks);
+        std::vector<int> n_remove(nranks);
+        std::vector<int> remove_offset(nranks);
+        unsigned int n_remove_total = 0;
+
+        for (unsigned int rank = 0; rank < nranks; ++rank)
+            {
+            const unsigned int *c = &all_counters[6*rank];
+            insert_accept += c[0];
+            insert_reject += c[1];
+            remove_accept += c[2];
+            remove_reject += c[3];
+            n_insert[rank] = c[4];
+            n_remove[rank] = c[5];
+            remove_offset[rank] = n_remove_total;
+            n_remove_total += c[5];
+            }
+
+        all_remove_tags.resize(n_remove_total);
+        if (n_remove_total)
+            {
+            MPI_Allgatherv(remove_tags.size() ? &remove_tags.front() : NULL, remove_tags.size(), MPI_UNSIGNED,
+                &all_remove_tags.front(), &n_remove.front(), &remove_offset.front(), MPI_UNSIGNED, mpi_comm);
+            }
+        }
+    #endif
+
+    m_count_total.insert_accept_count += insert_accept;
+    m_count_total.insert_reject_count += insert_reject;
+    m_count_total.remove_accept_count += remove_accept;
+    m_count_total.remove_reject_count += remove_reject;
+
+    // the number of changes is identical on all ranks
+    unsigned int n_insert_total = 0;
+    for (unsigned int rank = 0; rank < n_insert.size(); ++rank)
+        n_insert_total += n_insert[rank];
+
+    if (n_insert_total == 0 && all_remove_tags.size() == 0)
+        return;
+
+    std::vector<unsigned int> tags = m_pdata->insertRemoveParticles(all_remove_tags, n_insert, insert_types);
+
+    // the new particles are inside the local domain
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    for (unsigned int i = 0; i < tags.size(); ++i)
+        {
+        unsigned int idx = h_rtag.data[tags[i]];
+        unsigned int k = insert_list[i];
+        vec3<Scalar> pos = m_batch_insert_pos[k];
+
+        h_postype.data[idx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(insert_types[i]));
+        h_orientation.data[idx] = quat_to_scalar4(m_batch_insert_orientation[k]);
+        h_diameter.data[idx] = Scalar(1.0);
+        }
+    }
+
 template<class Shape>
 bool UpdaterMuVT<Shape>::trySwitchType(unsigned int timestep, unsigned int tag, unsigned int newtype, Scalar &lnboltzmann)
     {
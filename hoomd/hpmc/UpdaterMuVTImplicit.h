@@ -39,6 +39,12 @@ class UpdaterMuVTImplicit : public UpdaterMuVT<Shape>
         std::poisson_distribution<unsigned int> m_poisson;   //!< Poisson distribution
         std::shared_ptr<Integrator > m_mc_implicit;   //!< The associated implicit depletants integrator
 
+        //! Batched moves do not insert depletants
+        virtual bool supportsBatch() const
+            {
+            return false;
+            }
+
         /*! Check for overlaps in the new configuration
          * \param timestep  time step
          * \param type Type of particle to test
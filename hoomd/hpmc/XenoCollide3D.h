@@ -30,42 +30,19 @@ namespace detail
 
 const unsigned int XENOCOLLIDE_3D_MAX_ITERATIONS = 1024;
 
-//! XenoCollide overlap check in 3D
-/*! \tparam SupportFuncA Support function class type for shape A
-    \tparam SupportFuncB Support function class type for shape B
-    \param sa Support function for shape A
+//! XenoCollide overlap check in 3D that also returns a separating axis
+/*! \param sa Support function for shape A
     \param sb Support function for shape B
     \param ab_t Vector pointing from a's center to b's center, in frame A
     \param q Orientation of shape B in frame A
     \param R Approximate radius of Minkowski difference for scaling tolerance value
     \param err_count Error counter to increment whenever an infinite loop is encountered
+    \param n_sep Set to the last support direction (in frame A) when the shapes are disjoint
     \returns true when the two shapes overlap and false when they are disjoint.
 
-    XenoCollide is a generic algorithm for detecting overlaps between two shapes. It operates with the support function
-    of each of the two shapes. To enable generic use of this algorithm on a variety of shapes, those support functions
-    are passed in as templated functors. Each functor might store a reference to data (i.e. polyhedron verts), but the only
-    public interface that XenoCollide will use is to call the operator() on the functor and give it the normal vector
-    n *in the **local** coordinates* of that shape. Local coordinates are used to avoid massive memory usage needed to
-    store a translated copy of each shape.
-
-    The initial implementation is designed primarily for polygons. Shapes with curved surfaces could be used,
-    but they require an additional termination condition that comes with a tolerance. When and if such shapes are
-    needed, we can update this function to optionally implement that tolerance (via another template parameter).
-
-    The parameters of this class closely follow those of test_overlap_separating_planes, since they were found to be a
-    good breakdown of the problem into coordinate systems. Specifically, overlaps are checked in a coordinate system
-    where particle *A* is at the origin, and particle *B* is at position *ab_t*. Particle A has orientation (1,0,0,0)
-    and particle B has orientation *q*.
-
-    The recommended way of using this code is to specify the support functor in the same file as the shape data
-    (e.g. ShapeConvexPolyhedron.h). Then include XenoCollide3D.h and call xenocollide_3d where needed.
-
-    **Normalization**
-    In _Games Programming Gems_, the book normalizes all vectors passed into S. This is unnecessary in some circumstances
-    and we avoid it for performance reasons. Support functions that require the use of normal n vectors should normalize
-    it when needed.
-
-    \ingroup minkowski
+    When the check returns false, \a n_sep is (up to the tolerance checks) a direction in which the support of the
+    Minkowski difference B - A is negative, i.e. a separating axis. It can be tested again with
+    xenocollide_3d_separated() after the shapes moved slightly.
 */
 template<class SupportFuncA, class SupportFuncB>
 DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
@@ -73,7 +50,8 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
                                   const vec3<OverlapReal>& ab_t,
                                   const quat<OverlapReal>& q,
                                   const OverlapReal R,
-                                  unsigned int& err_count)
+                                  unsigned int& err_count,
+                                  vec3<OverlapReal>& n_sep)
     {
     // This implementation of XenoCollide is hand-written from the description of the algorithm on page 171 of _Games
     // Programming Gems 7_
@@ -104,7 +82,10 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
 
     /* if (dot(v1, v1 - v0) <= 0) // by convexity */
     if (dot(v1, v0) > OverlapReal(0.0))
+        {
+        n_sep = -v0;
         return false;   // origin is outside v1 support plane
+        }
 
     // find support v2 perpendicular to v0, v1 plane
     n = cross(v1, v0);
@@ -117,7 +98,10 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
     v2 = S(n); // Convexity should guarantee ||v2|| > 0, but v2 == v1 may be possible in edge cases of {B}-{A}
     // particles do not overlap if origin outside v2 support plane
     if (dot(v2, n) < OverlapReal(0.0))
+        {
+        n_sep = n;
         return false;
+        }
 
     // Find next support direction perpendicular to plane (v1,v0,v2)
     n = cross(v1 - v0, v2 - v0);
@@ -145,7 +129,10 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
         // Get the next support point
         v3 = S(n);
         if (dot(v3, n) <= 0)
+            {
+            n_sep = n;
             return false; // check if origin outside v3 support plane
+            }
 
         // If origin lies on opposite side of a plane from the third support point, use outer-facing plane normal
         // to find a new support point.
@@ -199,6 +186,7 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
         // if (origin outside support plane) return false
         if (dot(v4, n) < OverlapReal(0.0))
             {
+            n_sep = n;
             return false;
             }
 
@@ -211,7 +199,10 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
 
         // First, check if v4 is on plane (v2,v1,v3)
         if (fabs(d) < tol)
+            {
+            n_sep = n;
             return false; // no more refinement possible, but not intersection detected
+            }
 
         // Second, check if origin is on plane (v2,v1,v3) and has been missed by other checks
         d = dot(v1 * tol_multiplier, n);
@@ -278,6 +269,219 @@ DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
 
         }
     }
+
+//! XenoCollide overlap check in 3D
+/*! \tparam SupportFuncA Support function class type for shape A
+    \tparam SupportFuncB Support function class type for shape B
+    \param sa Support function for shape A
+    \param sb Support function for shape B
+    \param ab_t Vector pointing from a's center to b's center, in frame A
+    \param q Orientation of shape B in frame A
+    \param R Approximate radius of Minkowski difference for scaling tolerance value
+    \param err_count Error counter to increment whenever an infinite loop is encountered
+    \returns true when the two shapes overlap and false when they are disjoint.
+
+    XenoCollide is a generic algorithm for detecting overlaps between two shapes. It operates with the support function
+    of each of the two shapes. To enable generic use of this algorithm on a variety of shapes, those support functions
+    are passed in as templated functors. Each functor might store a reference to data (i.e. polyhedron verts), but the only
+    public interface that XenoCollide will use is to call the operator() on the functor and give it the normal vector
+    n *in the **local** coordinates* of that shape. Local coordinates are used to avoid massive memory usage needed to
+    store a translated copy of each shape.
+
+    The initial implementation is designed primarily for polygons. Shapes with curved surfaces could be used,
+    but they require an additional termination condition that comes with a tolerance. When and if such shapes are
+    needed, we can update this function to optionally implement that tolerance (via another template parameter).
+
+    The parameters of this class closely follow those of test_overlap_separating_planes, since they were found to be a
+    good breakdown of the problem into coordinate systems. Specifically, overlaps are checked in a coordinate system
+    where particle *A* is at the origin, and particle *B* is at position *ab_t*. Particle A has orientation (1,0,0,0)
+    and particle B has orientation *q*.
+
+    The recommended way of using this code is to specify the support functor in the same file as the shape data
+    (e.g. ShapeConvexPolyhedron.h). Then include XenoCollide3D.h and call xenocollide_3d where needed.
+
+    **Normalization**
+    In _Games Programming Gems_, the book normalizes all vectors passed into S. This is unnecessary in some circumstances
+    and we avoid it for performance reasons. Support functions that require the use of normal n vectors should normalize
+    it when needed.
+
+    \ingroup minkowski
+*/
+template<class SupportFuncA, class SupportFuncB>
+DEVICE inline bool xenocollide_3d(const SupportFuncA& sa,
+                                  const SupportFuncB& sb,
+                                  const vec3<OverlapReal>& ab_t,
+                                  const quat<OverlapReal>& q,
+                                  const OverlapReal R,
+                                  unsigned int& err_count)
+    {
+    vec3<OverlapReal> n_sep;
+    return xenocollide_3d(sa, sb, ab_t, q, R, err_count, n_sep);
+    }
+
+//! Test if a direction separates two shapes
+/*! \param sa Support function for shape A
+    \param sb Support function for shape B
+    \param ab_t Vector pointing from a's center to b's center, in frame A
+    \param q Orientation of shape B in frame A
+    \param n Candidate direction (in frame A)
+    \returns true when the support of the Minkowski difference B - A in direction \a n is negative
+
+    A single evaluation of the composite support function proves that the shapes are disjoint when it succeeds. It
+    is used to retest the separating axis found by a previous call to xenocollide_3d().
+*/
+template<class SupportFuncA, class SupportFuncB>
+DEVICE inline bool xenocollide_3d_separated(const SupportFuncA& sa,
+                                            const SupportFuncB& sb,
+                                            const vec3<OverlapReal>& ab_t,
+                                            const quat<OverlapReal>& q,
+                                            const vec3<OverlapReal>& n)
+    {
+    CompositeSupportFunc3D<SupportFuncA, SupportFuncB> S(sa, sb, ab_t, q);
+    return dot(S(n), n) < OverlapReal(0.0);
+    }
+
+//! Find the scale factor of the separation at which two shapes touch
+/*! \param sa Support function for shape A
+    \param sb Support function for shape B
+    \param ab_t Vector pointing from a's center to b's center, in frame A
+    \param q Orientation of shape B in frame A
+    \param tol Absolute tolerance of \a lambda
+    \param lambda_max Values of \a lambda above this need not be resolved
+    \param lambda Set to the smallest value for which the shapes overlap when b is at (1 - lambda) * ab_t
+    \returns false if the portal refinement did not converge
+
+    The points (1 - lambda) * ab_t lie on the ray from the interior point ab_t of the Minkowski difference B - A
+    through the origin. The portals of XenoCollide are found and refined in the same way along this ray, but the
+    refinement continues past the origin until the ray is bracketed between the plane of the portal and the support
+    plane parallel to it to within \a tol. Refinement stops early when the support planes alone show that the
+    result exceeds \a lambda_max. A result of zero or less means that the shapes overlap at their current
+    separation. When limited precision leaves the bounds inconsistent, the function gives up and returns false.
+
+    \ingroup minkowski
+*/
+template<class SupportFuncA, class SupportFuncB>
+DEVICE inline bool xenocollide_3d_contact_scale(const SupportFuncA& sa,
+                                                const SupportFuncB& sb,
+                                                const vec3<OverlapReal>& ab_t,
+                                                const quat<OverlapReal>& q,
+                                                const OverlapReal tol,
+                                                const OverlapReal lambda_max,
+                                                OverlapReal& lambda)
+    {
+    vec3<OverlapReal> v0, v1, v2, v3, v4, n;
+    CompositeSupportFunc3D<SupportFuncA, SupportFuncB> S(sa, sb, ab_t, q);
+    const OverlapReal precision_tol = 1e-7;        // precision tolerance for single-precision floats near 1.0
+    const OverlapReal root_tol = 3e-4;   // square root of precision tolerance
+
+    if (fabs(ab_t.x) < root_tol && fabs(ab_t.y) < root_tol && fabs(ab_t.z) < root_tol)
+        {
+        // Interior point is at origin => no scaling separates the particles
+        lambda = OverlapReal(-1.0);
+        return true;
+        }
+
+    // Phase 1: Portal Discovery
+    v0 = ab_t;
+    v1 = S(-v0);
+
+    // if v1 is on the ray, it is the point where the ray leaves B - A
+    n = cross(v1, v0);
+    if (fabs(n.x) < precision_tol && fabs(n.y) < precision_tol && fabs(n.z) < precision_tol)
+        {
+        lambda = dot(v1, v0) / dot(v0, v0);
+        return true;
+        }
+
+    v2 = S(n);
+    n = cross(v1 - v0, v2 - v0);
+    if (dot(n, v0) > OverlapReal(0.0))
+        {
+        v1.swap(v2);
+        n = -n;
+        }
+
+    unsigned int count = 0;
+    while (true)
+        {
+        count++;
+        if (count >= XENOCOLLIDE_3D_MAX_ITERATIONS || dot(n, n) == OverlapReal(0.0))
+            return false;
+
+        v3 = S(n);
+
+        // replace a vertex of the candidate portal until the ray passes through it
+        if (dot(cross(v1, v3), v0) < OverlapReal(0.0))
+            {
+            v2 = v3;
+            n = cross(v1 - v0, v2 - v0);
+            continue;
+            }
+        if (dot(cross(v3, v2), v0) < OverlapReal(0.0))
+            {
+            v1 = v3;
+            n = cross(v1 - v0, v2 - v0);
+            continue;
+            }
+        break;
+        }
+
+    // Phase 2: Portal Refinement
+    // every support plane bounds the result from below, the portal planes bound it from above
+    OverlapReal lambda_lower = OverlapReal(-1.0);
+    count = 0;
+    while (true)
+        {
+        count++;
+
+        // outer-facing normal of the portal, the ray enters the portal plane from behind
+        n = cross(v2 - v1, v3 - v1);
+        OverlapReal d0 = dot(v0, n);
+        if (count >= XENOCOLLIDE_3D_MAX_ITERATIONS || !(d0 < OverlapReal(0.0)))
+            return false;
+
+        v4 = S(n);
+        OverlapReal lambda_portal = dot(v1, n) / d0;
+        OverlapReal lambda_support = dot(v4, n) / d0;
+        if (lambda_support > lambda_lower)
+            lambda_lower = lambda_support;
+
+        if (lambda_portal <= OverlapReal(0.0))
+            {
+            // the origin is inside the portal, the shapes overlap
+            lambda = lambda_portal;
+            return true;
+            }
+
+        // with limited precision, the ray can miss a nearly degenerate portal
+        if (lambda_portal < lambda_lower - tol)
+            return false;
+
+        if (lambda_portal - lambda_lower <= tol || lambda_lower > lambda_max)
+            {
+            lambda = OverlapReal(0.5)*(lambda_portal + lambda_lower);
+            return true;
+            }
+
+        // Choose new portal, as in xenocollide_3d()
+        vec3<OverlapReal> x = cross(v4, v0);
+        if (dot(v1, x) > OverlapReal(0.0))
+            {
+            if (dot(v2, x) > OverlapReal(0.0))
+                v1 = v4;
+            else
+                v3 = v4;
+            }
+        else
+            {
+            if (dot(v3, x) > OverlapReal(0.0))
+                v2 = v4;
+            else
+                v1 = v4;
+            }
+        }
+    }
+
 } // end namespace hpmc::detail
 
 }; // end namespace hpmc
@@ -317,14 +317,14 @@ class wall(_external):
     confined by the INTERSECTION of all of these walls. In other words, particles are confined by all walls if they
     independently satisfy the confinement condition associated with each separate wall.
     Once you've created an instance of this class, use :py:meth:`add_sphere_wall`
-    to add a new spherical wall, :py:meth:`add_cylinder_wall` to add a new cylindrical wall, or
-    :py:meth:`add_plane_wall` to add a new plane wall.
+    to add a new spherical wall, :py:meth:`add_cylinder_wall` to add a new cylindrical wall,
+    :py:meth:`add_plane_wall` to add a new plane wall, or :py:meth:`add_mesh_wall` to add a closed triangle mesh.
 
     Specialized overlap checks have been written for supported combinations of wall types and particle shapes.
     These combinations are:
-    * Sphere particles: sphere walls, cylinder walls, plane walls
-    * Convex polyhedron particles: sphere walls, cylinder walls, plane walls
-    * Convex spheropolyhedron particles: sphere walls
+    * Sphere particles: sphere walls, cylinder walls, plane walls, mesh walls
+    * Convex polyhedron particles: sphere walls, cylinder walls, plane walls, mesh walls
+    * Convex spheropolyhedron particles: sphere walls, mesh walls
 
     Once initialized, the compute provides the following log quantities that can be logged via :py:class:`hoomd.analyze.log`:
 
@@ -714,6 +714,53 @@ class wall(_external):
         hoomd.util.print_status_line();
         return self.cpp_compute.getNumPlaneWalls();
 
+    def add_mesh_wall(self, vertices, faces, inside = True):
+        R""" Add a triangle mesh wall to the simulation.
+
+        Args:
+            vertices (list): vertices of the mesh.
+            faces (list): triangles of the mesh, each a list of three indices into *vertices*. The vertices of each triangle must be ordered counterclockwise
+                          when viewed from outside the mesh, so that the normals point out of the enclosed volume, as in STL files.
+            inside (bool): if True, then particles are CONFINED by the wall if they exist entirely inside the mesh. if False, then particles are CONFINED by the wall if they exist entirely outside the mesh.
+
+        The mesh must be closed. The triangles are stored in a bounding volume hierarchy, so only the triangles close to a
+        particle are checked for overlaps. Like the other walls, mesh walls are scaled when the box changes.
+
+        Example::
+
+            mc = hpmc.integrate.convex_polyhedron(seed = 415236);
+            ext_wall = hpmc.compute.wall(mc);
+            vertices, faces = hoomd.data.read_mesh('pore.stl');
+            ext_wall.add_mesh_wall(vertices = vertices, faces = faces, inside = True);
+
+        .. versionadded:: 2.3
+        """
+        hoomd.util.print_status_line();
+        mesh = _hoomd.make_triangle_mesh([list(v) for v in vertices], [list(f) for f in faces]);
+        self.cpp_compute.AddMeshWall(_hpmc.make_mesh_wall(mesh, inside));
+
+    def remove_mesh_wall(self, index):
+        R""" Remove a particular mesh wall from the simulation.
+
+        Args:
+            index (int): index of the mesh wall to be removed. indices begin at 0 in the order the mesh walls were added to the system.
+
+        .. versionadded:: 2.3
+        """
+        hoomd.util.print_status_line();
+        self.cpp_compute.RemoveMeshWall(index);
+
+    def get_num_mesh_walls(self):
+        R""" Get the current number of mesh walls in the simulation.
+
+        Returns:
+            The current number of mesh walls in the simulation.
+
+        .. versionadded:: 2.3
+        """
+        hoomd.util.print_status_line();
+        return self.cpp_compute.getNumMeshWalls();
+
     def set_volume(self, volume):
         R""" Set the volume associated with the intersection of all walls in the system.
 
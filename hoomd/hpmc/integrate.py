@@ -572,6 +572,10 @@ class mode_hpmc(_integrator):
         * *rotate_accept_count* - count of the number of accepted rotate moves
         * *rotate_reject_count* - count of the number of rejected rotate moves
         * *overlap_checks* - estimate of the number of overlap checks performed
+        * *overlap_insphere_count* - overlap checks resolved because the inspheres of the pair overlap
+        * *overlap_circumsphere_count* - overlap checks resolved because the circumspheres of the pair are disjoint
+        * *overlap_obb_count* - overlap checks resolved because the bounding boxes of the pair are disjoint (polyhedra only)
+        * *overlap_exact_count* - overlap checks that needed the exact shape overlap test
         * *translate_acceptance* - Average translate acceptance ratio over the run
         * *rotate_acceptance* - Average rotate acceptance ratio over the run
         * *move_count* - Count of the number of trial moves during the run
@@ -582,6 +586,10 @@ class mode_hpmc(_integrator):
                     rotate_accept_count=counters.rotate_accept_count,
                     rotate_reject_count=counters.rotate_reject_count,
                     overlap_checks=counters.overlap_checks,
+                    overlap_insphere_count=counters.overlap_insphere_count,
+                    overlap_circumsphere_count=counters.overlap_circumsphere_count,
+                    overlap_obb_count=counters.overlap_obb_count,
+                    overlap_exact_count=counters.overlap_exact_count,
                     translate_acceptance=counters.getTranslateAcceptance(),
                     rotate_acceptance=counters.getRotateAcceptance(),
                     move_count=counters.getNMoves());
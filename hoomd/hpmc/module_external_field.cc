@@ -69,17 +69,24 @@ PlaneWall make_plane_wall(py::list norm, py::list origin, bool inside)
     return PlaneWall(normal, orig, inside);
     }
 
+MeshWall make_mesh_wall(std::shared_ptr<TriangleMesh> mesh, bool inside)
+    {
+    return MeshWall(mesh, inside);
+    }
+
 void export_walls(py::module& m)
     {
     // export wall structs.
    py::class_<SphereWall, std::shared_ptr<SphereWall> >(m, "sphere_wall_params");
    py::class_<CylinderWall, std::shared_ptr<CylinderWall> >(m, "cylinder_wall_params");
    py::class_<PlaneWall, std::shared_ptr<PlaneWall> >(m, "plane_wall_params");
+   py::class_<MeshWall, std::shared_ptr<MeshWall> >(m, "mesh_wall_params");
 
     // export helper functions.
     m.def("make_sphere_wall", &make_sphere_wall);
     m.def("make_cylinder_wall", &make_cylinder_wall);
     m.def("make_plane_wall", &make_plane_wall);
+    m.def("make_mesh_wall", &make_mesh_wall);
     }
 
 
@@ -0,0 +1,56 @@
+from __future__ import division
+from __future__ import print_function
+
+import hoomd
+from hoomd import context, data, init, analyze, run
+from hoomd import hpmc
+
+import math
+import unittest
+
+context.initialize()
+
+class free_volume_test(unittest.TestCase):
+
+    def setUp(self):
+        self.L = 5.0
+        snap = data.make_snapshot(N=1, box=data.boxdim(L=self.L), particle_types=['A', 'B'])
+
+        # close to a corner of the box, so that the excluded volume spans periodic images
+        snap.particles.position[0] = [2.3, 2.4, -2.2]
+        self.system = init.read_snapshot(snap)
+
+        self.mc = hpmc.integrate.sphere(seed=123, d=0)
+        self.mc.shape_param.set('A', diameter=1.0)
+        self.mc.shape_param.set('B', diameter=1.0)
+
+        self.nsample = 200000
+        self.free_volume = hpmc.compute.free_volume(mc=self.mc, seed=987, nsample=self.nsample, test_type='B')
+        self.log = analyze.log(filename=None, quantities=['hpmc_free_volume'], period=1)
+
+    def tearDown(self):
+        del self.free_volume
+        del self.log
+        del self.mc
+        del self.system
+        context.initialize()
+
+    # the excluded volume of a unit sphere for a test sphere of unit diameter is that of a sphere of radius 1
+    def test_excluded_sphere(self):
+        run(1)
+        V_free = self.log.query('hpmc_free_volume')
+        V_ex = 4.0/3.0*math.pi
+
+        # five standard deviations of the estimate
+        p = V_ex/self.L**3
+        tol = 5*math.sqrt(p*(1-p)/self.nsample)*self.L**3
+        self.assertAlmostEqual(V_free, self.L**3 - V_ex, delta=tol)
+
+    # test particles that do not interact with the particles see the whole box
+    def test_no_interaction(self):
+        self.mc.overlap_checks.set('A', 'B', False)
+        run(1)
+        self.assertAlmostEqual(self.log.query('hpmc_free_volume'), self.L**3, places=3)
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
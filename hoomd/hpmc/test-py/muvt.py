@@ -32,6 +32,41 @@ class muvt_updater_test(unittest.TestCase):
 
         run(100)
 
+    def test_spheres_batch(self):
+        self.mc = hpmc.integrate.sphere(seed=123)
+        self.mc.set_params(deterministic=True)
+        self.mc.set_params(d=0.1)
+
+        # nearly ideal gas, where <N> = fugacity*V
+        self.mc.shape_param.set('A', diameter=0.05)
+
+        V = self.system.box.get_volume()
+        fugacity = 1000.0/V
+
+        self.muvt=hpmc.update.muvt(mc=self.mc,seed=456,transfer_types=['A'])
+        self.muvt.set_fugacity('A', fugacity)
+        self.muvt.set_params(batch=200)
+
+        run(100)
+
+        N = []
+        for i in range(10):
+            run(10)
+            N.append(len(self.system.particles))
+
+        N_avg = sum(N)/float(len(N))
+        self.assertLess(abs(N_avg - fugacity*V), 0.1*fugacity*V)
+
+    def test_spheres_batch_implicit(self):
+        self.mc = hpmc.integrate.sphere(seed=123, implicit=True)
+        self.mc.shape_param.set('A', diameter=1.0)
+
+        self.muvt=hpmc.update.muvt(mc=self.mc,seed=456,transfer_types=['A'])
+
+        # batched moves do not insert depletants, also when set directly on the updater
+        self.assertRaises(RuntimeError, self.muvt.set_params, batch=200)
+        self.assertRaises(RuntimeError, self.muvt.cpp_updater.setBatchSize, 200)
+
     def test_convex_polyhedron(self):
         self.mc = hpmc.integrate.convex_polyhedron(seed=10);
         self.mc.set_params(deterministic=True)
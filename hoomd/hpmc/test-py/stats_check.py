@@ -183,6 +183,78 @@ class pair_accept_some(unittest.TestCase):
         del self.system
         context.initialize()
 
+# check that every overlap check is resolved by exactly one tier of the overlap pipeline
+class overlap_tiers(unittest.TestCase):
+    def setUp(self):
+        self.cube = [(-0.5,-0.5,-0.5), (-0.5,-0.5,0.5), (-0.5,0.5,-0.5), (-0.5,0.5,0.5),
+                     (0.5,-0.5,-0.5), (0.5,-0.5,0.5), (0.5,0.5,-0.5), (0.5,0.5,0.5)];
+
+    def get_counters(self):
+        counters = self.mc.get_counters();
+        n_resolved = (counters['overlap_insphere_count'] + counters['overlap_circumsphere_count']
+                      + counters['overlap_obb_count'] + counters['overlap_exact_count']);
+
+        if context.exec_conf.isCUDAEnabled():
+            # the GPU kernels do not count the tiers
+            self.assertEqual(n_resolved, 0);
+            return None
+
+        self.assertEqual(n_resolved, counters['overlap_checks']);
+        return counters
+
+    def test_tiers(self):
+        # a dense simple cubic lattice of cubes, where the inspheres and circumspheres of neighbors overlap
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.1), n=6);
+        self.mc = hpmc.integrate.convex_polyhedron(seed=12, d=0.1, a=0.1);
+        self.mc.shape_param.set('A', vertices=self.cube);
+
+        run(20);
+        self.assertEqual(self.mc.count_overlaps(), 0);
+
+        counters = self.get_counters();
+        if counters is not None:
+            self.assertGreater(counters['overlap_exact_count'], 0);
+            self.assertGreater(counters['overlap_circumsphere_count'], 0);
+            self.assertEqual(counters['overlap_obb_count'], 0);
+
+    def test_insphere(self):
+        # cubes barely separated, so that translations toward a neighbor often make the inspheres overlap
+        self.system = init.create_lattice(unitcell=lattice.sc(a=1.02), n=6);
+        self.mc = hpmc.integrate.convex_polyhedron(seed=12, d=0.1, a=0.01);
+        self.mc.shape_param.set('A', vertices=self.cube);
+
+        run(20);
+        self.assertEqual(self.mc.count_overlaps(), 0);
+
+        counters = self.get_counters();
+        if counters is not None:
+            self.assertGreater(counters['overlap_insphere_count'], 0);
+
+    def test_obb(self):
+        # parallel rods side by side, where the circumspheres of neighbors overlap but their bounding boxes do not
+        uc = lattice.unitcell(N=1, a1=[4.4,0,0], a2=[0,1.1,0], a3=[0,0,1.1], dimensions=3,
+                              position=[[0,0,0]], type_name=['A']);
+        self.system = init.create_lattice(unitcell=uc, n=[2,8,8]);
+        self.mc = hpmc.integrate.polyhedron(seed=12, d=0.05, a=0.01);
+        v = [(-2,-0.25,-0.25), (-2,-0.25,0.25), (-2,0.25,-0.25), (-2,0.25,0.25),
+             (2,-0.25,-0.25), (2,-0.25,0.25), (2,0.25,-0.25), (2,0.25,0.25)];
+        f = [(0,1,3), (0,3,2), (4,6,7), (4,7,5), (0,4,5), (0,5,1),
+             (2,3,7), (2,7,6), (0,2,6), (0,6,4), (1,5,7), (1,7,3)];
+        self.mc.shape_param.set('A', vertices=v, faces=f);
+
+        run(20);
+        self.assertEqual(self.mc.count_overlaps(), 0);
+
+        counters = self.get_counters();
+        if counters is not None:
+            self.assertGreater(counters['overlap_obb_count'], 0);
+            self.assertEqual(counters['overlap_insphere_count'], 0);
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        context.initialize()
+
 
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
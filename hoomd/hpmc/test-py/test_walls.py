@@ -408,5 +408,84 @@ class sphere_wall_tetrahedron_specific_test(unittest.TestCase):
         del self.ext_wall
         context.initialize();
 
+class mesh_wall_convex_polyhedron_test(unittest.TestCase):
+    def setUp(self):
+        self.system = create_empty(N=1, box=data.boxdim(L=30, dimensions=3), particle_types=['A']);
+        self.mc = hpmc.integrate.convex_polyhedron(seed=10);
+        self.mc.shape_param.set('A', vertices = [(-0.5,-0.5,-0.5),
+                                                (-0.5,0.5,-0.5),
+                                                (-0.5,-0.5,0.5),
+                                                (-0.5,0.5,0.5),
+                                                (0.5,-0.5,-0.5),
+                                                (0.5,0.5,-0.5),
+                                                (0.5,-0.5,0.5),
+                                                (0.5,0.5,0.5)])
+
+        # cube of side 10 with outward normals
+        self.vertices = [(x,y,z) for z in (-5,5) for y in (-5,5) for x in (-5,5)];
+        self.faces = [[0,2,3], [0,3,1], [4,5,7], [4,7,6], [0,1,5], [0,5,4],
+                      [2,6,7], [2,7,3], [0,4,6], [0,6,2], [1,3,7], [1,7,5]];
+
+        self.ext_wall = hpmc.field.wall(self.mc);
+        self.ext_wall.add_mesh_wall(self.vertices, self.faces, inside=True);
+
+    def test(self):
+        run(1, quiet=True);
+        self.assertEqual(self.ext_wall.get_num_mesh_walls(), 1);
+        self.system.particles[0].orientation = (1,0,0,0);
+
+        # 1. a particle inside the mesh, far from the boundary
+        self.system.particles[0].position = (0,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 0);
+
+        # 2. a particle inside the mesh, close to a face and to an edge
+        self.system.particles[0].position = (4.4,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 0);
+        self.system.particles[0].position = (4.4,4.4,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 0);
+
+        # 3. a particle crossing a face and an edge
+        self.system.particles[0].position = (4.6,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 1);
+        self.system.particles[0].position = (4.4,4.6,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 1);
+
+        # 4. a particle outside the mesh
+        self.system.particles[0].position = (10,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 1);
+
+        # 5. the same positions with particles confined outside of the mesh
+        self.ext_wall.remove_mesh_wall(0);
+        self.ext_wall.add_mesh_wall(self.vertices, self.faces, inside=False);
+        self.assertEqual(self.ext_wall.count_overlaps(), 0);
+        self.system.particles[0].position = (5.4,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 1);
+        self.system.particles[0].position = (0,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 1);
+
+        # 6. the mesh scales with the box, a cube of side 20 in a box of side 60
+        self.ext_wall.remove_mesh_wall(0);
+        self.ext_wall.add_mesh_wall(self.vertices, self.faces, inside=True);
+        self.system.box = data.boxdim(L=60, dimensions=3);
+        self.system.particles[0].position = (9.4,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 0);
+        self.system.particles[0].position = (9.6,9.4,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 1);
+        self.system.particles[0].position = (4.6,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 0);
+
+        # and back, the unscaled mesh is kept
+        self.system.box = data.boxdim(L=30, dimensions=3);
+        self.system.particles[0].position = (4.6,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 1);
+        self.system.particles[0].position = (4.4,0,0);
+        self.assertEqual(self.ext_wall.count_overlaps(), 0);
+
+    def tearDown(self):
+        del self.mc
+        del self.system
+        del self.ext_wall
+        context.initialize();
+
 if __name__ == '__main__':
     unittest.main(argv = ['test.py', '-v'])
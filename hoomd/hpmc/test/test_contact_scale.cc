@@ -0,0 +1,165 @@
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/IntegratorHPMC.h"
+#include "hoomd/hpmc/Moves.h"
+#include "hoomd/hpmc/ShapeSphere.h"
+#include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeSpheropolyhedron.h"
+#include "hoomd/Saru.h"
+
+#include <iostream>
+#include <string>
+
+#include <hoomd/extern/pybind/include/pybind11/pybind11.h>
+#include <memory>
+
+using namespace hpmc;
+using namespace std;
+using namespace hpmc::detail;
+
+// helper function to compute poly radius
+poly3d_verts setup_verts(const vector< vec3<OverlapReal> > vlist, OverlapReal sweep_radius)
+    {
+    poly3d_verts result(vlist.size(), false);
+    result.sweep_radius = sweep_radius;
+    result.ignore = 0;
+
+    // extract the verts from the python list and compute the radius on the way
+    OverlapReal radius_sq = OverlapReal(0.0);
+    for (unsigned int i = 0; i < vlist.size(); i++)
+        {
+        vec3<OverlapReal> vert = vlist[i];
+        result.x[i] = vert.x;
+        result.y[i] = vert.y;
+        result.z[i] = vert.z;
+        radius_sq = std::max(radius_sq, dot(vert, vert));
+        }
+    for (unsigned int i = vlist.size(); i < result.N; i++)
+        {
+        result.x[i] = 0;
+        result.y[i] = 0;
+        result.z[i] = 0;
+        }
+
+    // set the diameter
+    result.diameter = 2*(sqrt(radius_sq)+sweep_radius);
+
+    return result;
+    }
+
+//! Find the contact scale by bisection with test_overlap
+template<class Shape>
+Scalar bisect_contact_scale(const vec3<Scalar>& r_ab, const Shape& a, const Shape& b)
+    {
+    unsigned int err = 0;
+    Scalar L = 0.0;
+    Scalar R = 1.0;
+    for (unsigned int k = 0; k < 50; ++k)
+        {
+        Scalar m = Scalar(0.5)*(L+R);
+        if (test_overlap(r_ab*(Scalar(1.0)-m), a, b, err))
+            R = m;
+        else
+            L = m;
+        }
+    return Scalar(0.5)*(L+R);
+    }
+
+//! Compare find_contact_scale with bisection for random orientations and separations
+template<class Shape>
+void check_random_pairs(const typename Shape::param_type& params)
+    {
+    hoomd::detail::Saru rng(1, 2, 3);
+    Shape tmp(quat<Scalar>(), params);
+    Scalar D = tmp.getCircumsphereDiameter();
+
+    // the analyzer falls back to bisection in the rare cases without a result
+    unsigned int n_found = 0;
+    const unsigned int n_pairs = 200;
+    for (unsigned int i = 0; i < n_pairs; ++i)
+        {
+        Shape a(generateRandomOrientation(rng), params);
+        Shape b(generateRandomOrientation(rng), params);
+
+        // disjoint at the start
+        vec3<Scalar> n(rng.s<Scalar>(-1,1), rng.s<Scalar>(-1,1), rng.s<Scalar>(-1,1));
+        vec3<Scalar> r_ab = D*Scalar(1.05)*n/sqrt(dot(n,n));
+
+        OverlapReal lambda;
+        if (!find_contact_scale(r_ab, a, b, OverlapReal(1e-5), OverlapReal(1.0), lambda))
+            continue;
+        n_found++;
+        MY_CHECK_SMALL(lambda - bisect_contact_scale(r_ab, a, b), 1e-4);
+
+        // overlapping pairs give values of zero or less
+        if (find_contact_scale(r_ab*(Scalar(1.0) - lambda - Scalar(0.01)), a, b, OverlapReal(1e-5),
+            OverlapReal(1.0), lambda))
+            UP_ASSERT(lambda <= OverlapReal(0.0));
+        }
+
+    UP_ASSERT(n_found >= n_pairs*9/10);
+    }
+
+UP_TEST( sphere )
+    {
+    sph_params params;
+    params.radius = 0.5;
+    params.ignore = 0;
+    params.isOriented = false;
+
+    ShapeSphere a(quat<Scalar>(), params);
+    ShapeSphere b(quat<Scalar>(), params);
+
+    OverlapReal lambda;
+    UP_ASSERT(find_contact_scale(vec3<Scalar>(0,1.25,0), a, b, OverlapReal(1e-5), OverlapReal(1.0), lambda));
+    MY_CHECK_CLOSE(lambda, 0.2, tol);
+
+    UP_ASSERT(find_contact_scale(vec3<Scalar>(0.5,0,0), a, b, OverlapReal(1e-5), OverlapReal(1.0), lambda));
+    UP_ASSERT(lambda < OverlapReal(0.0));
+    }
+
+UP_TEST( convex_polyhedron )
+    {
+    vector< vec3<OverlapReal> > vlist;
+    for (unsigned int i = 0; i < 8; ++i)
+        vlist.push_back(vec3<OverlapReal>((i & 1) ? 0.5 : -0.5, (i & 2) ? 0.5 : -0.5, (i & 4) ? 0.5 : -0.5));
+    poly3d_verts verts = setup_verts(vlist, 0.0);
+
+    // face to face contact of two aligned cubes
+    ShapeConvexPolyhedron a(quat<Scalar>(), verts);
+    ShapeConvexPolyhedron b(quat<Scalar>(), verts);
+    OverlapReal lambda;
+    UP_ASSERT(find_contact_scale(vec3<Scalar>(1.25,0.1,0), a, b, OverlapReal(1e-5), OverlapReal(1.0), lambda));
+    MY_CHECK_CLOSE(lambda, 0.2, tol);
+
+    // results beyond lambda_max only need to exceed it
+    UP_ASSERT(find_contact_scale(vec3<Scalar>(1.25,0.1,0), a, b, OverlapReal(1e-5), OverlapReal(0.1), lambda));
+    UP_ASSERT(lambda > OverlapReal(0.1));
+
+    check_random_pairs<ShapeConvexPolyhedron>(verts);
+    }
+
+UP_TEST( spheropolyhedron )
+    {
+    vector< vec3<OverlapReal> > vlist;
+    vlist.push_back(vec3<OverlapReal>(0,0,0));
+    vlist.push_back(vec3<OverlapReal>(1,0,0));
+    vlist.push_back(vec3<OverlapReal>(0,1.25,0));
+    vlist.push_back(vec3<OverlapReal>(0,0,1.1));
+    poly3d_verts verts = setup_verts(vlist, 0.25);
+
+    check_random_pairs<ShapeSpheropolyhedron>(verts);
+
+    // a single vertex is a sphere
+    vlist.resize(1);
+    verts = setup_verts(vlist, 0.5);
+    ShapeSpheropolyhedron a(quat<Scalar>(), verts);
+    ShapeSpheropolyhedron b(quat<Scalar>(), verts);
+    OverlapReal lambda;
+    UP_ASSERT(find_contact_scale(vec3<Scalar>(0.75,1.0,0), a, b, OverlapReal(1e-5), OverlapReal(1.0), lambda));
+    MY_CHECK_CLOSE(lambda, 0.2, tol);
+    }
@@ -2,6 +2,7 @@
 #include "hoomd/hpmc/IntegratorHPMC.h"
 #include "hoomd/hpmc/Moves.h"
 #include "hoomd/hpmc/ShapeConvexPolygon.h"
+#include "hoomd/hpmc/ShapeProxy.h"
 
 #include "hoomd/test/upp11_config.h"
 
@@ -423,6 +424,84 @@ UP_TEST( overlap_square_tri )
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
     }
 
+UP_TEST( overlap_separating_axis )
+    {
+    // a square and a triangle move along a path that makes them approach, overlap, and separate again
+    Scalar alpha = -M_PI/5.0;
+    quat<Scalar> o_a(cos(alpha/2.0), (Scalar)sin(alpha/2.0) * vec3<Scalar>(0,0,1)); // rotation quaternion
+    alpha = M_PI/3.0;
+    quat<Scalar> o_b(cos(alpha/2.0), (Scalar)sin(alpha/2.0) * vec3<Scalar>(0,0,1)); // rotation quaternion
+
+    std::vector< vec2<OverlapReal> > vlist_a;
+    vlist_a.push_back(vec2<OverlapReal>(-0.5,-0.5));
+    vlist_a.push_back(vec2<OverlapReal>(0.5,-0.5));
+    vlist_a.push_back(vec2<OverlapReal>(0.5,0.5));
+    vlist_a.push_back(vec2<OverlapReal>(-0.5,0.5));
+    poly2d_verts verts_a = setup_verts(vlist_a);
+
+    std::vector< vec2<OverlapReal> > vlist_b;
+    vlist_b.push_back(vec2<OverlapReal>(-0.5,-0.5));
+    vlist_b.push_back(vec2<OverlapReal>(0.5,-0.5));
+    vlist_b.push_back(vec2<OverlapReal>(0.5,0.5));
+    poly2d_verts verts_b = setup_verts(vlist_b);
+
+    ShapeConvexPolygon a(o_a, verts_a);
+    ShapeConvexPolygon b(o_b, verts_b);
+
+    vec3<OverlapReal> axis(0,0,0);
+    unsigned int n_separated = 0;
+    for (unsigned int i = 0; i < 200; i++)
+        {
+        Scalar t = Scalar(i)/Scalar(200);
+        vec3<Scalar> r_ij(2.0 - 2.0*t, 0.4*sin(10*t), 0);
+
+        // the result must not depend on the cached axis
+        bool overlap = test_overlap(r_ij, a, b, err_count);
+        UP_ASSERT_EQUAL(test_overlap_separating_axis(r_ij, a, b, err_count, axis), overlap);
+
+        if (!overlap)
+            {
+            // the returned axis separates the pair
+            n_separated++;
+            UP_ASSERT(is_separating_axis(a.verts,
+                                         b.verts,
+                                         vec2<OverlapReal>(r_ij.x, r_ij.y),
+                                         quat<OverlapReal>(a.orientation),
+                                         quat<OverlapReal>(b.orientation),
+                                         vec2<OverlapReal>(axis.x, axis.y)));
+            }
+        }
+    UP_ASSERT(n_separated > 0);
+
+    // a cached axis that does not separate the shapes must not hide an overlap
+    axis = vec3<OverlapReal>(1,0,0);
+    UP_ASSERT(test_overlap_separating_axis(vec3<Scalar>(0.9,0,0), a, a, err_count, axis));
+    }
+
+UP_TEST( insphere_radius )
+    {
+    // unit square centered at the origin
+    std::vector< vec2<OverlapReal> > vlist;
+    vlist.push_back(vec2<OverlapReal>(-0.5,-0.5));
+    vlist.push_back(vec2<OverlapReal>(0.5,-0.5));
+    vlist.push_back(vec2<OverlapReal>(0.5,0.5));
+    vlist.push_back(vec2<OverlapReal>(-0.5,0.5));
+    poly2d_verts verts = setup_verts(vlist);
+
+    OverlapReal r = compute_poly2d_insphere_radius(verts);
+    MY_CHECK_CLOSE(r, 0.5, tol_small);
+    UP_ASSERT(r <= OverlapReal(0.5));
+
+    // the sweep radius adds to the distance of the closest edge
+    verts.sweep_radius = 0.25;
+    MY_CHECK_CLOSE(compute_poly2d_insphere_radius(verts), 0.75, tol_small);
+
+    // with the origin outside, only the sweep around the closest edge contains a circle around the origin
+    for (unsigned int i = 0; i < verts.N; i++)
+        verts.x[i] += 0.6;
+    MY_CHECK_CLOSE(compute_poly2d_insphere_radius(verts), 0.15, tol_small);
+    }
+
 /*UP_TEST( visual )
     {
     // place these randomly and draw them with GLE colored red if they overlap
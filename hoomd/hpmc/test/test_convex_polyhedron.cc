@@ -3,6 +3,7 @@
 #include "hoomd/hpmc/IntegratorHPMC.h"
 #include "hoomd/hpmc/Moves.h"
 #include "hoomd/hpmc/ShapeConvexPolyhedron.h"
+#include "hoomd/hpmc/ShapeProxy.h"
 
 #include "hoomd/test/upp11_config.h"
 
@@ -620,3 +621,83 @@ UP_TEST( overlap_cube_rot3 )
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
 
     }
+
+UP_TEST( overlap_separating_axis )
+    {
+    // a cube and a rotated cube move along a path that makes them approach, overlap, and separate again
+    quat<Scalar> o;
+    quat<Scalar> o_b = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), 0.6)
+                       * quat<Scalar>::fromAxisAngle(vec3<Scalar>(1,0,0), 0.4);
+
+    vector< vec3<OverlapReal> > vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,-0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(0.5,0.5,0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,0.5,0.5));
+    poly3d_verts verts = setup_verts(vlist);
+
+    ShapeConvexPolyhedron a(o, verts);
+    ShapeConvexPolyhedron b(o_b, verts);
+
+    vec3<OverlapReal> axis(0,0,0);
+    unsigned int n_separated = 0;
+    for (unsigned int i = 0; i < 200; i++)
+        {
+        Scalar t = Scalar(i)/Scalar(200);
+        vec3<Scalar> r_ij(2.0 - 2.0*t, 0.3*sin(10*t), 0.2*cos(7*t));
+
+        // the result must not depend on the cached axis
+        bool overlap = test_overlap(r_ij, a, b, err_count);
+        UP_ASSERT_EQUAL(test_overlap_separating_axis(r_ij, a, b, err_count, axis), overlap);
+
+        if (!overlap)
+            {
+            // the returned axis separates the pair
+            n_separated++;
+            vec3<OverlapReal> dr(r_ij);
+            UP_ASSERT(xenocollide_3d_separated(SupportFuncConvexPolyhedron(a.verts),
+                                               SupportFuncConvexPolyhedron(b.verts),
+                                               dr,
+                                               quat<OverlapReal>(b.orientation),
+                                               axis));
+            }
+        }
+    UP_ASSERT(n_separated > 0);
+
+    // a cached axis that does not separate the shapes must not hide an overlap
+    axis = vec3<OverlapReal>(1,0,0);
+    UP_ASSERT(test_overlap_separating_axis(vec3<Scalar>(0.9,0,0), a, a, err_count, axis));
+    }
+
+UP_TEST( insphere_radius )
+    {
+    // unit cube centered at the origin
+    vector< vec3<OverlapReal> > vlist;
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>( 0.5,-0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>( 0.5, 0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5,-0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5,-0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>( 0.5,-0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>( 0.5, 0.5, 0.5));
+    vlist.push_back(vec3<OverlapReal>(-0.5, 0.5, 0.5));
+    poly3d_verts verts = setup_verts(vlist);
+
+    OverlapReal r = compute_poly3d_insphere_radius(verts);
+    MY_CHECK_CLOSE(r, 0.5, tol_small);
+    UP_ASSERT(r <= OverlapReal(0.5));
+
+    // the sweep radius adds to the distance of the closest facet
+    verts.sweep_radius = 0.25;
+    MY_CHECK_CLOSE(compute_poly3d_insphere_radius(verts), 0.75, tol_small);
+
+    // with the origin outside, only the sweep around the closest vertex contains a sphere around the origin
+    for (unsigned int i = 0; i < verts.N; i++)
+        verts.x[i] += 1.0;
+    verts.sweep_radius = 0;
+    UP_ASSERT_EQUAL(compute_poly3d_insphere_radius(verts), OverlapReal(0.0));
+    }
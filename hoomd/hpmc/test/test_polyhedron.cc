@@ -464,3 +464,111 @@ UP_TEST( overlap_octahedron_sphere )
     UP_ASSERT(test_overlap(r_ij,a,b,err_count));
     UP_ASSERT(test_overlap(-r_ij,b,a,err_count));
     }
+
+//! Build a non-convex, star-shaped polyhedron with many faces by displacing a tessellated cube onto a bumpy sphere
+void build_bumpy_sphere(poly3d_data& data, unsigned int n)
+    {
+    unsigned int k = 0;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+        for (int side = -1; side <= 1; side += 2)
+            for (unsigned int i = 0; i < n; ++i)
+                for (unsigned int j = 0; j < n; ++j)
+                    {
+                    // the four corners of this patch of the cube face
+                    vec3<OverlapReal> corner[4];
+                    for (unsigned int c = 0; c < 4; ++c)
+                        {
+                        OverlapReal u = -1.0 + 2.0*(i + (c == 1 || c == 2))/n;
+                        OverlapReal v = -1.0 + 2.0*(j + (c >= 2))/n;
+                        OverlapReal x[3];
+                        x[axis] = side;
+                        x[(axis+1) % 3] = side*u;
+                        x[(axis+2) % 3] = v;
+                        vec3<OverlapReal> p(x[0],x[1],x[2]);
+                        p = p / sqrt(dot(p,p));
+                        OverlapReal r = 0.5*(1.0 + 0.3*sin(3.0*p.x)*cos(4.0*p.y) + 0.2*p.z*p.z);
+                        corner[c] = r*p;
+                        }
+
+                    // two triangles per patch
+                    unsigned int tri[6] = {0,1,2,0,2,3};
+                    for (unsigned int t = 0; t < 6; ++t)
+                        {
+                        data.verts[k] = corner[tri[t]];
+                        data.face_verts[k] = k;
+                        k++;
+                        }
+                    }
+
+    for (unsigned int f = 0; f <= data.n_faces; ++f)
+        data.face_offs[f] = 3*f;
+    }
+
+UP_TEST( overlap_nonconvex_tree )
+    {
+    // two non-convex polyhedra with hundreds of faces approach, overlap and separate while rotating, the tree
+    // based overlap check must agree with testing all pairs of triangles and the containment of a vertex
+    const unsigned int n = 4;
+    const unsigned int n_faces = 6*n*n*2;
+
+    poly3d_data data(3*n_faces, n_faces, 3*n_faces, 3*n_faces, false);
+    data.sweep_radius=data.convex_hull_verts.sweep_radius=0.0f;
+    data.ignore = 0;
+    build_bumpy_sphere(data, n);
+    set_radius(data);
+    initialize_convex_hull(data);
+
+    ShapePolyhedron::param_type p = data;
+    p.tree = build_tree(data);
+
+    unsigned int n_overlap = 0;
+    unsigned int n_disjoint = 0;
+    for (unsigned int step = 0; step < 100; ++step)
+        {
+        Scalar t = Scalar(step)/Scalar(100);
+        quat<Scalar> o_a = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,0,1), 5.0*t);
+        quat<Scalar> o_b = quat<Scalar>::fromAxisAngle(vec3<Scalar>(1,0,0), 3.0*t)
+                           * quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,1,0), 0.7);
+        vec3<Scalar> r_ij(1.6 - 1.4*t, 0.2*sin(9*t), 0.1*cos(5*t));
+
+        ShapePolyhedron a(o_a, p);
+        ShapePolyhedron b(o_b, p);
+
+        // brute force reference, in the frame of b
+        quat<OverlapReal> q(conj(quat<OverlapReal>(o_b))*quat<OverlapReal>(o_a));
+        vec3<OverlapReal> dr(rotate(conj(quat<OverlapReal>(o_b)), -vec3<OverlapReal>(r_ij)));
+        bool reference = false;
+        for (unsigned int i = 0; i < n_faces && !reference; ++i)
+            {
+            float U[3][3];
+            for (unsigned int k = 0; k < 3; ++k)
+                {
+                vec3<OverlapReal> v = rotate(q, data.verts[data.face_verts[3*i+k]]) + dr;
+                U[k][0] = v.x; U[k][1] = v.y; U[k][2] = v.z;
+                }
+            for (unsigned int j = 0; j < n_faces && !reference; ++j)
+                {
+                float V[3][3];
+                for (unsigned int k = 0; k < 3; ++k)
+                    {
+                    vec3<OverlapReal> v = data.verts[data.face_verts[3*j+k]];
+                    V[k][0] = v.x; V[k][1] = v.y; V[k][2] = v.z;
+                    }
+                reference = NoDivTriTriIsect(V[0],V[1],V[2],U[0],U[1],U[2],0.0);
+                }
+            }
+
+        // the shapes are identical, so neither can be contained in the other without intersecting faces
+        bool overlap = test_overlap(r_ij, a, b, err_count);
+        UP_ASSERT_EQUAL(overlap, reference);
+        UP_ASSERT_EQUAL(test_overlap(-r_ij, b, a, err_count), reference);
+
+        if (overlap)
+            n_overlap++;
+        else
+            n_disjoint++;
+        }
+
+    UP_ASSERT(n_overlap > 0);
+    UP_ASSERT(n_disjoint > 0);
+    }
@@ -0,0 +1,98 @@
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/UpdaterClusters.h"
+#include "hoomd/Saru.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace hpmc;
+using namespace hpmc::detail;
+
+//! Check the components of a small graph
+UP_TEST( components )
+    {
+    UnionFind G;
+    G.resize(8);
+
+    // components {0,3,5}, {1}, {2,4,6,7}
+    G.merge(5,3);
+    G.merge(3,0);
+    G.merge(7,6);
+    G.merge(2,4);
+    G.merge(6,4);
+    G.merge(2,7);
+
+    std::vector<unsigned int> members, offsets;
+    G.connectedComponents(members, offsets);
+
+    UP_ASSERT_EQUAL(offsets.size(), (unsigned int)4);
+    UP_ASSERT_EQUAL(offsets[3], (unsigned int)8);
+
+    unsigned int expected[8] = {0,3,5, 1, 2,4,6,7};
+    for (unsigned int i = 0; i < 8; ++i)
+        UP_ASSERT_EQUAL(members[i], expected[i]);
+    UP_ASSERT_EQUAL(offsets[1], (unsigned int)3);
+    UP_ASSERT_EQUAL(offsets[2], (unsigned int)4);
+
+    // every set is represented by its smallest vertex
+    UP_ASSERT_EQUAL(G.find(7), (unsigned int)2);
+    UP_ASSERT_EQUAL(G.find(5), (unsigned int)0);
+
+    // resizing removes all edges
+    G.resize(3);
+    G.connectedComponents(members, offsets);
+    UP_ASSERT_EQUAL(offsets.size(), (unsigned int)4);
+    }
+
+//! Compare with labels propagated over the edge list of a random graph
+UP_TEST( random_graph )
+    {
+    const unsigned int V = 1000;
+    hoomd::detail::Saru rng(1, 2, 3);
+
+    std::vector<std::pair<unsigned int, unsigned int> > edges;
+    for (unsigned int k = 0; k < 700; ++k)
+        edges.push_back(std::make_pair(rng.u32() % V, rng.u32() % V));
+
+    UnionFind G;
+    G.resize(V);
+    for (unsigned int k = 0; k < edges.size(); ++k)
+        G.merge(edges[k].first, edges[k].second);
+
+    // reference: iterate min-label propagation until it converges
+    std::vector<unsigned int> label(V);
+    for (unsigned int v = 0; v < V; ++v)
+        label[v] = v;
+
+    bool changed = true;
+    while (changed)
+        {
+        changed = false;
+        for (unsigned int k = 0; k < edges.size(); ++k)
+            {
+            unsigned int &a = label[edges[k].first];
+            unsigned int &b = label[edges[k].second];
+            if (a != b)
+                {
+                a = b = std::min(a, b);
+                changed = true;
+                }
+            }
+        }
+
+    for (unsigned int v = 0; v < V; ++v)
+        UP_ASSERT_EQUAL(G.find(v), label[v]);
+
+    std::vector<unsigned int> members, offsets;
+    G.connectedComponents(members, offsets);
+    UP_ASSERT_EQUAL(members.size(), V);
+    for (unsigned int c = 0; c + 1 < offsets.size(); ++c)
+        {
+        UP_ASSERT(offsets[c] < offsets[c+1]);
+        for (unsigned int k = offsets[c]; k < offsets[c+1]; ++k)
+            UP_ASSERT_EQUAL(label[members[k]], members[offsets[c]]);
+        }
+    }
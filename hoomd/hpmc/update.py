@@ -716,13 +716,22 @@ class muvt(_updater):
         fugacity_variant = hoomd.variant._setup_variant_input(fugacity);
         self.cpp_updater.setFugacity(type_id, fugacity_variant.cpp_variant);
 
-    def set_params(self, dV=None, move_ratio=None, transfer_ratio=None):
+    def set_params(self, dV=None, move_ratio=None, transfer_ratio=None, batch=None):
         R""" Set muVT parameters.
 
         Args:
             dV (float): (if set) Set volume rescaling factor (dimensionless)
             move_ratio (float): (if set) Set the ratio between volume and exchange/transfer moves (applies to Gibbs ensemble)
             transfer_ratio (float): (if set) Set the ratio between transfer and exchange moves
+            batch (int): (if set) Number of insertions and removals every MPI rank attempts per update (0 to disable)
+
+        When *batch* is larger than zero, every MPI rank attempts *batch* insertions and removals of its own in
+        the interior of its domain, instead of a single insertion or removal per update shared by all ranks. The
+        changes of all ranks are communicated once per update, so the number of attempted moves scales with the
+        number of ranks. Batched moves are only available in the grand canonical ensemble without depletants.
+
+        .. versionadded:: 2.3
+           *batch*
 
         Example::
 
@@ -730,6 +739,7 @@ class muvt(_updater):
             muvt.set_params(dV=0.1)
             muvt.set_params(n_trial=2)
             muvt.set_params(move_ratio=0.05)
+            muvt.set_params(batch=64)
 
         """
         hoomd.util.print_status_line();
@@ -747,6 +757,12 @@ class muvt(_updater):
         if transfer_ratio is not None:
             self.cpp_updater.setTransferRatio(float(transfer_ratio))
 
+        if batch is not None:
+            if self.gibbs or self.mc.implicit:
+                hoomd.context.msg.error("update.muvt: batch is not supported in the Gibbs ensemble or with depletants.\n");
+                raise RuntimeError("Error setting muVT parameters");
+            self.cpp_updater.setBatchSize(int(batch))
+
 class remove_drift(_updater):
     R""" Remove the center of mass drift from a system restrained on a lattice.
 
@@ -29,12 +29,13 @@ def is_initialized():
     else:
         return True;
 
-def create_lattice(unitcell, n):
+def create_lattice(unitcell, n, distributed=False):
     R""" Create a lattice.
 
     Args:
         unitcell (:py:class:`hoomd.lattice.unitcell`): The unit cell of the lattice.
         n (list): Number of replicates in each direction.
+        distributed (bool): When True, every MPI rank generates only the particles in its own domain.
 
     :py:func:`create_lattice` take a unit cell and replicates it the requested number of times in each direction.
     The resulting simulation box is commensurate with the given unit cell. A generic :py:class:`hoomd.lattice.unitcell`
@@ -59,6 +60,14 @@ def create_lattice(unitcell, n):
 
         hoomd.init.create_lattice(unitcell=hoomd.lattice.hex(a=1.0),
                                   n=[100,58]);
+
+    By default, the replicated lattice is built in a snapshot on the root rank and then distributed to the other ranks.
+    With *distributed=True*, no rank builds the whole lattice: every rank generates the particles that fall in its
+    own domain, so the root rank does not need memory for the whole system and initialization scales with the number
+    of ranks. The resulting system, including the particle tags, is the same in both modes.
+
+    .. versionadded:: 2.3
+        The *distributed* argument.
     """
     hoomd.util.print_status_line();
 
@@ -82,12 +91,14 @@ def create_lattice(unitcell, n):
         hoomd.context.msg.error("n must have length equal to the number of dimensions in the unit cell\n");
         raise RuntimeError("Error initializing");
 
-    if snap.box.dimensions == 3:
-        snap.replicate(n[0],n[1],n[2])
     if snap.box.dimensions == 2:
-        snap.replicate(n[0],n[1],1)
+        n = [n[0], n[1], 1];
 
-    read_snapshot(snapshot=snap);
+    if distributed:
+        _read_replicated(snap, n);
+    else:
+        snap.replicate(n[0],n[1],n[2])
+        read_snapshot(snapshot=snap);
 
     hoomd.util.unquiet_status();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
@@ -209,11 +220,12 @@ def read_getar(filename, modes={'any': 'any'}):
 
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_snapshot(snapshot):
+def read_snapshot(snapshot, replicate=None):
     R""" Initializes the system from a snapshot.
 
     Args:
         snapshot (:py:mod:`hoomd.data` snapshot): The snapshot to initialize the system.
+        replicate (list): (if specified) Number of replicas *[nx, ny, nz]* of the snapshot along each box vector.
 
     Snapshots temporarily store system data. Snapshots contain the complete simulation state in a
     single object. Snapshots are set to time_step 0, and should not be used to restart a simulation.
@@ -226,8 +238,21 @@ def read_snapshot(snapshot):
         snapshot = my_system_create_routine(.. parameters ..)
         system = init.read_snapshot(snapshot)
 
+    When *replicate* is given, the system is initialized with *nx* by *ny* by *nz* replicas of the snapshot, as if
+    the snapshot were replicated first with ``snapshot.replicate(nx, ny, nz)``, bonded groups included. The replicated
+    snapshot is never built: every MPI rank generates only the particles and bonded groups in its own domain from
+    the snapshot of the unit cell. Use *replicate* to build large systems, such as polymer melts, from a small unit
+    cell. For 2D snapshots, *nz* must be 1.
+
+    Example::
+
+        system = init.read_snapshot(polymer_cell, replicate=[100, 100, 100])
+
     See Also:
         :py:mod:`hoomd.data`
+
+    .. versionadded:: 2.3
+        The *replicate* argument.
     """
     hoomd.util.print_status_line();
 
@@ -238,6 +263,14 @@ def read_snapshot(snapshot):
         hoomd.context.msg.error("Cannot initialize more than once\n");
         raise RuntimeError("Error initializing");
 
+    if replicate is not None:
+        if len(replicate) != 3:
+            hoomd.context.msg.error("init.read_snapshot: replicate must have 3 elements\n");
+            raise RuntimeError("Error initializing");
+
+        _read_replicated(snapshot, [int(r) for r in replicate]);
+        return hoomd.data.system_data(hoomd.context.current.system_definition);
+
     # broadcast snapshot metadata so that all ranks have _global_box (the user may have set box only on rank 0)
     snapshot._broadcast_box(hoomd.context.exec_conf);
     my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
@@ -253,7 +286,7 @@ def read_snapshot(snapshot):
     _perform_common_init_tasks();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
-def read_gsd(filename, restart = None, frame = 0, time_step = None):
+def read_gsd(filename, restart = None, frame = 0, time_step = None, distributed = False):
     R""" Read initial system state from an GSD file.
 
     Args:
@@ -261,6 +294,7 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         restart (str): If it exists, read the file *restart* instead of *filename*.
         frame (int): Index of the frame to read from the GSD file. Negative values index from the end of the file.
         time_step (int): (if specified) Time step number to initialize instead of the one stored in the GSD file.
+        distributed (bool): When True, every MPI rank reads a part of the file and no rank holds the whole system.
 
     All particles, bonds, angles, dihedrals, impropers, constraints, and box information
     are read from the given GSD file at the given frame index. To read and write GSD files
@@ -275,8 +309,17 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     The result of :py:func:`hoomd.init.read_gsd` can be saved in a variable and later used to read and/or
     change particle properties later in the script. See :py:mod:`hoomd.data` for more information.
 
+    By default, the root rank reads the whole frame and then distributes it to the other ranks. With
+    *distributed=True*, every rank reads an equal part of the frame and sends each particle directly to the rank
+    that owns it, so the root rank does not need memory for the whole system. The resulting system, including the
+    particle tags, is the same in both modes. Integrator and analyzer state can only be restored with
+    *distributed=False*.
+
     See Also:
         :py:class:`hoomd.dump.gsd`
+
+    .. versionadded:: 2.3
+        The *distributed* argument.
     """
     hoomd.util.print_status_line();
 
@@ -288,9 +331,16 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
         raise RuntimeError("Error initializing");
 
     if restart is not None and os.path.exists(restart):
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, restart, abs(frame), frame < 0);
-    else:
-        reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
+        filename = restart;
+
+    if distributed:
+        reader = _hoomd.DistributedGSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
+        if time_step is None:
+            time_step = reader.getTimeStep();
+        _read_local(reader, time_step);
+        return hoomd.data.system_data(hoomd.context.current.system_definition);
+
+    reader = _hoomd.GSDReader(hoomd.context.exec_conf, filename, abs(frame), frame < 0);
     snapshot = reader.getSnapshot();
     if time_step is None:
         time_step = reader.getTimeStep();
@@ -312,6 +362,70 @@ def read_gsd(filename, restart = None, frame = 0, time_step = None):
     hoomd.context.current.state_reader.clearSnapshot();
     return hoomd.data.system_data(hoomd.context.current.system_definition);
 
+def read_checkpoint(prefix, restart = None):
+    R""" Restore the system from a checkpoint.
+
+    Args:
+        prefix (str): Prefix of the checkpoint file names.
+        restart (str): Read the checkpoint with this prefix instead, if its manifest exists.
+
+    :py:func:`hoomd.init.read_checkpoint` reads a checkpoint written by :py:class:`hoomd.dump.checkpoint`. It restores
+    the particles, bonds, angles, dihedrals, impropers, constraints, pairs, box, time step, and the state of the
+    integrators exactly. The checkpoint must be read on the same number of MPI ranks it was written on, and the
+    domain decomposition is the one stored in the checkpoint (any :py:class:`hoomd.comm.decomposition` is ignored).
+    Every rank reads its own particles directly, so no rank needs memory for the whole system.
+
+    Example::
+
+        system = init.read_checkpoint(prefix="restart")
+
+    See Also:
+        :py:class:`hoomd.dump.checkpoint`
+
+    .. versionadded:: 2.3
+    """
+    hoomd.util.print_status_line();
+
+    hoomd.context._verify_init();
+
+    # check if initialization has already occured
+    if is_initialized():
+        hoomd.context.msg.error("Cannot initialize more than once\n");
+        raise RuntimeError("Error initializing");
+
+    if restart is not None and os.path.exists(restart + '.manifest'):
+        prefix = restart;
+
+    reader = _hoomd.CheckpointReader(hoomd.context.exec_conf, prefix);
+    snapshot = reader.getSnapshot();
+
+    my_domain_decomposition = None
+    if _hoomd.is_MPI_available():
+        my_domain_decomposition = reader.getDomainDecomposition();
+
+    if my_domain_decomposition is not None:
+        if hoomd.context.current.decomposition is not None:
+            hoomd.context.msg.warning("init.read_checkpoint: Using the domain decomposition of the checkpoint.\n");
+        else:
+            hoomd.util.quiet_status()
+            hoomd.context.current.decomposition = hoomd.comm.decomposition()
+            hoomd.util.unquiet_status()
+
+        # the load balancer adjusts the decomposition of the checkpoint
+        hoomd.context.current.decomposition.cpp_dd = my_domain_decomposition
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
+    else:
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
+
+    # read the particles of every rank
+    reader.restore(hoomd.context.current.system_definition);
+
+    # initialize the system
+    hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, reader.getTimeStep());
+
+    _perform_common_init_tasks();
+    return hoomd.data.system_data(hoomd.context.current.system_definition);
+
 def restore_getar(filename, modes={'any': 'any'}):
     """Restore a subset of the current system's parameters from a
     trajectory archive (.tar, .zip, .sqlite) file. For a detailed
@@ -361,6 +475,42 @@ def _perform_common_init_tasks():
             # set Communicator in C++ System
             hoomd.context.current.system.setCommunicator(cpp_communicator)
 
+## Initialize the system from replicas of a unit cell snapshot
+# \internal
+def _read_replicated(unit_cell, n):
+    # the unit cell is small, every rank needs all of it
+    unit_cell._broadcast(0, hoomd.context.exec_conf);
+
+    if unit_cell._dimensions == 2 and n[2] != 1:
+        hoomd.context.msg.error("init: a 2D snapshot cannot be replicated along z\n");
+        raise RuntimeError("Error initializing");
+
+    if isinstance(unit_cell, _hoomd.SnapshotSystemData_float):
+        reader = _hoomd.ReplicatedSnapshotReader_float(hoomd.context.exec_conf, unit_cell, n[0], n[1], n[2]);
+    else:
+        reader = _hoomd.ReplicatedSnapshotReader_double(hoomd.context.exec_conf, unit_cell, n[0], n[1], n[2]);
+
+    _read_local(reader, 0);
+
+## Initialize the system from a reader that fills in the particles of every rank
+# \internal
+def _read_local(reader, time_step):
+    # initialize an empty system on all ranks, then let every rank fill in its own particles
+    snapshot = reader.getSnapshot();
+    my_domain_decomposition = _create_domain_decomposition(snapshot._global_box);
+
+    if my_domain_decomposition is not None:
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf, my_domain_decomposition);
+    else:
+        hoomd.context.current.system_definition = _hoomd.SystemDefinition(snapshot, hoomd.context.exec_conf);
+
+    reader.readLocal(hoomd.context.current.system_definition);
+
+    # initialize the system
+    hoomd.context.current.system = _hoomd.System(hoomd.context.current.system_definition, time_step);
+
+    _perform_common_init_tasks();
+
 ## Create a DomainDecomposition object
 # \internal
 def _create_domain_decomposition(box):
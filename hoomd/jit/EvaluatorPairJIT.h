@@ -0,0 +1,137 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_JIT_H__
+#define __PAIR_EVALUATOR_JIT_H__
+
+#ifndef NVCC
+#include <string>
+#endif
+
+#include "hoomd/HOOMDMath.h"
+#include "PairEvalFactory.h"
+
+/*! \file EvaluatorPairJIT.h
+    \brief Defines the pair evaluator class for JIT compiled user pair potentials
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Per type pair parameters of the JIT pair evaluator
+/*! The function pointer is the same for every type pair, it is stored per type pair so that the evaluator fits into
+    the PotentialPair parameter framework. The type ids are stored so that the user function can branch on them.
+*/
+struct jit_pair_params
+    {
+    PairEvalFactory::EvalFnPtr eval;  //!< Pointer to the JIT compiled scalar evaluator
+    unsigned int type_i;              //!< Type of the first particle in the pair
+    unsigned int type_j;              //!< Type of the second particle in the pair
+    };
+
+//! Class for evaluating JIT compiled user pair potentials
+/*! <b>General Overview</b>
+
+    See EvaluatorPairLJ
+
+    <b>JIT specifics</b>
+
+    EvaluatorPairJIT calls a user provided function compiled at run time with LLVM (see PairEvalFactory). The function
+    receives rsq, the types, diameters and charges of both particles and returns the pair energy while writing
+    the force divided by r into its last argument.
+
+    Because the user function may use diameters and charges, both are always requested. Energy shifting is
+    performed here by evaluating the user function a second time at the cutoff. XPLOR smoothing is handled by
+    PotentialPair as for every other evaluator.
+
+    PotentialPairJIT uses this evaluator for computeEnergyBetweenSets() and as a fallback when the LLVM module
+    provides no batched kernel.
+*/
+class EvaluatorPairJIT
+    {
+    public:
+        //! Define the parameter type used by this pair potential evaluator
+        typedef jit_pair_params param_type;
+
+        //! Constructs the pair potential evaluator
+        /*! \param _rsq Squared distance beteen the particles
+            \param _rcutsq Sqauared distance at which the potential goes to 0
+            \param _params Per type pair parameters of this potential
+        */
+        EvaluatorPairJIT(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+            : rsq(_rsq), rcutsq(_rcutsq), eval(_params.eval), type_i(_params.type_i), type_j(_params.type_j),
+              di(0), dj(0), qi(0), qj(0)
+            {
+            }
+
+        //! The user function may use the diameter
+        static bool needsDiameter() { return true; }
+        //! Accept the optional diameter values
+        /*! \param _di Diameter of particle i
+            \param _dj Diameter of particle j
+        */
+        void setDiameter(Scalar _di, Scalar _dj)
+            {
+            di = _di;
+            dj = _dj;
+            }
+
+        //! The user function may use the charge
+        static bool needsCharge() { return true; }
+        //! Accept the optional charge values
+        /*! \param _qi Charge of particle i
+            \param _qj Charge of particle j
+        */
+        void setCharge(Scalar _qi, Scalar _qj)
+            {
+            qi = _qi;
+            qj = _qj;
+            }
+
+        //! Evaluate the force and energy
+        /*! \param force_divr Output parameter to write the computed force divided by r.
+            \param pair_eng Output parameter to write the computed pair energy
+            \param energy_shift If true, the potential must be shifted so that V(r) is continuous at the cutoff
+
+            \return True if they are evaluated or false if they are not because we are beyond the cuttoff
+        */
+        bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+            {
+            if (rsq < rcutsq && eval)
+                {
+                pair_eng = eval(rsq, type_i, type_j, di, dj, qi, qj, force_divr);
+
+                if (energy_shift)
+                    {
+                    Scalar force_divr_cut = Scalar(0.0);
+                    pair_eng -= eval(rcutsq, type_i, type_j, di, dj, qi, qj, force_divr_cut);
+                    }
+                return true;
+                }
+            else
+                return false;
+            }
+
+        //! Get the name of this potential
+        /*! \returns The potential name. Must be short and all lowercase, as this is the name energies will be logged as
+            via analyze.log.
+        */
+        static std::string getName()
+            {
+            return std::string("jit");
+            }
+
+    protected:
+        Scalar rsq;                       //!< Stored rsq from the constructor
+        Scalar rcutsq;                    //!< Stored rcutsq from the constructor
+        PairEvalFactory::EvalFnPtr eval;  //!< The JIT compiled evaluator
+        unsigned int type_i;              //!< Type of particle i
+        unsigned int type_j;              //!< Type of particle j
+        Scalar di;                        //!< Diameter of particle i
+        Scalar dj;                        //!< Diameter of particle j
+        Scalar qi;                        //!< Charge of particle i
+        Scalar qj;                        //!< Charge of particle j
+    };
+
+#endif // __PAIR_EVALUATOR_JIT_H__
@@ -0,0 +1,78 @@
+#include <utility>
+#include <memory>
+#include <sstream>
+#include "JITModule.h"
+
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Support/SourceMgr.h"
+#include "llvm/IRReader/IRReader.h"
+#if defined LLVM_VERSION_MAJOR && LLVM_VERSION_MAJOR > 3 || (LLVM_VERSION_MAJOR == 3 && LLVM_VERSION_MINOR >= 9)
+#include "llvm/ExecutionEngine/Orc/OrcABISupport.h"
+#else
+#include "llvm/ExecutionEngine/Orc/OrcArchitectureSupport.h"
+#endif
+#include "llvm/ExecutionEngine/Orc/ExecutionUtils.h"
+#include "llvm/ExecutionEngine/ExecutionEngine.h"
+#include "llvm/Support/DynamicLibrary.h"
+
+#include "llvm/Support/raw_os_ostream.h"
+
+std::unique_ptr<llvm::orc::KaleidoscopeJIT> compileJITModule(const std::string& llvm_ir,
+                                                             const std::string& name,
+                                                             std::string& error_msg)
+    {
+    // initialize LLVM
+    std::ostringstream sstream;
+    llvm::raw_os_ostream llvm_err(sstream);
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+
+    // Add the program's symbols into the JIT's search space.
+    if (llvm::sys::DynamicLibrary::LoadLibraryPermanently(nullptr))
+        {
+        error_msg = "Error loading program symbols.\n";
+        return nullptr;
+        }
+
+    #if defined LLVM_VERSION_MAJOR && LLVM_VERSION_MAJOR > 3 || (LLVM_VERSION_MAJOR == 3 && LLVM_VERSION_MINOR >= 9)
+    llvm::LLVMContext Context;
+    #else
+    llvm::LLVMContext &Context = llvm::getGlobalContext();
+    #endif
+    llvm::SMDiagnostic Err;
+
+    // Read the input IR data
+    llvm::StringRef ir_str(llvm_ir);
+    std::unique_ptr<llvm::MemoryBuffer> ir_membuf = llvm::MemoryBuffer::getMemBuffer(ir_str);
+    std::unique_ptr<llvm::Module> Mod = llvm::parseIR(*ir_membuf, Err, Context);
+
+    if (!Mod)
+        {
+        // if the module didn't load, report an error
+        Err.print(name.c_str(), llvm_err);
+        llvm_err.flush();
+        error_msg = sstream.str();
+        return nullptr;
+        }
+
+    // Build the JIT and add the module
+    std::unique_ptr<llvm::orc::KaleidoscopeJIT> jit(new llvm::orc::KaleidoscopeJIT());
+    jit->addModule(std::move(Mod));
+
+    llvm_err.flush();
+    return jit;
+    }
+
+uint64_t findJITFunction(llvm::orc::KaleidoscopeJIT& jit, const std::string& name)
+    {
+    auto sym = jit.findSymbol(name);
+    if (!sym)
+        return 0;
+
+    #if defined LLVM_VERSION_MAJOR && LLVM_VERSION_MAJOR >= 5
+    return cantFail(sym.getAddress());
+    #else
+    return sym.getAddress();
+    #endif
+    }
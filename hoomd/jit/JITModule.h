@@ -0,0 +1,26 @@
+#pragma once
+
+#include "KaleidoscopeJIT.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+//! Compile an LLVM IR module with a new JIT engine
+/*! \param llvm_ir Contents of the LLVM IR file
+    \param name Name to print with parse errors
+    \param error_msg Set to the error message when compilation fails (output)
+    \returns The JIT engine that holds the compiled module, or a null pointer when compilation fails
+
+    Shared by the JIT evaluator factories.
+*/
+std::unique_ptr<llvm::orc::KaleidoscopeJIT> compileJITModule(const std::string& llvm_ir,
+                                                             const std::string& name,
+                                                             std::string& error_msg);
+
+//! Look up the address of a function in a compiled module
+/*! \param jit JIT engine returned by compileJITModule()
+    \param name Name of the function
+    \returns The address of the function, or 0 if the module does not define it
+*/
+uint64_t findJITFunction(llvm::orc::KaleidoscopeJIT& jit, const std::string& name);
@@ -0,0 +1,24 @@
+#include "PairEvalFactory.h"
+#include "JITModule.h"
+
+//! C'tor
+PairEvalFactory::PairEvalFactory(const std::string& llvm_ir)
+    {
+    // set to null pointer
+    m_eval = NULL;
+    m_eval_batch = NULL;
+
+    m_jit = compileJITModule(llvm_ir, "PairEvalFactory", m_error_msg);
+    if (!m_jit)
+        return;
+
+    m_eval = (EvalFnPtr)findJITFunction(*m_jit, "eval");
+    if (!m_eval)
+        {
+        m_error_msg = "Could not find eval function in LLVM module.\n";
+        return;
+        }
+
+    // the batched kernel is optional
+    m_eval_batch = (EvalBatchFnPtr)findJITFunction(*m_jit, "eval_batch");
+    }
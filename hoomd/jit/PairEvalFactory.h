@@ -0,0 +1,70 @@
+#pragma once
+
+// do not include python headers
+#define HOOMD_NOPYTHON
+#include "hoomd/HOOMDMath.h"
+
+#include "KaleidoscopeJIT.h"
+
+//! Compile LLVM IR for user defined MD pair potentials
+/*! PairEvalFactory loads an LLVM module and looks up two functions in it:
+     - \c eval (required) computes the energy and force/r of a single pair
+     - \c eval_batch (optional) computes the energy and force/r of a block of neighbors of a single particle i
+
+    The batched kernel is generated by jit.pair.user as a simple loop over the scalar evaluator so that clang can
+    vectorize it. IR files compiled outside of HOOMD may omit it, in which case getEvalBatch() returns NULL and
+    callers must fall back to the scalar function.
+*/
+class PairEvalFactory
+    {
+    public:
+        //! Function signature of the scalar pair evaluator
+        typedef Scalar (*EvalFnPtr)(Scalar rsq,
+            unsigned int type_i,
+            unsigned int type_j,
+            Scalar d_i,
+            Scalar d_j,
+            Scalar charge_i,
+            Scalar charge_j,
+            Scalar& force_divr);
+
+        //! Function signature of the batched pair evaluator
+        typedef void (*EvalBatchFnPtr)(unsigned int n,
+            const Scalar *rsq,
+            unsigned int type_i,
+            const unsigned int *type_j,
+            Scalar d_i,
+            const Scalar *d_j,
+            Scalar charge_i,
+            const Scalar *charge_j,
+            Scalar *force_divr,
+            Scalar *pair_eng);
+
+        //! Constructor
+        PairEvalFactory(const std::string& llvm_ir);
+
+        //! Return the scalar evaluator
+        EvalFnPtr getEval()
+            {
+            return m_eval;
+            }
+
+        //! Return the batched evaluator (may be NULL)
+        EvalBatchFnPtr getEvalBatch()
+            {
+            return m_eval_batch;
+            }
+
+        //! Get the error message from initialization
+        const std::string& getError()
+            {
+            return m_error_msg;
+            }
+
+    private:
+        std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
+        EvalFnPtr m_eval;                                  //!< Function pointer to the scalar evaluator
+        EvalBatchFnPtr m_eval_batch;                       //!< Function pointer to the batched evaluator
+
+        std::string m_error_msg; //!< The error message if initialization fails
+    };
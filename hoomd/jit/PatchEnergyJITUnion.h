@@ -87,6 +87,25 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
             float d_j,
             float charge_j);
 
+        //! evaluate the energy of the patch interaction for a batch of pairs that share particle i
+        /*! The JIT module evaluates constituent particles, so the batched kernel of PatchEnergyJIT does not apply to
+            unions. Evaluate each pair of unions with energy().
+        */
+        virtual void energy_batch(unsigned int n,
+            const vec3<float> *r_ij,
+            unsigned int type_i,
+            const quat<float>& q_i,
+            float d_i,
+            float charge_i,
+            const unsigned int *type_j,
+            const quat<float> *q_j,
+            const float *d_j,
+            const float *charge_j,
+            float *energy)
+            {
+            hpmc::PatchEnergy::energy_batch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j, energy);
+            }
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange()
             {
@@ -0,0 +1,328 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PotentialPairJIT.h"
+
+#include <sstream>
+
+/*! \file PotentialPairJIT.cc
+    \brief Defines the JIT compiled MD pair potential
+*/
+
+/*! \param sysdef System to compute forces on
+    \param nlist Neighborlist to use for computing the forces
+    \param llvm_ir Contents of the LLVM IR to load
+    \param log_suffix Name given to this instance of the force
+
+    After construction, the LLVM IR is loaded, compiled, and the per type pair parameters point to the evaluator.
+*/
+PotentialPairJIT::PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<NeighborList> nlist,
+                                   const std::string& llvm_ir,
+                                   const std::string& log_suffix)
+    : PotentialPair<EvaluatorPairJIT>(sysdef, nlist, log_suffix), m_eval(NULL), m_eval_batch(NULL)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PotentialPairJIT" << std::endl;
+
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "pair.jit: JIT pair potentials are not supported on the GPU" << std::endl;
+        throw std::runtime_error("Error initializing PotentialPairJIT");
+        }
+
+    // build the JIT
+    m_factory = std::shared_ptr<PairEvalFactory>(new PairEvalFactory(llvm_ir));
+
+    // get the evaluators
+    m_eval = m_factory->getEval();
+    m_eval_batch = m_factory->getEvalBatch();
+
+    if (!m_eval)
+        {
+        m_exec_conf->msg->error() << m_factory->getError() << std::endl;
+        throw std::runtime_error("Error compiling JIT code.");
+        }
+
+    if (!m_eval_batch)
+        m_exec_conf->msg->notice(2) << "pair.jit: No eval_batch in LLVM module, using the scalar evaluator" << std::endl;
+
+    updateJITParams();
+    }
+
+PotentialPairJIT::~PotentialPairJIT()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PotentialPairJIT" << std::endl;
+    }
+
+void PotentialPairJIT::slotNumTypesChange()
+    {
+    PotentialPair<EvaluatorPairJIT>::slotNumTypesChange();
+    updateJITParams();
+    }
+
+void PotentialPairJIT::updateJITParams()
+    {
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::overwrite);
+    for (unsigned int typ1 = 0; typ1 < m_typpair_idx.getW(); typ1++)
+        for (unsigned int typ2 = 0; typ2 < m_typpair_idx.getH(); typ2++)
+            {
+            param_type& param = h_params.data[m_typpair_idx(typ1, typ2)];
+            param.eval = m_eval;
+            param.type_i = typ1;
+            param.type_j = typ2;
+            }
+    }
+
+/*! \post The pair forces are computed for the given timestep. The neighborlist's compute method is called to ensure
+    that it is up to date before proceeding.
+
+    \param timestep specifies the current time step of the simulation
+
+    The computation follows PotentialPair::computeForces(). The difference is that the neighbors of particle i inside
+    the cutoff are first gathered into contiguous arrays, and the energies and forces of up to block_size neighbors
+    are obtained from a single call to the batched kernel.
+*/
+void PotentialPairJIT::computeForces(unsigned int timestep)
+    {
+    if (!m_eval_batch)
+        {
+        PotentialPair<EvaluatorPairJIT>::computeForces(timestep);
+        return;
+        }
+
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
+
+    // start the profile for this compute
+    if (m_prof) m_prof->push(m_prof_name);
+
+    // depending on the neighborlist settings, we can take advantage of newton's third law
+    // to reduce computations at the cost of memory access complexity: set that flag now
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+
+    // access the neighbor list, particle data, and system box
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    //force arrays
+    ArrayHandle<Scalar4> h_force(m_force,access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar>  h_virial(m_virial,access_location::host, access_mode::overwrite);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+
+    PDataFlags flags = this->m_pdata->getFlags();
+    bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
+
+    // need to start from a zero force, energy and virial
+    memset((void*)h_force.data,0,sizeof(Scalar4)*m_force.getNumElements());
+    memset((void*)h_virial.data,0,sizeof(Scalar)*m_virial.getNumElements());
+
+    // per block storage, the kernel reads and writes contiguous arrays
+    unsigned int blk_j[block_size];
+    Scalar3 blk_dx[block_size];
+    Scalar blk_rsq[block_size];
+    Scalar blk_rcutsq[block_size];
+    unsigned int blk_typej[block_size];
+    Scalar blk_dj[block_size];
+    Scalar blk_qj[block_size];
+    Scalar blk_force_divr[block_size];
+    Scalar blk_pair_eng[block_size];
+    Scalar blk_force_divr_cut[block_size];
+    Scalar blk_pair_eng_cut[block_size];
+    bool blk_shift[block_size];
+
+    // for each particle
+    for (int i = 0; i < (int)m_pdata->getN(); i++)
+        {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
+
+        Scalar di = h_diameter.data[i];
+        Scalar qi = h_charge.data[i];
+
+        // initialize current particle force, potential energy, and virial to 0
+        Scalar3 fi = make_scalar3(0, 0, 0);
+        Scalar pei = 0.0;
+        Scalar virialxxi = 0.0;
+        Scalar virialxyi = 0.0;
+        Scalar virialxzi = 0.0;
+        Scalar virialyyi = 0.0;
+        Scalar virialyzi = 0.0;
+        Scalar virialzzi = 0.0;
+
+        const unsigned int myHead = h_head_list.data[i];
+        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        unsigned int k = 0;
+        while (k < size)
+            {
+            // gather the next block of neighbors inside the cutoff
+            unsigned int n = 0;
+            bool any_shift = false;
+            for (; k < size && n < block_size; k++)
+                {
+                unsigned int j = h_nlist.data[myHead + k];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 dx = box.minImage(pi - pj);
+                Scalar rsq = dot(dx, dx);
+
+                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+                assert(typej < m_pdata->getNTypes());
+
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                Scalar rcutsq = h_rcutsq.data[typpair_idx];
+
+                if (rsq >= rcutsq)
+                    continue;
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                bool energy_shift = false;
+                if (m_shift_mode == shift)
+                    energy_shift = true;
+                else if (m_shift_mode == xplor)
+                    {
+                    if (h_ronsq.data[typpair_idx] > rcutsq)
+                        energy_shift = true;
+                    }
+                any_shift |= energy_shift;
+
+                blk_j[n] = j;
+                blk_dx[n] = dx;
+                blk_rsq[n] = rsq;
+                blk_rcutsq[n] = rcutsq;
+                blk_typej[n] = typej;
+                blk_dj[n] = h_diameter.data[j];
+                blk_qj[n] = h_charge.data[j];
+                blk_shift[n] = energy_shift;
+                n++;
+                }
+
+            if (n == 0)
+                continue;
+
+            // evaluate the whole block at once
+            m_eval_batch(n, blk_rsq, typei, blk_typej, di, blk_dj, qi, blk_qj, blk_force_divr, blk_pair_eng);
+
+            // the energy at the cutoff is also evaluated as a block
+            if (any_shift)
+                m_eval_batch(n, blk_rcutsq, typei, blk_typej, di, blk_dj, qi, blk_qj,
+                             blk_force_divr_cut, blk_pair_eng_cut);
+
+            // accumulate the results
+            for (unsigned int m = 0; m < n; m++)
+                {
+                unsigned int j = blk_j[m];
+                Scalar3 dx = blk_dx[m];
+                Scalar rsq = blk_rsq[m];
+                Scalar rcutsq = blk_rcutsq[m];
+                Scalar force_divr = blk_force_divr[m];
+                Scalar pair_eng = blk_pair_eng[m];
+
+                if (blk_shift[m])
+                    pair_eng -= blk_pair_eng_cut[m];
+
+                // modify the potential for xplor shifting
+                if (m_shift_mode == xplor)
+                    {
+                    Scalar ronsq = h_ronsq.data[m_typpair_idx(typei, blk_typej[m])];
+                    if (rsq >= ronsq && rsq < rcutsq)
+                        {
+                        // Implement XPLOR smoothing (FLOPS: 16)
+                        Scalar old_pair_eng = pair_eng;
+                        Scalar old_force_divr = force_divr;
+
+                        // calculate 1.0 / (xplor denominator)
+                        Scalar xplor_denom_inv =
+                            Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq *
+                                   (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+                        Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                        // make modifications to the old pair energy and force
+                        pair_eng = old_pair_eng * s;
+                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                        }
+                    }
+
+                Scalar force_div2r = force_divr * Scalar(0.5);
+                // add the force, potential energy and virial to the particle i
+                fi += dx*force_divr;
+                pei += pair_eng * Scalar(0.5);
+                if (compute_virial)
+                    {
+                    virialxxi += force_div2r*dx.x*dx.x;
+                    virialxyi += force_div2r*dx.x*dx.y;
+                    virialxzi += force_div2r*dx.x*dx.z;
+                    virialyyi += force_div2r*dx.y*dx.y;
+                    virialyzi += force_div2r*dx.y*dx.z;
+                    virialzzi += force_div2r*dx.z*dx.z;
+                    }
+
+                // add the force to particle j if we are using the third law
+                // only add force to local particles
+                if (third_law && j < m_pdata->getN())
+                    {
+                    h_force.data[j].x -= dx.x*force_divr;
+                    h_force.data[j].y -= dx.y*force_divr;
+                    h_force.data[j].z -= dx.z*force_divr;
+                    h_force.data[j].w += pair_eng * Scalar(0.5);
+                    if (compute_virial)
+                        {
+                        h_virial.data[0*m_virial_pitch+j] += force_div2r*dx.x*dx.x;
+                        h_virial.data[1*m_virial_pitch+j] += force_div2r*dx.x*dx.y;
+                        h_virial.data[2*m_virial_pitch+j] += force_div2r*dx.x*dx.z;
+                        h_virial.data[3*m_virial_pitch+j] += force_div2r*dx.y*dx.y;
+                        h_virial.data[4*m_virial_pitch+j] += force_div2r*dx.y*dx.z;
+                        h_virial.data[5*m_virial_pitch+j] += force_div2r*dx.z*dx.z;
+                        }
+                    }
+                }
+            }
+
+        // finally, increment the force, potential energy and virial for particle i
+        h_force.data[i].x += fi.x;
+        h_force.data[i].y += fi.y;
+        h_force.data[i].z += fi.z;
+        h_force.data[i].w += pei;
+        if (compute_virial)
+            {
+            h_virial.data[0*m_virial_pitch+i] += virialxxi;
+            h_virial.data[1*m_virial_pitch+i] += virialxyi;
+            h_virial.data[2*m_virial_pitch+i] += virialxzi;
+            h_virial.data[3*m_virial_pitch+i] += virialyyi;
+            h_virial.data[4*m_virial_pitch+i] += virialyzi;
+            h_virial.data[5*m_virial_pitch+i] += virialzzi;
+            }
+        }
+
+    if (m_prof) m_prof->pop();
+    }
+
+void export_PotentialPairJIT(pybind11::module &m)
+    {
+    export_PotentialPair<PotentialPair<EvaluatorPairJIT> >(m, "PotentialPairJITBase");
+    pybind11::class_<PotentialPairJIT, std::shared_ptr<PotentialPairJIT> >(m, "PotentialPairJIT",
+            pybind11::base< PotentialPair<EvaluatorPairJIT> >())
+            .def(pybind11::init< std::shared_ptr<SystemDefinition>,
+                                 std::shared_ptr<NeighborList>,
+                                 const std::string&,
+                                 const std::string& >())
+            .def("hasBatchKernel", &PotentialPairJIT::hasBatchKernel)
+            ;
+    }
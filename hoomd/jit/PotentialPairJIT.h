@@ -0,0 +1,72 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _POTENTIAL_PAIR_JIT_H_
+#define _POTENTIAL_PAIR_JIT_H_
+
+#include "hoomd/md/PotentialPair.h"
+
+#include "EvaluatorPairJIT.h"
+#include "PairEvalFactory.h"
+
+/*! \file PotentialPairJIT.h
+    \brief Declares the JIT compiled MD pair potential
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Compute MD pair forces with runtime generated code
+/*! PotentialPairJIT is a PotentialPair with EvaluatorPairJIT as the evaluator. It owns the PairEvalFactory that
+    holds the compiled code and fills the per type pair parameters with the function pointer on construction and
+    whenever the number of types changes. Cutoffs, r_on and shift modes are set through the usual PotentialPair
+    interface.
+
+    When the LLVM module provides the batched kernel \c eval_batch, computeForces() gathers the neighbors of each
+    particle that are inside the cutoff into blocks of up to block_size entries, evaluates each block with a single
+    call, and then accumulates forces, energies and virials exactly as PotentialPair does. The batched kernel is a
+    plain loop over contiguous arrays that clang vectorizes. When there is no batched kernel, the scalar code path
+    of PotentialPair is used.
+*/
+class PotentialPairJIT : public PotentialPair<EvaluatorPairJIT>
+    {
+    public:
+        //! Constructor
+        PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<NeighborList> nlist,
+                         const std::string& llvm_ir,
+                         const std::string& log_suffix="");
+
+        //! Destructor
+        virtual ~PotentialPairJIT();
+
+        //! Test if the batched kernel is in use
+        bool hasBatchKernel()
+            {
+            return m_eval_batch != NULL;
+            }
+
+        //! Number of neighbors evaluated per call to the batched kernel
+        static const unsigned int block_size = 64;
+
+    protected:
+        std::shared_ptr<PairEvalFactory> m_factory;     //!< The factory for the evaluator functions
+        PairEvalFactory::EvalFnPtr m_eval;              //!< Pointer to the scalar evaluator inside the JIT module
+        PairEvalFactory::EvalBatchFnPtr m_eval_batch;   //!< Pointer to the batched evaluator (may be NULL)
+
+        //! Actually compute the forces
+        virtual void computeForces(unsigned int timestep);
+
+        //! Method to be called when number of types changes
+        virtual void slotNumTypesChange();
+
+    private:
+        //! Fill the per type pair parameters with the JIT function pointer
+        void updateJITParams();
+    };
+
+//! Exports the PotentialPairJIT class to python
+void export_PotentialPairJIT(pybind11::module &m);
+
+#endif // _POTENTIAL_PAIR_JIT_H_
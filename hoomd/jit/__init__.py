@@ -15,3 +15,9 @@ existing job scripts may need to be updated. **Maintainer:** Joshua A. Anderson,
 """
 
 from hoomd.jit import patch
+
+# jit.pair requires the md package
+try:
+    from hoomd.jit import pair
+except ImportError:
+    pass
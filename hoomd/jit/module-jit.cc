@@ -4,6 +4,10 @@
 #include "PatchEnergyJIT.h"
 #include "PatchEnergyJITUnion.h"
 
+#ifdef BUILD_MD
+#include "PotentialPairJIT.h"
+#endif
+
 #include <hoomd/extern/pybind/include/pybind11/pybind11.h>
 
 //! Create the python module
@@ -17,5 +21,9 @@ PYBIND11_PLUGIN(_jit)
     export_PatchEnergyJIT(m);
     export_PatchEnergyJITUnion(m);
 
+    #ifdef BUILD_MD
+    export_PotentialPairJIT(m);
+    #endif
+
     return m.ptr();
     }
@@ -0,0 +1,261 @@
+# Copyright (c) 2009-2017 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+R""" JIT compiled pair potentials for MD.
+"""
+
+from hoomd import _hoomd
+from hoomd.jit import _jit
+from hoomd.md import pair as md_pair
+import hoomd
+
+from distutils.spawn import find_executable
+import subprocess
+import os
+
+class user(md_pair.pair):
+    R''' Define an arbitrary MD pair potential.
+
+    Args:
+        r_cut (float): Default cutoff radius (in distance units).
+        nlist (:py:mod:`hoomd.md.nlist`): Neighbor list
+        code (str): C++ code to compile
+        llvm_ir_file (str): File name of the llvm IR file to load.
+        clang_exec (str): The Clang executable to use
+        name (str): Name of the force instance.
+
+    The :py:class:`user` pair potential takes C++ code, JIT compiles it at run time and calls it natively to evaluate
+    the energy and force of every pair of particles within the cutoff. It enables researchers to implement
+    custom isotropic pair potentials without tabulating them in :py:class:`hoomd.md.pair.table` and without
+    modifying and recompiling HOOMD.
+
+    :py:class:`user` supports all the features of standard pair potentials documented in
+    :py:class:`hoomd.md.pair.pair`: per type pair cutoffs, energy shifting and XPLOR smoothing. The only
+    coefficients are *r_cut* and *r_on*. Every type pair must still be listed in ``pair_coeff``, for example by
+    setting *r_cut* for all pairs with ``pair_coeff.set(types, types, r_cut=...)``.
+
+    .. rubric:: C++ code
+
+    Supply C++ code to the *code* argument and :py:class:`user` will compile the code and call it to evaluate
+    the pair potential. Compilation assumes that a recent ``clang`` installation is on your PATH.
+
+    The text provided in *code* is the body of a function with the following signature:
+
+    .. code::
+
+        Scalar eval(Scalar rsq,
+                    unsigned int type_i,
+                    unsigned int type_j,
+                    Scalar d_i,
+                    Scalar d_j,
+                    Scalar charge_i,
+                    Scalar charge_j,
+                    Scalar& force_divr)
+
+    * ``Scalar`` is defined in HOOMDMath.h. It is ``double`` unless HOOMD is compiled in single precision.
+    * *rsq* is the squared distance between the particles.
+    * *type_i* and *type_j* are the integer types of the particles.
+    * *d_i* and *d_j* are the diameters of the particles.
+    * *charge_i* and *charge_j* are the charges of the particles.
+    * Your code *must* write the force divided by r, :math:`-\frac{1}{r}\frac{\partial V}{\partial r}`, to
+      *force_divr* and return the pair energy :math:`V(r)`.
+    * The function is only called for :math:`r < r_{\mathrm{cut}}` and, when the energy is shifted, with
+      *rsq* = :math:`r_{\mathrm{cut}}^2`.
+
+    :py:class:`user` also compiles a batched version of the code that evaluates a block of neighbors of a single
+    particle in one call. The batched loop is vectorized by clang, so keep the code free of function calls that
+    cannot be inlined (``fast::exp``, ``fast::sqrt``, etc. are fine).
+
+    Example:
+
+    .. code-block:: python
+
+        lennard_jones = """Scalar r2inv = Scalar(1.0) / rsq;
+                           Scalar r6inv = r2inv * r2inv * r2inv;
+                           force_divr = r2inv * r6inv * (Scalar(48.0) * r6inv - Scalar(24.0));
+                           return Scalar(4.0) * r6inv * (r6inv - Scalar(1.0));
+                        """
+        nl = md.nlist.cell()
+        lj = hoomd.jit.pair.user(r_cut=2.5, nlist=nl, code=lennard_jones)
+        lj.pair_coeff.set(['A', 'B'], ['A', 'B'], r_cut=2.5)
+        lj.set_params(mode='shift')
+
+    .. rubric:: LLVM IR code
+
+    You can compile outside of HOOMD and provide a direct link to the LLVM IR file in *llvm_ir_file*. A
+    compatible file contains an extern "C" eval function with the signature given above. It may also contain an
+    extern "C" function ``eval_batch`` with the signature:
+
+    .. code::
+
+        void eval_batch(unsigned int n,
+                        const Scalar *rsq,
+                        unsigned int type_i,
+                        const unsigned int *type_j,
+                        Scalar d_i,
+                        const Scalar *d_j,
+                        Scalar charge_i,
+                        const Scalar *charge_j,
+                        Scalar *force_divr,
+                        Scalar *pair_eng)
+
+    that evaluates *n* pairs at once. When ``eval_batch`` is not present, ``eval`` is called once per pair.
+
+    Compile the file with clang: ``clang -O3 --std=c++11 -DHOOMD_NOPYTHON -I /path/to/hoomd/include -S -emit-llvm code.cc``
+    to produce the LLVM IR in ``code.ll``. Add ``-DSINGLE_PRECISION`` when HOOMD is compiled in single precision.
+
+    Note:
+        :py:class:`user` is only available on the CPU.
+
+    .. versionadded:: 2.3
+    '''
+    def __init__(self, r_cut, nlist, code=None, llvm_ir_file=None, clang_exec=None, name=None):
+        hoomd.util.print_status_line();
+
+        # check if initialization has occurred
+        if hoomd.context.exec_conf is None:
+            hoomd.context.msg.error("Cannot create pair potential before context initialization\n");
+            raise RuntimeError('Error creating pair potential');
+
+        # raise an error if this run is on the GPU
+        if hoomd.context.exec_conf.isCUDAEnabled():
+            hoomd.context.msg.error("JIT pair potentials are not supported on the GPU\n");
+            raise RuntimeError("Error initializing pair potential");
+
+        # initialize the base class
+        md_pair.pair.__init__(self, r_cut, nlist, name);
+
+        if code is not None:
+            llvm_ir = self.compile_user(code, clang_exec)
+        else:
+            # IR is a text file
+            with open(llvm_ir_file,'r') as f:
+                llvm_ir = f.read()
+
+        # create the c++ mirror class
+        self.cpp_force = _jit.PotentialPairJIT(hoomd.context.current.system_definition, self.nlist.cpp_nlist, llvm_ir, self.name);
+        self.cpp_class = _jit.PotentialPairJIT;
+
+        hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
+
+        # the only coefficients are r_cut and r_on
+        self.required_coeffs = [];
+
+    def compile_user(self, code, clang_exec, fn=None):
+        R'''Helper function to compile the provided code into LLVM IR
+
+        Args:
+            code (str): C++ code to compile
+            clang_exec (str): The Clang executable to use
+            fn (str): If provided, the code will be written to a file.
+
+        .. versionadded:: 2.3
+        '''
+        cpp_function = """
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+extern "C"
+{
+static inline Scalar eval_pair(Scalar rsq,
+    unsigned int type_i,
+    unsigned int type_j,
+    Scalar d_i,
+    Scalar d_j,
+    Scalar charge_i,
+    Scalar charge_j,
+    Scalar& force_divr)
+    {
+"""
+        cpp_function += code
+        cpp_function += """
+    }
+
+Scalar eval(Scalar rsq,
+    unsigned int type_i,
+    unsigned int type_j,
+    Scalar d_i,
+    Scalar d_j,
+    Scalar charge_i,
+    Scalar charge_j,
+    Scalar& force_divr)
+    {
+    return eval_pair(rsq, type_i, type_j, d_i, d_j, charge_i, charge_j, force_divr);
+    }
+
+void eval_batch(unsigned int n,
+    const Scalar * __restrict__ rsq,
+    unsigned int type_i,
+    const unsigned int * __restrict__ type_j,
+    Scalar d_i,
+    const Scalar * __restrict__ d_j,
+    Scalar charge_i,
+    const Scalar * __restrict__ charge_j,
+    Scalar * __restrict__ force_divr,
+    Scalar * __restrict__ pair_eng)
+    {
+    #pragma clang loop vectorize(enable) interleave(enable)
+    for (unsigned int k = 0; k < n; k++)
+        pair_eng[k] = eval_pair(rsq[k], type_i, type_j[k], d_i, d_j[k], charge_i, charge_j[k], force_divr[k]);
+    }
+}
+"""
+
+        include_path = os.path.dirname(hoomd.__file__) + '/include';
+        include_path_source = hoomd._hoomd.__hoomd_source_dir__;
+
+        if clang_exec is not None:
+            clang = clang_exec;
+        else:
+            clang = find_executable('clang');
+
+        # match the floating point precision of the hoomd build
+        defines = ['-DHOOMD_NOPYTHON']
+        if 'SINGLE' in hoomd._hoomd.hoomd_compile_flags().split():
+            defines.append('-DSINGLE_PRECISION')
+
+        if fn is not None:
+            cmd = [clang, '-O3', '--std=c++11'] + defines + ['-I', include_path, '-I', include_path_source, '-S', '-emit-llvm','-x','c++', '-o',fn,'-']
+        else:
+            cmd = [clang, '-O3', '--std=c++11'] + defines + ['-I', include_path, '-I', include_path_source, '-S', '-emit-llvm','-x','c++', '-o','-','-']
+        p = subprocess.Popen(cmd,stdin=subprocess.PIPE,stdout=subprocess.PIPE,stderr=subprocess.PIPE)
+
+        # pass C++ function to stdin
+        output = p.communicate(cpp_function.encode('utf-8'))
+        llvm_ir = output[0].decode()
+
+        if p.returncode != 0:
+            hoomd.context.msg.error("Error compiling provided code\n");
+            hoomd.context.msg.error("Command "+' '.join(cmd)+"\n");
+            hoomd.context.msg.error(output[1].decode()+"\n");
+            raise RuntimeError("Error initializing pair potential");
+
+        return llvm_ir
+
+    def process_coeff(self, coeff):
+        # the JIT code has no per type pair parameters
+        return None;
+
+    ## \internal
+    # \brief Set r_cut and r_on for all type pairs
+    # \details The per type pair parameters point to the compiled code and are managed in C++
+    def update_coeffs(self):
+        coeff_list = ["r_cut", "r_on"];
+        # check that the pair coefficents are valid
+        if not self.pair_coeff.verify(self.required_coeffs + coeff_list):
+            hoomd.context.msg.error("Not all pair coefficients are set\n");
+            raise RuntimeError("Error updating pair coefficients");
+
+        ntypes = hoomd.context.current.system_definition.getParticleData().getNTypes();
+        type_list = [];
+        for i in range(0,ntypes):
+            type_list.append(hoomd.context.current.system_definition.getParticleData().getNameByType(i));
+
+        for i in range(0,ntypes):
+            for j in range(i,ntypes):
+                r_cut = self.pair_coeff.get(type_list[i], type_list[j], 'r_cut');
+                r_on = self.pair_coeff.get(type_list[i], type_list[j], 'r_on');
+
+                # rcut can now have "invalid" C++ values, which we round up to zero
+                self.cpp_force.setRcut(i, j, max(r_cut, 0.0));
+                self.cpp_force.setRon(i, j, max(r_on, 0.0));
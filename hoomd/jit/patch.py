@@ -79,6 +79,10 @@ class user(object):
                       """
         patch = hoomd.jit.patch.user(mc=mc, r_cut=1.1, code=square_well)
 
+    HPMC collects all neighbors of a trial move within *r_cut* and evaluates them with one call to a batched version
+    of the code, which clang vectorizes. Keep the code free of function calls that cannot be inlined to benefit from
+    vectorization.
+
     .. rubric:: LLVM IR code
 
     You can compile outside of HOOMD and provide a direct link
@@ -98,6 +102,25 @@ class user(object):
 
     ``vec3`` and ``quat`` are defined in HOOMDMath.h.
 
+    The file may also contain an extern "C" function ``eval_batch`` that evaluates *n* pairs that share particle *i*
+    at once and writes the energy of pair *k* to ``energy[k]``:
+
+    .. code::
+
+        void eval_batch(unsigned int n,
+                        const vec3<float> *r_ij,
+                        unsigned int type_i,
+                        const quat<float>& q_i,
+                        float d_i,
+                        float charge_i,
+                        const unsigned int *type_j,
+                        const quat<float> *q_j,
+                        const float *d_j,
+                        const float *charge_j,
+                        float *energy)
+
+    When ``eval_batch`` is not present, ``eval`` is called once per pair.
+
     Compile the file with clang: ``clang -O3 --std=c++11 -DHOOMD_NOPYTHON -I /path/to/hoomd/include -S -emit-llvm code.cc`` to produce
     the LLVM IR in ``code.ll``.
 
@@ -154,7 +177,7 @@ class user(object):
 
 extern "C"
 {
-float eval(const vec3<float>& r_ij,
+static inline float eval_patch(const vec3<float>& r_ij,
     unsigned int type_i,
     const quat<float>& q_i,
     float d_i,
@@ -168,6 +191,36 @@ float eval(const vec3<float>& r_ij,
         cpp_function += code
         cpp_function += """
     }
+
+float eval(const vec3<float>& r_ij,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    unsigned int type_j,
+    const quat<float>& q_j,
+    float d_j,
+    float charge_j)
+    {
+    return eval_patch(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
+    }
+
+void eval_batch(unsigned int n,
+    const vec3<float> * __restrict__ r_ij,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    const unsigned int * __restrict__ type_j,
+    const quat<float> * __restrict__ q_j,
+    const float * __restrict__ d_j,
+    const float * __restrict__ charge_j,
+    float * __restrict__ energy)
+    {
+    #pragma clang loop vectorize(enable) interleave(enable)
+    for (unsigned int k = 0; k < n; k++)
+        energy[k] = eval_patch(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k], q_j[k], d_j[k], charge_j[k]);
+    }
 }
 """
 
@@ -10,9 +10,11 @@
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <vector>
 
 #include "NeighborList.h"
 #include "hoomd/ForceCompute.h"
+#include "hoomd/VectorMath.h"
 
 /*! \file AnisoPotentialPair.h
     \brief Defines the template class for anisotropic pair potentials
@@ -52,6 +54,10 @@
     potential aniso_evaluator class passed in. See the appropriate documentation for the aniso_evaluator for the definition of each
     element of the parameters.
 
+    Evaluators that return true from needsFrames() receive the space to body frame rotation matrices of both particles
+    through setFrames(). On the CPU, these are computed once per particle and step instead of once per pair. Evaluators
+    must still work from the quaternions alone, which is what the GPU kernels pass.
+
     For profiling and logging, AnisoPotentialPair needs to know the name of the potential. For now, that will be queried from
     the aniso_evaluator. Perhaps in the future we could allow users to change that so multiple pair potentials could be logged
     independantly.
@@ -116,6 +122,7 @@ class AnisoPotentialPair : public ForceCompute
         GPUArray<param_type> m_params;   //!< Pair parameters per type pair
         std::string m_prof_name;                    //!< Cached profiler name
         std::string m_log_name;                     //!< Cached log name
+        std::vector< rotmat3<Scalar> > m_frames;   //!< Space to body frame rotation of each local and ghost particle
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -296,6 +303,15 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
+    // the orientations change every step, so rotate them into frames once per step rather than once per pair
+    if (aniso_evaluator::needsFrames())
+        {
+        unsigned int n_frames = m_pdata->getN() + m_pdata->getNGhosts();
+        m_frames.resize(n_frames);
+        for (unsigned int i = 0; i < n_frames; i++)
+            m_frames[i] = rotmat3<Scalar>(conj(quat<Scalar>(h_orientation.data[i])));
+        }
+
     // for each particle
     for (int i = 0; i < (int)m_pdata->getN(); i++)
         {
@@ -383,6 +399,8 @@ void AnisoPotentialPair< aniso_evaluator >::computeForces(unsigned int timestep)
                 eval.setDiameter(di, dj);
             if (aniso_evaluator::needsCharge())
                 eval.setCharge(qi, qj);
+            if (aniso_evaluator::needsFrames())
+                eval.setFrames(m_frames[i], m_frames[j]);
 
             bool evaluated = eval.evaluate(force, pair_eng, energy_shift,torque_i,torque_j);
 
@@ -5,6 +5,7 @@
 // Maintainer: phillicl
 
 #include "BondTablePotential.h"
+#include "TableInterpolation.h"
 #include "hoomd/BondedGroupData.h"
 
 namespace py = pybind11;
@@ -24,7 +25,7 @@ using namespace std;
 BondTablePotential::BondTablePotential(std::shared_ptr<SystemDefinition> sysdef,
                                unsigned int table_width,
                                const std::string& log_suffix)
-        : ForceCompute(sysdef), m_table_width(table_width)
+        : ForceCompute(sysdef), m_table_width(table_width), m_cubic(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing BondTablePotential" << endl;
 
@@ -234,18 +235,12 @@ void BondTablePotential::computeForces(unsigned int timestep)
             unsigned int value_i = (unsigned int)floor(value_f);
             Scalar2 VF0 = h_tables.data[m_table_value(value_i, type)];
             Scalar2 VF1 = h_tables.data[m_table_value(value_i+1, type)];
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
+            // compute the interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
             // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            table_interpolate(VF0, VF1, f, delta_r, m_cubic, V, F);
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar force_divr = Scalar(0.0);
@@ -296,5 +291,6 @@ void export_BondTablePotential(py::module& m)
     py::class_<BondTablePotential, std::shared_ptr<BondTablePotential> >(m, "BondTablePotential", py::base<ForceCompute>())
     .def(py::init< std::shared_ptr<SystemDefinition>, unsigned int, const std::string& >())
     .def("setTable", &BondTablePotential::setTable)
+    .def("setCubicInterpolation", &BondTablePotential::setCubicInterpolation)
     ;
     }
@@ -92,6 +92,7 @@ void BondTablePotentialGPU::computeForces(unsigned int timestep)
                              d_params.data,
                              m_table_width,
                              m_table_value,
+                             m_cubic,
                              d_flags.data,
                              m_tuner->getParam(),
                              m_exec_conf->getComputeCapability());
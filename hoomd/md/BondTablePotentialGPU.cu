@@ -5,6 +5,7 @@
 // Maintainer: joaander
 
 #include "BondTablePotentialGPU.cuh"
+#include "TableInterpolation.h"
 #include "hoomd/TextureTools.h"
 
 
@@ -32,6 +33,7 @@ scalar2_tex_t tables_tex;
     \param n_bond_type number of bond types
     \param d_params Parameters for each table associated with a type pair
     \param table_value index helper function
+    \param cubic True to interpolate the tables with cubic splines
     \param d_flags Flag allocated on the device for use in checking for bonds that cannot be evaluated
 
     See BondTablePotential for information on the memory layout.
@@ -53,6 +55,7 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
                                      const Scalar2 *d_tables,
                                      const Scalar4 *d_params,
                                      const Index2D table_value,
+                                     const bool cubic,
                                      unsigned int *d_flags)
     {
 
@@ -126,18 +129,12 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
 
             Scalar2 VF0 = texFetchScalar2(d_tables, tables_tex, table_value(value_i, cur_bond_type));
             Scalar2 VF1 = texFetchScalar2(d_tables, tables_tex, table_value(value_i+1, cur_bond_type));
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
+            // compute the interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
             // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            table_interpolate(VF0, VF1, f, delta_r, cubic, V, F);
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar forcemag_divr = 0.0f;
@@ -187,6 +184,7 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
     \param d_params Parameters for each table associated with a type pair
     \param table_width Number of entries in the table
     \param table_value indexer helper
+    \param cubic True to interpolate the tables with cubic splines
     \param d_flags flags on the device - a 1 will be written if evaluation
                    of forces failed for any bond
     \param block_size Block size at which to run the kernel
@@ -208,6 +206,7 @@ cudaError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                      const Scalar4 *d_params,
                                      const unsigned int table_width,
                                      const Index2D &table_value,
+                                     const bool cubic,
                                      unsigned int *d_flags,
                                      const unsigned int block_size,
                                      const unsigned int compute_capability)
@@ -255,6 +254,7 @@ cudaError_t gpu_compute_bondtable_forces(Scalar4* d_force,
              d_tables,
              d_params,
              table_value,
+             cubic,
              d_flags);
 
     return cudaSuccess;
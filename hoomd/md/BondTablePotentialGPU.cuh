@@ -31,6 +31,7 @@ cudaError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                      const Scalar4 *d_params,
                                      const unsigned int table_width,
                                      const Index2D &table_value,
+                                     const bool cubic,
                                      unsigned int *d_flags,
                                      const unsigned int block_size,
                                      const unsigned int compute_capability);
@@ -0,0 +1,113 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#include "hoomd/BondedGroupData.h"
+
+#ifdef ENABLE_TBB
+#include <tbb/tbb.h>
+#endif
+
+/*! \file BondedForceGather.h
+    \brief Declares a helper to compute bonded forces in parallel on the CPU
+*/
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifndef __BONDED_FORCE_GATHER_H__
+#define __BONDED_FORCE_GATHER_H__
+
+#ifdef ENABLE_TBB
+//! Compute bonded forces in parallel over the local particles
+/*! \param group_data Bonded group data (bonds, angles, dihedrals or impropers)
+    \param N Number of local particles
+    \param h_force Force array to write (force in x,y,z, energy in w)
+    \param h_virial Virial array to write
+    \param virial_pitch Pitch of the virial array
+    \param compute_virial Set to false to skip the virial
+    \param compute Functor that evaluates a single group
+
+    The serial force computes loop over the groups and scatter the forces to the group members. Run in parallel,
+    this would need atomic updates and the summation order would depend on the thread schedule. Instead, this
+    helper loops in parallel over the local particles and gathers the force on each particle from its entries in
+    the per-particle group table of BondedGroupData (the same table that the GPU kernels use). Each group is
+    evaluated once for every member, but every thread only writes to the particles it owns, so no atomic
+    operations are needed and the result is independent of the number of threads.
+
+    \a compute is called as <code>compute(idx, type, f, eng, virial)</code> where \a idx holds the particle
+    indices of the group members in group order and \a type is the group type. It must write the force on each
+    member to <code>f[0..size-1]</code>, the energy per member to \a eng and the virial per member to
+    <code>virial[0..5]</code>.
+
+    \a h_force and \a h_virial are overwritten for the local particles. Ghost particles are left untouched.
+*/
+template<class group_data, class Compute>
+void gather_bonded_forces(std::shared_ptr<group_data> data,
+                          unsigned int N,
+                          Scalar4 *h_force,
+                          Scalar *h_virial,
+                          unsigned int virial_pitch,
+                          bool compute_virial,
+                          const Compute& compute)
+    {
+    const unsigned int group_size = group_data::size;
+
+    // access the group table (this rebuilds it if needed)
+    const GPUArray<typename group_data::members_t>& gpu_table = data->getGPUTable();
+    const Index2D& gpu_table_indexer = data->getGPUTableIndexer();
+
+    ArrayHandle<typename group_data::members_t> h_gpu_table(gpu_table, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_gpu_pos_table(data->getGPUPosTable(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_groups(data->getNGroupsArray(), access_location::host, access_mode::read);
+
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (unsigned int idx = r.begin(); idx != r.end(); ++idx)
+            {
+            Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+            Scalar virial[6];
+            for (unsigned int k = 0; k < 6; k++)
+                virial[k] = Scalar(0.0);
+
+            unsigned int n_groups = h_n_groups.data[idx];
+            for (unsigned int group_idx = 0; group_idx < n_groups; group_idx++)
+                {
+                const typename group_data::members_t& cur_group = h_gpu_table.data[gpu_table_indexer(idx, group_idx)];
+                unsigned int cur_group_pos = h_gpu_pos_table.data[gpu_table_indexer(idx, group_idx)];
+
+                // the table lists the other members in group order, and the type in the last element
+                unsigned int member_idx[group_size];
+                unsigned int n = 0;
+                for (unsigned int j = 0; j < group_size; j++)
+                    member_idx[j] = (j == cur_group_pos) ? idx : cur_group.idx[n++];
+                unsigned int cur_group_type = cur_group.idx[group_size-1];
+
+                Scalar3 f[group_size];
+                Scalar eng = Scalar(0.0);
+                Scalar group_virial[6];
+                compute(member_idx, cur_group_type, f, eng, group_virial);
+
+                force.x += f[cur_group_pos].x;
+                force.y += f[cur_group_pos].y;
+                force.z += f[cur_group_pos].z;
+                force.w += eng;
+
+                if (compute_virial)
+                    for (unsigned int k = 0; k < 6; k++)
+                        virial[k] += group_virial[k];
+                }
+
+            h_force[idx] = force;
+            for (unsigned int k = 0; k < 6; k++)
+                h_virial[k*virial_pitch+idx] = virial[k];
+            }
+        });
+    }
+#endif
+
+#endif // __BONDED_FORCE_GATHER_H__
@@ -70,7 +70,7 @@ class EvaluatorPairDipole
         */
         DEVICE EvaluatorPairDipole(Scalar3& _dr, Scalar4& _quat_i, Scalar4& _quat_j, Scalar _rcutsq, param_type& params)
             :dr(_dr), rcutsq(_rcutsq), quat_i(_quat_i), quat_j(_quat_j),
-             mu(params.x), A(params.y), kappa(params.z)
+             mu(params.x), A(params.y), kappa(params.z), have_frames(false)
             {
             }
 
@@ -103,6 +103,24 @@ class EvaluatorPairDipole
             q_j = qj;
             }
 
+        //! uses precomputed body frames
+        DEVICE static bool needsFrames()
+            {
+            return true;
+            }
+
+        //! Accept the optional body frames
+        /*! \param frame_i Rotation from the space frame to the body frame of particle i (rows are the body axes)
+            \param frame_j Rotation from the space frame to the body frame of particle j
+        */
+        DEVICE void setFrames(const rotmat3<Scalar>& frame_i, const rotmat3<Scalar>& frame_j)
+            {
+            // the dipoles point along the body x axes
+            axis_i = frame_i.row0;
+            axis_j = frame_j.row0;
+            have_frames = true;
+            }
+
         //! Evaluate the force and energy
         /*! \param force Output parameter to write the computed force.
             \param pair_eng Output parameter to write the computed pair energy.
@@ -126,8 +144,17 @@ class EvaluatorPairDipole
             Scalar r5inv = r3inv*r2inv;
 
             // convert dipole vector in the body frame of each particle to space frame
-            vec3<Scalar> p_i = rotate(quat<Scalar>(quat_i), vec3<Scalar>(mu, 0, 0));
-            vec3<Scalar> p_j = rotate(quat<Scalar>(quat_j), vec3<Scalar>(mu, 0, 0));
+            vec3<Scalar> p_i, p_j;
+            if (have_frames)
+                {
+                p_i = mu*axis_i;
+                p_j = mu*axis_j;
+                }
+            else
+                {
+                p_i = rotate(quat<Scalar>(quat_i), vec3<Scalar>(mu, 0, 0));
+                p_j = rotate(quat<Scalar>(quat_j), vec3<Scalar>(mu, 0, 0));
+                }
 
             vec3<Scalar> f;
             vec3<Scalar> t_i;
@@ -224,6 +251,8 @@ class EvaluatorPairDipole
         Scalar q_i, q_j;            //!< Stored particle charges
         Scalar4 quat_i,quat_j;      //!< Stored quaternion of ith and jth particle from constuctor
         Scalar mu, A, kappa;        //!< Stored dipole magnitude, electrostatic magnitude and inverse screeing length
+        vec3<Scalar> axis_i,axis_j; //!< Body x axes of ith and jth particle in the space frame
+        bool have_frames;           //!< True if the axes were set from precomputed frames
     };
 
 
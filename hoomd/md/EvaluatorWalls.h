@@ -13,6 +13,7 @@
 
 #ifndef NVCC
 #include <string>
+#include <limits>
 #endif
 
 #include "hoomd/BoxDim.h"
@@ -36,9 +37,11 @@ struct wall_type{
     unsigned int     numSpheres; // these data types come first, since the structs are aligned already
     unsigned int     numCylinders;
     unsigned int     numPlanes;
+    unsigned int     numMeshes;
     SphereWall       Spheres[MAX_N_SWALLS];
     CylinderWall     Cylinders[MAX_N_CWALLS];
     PlaneWall        Planes[MAX_N_PWALLS];
+    const MeshWall*  Meshes; // host array of numMeshes mesh walls, only set on the CPU
 };
 
 //! Applys a wall force from all walls in the field parameter
@@ -263,6 +266,36 @@ class EvaluatorWalls
                         extrapEvaluator(F, energy, drv, rextrapsq, r);
                         }
                     }
+                #ifndef NVCC
+                for (unsigned int k = 0; k < m_field.numMeshes; k++)
+                    {
+                    // particles on the outside need the distance to the mesh no matter how far away they are
+                    vec3<Scalar> normal;
+                    drv = vecPtToWall(m_field.Meshes[k], position, inside, normal,
+                        std::numeric_limits<Scalar>::infinity());
+                    rsq = dot(drv, drv);
+                    if (inside && rsq>=rextrapsq)
+                        {
+                        callEvaluator(F, energy, drv);
+                        }
+                    else
+                        {
+                        Scalar r = fast::sqrt(rsq);
+                        if (rsq == 0.0)
+                            {
+                            inside = true; //just in case
+                            drv = (m_field.Meshes[k].inside) ? normal : -normal;
+                            }
+                        else
+                            {
+                            drv *= 1/r;
+                            }
+                        r = (inside) ? m_params.rextrap - r : m_params.rextrap + r;
+                        drv *= (inside) ? r : -r;
+                        extrapEvaluator(F, energy, drv, rextrapsq, r);
+                        }
+                    }
+                #endif
                 }
             else //normal mode
                 {
@@ -290,6 +323,19 @@ class EvaluatorWalls
                         callEvaluator(F, energy, drv);
                         }
                     }
+                #ifndef NVCC
+                // only the part of the mesh within the cutoff needs to be searched
+                Scalar rcut = fast::sqrt(m_params.rcutsq);
+                for (unsigned int k = 0; k < m_field.numMeshes; k++)
+                    {
+                    vec3<Scalar> normal;
+                    drv = vecPtToWall(m_field.Meshes[k], position, inside, normal, rcut);
+                    if (inside)
+                        {
+                        callEvaluator(F, energy, drv);
+                        }
+                    }
+                #endif
                 }
 
             // evaluate virial
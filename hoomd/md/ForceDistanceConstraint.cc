@@ -7,6 +7,7 @@
 #include "ForceDistanceConstraint.h"
 
 #include <string.h>
+#include <algorithm>
 using namespace Eigen;
 namespace py = pybind11;
 
@@ -20,8 +21,8 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
         : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()),
           m_cmatrix(m_exec_conf), m_cvec(m_exec_conf), m_lagrange(m_exec_conf),
           m_rel_tol(1e-3), m_constraint_violated(m_exec_conf), m_condition(m_exec_conf),
-          m_sparse_idxlookup(m_exec_conf), m_constraint_reorder(true), m_constraints_added_removed(true),
-          m_d_max(0.0)
+          m_sparse_idxlookup(m_exec_conf), m_solver(direct), m_solver_tol(1e-8), m_refactor(true),
+          m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -63,7 +64,6 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
 
     // reallocate through amortized resizin
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
-    m_cmatrix.resize(n_constraint*n_constraint);
     m_cvec.resize(n_constraint);
 
     // populate the terms in the matrix vector equation
@@ -82,27 +82,24 @@ void ForceDistanceConstraint::computeForces(unsigned int timestep)
         m_prof->pop();
     }
 
+/*! The matrix is assembled in sparse form. Row n only has non-zero elements in the columns of the constraints that
+    share a particle with constraint n, which are found in the per-particle constraint table of ConstraintData.
+    \param timestep Current timestep
+*/
 void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
     {
-    // fill the matrix in column-major order
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
 
-    if (m_constraint_reorder)
-        {
-        // reset flag
-        m_constraint_reorder = false;
-
-        // resize lookup matrix
-        m_sparse_idxlookup.resize(n_constraint*n_constraint);
+    // the sparsity pattern is determined below
+    m_constraint_reorder = false;
 
-        ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
+    // access the per-particle constraint table (this rebuilds it if needed)
+    const GPUArray<ConstraintData::members_t>& gpu_constraint_list = m_cdata->getGPUTable();
+    const Index2D& gpu_table_indexer = m_cdata->getGPUTableIndexer();
 
-        // reset lookup matrix values to -1
-        for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
-            {
-            h_sparse_idxlookup.data[i] = -1;
-            }
-        }
+    ArrayHandle<ConstraintData::members_t> h_gpu_clist(gpu_constraint_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_gpu_n_constraints(m_cdata->getNGroupsArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_gpu_cpos(m_cdata->getGPUPosTable(), access_location::host, access_mode::read);
 
     // access particle data
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
@@ -110,15 +107,13 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_netforce(m_pdata->getNetForce(), access_location::host, access_mode::read);
 
-    // access matrix elements
-    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::overwrite);
+    // access the RHS vector
     ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::overwrite);
 
-    // clear matrix
-    memset(h_cmatrix.data, 0, sizeof(double)*m_cmatrix.size());
-
     const BoxDim& box = m_pdata->getBox();
 
+    m_triplets.clear();
+
     unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
     for (unsigned int n = 0; n < n_constraint; ++n)
         {
@@ -139,7 +134,6 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
             throw std::runtime_error("Error in constraint calculation");
             }
 
-
         vec3<Scalar> ra(h_pos.data[idx_a]);
         vec3<Scalar> rb(h_pos.data[idx_b]);
         vec3<Scalar> rn(ra-rb);
@@ -155,68 +149,65 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
         vec3<Scalar> rndot(va-vb);
         vec3<Scalar> qn(rn+rndot*m_deltaT);
 
-        // fill matrix row
-        for (unsigned int m = 0; m < n_constraint; ++m)
+        // fill the matrix row, looping over the constraints of both particles
+        for (unsigned int i = 0; i < 2; ++i)
             {
-            // lookup the tag of each of the particles participating in the constraint
-            const ConstraintData::members_t constraint_m = m_cdata->getMembersByIndex(m);
-            assert(constraint_m.tag[0] <= m_pdata->getMaximumTag());
-            assert(constraint_m.tag[1] <= m_pdata->getMaximumTag());
-
-            // transform a and b into indicies into the particle data arrays
-            // (MEM TRANSFER: 4 integers)
-            unsigned int idx_m_a = h_rtag.data[constraint_m.tag[0]];
-            unsigned int idx_m_b = h_rtag.data[constraint_m.tag[1]];
-            assert(idx_m_a <= m_pdata->getN()+m_pdata->getNGhosts());
-            assert(idx_m_b <= m_pdata->getN()+m_pdata->getNGhosts());
-
-            if (idx_m_a >= max_local || idx_m_b >= max_local)
+            unsigned int idx = (i == 0) ? idx_a : idx_b;
+            unsigned int n_constraint_ptl = h_gpu_n_constraints.data[idx];
+
+            for (unsigned int cidx = 0; cidx < n_constraint_ptl; ++cidx)
                 {
-                this->m_exec_conf->msg->error() << "constrain.distance(): constraint " <<
-                    constraint_m.tag[0] << " " << constraint_m.tag[1] << " incomplete." << std::endl << std::endl;
-                throw std::runtime_error("Error in constraint calculation");
-                }
+                const ConstraintData::members_t& cur_constraint = h_gpu_clist.data[gpu_table_indexer(idx, cidx)];
 
-            vec3<Scalar> rm_a(h_pos.data[idx_m_a]);
-            vec3<Scalar> rm_b(h_pos.data[idx_m_b]);
-            vec3<Scalar> rm(rm_a-rm_b);
+                // the other ptl in the constraint
+                unsigned int idx_other = cur_constraint.idx[0];
 
-            // apply minimum image
-            rm = box.minImage(rm);
+                // constraints between a and b have already been visited from a
+                if (i == 1 && idx_other == idx_a)
+                    continue;
 
-            double delta(0.0);
-            if (idx_m_a == idx_a)
-                {
-                delta += double(4.0)*dot(qn,rm)/ma;
-                }
-            if (idx_m_b == idx_a)
-                {
-                delta -= double(4.0)*dot(qn,rm)/ma;
-                }
-            if (idx_m_a == idx_b)
-                {
-                delta -= double(4.0)*dot(qn,rm)/mb;
-                }
-            if (idx_m_b == idx_b)
-                {
-                delta += double(4.0)*dot(qn,rm)/mb;
-                }
+                // constraint index
+                unsigned int m = cur_constraint.idx[1];
+
+                // indices of constrained ptls in correct order
+                unsigned int idx_m_a, idx_m_b;
+                if (h_gpu_cpos.data[gpu_table_indexer(idx, cidx)] == 0)
+                    {
+                    idx_m_a = idx;
+                    idx_m_b = idx_other;
+                    }
+                else
+                    {
+                    idx_m_a = idx_other;
+                    idx_m_b = idx;
+                    }
 
-            h_cmatrix.data[m*n_constraint+n] += delta;
+                vec3<Scalar> rm_a(h_pos.data[idx_m_a]);
+                vec3<Scalar> rm_b(h_pos.data[idx_m_b]);
+                vec3<Scalar> rm(rm_a-rm_b);
 
-            // update sparse matrix
-            int k = m_sparse_idxlookup[m*n_constraint+n];
+                // apply minimum image
+                rm = box.minImage(rm);
 
-            if ( (k == -1 && delta != double(0.0))
-                || (k != -1 && delta == double(0.0)))
-                {
-                m_condition.resetFlags(1);
-                }
+                double delta(0.0);
+                if (idx_m_a == idx_a)
+                    {
+                    delta += double(4.0)*dot(qn,rm)/ma;
+                    }
+                if (idx_m_b == idx_a)
+                    {
+                    delta -= double(4.0)*dot(qn,rm)/ma;
+                    }
+                if (idx_m_a == idx_b)
+                    {
+                    delta -= double(4.0)*dot(qn,rm)/mb;
+                    }
+                if (idx_m_b == idx_b)
+                    {
+                    delta += double(4.0)*dot(qn,rm)/mb;
+                    }
 
-            if (k != -1)
-                {
-                // update sparse matrix value directly
-                m_sparse.valuePtr()[k] = delta;
+                m_triplets.push_back(Triplet<double>(n, m, delta));
                 }
             }
 
@@ -234,6 +225,24 @@ void ForceDistanceConstraint::fillMatrixVector(unsigned int timestep)
         h_cvec.data[n] += double(2.0)*dot(qn,vec3<Scalar>(h_netforce.data[idx_a])/ma
               -vec3<Scalar>(h_netforce.data[idx_b])/mb);
         }
+
+    // build the sparse matrix (column-major, sorted by row within every column)
+    m_sparse.resize(n_constraint, n_constraint);
+    m_sparse.setFromTriplets(m_triplets.begin(), m_triplets.end());
+
+    // compare the sparsity pattern to that of the previous step
+    const int *outer = m_sparse.outerIndexPtr();
+    const int *inner = m_sparse.innerIndexPtr();
+    unsigned int nnz = m_sparse.nonZeros();
+
+    if (m_sparse_outer.size() != n_constraint+1 || m_sparse_inner.size() != nnz
+        || !std::equal(m_sparse_outer.begin(), m_sparse_outer.end(), outer)
+        || !std::equal(m_sparse_inner.begin(), m_sparse_inner.end(), inner))
+        {
+        m_sparse_outer.assign(outer, outer + n_constraint + 1);
+        m_sparse_inner.assign(inner, inner + nnz);
+        m_condition.resetFlags(1);
+        }
     }
 
 void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
@@ -262,12 +271,13 @@ void ForceDistanceConstraint::checkConstraints(unsigned int timestep)
         }
     }
 
+/*! \param timestep Current timestep
+
+    Solves the sparse matrix equation assembled by fillMatrixVector() for the Lagrange multipliers.
+*/
 void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
     {
-    // use Eigen dense matrix algebra (slow for large matrices)
-    typedef Matrix<double, Dynamic, Dynamic, ColMajor> matrix_t;
     typedef Matrix<double, Dynamic, 1> vec_t;
-    typedef Map<matrix_t> matrix_map_t;
     typedef Map<vec_t> vec_map_t;
 
     unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
@@ -278,7 +288,7 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
     if (m_prof)
         m_prof->push("solve");
 
-    // reallocate array of constraint forces
+    // reallocate array of constraint forces, keeping the previous solution as initial guess
     m_lagrange.resize(n_constraint);
 
     unsigned int sparsity_pattern_changed = m_condition.readFlags();
@@ -293,83 +303,100 @@ void ForceDistanceConstraint::solveConstraints(unsigned int timestep)
         if (m_prof)
             m_prof->push("LU");
 
-        // access matrix
-        ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::read);
+        // Compute the ordering permutation vector from the structural pattern of A
+        m_sparse_solver.analyzePattern(m_sparse);
 
-        // wrap array
-        matrix_map_t map_matrix(h_cmatrix.data, n_constraint,n_constraint);
+        // the previous factorization cannot be reused
+        m_refactor = true;
 
-        // sparsity pattern changed
-        m_sparse = map_matrix.sparseView();
+        if (m_prof)
+            m_prof->pop();
+        }
 
-            {
-            ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
+    // access RHS and solution vector
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
 
-            // reset lookup matrix values to -1
-            for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
-                {
-                h_sparse_idxlookup.data[i] = -1;
-                }
+    bool solved = false;
+    if (m_solver == iterative && !m_refactor)
+        {
+        if (m_prof)
+            m_prof->push("refine");
 
-            // construct lookup table
-            int *inner_non_zeros = m_sparse.innerNonZeroPtr();
-            int *outer = m_sparse.outerIndexPtr();
-            int *inner = m_sparse.innerIndexPtr();
-            for (int i = 0; i < m_sparse.outerSize(); ++i)
-                {
-                int id = outer[i];
-                int end;
+        solved = refineConstraints(h_cvec.data, h_lagrange.data, n_constraint);
 
-                if(m_sparse.isCompressed())
-                    end = outer[i+1];
-                else
-                    end = id + inner_non_zeros[i];
+        if (m_prof)
+            m_prof->pop();
+        }
 
-                for (; id < end; ++id)
-                    {
-                    unsigned int col = i;
-                    unsigned int row = inner[id];
+    if (!solved)
+        {
+        if (m_prof)
+            m_prof->push("refactor/solve");
 
-                    // set pointer to index in sparse_val
-                    h_sparse_idxlookup.data[col*n_constraint+row] = id;
-                    }
-                }
+        // Compute the numerical factorization
+        m_sparse_solver.factorize(m_sparse);
+        m_refactor = false;
+
+        if (m_sparse_solver.info())
+            {
+            m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
+            throw std::runtime_error("Error evaluating constraint forces.\n");
             }
 
-        // Compute the ordering permutation vector from the structural pattern of A
-        m_sparse_solver.analyzePattern(m_sparse);
+        vec_map_t map_vec(h_cvec.data, n_constraint, 1);
+        vec_map_t map_lagrange(h_lagrange.data,n_constraint, 1);
+
+        //Use the factors to solve the linear system
+        map_lagrange = m_sparse_solver.solve(map_vec);
 
         if (m_prof)
             m_prof->pop();
         }
 
-
     if (m_prof)
-        m_prof->push("refactor/solve");
+        m_prof->pop();
+    }
 
-    // Compute the numerical factorization
-    m_sparse_solver.factorize(m_sparse);
+/*! \param rhs Right hand side of the constraint equation
+    \param lagrange Lagrange multipliers of the previous step on input, solution on output
+    \param n_constraint Number of constraints
+    \returns true if the relative residual has dropped below the solver tolerance
 
-    if (m_sparse_solver.info())
-        {
-        m_exec_conf->msg->error() << "Could not solve linear system of constraint equations." << std::endl;
-        throw std::runtime_error("Error evaluating constraint forces.\n");
-        }
+    Iterative refinement x <- x + LU^-1 (b - A x) with the LU factorization of an earlier step. The factorization
+    stays a good approximate inverse of A as long as the particles move little compared to the constraint lengths.
+*/
+bool ForceDistanceConstraint::refineConstraints(double *rhs, double *lagrange, unsigned int n_constraint)
+    {
+    typedef Matrix<double, Dynamic, 1> vec_t;
+    typedef Map<vec_t> vec_map_t;
 
-    // access RHS and solution vector
-    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
-    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::overwrite);
-    vec_map_t map_vec(h_cvec.data, n_constraint, 1);
-    vec_map_t map_lagrange(h_lagrange.data,n_constraint, 1);
+    // maximum number of refinement steps before factorizing again
+    const unsigned int max_iterations = 10;
 
-    //Use the factors to solve the linear system
-    map_lagrange = m_sparse_solver.solve(map_vec);
+    vec_map_t map_vec(rhs, n_constraint, 1);
+    vec_map_t map_lagrange(lagrange, n_constraint, 1);
 
-    if (m_prof)
-        m_prof->pop();
+    double tol = double(m_solver_tol)*map_vec.norm();
 
-    if (m_prof)
-        m_prof->pop();
+    vec_t residual = map_vec - m_sparse*map_lagrange;
+    for (unsigned int i = 0; i < max_iterations; ++i)
+        {
+        if (residual.norm() <= tol)
+            {
+            m_exec_conf->msg->notice(9) << "ForceDistanceConstraint: converged in " << i << " iterations" << std::endl;
+            return true;
+            }
+
+        map_lagrange += m_sparse_solver.solve(residual);
+        residual = map_vec - m_sparse*map_lagrange;
+        }
+
+    if (residual.norm() <= tol)
+        return true;
+
+    m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: iterative solver did not converge, refactorizing" << std::endl;
+    return false;
     }
 
 void ForceDistanceConstraint::computeConstraintForces(unsigned int timestep)
@@ -593,8 +620,16 @@ void ForceDistanceConstraint::assignMoleculeTags()
 
 void export_ForceDistanceConstraint(py::module& m)
     {
-    py::class_< ForceDistanceConstraint, std::shared_ptr<ForceDistanceConstraint> >(m, "ForceDistanceConstraint", py::base<MolecularForceCompute>())
-        .def(py::init< std::shared_ptr<SystemDefinition> >())
+    py::class_< ForceDistanceConstraint, std::shared_ptr<ForceDistanceConstraint> > constraint(m, "ForceDistanceConstraint", py::base<MolecularForceCompute>());
+    constraint.def(py::init< std::shared_ptr<SystemDefinition> >())
         .def("setRelativeTolerance", &ForceDistanceConstraint::setRelativeTolerance)
+        .def("setSolver", &ForceDistanceConstraint::setSolver)
+        .def("setSolverTolerance", &ForceDistanceConstraint::setSolverTolerance)
+    ;
+
+    py::enum_<ForceDistanceConstraint::solverType>(constraint, "solverType")
+        .value("direct", ForceDistanceConstraint::solverType::direct)
+        .value("iterative", ForceDistanceConstraint::solverType::iterative)
+        .export_values()
     ;
     }
@@ -30,6 +30,20 @@
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for Constraint Molecular Dynamics Simulations,” Mol. Simul., vol. 13, no. 6, pp. 395–405, 1994.
     [2] M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    The matrix of the constraint-force equation only couples constraints that share a particle. On the CPU, it is
+    assembled directly in sparse form from the per-particle constraint table of ConstraintData, so memory and time
+    scale with the number of constraints, not with its square. The matrix is block-diagonal, with one block for
+    every molecule (the connected components labeled by assignMoleculeTags()), and the fill-reducing ordering of the
+    sparse LU solver keeps the factors within these blocks.
+
+    Two solvers are available:
+     - <b>direct</b> factorizes the matrix on every step. The symbolic analysis is only repeated when the sparsity
+       pattern changes.
+     - <b>iterative</b> keeps the LU factorization of an earlier step and uses it to iteratively refine the
+       Lagrange multipliers of the previous step until the relative residual drops below the solver tolerance.
+       The matrix changes little from one step to the next, so a few triangular solves replace the numerical
+       factorization. When the refinement does not converge, the matrix is factorized again. (CPU only)
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -54,6 +68,26 @@ class ForceDistanceConstraint : public MolecularForceCompute
             m_rel_tol = rel_tol;
             }
 
+        //! Enum for the linear solver
+        enum solverType
+            {
+            direct = 0,
+            iterative
+            };
+
+        //! Set the linear solver
+        void setSolver(solverType solver)
+            {
+            m_solver = solver;
+            m_refactor = true;
+            }
+
+        //! Set the relative residual at which the iterative solver stops
+        void setSolverTolerance(Scalar solver_tol)
+            {
+            m_solver_tol = solver_tol;
+            }
+
         #ifdef ENABLE_MPI
         //! Get ghost particle fields requested by this pair potential
         virtual CommFlags getRequestedCommFlags(unsigned int timestep);
@@ -65,7 +99,7 @@ class ForceDistanceConstraint : public MolecularForceCompute
     protected:
         std::shared_ptr<ConstraintData> m_cdata; //! The constraint data
 
-        GPUVector<double> m_cmatrix;                //!< The matrix for the constraint force equation (column-major)
+        GPUVector<double> m_cmatrix;                //!< Dense matrix for the constraint force equation (column-major, GPU only)
         GPUVector<double> m_cvec;                   //!< The vector on the RHS of the constraint equation
         GPUVector<double> m_lagrange;               //!< The solution for the lagrange multipliers
 
@@ -76,7 +110,14 @@ class ForceDistanceConstraint : public MolecularForceCompute
         Eigen::SparseMatrix<double, Eigen::ColMajor> m_sparse;    //!< The sparse constraint matrix representation
         Eigen::SparseLU<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::COLAMDOrdering<int> > m_sparse_solver;
             //!< The persistent state of the sparse matrix solver
-        GPUVector<int> m_sparse_idxlookup;          //!< Reverse lookup from column-major to sparse matrix element
+        GPUVector<int> m_sparse_idxlookup;          //!< Reverse lookup from column-major to sparse matrix element (GPU only)
+        std::vector< Eigen::Triplet<double> > m_triplets; //!< Non-zero elements of the sparse matrix
+        std::vector<int> m_sparse_outer;            //!< Column offsets of the current sparsity pattern
+        std::vector<int> m_sparse_inner;            //!< Row indices of the current sparsity pattern
+
+        solverType m_solver;                        //!< The linear solver
+        Scalar m_solver_tol;                        //!< Relative residual at which the iterative solver stops
+        bool m_refactor;                            //!< True if the iterative solver needs a new factorization
 
         bool m_constraint_reorder;         //!< True if groups have changed
         bool m_constraints_added_removed;  //!< True if global constraint topology has changed
@@ -89,6 +130,9 @@ class ForceDistanceConstraint : public MolecularForceCompute
         //! Populate the quantities in the constraint-force equatino
         virtual void fillMatrixVector(unsigned int timestep);
 
+        //! Refine the Lagrange multipliers with a previous factorization
+        bool refineConstraints(double *rhs, double *lagrange, unsigned int n_constraint);
+
         //! Check violation of constraints
         virtual void checkConstraints(unsigned int timestep);
 
@@ -96,6 +96,9 @@ void ForceDistanceConstraintGPU::fillMatrixVector(unsigned int timestep)
     // fill the matrix in row-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
+    // reallocate through amortized resizing
+    m_cmatrix.resize(n_constraint*n_constraint);
+
     if (m_constraint_reorder)
         {
         // reset flag
@@ -180,6 +183,60 @@ void ForceDistanceConstraintGPU::fillMatrixVector(unsigned int timestep)
         m_prof->pop(m_exec_conf);
     }
 
+#ifndef CUSOLVER_AVAILABLE
+/*! Converts the dense matrix filled on the GPU into the host sparse matrix and builds the reverse lookup table
+    the GPU kernel uses to update the sparse matrix values directly.
+*/
+void ForceDistanceConstraintGPU::denseToSparse()
+    {
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> matrix_t;
+    typedef Eigen::Map<matrix_t> matrix_map_t;
+
+    unsigned int n_constraint = m_cdata->getN()+m_cdata->getNGhosts();
+
+    // access matrix
+    ArrayHandle<double> h_cmatrix(m_cmatrix, access_location::host, access_mode::read);
+
+    // wrap array
+    matrix_map_t map_matrix(h_cmatrix.data, n_constraint,n_constraint);
+
+    // sparsity pattern changed
+    m_sparse = map_matrix.sparseView();
+
+    ArrayHandle<int> h_sparse_idxlookup(m_sparse_idxlookup, access_location::host, access_mode::overwrite);
+
+    // reset lookup matrix values to -1
+    for (unsigned int i = 0; i < n_constraint*n_constraint; ++i)
+        {
+        h_sparse_idxlookup.data[i] = -1;
+        }
+
+    // construct lookup table
+    int *inner_non_zeros = m_sparse.innerNonZeroPtr();
+    int *outer = m_sparse.outerIndexPtr();
+    int *inner = m_sparse.innerIndexPtr();
+    for (int i = 0; i < m_sparse.outerSize(); ++i)
+        {
+        int id = outer[i];
+        int end;
+
+        if(m_sparse.isCompressed())
+            end = outer[i+1];
+        else
+            end = id + inner_non_zeros[i];
+
+        for (; id < end; ++id)
+            {
+            unsigned int col = i;
+            unsigned int row = inner[id];
+
+            // set pointer to index in sparse_val
+            h_sparse_idxlookup.data[col*n_constraint+row] = id;
+            }
+        }
+    }
+#endif
+
 void ForceDistanceConstraintGPU::solveConstraints(unsigned int timestep)
     {
     // ==1 if the sparsity pattern of the matrix changes (in particular if connectivity changes)
@@ -192,6 +249,11 @@ void ForceDistanceConstraintGPU::solveConstraints(unsigned int timestep)
         ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
         cudaMemcpy(m_sparse.valuePtr(), h_sparse_val.data, sizeof(double)*m_sparse.data().size(),cudaMemcpyDeviceToHost);
         }
+    else
+        {
+        // convert the dense matrix
+        denseToSparse();
+        }
 
     // solve on CPU
     ForceDistanceConstraint::solveConstraints(timestep);
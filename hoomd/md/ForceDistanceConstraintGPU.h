@@ -121,6 +121,11 @@ class ForceDistanceConstraintGPU : public ForceDistanceConstraint
 
         //! Compute the constraint forces using the Lagrange multipliers
         virtual void computeConstraintForces(unsigned int timestep);
+
+        #ifndef CUSOLVER_AVAILABLE
+        //! Convert the dense constraint matrix into the host sparse matrix
+        void denseToSparse();
+        #endif
     };
 
 //! Exports the ForceDistanceConstraint to python
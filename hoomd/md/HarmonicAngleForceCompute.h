@@ -5,6 +5,7 @@
 // Maintainer: dnlebard
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedForceGather.h"
 
 #include <memory>
 
@@ -26,7 +27,8 @@
 //! Computes harmonic angle forces on each particle
 /*! Harmonic angle forces are computed on every particle in the simulation.
 
-    The angles which forces are computed on are accessed from ParticleData::getAngleData
+    The angles which forces are computed on are accessed from ParticleData::getAngleData. With TBB and more than one
+    thread, the forces are gathered in parallel over the local particles with gather_bonded_forces().
     \ingroup computes
 */
 class HarmonicAngleForceCompute : public ForceCompute
@@ -116,6 +116,14 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     if (m_prof) m_prof->push("Harmonic Improper");
 
     assert(m_pdata);
+
+    #ifdef ENABLE_TBB
+    // the improper table is rebuilt on access from the reverse tags, so access it before acquiring them below
+    bool use_threads = m_exec_conf->getNumThreads() > 1;
+    if (use_threads)
+        m_improper_data->getGPUTable();
+    #endif
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
@@ -137,37 +145,13 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
     // get a local copy of the simulation box too
     const BoxDim& box = m_pdata->getBox();
 
-    // for each of the impropers
-    const unsigned int size = (unsigned int)m_improper_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate a single improper: forces on all four members, 1/4 of the energy and 1/4 of the virial
+    auto compute_improper = [&](const unsigned int *idx, unsigned int improper_type, Scalar3 *f, Scalar& improper_eng, Scalar *improper_virial)
         {
-        // lookup the tag of each of the particles participating in the improper
-        const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(i);
-        assert(improper.tag[0] <= m_pdata->getMaximumTag());
-        assert(improper.tag[1] <= m_pdata->getMaximumTag());
-        assert(improper.tag[2] <= m_pdata->getMaximumTag());
-        assert(improper.tag[3] <= m_pdata->getMaximumTag());
-
-        // transform a, b, and c into indicies into the particle data arrays
-        // MEM TRANSFER: 6 ints
-        unsigned int idx_a = h_rtag.data[improper.tag[0]];
-        unsigned int idx_b = h_rtag.data[improper.tag[1]];
-        unsigned int idx_c = h_rtag.data[improper.tag[2]];
-        unsigned int idx_d = h_rtag.data[improper.tag[3]];
-
-        // throw an error if this angle is incomplete
-        if (idx_a == NOT_LOCAL|| idx_b == NOT_LOCAL || idx_c == NOT_LOCAL || idx_d == NOT_LOCAL)
-            {
-            this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
-                improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
-                << " incomplete." << endl << endl;
-            throw std::runtime_error("Error in improper calculation");
-            }
-
-        assert(idx_a < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_b < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_c < m_pdata->getN() + m_pdata->getNGhosts());
-        assert(idx_d < m_pdata->getN() + m_pdata->getNGhosts());
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
+        unsigned int idx_c = idx[2];
+        unsigned int idx_d = idx[3];
 
         // calculate d\vec{r}
         Scalar3 dab;
@@ -220,13 +204,12 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         Scalar s = sqrt(1.0 - c*c);
         if (s < SMALL) s = SMALL;
 
-        unsigned int improper_type = m_improper_data->getTypeByIndex(i);
         Scalar domega = acos(c) - m_chi[improper_type];
         Scalar a = m_K[improper_type] * domega;
 
         // calculate the energy, 1/4th for each atom
         //Scalar improper_eng = Scalar(0.25)*a*domega;
-        Scalar improper_eng = Scalar(0.125)*a*domega; // the .125 term is 1/2 * 1/4
+        improper_eng = Scalar(0.125)*a*domega; // the .125 term is 1/2 * 1/4
         //a = -a * 2.0/s;
         a = -a / s; // the missing 2.0 factor is to ensure K/2 is factored in for the forces
         c = c * a;
@@ -263,7 +246,6 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
 
         // and calculate the virial (upper triangular version)
         // compute 1/4 of the virial, 1/4 for each atom in the improper
-        Scalar improper_virial[6];
         improper_virial[0] = (1./4.)*(dab.x*ffax + dcb.x*ffcx + (ddc.x+dcb.x)*ffdx);
         improper_virial[1] = (1./4.)*(dab.y*ffax + dcb.y*ffcx + (ddc.y+dcb.y)*ffdx);
         improper_virial[2] = (1./4.)*(dab.z*ffax + dcb.z*ffcx + (ddc.z+dcb.z)*ffdx);
@@ -271,45 +253,75 @@ void HarmonicImproperForceCompute::computeForces(unsigned int timestep)
         improper_virial[4] = (1./4.)*(dab.z*ffay + dcb.z*ffcy + (ddc.z+dcb.z)*ffdy);
         improper_virial[5] = (1./4.)*(dab.z*ffaz + dcb.z*ffcz + (ddc.z+dcb.z)*ffdz);
 
-        if (idx_a < m_pdata->getN())
-            {
-            // accumulate the forces
-            h_force.data[idx_a].x += ffax;
-            h_force.data[idx_a].y += ffay;
-            h_force.data[idx_a].z += ffaz;
-            h_force.data[idx_a].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_a]  += improper_virial[k];
-            }
+        // forces on a, b, c and d
+        f[0] = make_scalar3(ffax, ffay, ffaz);
+        f[1] = make_scalar3(ffbx, ffby, ffbz);
+        f[2] = make_scalar3(ffcx, ffcy, ffcz);
+        f[3] = make_scalar3(ffdx, ffdy, ffdz);
+        };
 
-        if (idx_b < m_pdata->getN())
-            {
-            h_force.data[idx_b].x += ffbx;
-            h_force.data[idx_b].y += ffby;
-            h_force.data[idx_b].z += ffbz;
-            h_force.data[idx_b].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_b]  += improper_virial[k];
-            }
+    #ifdef ENABLE_TBB
+    if (use_threads)
+        {
+        // gather the forces on each local particle in parallel
+        gather_bonded_forces(m_improper_data, m_pdata->getN(), h_force.data, h_virial.data, virial_pitch,
+            true, compute_improper);
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    // for each of the impropers
+    const unsigned int size = (unsigned int)m_improper_data->getN();
+    for (unsigned int i = 0; i < size; i++)
+        {
+        // lookup the tag of each of the particles participating in the improper
+        const ImproperData::members_t& improper = m_improper_data->getMembersByIndex(i);
+        assert(improper.tag[0] <= m_pdata->getMaximumTag());
+        assert(improper.tag[1] <= m_pdata->getMaximumTag());
+        assert(improper.tag[2] <= m_pdata->getMaximumTag());
+        assert(improper.tag[3] <= m_pdata->getMaximumTag());
 
-        if (idx_c < m_pdata->getN())
+        // transform a, b, and c into indicies into the particle data arrays
+        // MEM TRANSFER: 6 ints
+        unsigned int idx[4];
+        idx[0] = h_rtag.data[improper.tag[0]];
+        idx[1] = h_rtag.data[improper.tag[1]];
+        idx[2] = h_rtag.data[improper.tag[2]];
+        idx[3] = h_rtag.data[improper.tag[3]];
+
+        // throw an error if this angle is incomplete
+        if (idx[0] == NOT_LOCAL|| idx[1] == NOT_LOCAL || idx[2] == NOT_LOCAL || idx[3] == NOT_LOCAL)
             {
-            h_force.data[idx_c].x += ffcx;
-            h_force.data[idx_c].y += ffcy;
-            h_force.data[idx_c].z += ffcz;
-            h_force.data[idx_c].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_c]  += improper_virial[k];
+            this->m_exec_conf->msg->error() << "improper.harmonic: improper " <<
+                improper.tag[0] << " " << improper.tag[1] << " " << improper.tag[2] << " " << improper.tag[3]
+                << " incomplete." << endl << endl;
+            throw std::runtime_error("Error in improper calculation");
             }
 
-        if (idx_d < m_pdata->getN())
+        assert(idx[0] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[1] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[2] < m_pdata->getN() + m_pdata->getNGhosts());
+        assert(idx[3] < m_pdata->getN() + m_pdata->getNGhosts());
+
+        Scalar3 f[4];
+        Scalar improper_eng;
+        Scalar improper_virial[6];
+        compute_improper(idx, m_improper_data->getTypeByIndex(i), f, improper_eng, improper_virial);
+
+        // accumulate the forces (only for non-ghost particles)
+        for (unsigned int j = 0; j < 4; j++)
             {
-            h_force.data[idx_d].x += ffdx;
-            h_force.data[idx_d].y += ffdy;
-            h_force.data[idx_d].z += ffdz;
-            h_force.data[idx_d].w += improper_eng;
-            for (int k = 0; k < 6; k++)
-                h_virial.data[k*virial_pitch+idx_d]  += improper_virial[k];
+            if (idx[j] < m_pdata->getN())
+                {
+                h_force.data[idx[j]].x += f[j].x;
+                h_force.data[idx[j]].y += f[j].y;
+                h_force.data[idx[j]].z += f[j].z;
+                h_force.data[idx[j]].w += improper_eng;
+                for (int k = 0; k < 6; k++)
+                    h_virial.data[k*virial_pitch+idx[j]]  += improper_virial[k];
+                }
             }
         }
 
@@ -24,7 +24,7 @@ NeighborListTree::NeighborListTree(std::shared_ptr<SystemDefinition> sysdef,
                                        Scalar r_cut,
                                        Scalar r_buff)
     : NeighborList(sysdef, r_cut, r_buff), m_box_changed(true), m_max_num_changed(true), m_remap_particles(true),
-      m_type_changed(true), m_n_images(0)
+      m_type_changed(true), m_n_images(0), m_body_tree(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListTree" << endl;
 
@@ -48,6 +48,13 @@ void NeighborListTree::buildNlist(unsigned int timestep)
     // allocate the memory as needed and sort particles
     setupTree();
 
+    // search the pairs of bodies first if pairs within a body are excluded
+    if (m_filter_body && m_body_tree && buildBodyTree())
+        {
+        traverseBodyTree();
+        return;
+        }
+
     // build the trees
     buildTree();
 
@@ -409,9 +416,318 @@ void NeighborListTree::traverseTree()
     if (this->m_prof) this->m_prof->pop();
     }
 
+/*!
+ * Every particle is assigned to the unit of the central particle of its body. Free particles, and constituent
+ * particles whose central particle is not present on this rank (or whose copy is not the nearby one), form a
+ * unit of their own. The position of every member is unwrapped to the image next to its central particle, and
+ * the unit is enclosed by the bounding box of its members. One AABB tree is built for all units, and units with more
+ * members than fit in a leaf also get a tree of their members.
+ *
+ * \returns false if no particles were grouped into bodies, in which case the per-type trees are faster
+ */
+bool NeighborListTree::buildBodyTree()
+    {
+    if (this->m_prof) this->m_prof->push("Build bodies");
+
+    const unsigned int n_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    const unsigned int n_rtag = m_pdata->getRTags().getNumElements();
+
+    const BoxDim& box = m_pdata->getBox();
+
+    // no constituent particle is further from its central particle than the largest body diameter
+    const Scalar max_d_comp = m_pdata->getMaxCompositeParticleDiameter();
+    const Scalar max_dist_sq = max_d_comp*max_d_comp*Scalar(1.0001);
+
+    // assign the particles to the units of their central particles
+    m_central.resize(n_local);
+    m_unit_pos.resize(n_local);
+    unsigned int n_units = 0;
+    for (unsigned int i = 0; i < n_local; ++i)
+        {
+        const vec3<Scalar> pos_i(h_postype.data[i]);
+        const unsigned int body_i = h_body.data[i];
+
+        unsigned int central = i;
+        vec3<Scalar> unit_pos = pos_i;
+        if (body_i != NO_BODY && body_i < n_rtag)
+            {
+            const unsigned int idx = h_rtag.data[body_i];
+            if (idx < n_local && idx != i && h_body.data[idx] == body_i)
+                {
+                const vec3<Scalar> pos_c(h_postype.data[idx]);
+                const vec3<Scalar> dr = vec3<Scalar>(box.minImage(vec_to_scalar3(pos_i - pos_c)));
+                if (dot(dr,dr) <= max_dist_sq)
+                    {
+                    central = idx;
+                    unit_pos = pos_c + dr;
+                    }
+                }
+            }
+
+        m_central[i] = central;
+        m_unit_pos[i] = unit_pos;
+        if (central == i)
+            ++n_units;
+        }
+
+    if (n_units == n_local)
+        {
+        // there are no bodies on this rank
+        if (this->m_prof) this->m_prof->pop();
+        return false;
+        }
+
+    // number the units by their central particles and count the members
+    m_unit_central.resize(n_units);
+    m_unit_lower.resize(n_units);
+    m_unit_upper.resize(n_units);
+    m_unit_head.assign(n_units+1, 0);
+
+    // m_unit_members temporarily holds the unit index of every central particle
+    m_unit_members.resize(n_local);
+    unsigned int cur_unit = 0;
+    for (unsigned int i = 0; i < n_local; ++i)
+        {
+        if (m_central[i] == i)
+            {
+            m_unit_central[cur_unit] = i;
+            m_unit_lower[cur_unit] = m_unit_upper[cur_unit] = m_unit_pos[i];
+            m_unit_members[i] = cur_unit++;
+            }
+        }
+
+    // replace the central particle by the unit index, and compute the bounding boxes of the units
+    for (unsigned int i = 0; i < n_local; ++i)
+        {
+        const unsigned int unit = m_unit_members[m_central[i]];
+        m_central[i] = unit;
+        ++m_unit_head[unit+1];
+
+        const vec3<Scalar>& pos = m_unit_pos[i];
+        vec3<Scalar>& lower = m_unit_lower[unit];
+        vec3<Scalar>& upper = m_unit_upper[unit];
+        lower = vec3<Scalar>(std::min(lower.x, pos.x), std::min(lower.y, pos.y), std::min(lower.z, pos.z));
+        upper = vec3<Scalar>(std::max(upper.x, pos.x), std::max(upper.y, pos.y), std::max(upper.z, pos.z));
+        }
+
+    // m_central now holds the unit of every particle, group the particles by unit
+    for (unsigned int unit = 0; unit < n_units; ++unit)
+        m_unit_head[unit+1] += m_unit_head[unit];
+
+    std::vector<unsigned int> unit_fill(m_unit_head.begin(), m_unit_head.end()-1);
+    for (unsigned int i = 0; i < n_local; ++i)
+        m_unit_members[unit_fill[m_central[i]]++] = i;
+
+    // build the tree of the units
+    m_unit_aabbs.resize(n_units);
+    ArrayHandle<AABB> h_unit_aabbs(m_unit_aabbs, access_location::host, access_mode::overwrite);
+    for (unsigned int unit = 0; unit < n_units; ++unit)
+        {
+        h_unit_aabbs.data[unit] = AABB(m_unit_lower[unit], m_unit_upper[unit]);
+        h_unit_aabbs.data[unit].tag = unit;
+        }
+    m_unit_tree.buildTree(h_unit_aabbs.data, n_units);
+
+    // build the trees of the members of large units, smaller units are searched directly
+    m_member_trees.resize(n_units);
+    m_member_aabbs.resize(n_local);
+    ArrayHandle<AABB> h_member_aabbs(m_member_aabbs, access_location::host, access_mode::overwrite);
+    for (unsigned int unit = 0; unit < n_units; ++unit)
+        {
+        const unsigned int first = m_unit_head[unit];
+        const unsigned int n_members = m_unit_head[unit+1] - first;
+        if (n_members <= NODE_CAPACITY)
+            continue;
+
+        for (unsigned int m = first; m < first + n_members; ++m)
+            {
+            const unsigned int j = m_unit_members[m];
+            h_member_aabbs.data[m] = AABB(m_unit_pos[j], j);
+            }
+        m_member_trees[unit].buildTree(h_member_aabbs.data + first, n_members);
+        }
+
+    if (this->m_prof) this->m_prof->pop();
+    return true;
+    }
+
+/*!
+ * Each unit with members owned by this rank queries the tree of units with its bounding box, expanded by the largest
+ * neighbor list cutoff. For every candidate unit, each local member is first tested against the bounding box of the
+ * candidate, and then against the members of the candidate found in its tree of members (or against all of them for
+ * small units). The members of the same unit are never tested against each other.
+ */
+void NeighborListTree::traverseBodyTree()
+    {
+    if (this->m_prof) this->m_prof->push("Traverse bodies");
+
+    // acquire particle data
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+
+    // neighborlist data
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_conditions(m_conditions, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
+
+    const unsigned int N = m_pdata->getN();
+    for (unsigned int i = 0; i < N; ++i)
+        h_n_neigh.data[i] = 0;
+
+    // largest cutoff of any pair of particles
+    Scalar r_list_max = m_rcut_max_max + m_r_buff;
+    if (m_diameter_shift)
+        r_list_max += m_d_max - Scalar(1.0);
+    const vec3<Scalar> r_list_vec(r_list_max, r_list_max, r_list_max);
+
+    const unsigned int n_units = m_unit_central.size();
+    for (unsigned int cur_unit = 0; cur_unit < n_units; ++cur_unit)
+        {
+        const unsigned int first = m_unit_head[cur_unit];
+        const unsigned int last = m_unit_head[cur_unit+1];
+
+        // only units with local members search for neighbors
+        bool has_local = false;
+        for (unsigned int m = first; m < last && !has_local; ++m)
+            has_local = m_unit_members[m] < N;
+        if (!has_local)
+            continue;
+
+        for (unsigned int cur_image = 0; cur_image < m_n_images; ++cur_image) // for each image vector
+            {
+            const vec3<Scalar> image = m_image_list[cur_image];
+            AABB aabb = AABB(m_unit_lower[cur_unit] + image - r_list_vec, m_unit_upper[cur_unit] + image + r_list_vec);
+
+            // stackless traversal of the tree
+            for (unsigned int cur_node_idx = 0; cur_node_idx < m_unit_tree.getNumNodes(); ++cur_node_idx)
+                {
+                if (!overlap(m_unit_tree.getNodeAABB(cur_node_idx), aabb))
+                    {
+                    // skip ahead
+                    cur_node_idx += m_unit_tree.getNodeSkip(cur_node_idx);
+                    continue;
+                    }
+
+                if (!m_unit_tree.isNodeLeaf(cur_node_idx))
+                    continue;
+
+                for (unsigned int cur_p = 0; cur_p < m_unit_tree.getNodeNumParticles(cur_node_idx); ++cur_p)
+                    {
+                    const unsigned int other_unit = m_unit_tree.getNodeParticleTag(cur_node_idx, cur_p);
+
+                    // pairs within the same body are never enumerated
+                    if (other_unit == cur_unit)
+                        continue;
+
+                    const AABB other_aabb(m_unit_lower[other_unit], m_unit_upper[other_unit]);
+                    const unsigned int other_first = m_unit_head[other_unit];
+                    const unsigned int other_last = m_unit_head[other_unit+1];
+                    const AABBTree& other_tree = m_member_trees[other_unit];
+                    const bool use_tree = other_last - other_first > NODE_CAPACITY;
+
+                    for (unsigned int m = first; m < last; ++m)
+                        {
+                        const unsigned int i = m_unit_members[m];
+                        if (i >= N)
+                            continue;
+
+                        // test the member against the bounding box of the other unit
+                        const vec3<Scalar> pos_i_image = m_unit_pos[i] + image;
+                        const AABB aabb_i(pos_i_image - r_list_vec, pos_i_image + r_list_vec);
+                        if (!overlap(other_aabb, aabb_i))
+                            continue;
+
+                        const unsigned int type_i = __scalar_as_int(h_postype.data[i].w);
+                        const unsigned int body_i = h_body.data[i];
+                        const Scalar diam_i = h_diameter.data[i];
+                        const unsigned int Nmax_i = h_Nmax.data[type_i];
+                        const unsigned int nlist_head_i = h_head_list.data[i];
+                        unsigned int n_neigh_i = h_n_neigh.data[i];
+
+                        // adds j to the neighbors of i if it is within the cutoff
+                        auto test_pair = [&](unsigned int j)
+                            {
+                            if (i == j || (m_storage_mode == half && j < i))
+                                return;
+
+                            // constituents whose central particle is not present still need the body filter
+                            if (body_i != NO_BODY && body_i == h_body.data[j])
+                                return;
+
+                            const unsigned int type_j = __scalar_as_int(h_postype.data[j].w);
+                            Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i,type_j)];
+                            if (r_cut <= Scalar(0.0))
+                                return;
+
+                            Scalar r_cut_i = r_cut + m_r_buff;
+
+                            Scalar sqshift = Scalar(0.0);
+                            if (m_diameter_shift)
+                                {
+                                const Scalar delta = (diam_i + h_diameter.data[j]) * Scalar(0.5) - Scalar(1.0);
+                                sqshift = (delta + Scalar(2.0) * r_cut_i) * delta;
+                                }
+
+                            const vec3<Scalar> drij = m_unit_pos[j] - pos_i_image;
+                            if (dot(drij,drij) <= r_cut_i*r_cut_i + sqshift)
+                                {
+                                if (n_neigh_i < Nmax_i)
+                                    h_nlist.data[nlist_head_i + n_neigh_i] = j;
+                                else
+                                    h_conditions.data[type_i] = max(h_conditions.data[type_i], n_neigh_i+1);
+
+                                ++n_neigh_i;
+                                }
+                            };
+
+                        if (use_tree)
+                            {
+                            // stackless traversal of the members of the other unit
+                            for (unsigned int node = 0; node < other_tree.getNumNodes(); ++node)
+                                {
+                                if (!overlap(other_tree.getNodeAABB(node), aabb_i))
+                                    {
+                                    node += other_tree.getNodeSkip(node);
+                                    continue;
+                                    }
+
+                                if (!other_tree.isNodeLeaf(node))
+                                    continue;
+
+                                for (unsigned int k = 0; k < other_tree.getNodeNumParticles(node); ++k)
+                                    test_pair(other_tree.getNodeParticleTag(node, k));
+                                }
+                            }
+                        else
+                            {
+                            for (unsigned int n = other_first; n < other_last; ++n)
+                                test_pair(m_unit_members[n]);
+                            }
+
+                        h_n_neigh.data[i] = n_neigh_i;
+                        }
+                    }
+                } // end stackless search
+            } // end loop over images
+        } // end loop over units
+
+    if (this->m_prof) this->m_prof->pop();
+    }
+
 void export_NeighborListTree(py::module& m)
     {
     py::class_<NeighborListTree, std::shared_ptr<NeighborListTree> >(m, "NeighborListTree", py::base<NeighborList>())
     .def(py::init< std::shared_ptr<SystemDefinition>, Scalar, Scalar >())
+    .def("setBodyTree", &NeighborListTree::setBodyTree)
+    .def("getBodyTree", &NeighborListTree::getBodyTree)
                      ;
     }
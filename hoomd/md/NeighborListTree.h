@@ -35,6 +35,13 @@
  * Any class directly modifying the types of particles \b must signal this change to NeighborListTree using
  * notifyParticleSort().
  *
+ * When particles of the same rigid body are excluded (setFilterBody()), the neighbor list is built in two levels.
+ * Every body is enclosed by the bounding box of its constituent particles, and a single tree of these boxes (and of
+ * the points of the free particles) finds the candidate pairs of bodies. For every candidate, each constituent
+ * particle only searches the tree of the constituents of the other body, so pairs within the same body are never
+ * enumerated. A constituent particle whose central particle is not present on this rank is treated as a free
+ * particle. setBodyTree() disables the two-level search.
+ *
  * \ingroup computes
  */
 class NeighborListTree : public NeighborList
@@ -48,6 +55,22 @@ class NeighborListTree : public NeighborList
         //! Destructor
         virtual ~NeighborListTree();
 
+        //! Enable or disable the two-level search over rigid bodies
+        /*! \param body_tree Set to false to always use the per-type trees, also when particles of the same body
+                are excluded
+        */
+        void setBodyTree(bool body_tree)
+            {
+            m_body_tree = body_tree;
+            forceUpdate();
+            }
+
+        //! Test if the two-level search over rigid bodies is enabled
+        bool getBodyTree() const
+            {
+            return m_body_tree;
+            }
+
     protected:
         //! Builds the neighbor list
         virtual void buildNlist(unsigned int timestep);
@@ -92,6 +115,7 @@ class NeighborListTree : public NeighborList
 
         std::vector< vec3<Scalar> > m_image_list;    //!< List of translation vectors
         unsigned int m_n_images;                //!< The number of image vectors to check
+        bool m_body_tree;                       //!< True if rigid bodies are searched in two levels
 
         //! Driver for tree configuration
         void setupTree();
@@ -107,6 +131,25 @@ class NeighborListTree : public NeighborList
 
         //! Traverses AABB trees to compute neighbors
         void traverseTree();
+
+        // two-level search over rigid bodies
+        GPUVector<hpmc::detail::AABB>   m_unit_aabbs;   //!< AABBs of all bodies and free particles
+        hpmc::detail::AABBTree          m_unit_tree;    //!< Tree of the body and free particle AABBs
+        std::vector<unsigned int>   m_unit_head;        //!< Index of the first member of each unit in m_unit_members
+        std::vector<unsigned int>   m_unit_members;     //!< Particle indices, grouped by unit
+        std::vector<unsigned int>   m_unit_central;     //!< Index of the central particle of each unit
+        std::vector< vec3<Scalar> > m_unit_lower;       //!< Lower corner of the bounding box of the members of each unit
+        std::vector< vec3<Scalar> > m_unit_upper;       //!< Upper corner of the bounding box of the members of each unit
+        std::vector<hpmc::detail::AABBTree> m_member_trees; //!< Trees of the members of each unit larger than a leaf
+        GPUVector<hpmc::detail::AABB>   m_member_aabbs; //!< AABBs of the members, grouped by unit
+        std::vector<unsigned int>   m_central;          //!< Index of the central particle of every particle
+        std::vector< vec3<Scalar> > m_unit_pos;         //!< Position of every particle, unwrapped next to its central particle
+
+        //! Groups the particles by body and builds the tree of the bodies
+        bool buildBodyTree();
+
+        //! Traverses the tree of the bodies to compute neighbors
+        void traverseBodyTree();
     };
 
 //! Exports NeighborListTree to python
@@ -6,6 +6,7 @@
 
 #include "hoomd/ForceCompute.h"
 #include "hoomd/BondedGroupData.h"
+#include "BondedForceGather.h"
 
 #include <memory>
 #include <vector>
@@ -27,6 +28,10 @@
 /*! OPLS dihedral forces are computed on every particle in the simulation.
 
     The dihedrals which forces are computed on are accessed from ParticleData::getDihedralData
+
+    With TBB and more than one thread, the forces are gathered in parallel over the local particles with
+    gather_bonded_forces().
+
     \ingroup computes
 */
 class OPLSDihedralForceCompute : public ForceCompute
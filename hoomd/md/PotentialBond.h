@@ -4,6 +4,7 @@
 #include <memory>
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
+#include "BondedForceGather.h"
 
 #include <vector>
 
@@ -22,6 +23,9 @@
 
 /*! Bond potential with evaluator support
 
+    With TBB and more than one thread, the forces are gathered in parallel over the local particles with
+    gather_bonded_forces().
+
     \ingroup computes
 */
 template < class evaluator >
@@ -147,6 +151,13 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
     assert(m_pdata);
 
+    #ifdef ENABLE_TBB
+    // the bond table is rebuilt on access from the reverse tags, so access it before acquiring them below
+    bool use_threads = m_exec_conf->getNumThreads() > 1;
+    if (use_threads)
+        m_bond_data->getGPUTable();
+    #endif
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
@@ -178,36 +189,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
     PDataFlags flags = this->m_pdata->getFlags();
     bool compute_virial = flags[pdata_flag::pressure_tensor] || flags[pdata_flag::isotropic_virial];
 
-    Scalar bond_virial[6];
-    for (unsigned int i = 0; i< 6; i++)
-        bond_virial[i]=Scalar(0.0);
-
-    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
-    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
-
-    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
-
-    // for each of the bonds
-    const unsigned int size = (unsigned int)m_bond_data->getN();
-    for (unsigned int i = 0; i < size; i++)
+    // evaluate a single bond: forces on both members, half the energy and half the virial
+    auto compute_bond = [&](const unsigned int *idx, unsigned int type, Scalar3 *f, Scalar& bond_eng, Scalar *bond_virial)
         {
-        // lookup the tag of each of the particles participating in the bond
-        const typename BondData::members_t& bond = h_bonds.data[i];
-        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
-        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
-
-        // transform a and b into indicies into the particle data arrays
-        // (MEM TRANSFER: 4 integers)
-        unsigned int idx_a = h_rtag.data[bond.tag[0]];
-        unsigned int idx_b = h_rtag.data[bond.tag[1]];
-
-        // throw an error if this bond is incomplete
-        if (idx_a >= max_local || idx_b >= max_local)
-            {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
-                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
+        unsigned int idx_a = idx[0];
+        unsigned int idx_b = idx[1];
 
         // calculate d\vec{r}
         // (MEM TRANSFER: 6 Scalars / FLOPS: 3)
@@ -241,11 +227,11 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
         Scalar rsq = dot(dx,dx);
 
         // get parameters for this bond type
-        param_type param = h_params.data[h_typeval.data[i].type];
+        param_type param = h_params.data[type];
 
         // compute the force and potential energy
         Scalar force_divr = Scalar(0.0);
-        Scalar bond_eng = Scalar(0.0);
+        bond_eng = Scalar(0.0);
         evaluator eval(rsq, param);
         if (evaluator::needsDiameter())
             eval.setDiameter(diameter_a,diameter_b);
@@ -254,51 +240,93 @@ void PotentialBond< evaluator >::computeForces(unsigned int timestep)
 
         bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
 
+        if (!evaluated)
+            {
+            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
+            throw std::runtime_error("Error in bond calculation");
+            }
+
         // Bond energy must be halved
         bond_eng *= Scalar(0.5);
 
-        if (evaluated)
+        f[1] = force_divr * dx;
+        f[0] = -f[1];
+
+        // calculate virial
+        if (compute_virial)
             {
-            // calculate virial
-            if (compute_virial)
-                {
-                Scalar force_div2r = Scalar(1.0/2.0)*force_divr;
-                bond_virial[0] = dx.x * dx.x * force_div2r; // xx
-                bond_virial[1] = dx.x * dx.y * force_div2r; // xy
-                bond_virial[2] = dx.x * dx.z * force_div2r; // xz
-                bond_virial[3] = dx.y * dx.y * force_div2r; // yy
-                bond_virial[4] = dx.y * dx.z * force_div2r; // yz
-                bond_virial[5] = dx.z * dx.z * force_div2r; // zz
-                }
+            Scalar force_div2r = Scalar(1.0/2.0)*force_divr;
+            bond_virial[0] = dx.x * dx.x * force_div2r; // xx
+            bond_virial[1] = dx.x * dx.y * force_div2r; // xy
+            bond_virial[2] = dx.x * dx.z * force_div2r; // xz
+            bond_virial[3] = dx.y * dx.y * force_div2r; // yy
+            bond_virial[4] = dx.y * dx.z * force_div2r; // yz
+            bond_virial[5] = dx.z * dx.z * force_div2r; // zz
+            }
+        };
 
-            // add the force to the particles (only for non-ghost particles)
-            if (idx_b < m_pdata->getN())
-                {
-                h_force.data[idx_b].x += force_divr * dx.x;
-                h_force.data[idx_b].y += force_divr * dx.y;
-                h_force.data[idx_b].z += force_divr * dx.z;
-                h_force.data[idx_b].w += bond_eng;
-                if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_b]  += bond_virial[i];
-                }
+    #ifdef ENABLE_TBB
+    if (use_threads)
+        {
+        // gather the forces on each local particle in parallel
+        gather_bonded_forces(m_bond_data, m_pdata->getN(), h_force.data, h_virial.data, m_virial_pitch,
+            compute_virial, compute_bond);
+
+        if (m_prof) m_prof->pop();
+        return;
+        }
+    #endif
+
+    Scalar bond_virial[6];
+    for (unsigned int i = 0; i< 6; i++)
+        bond_virial[i]=Scalar(0.0);
+
+    ArrayHandle<typename BondData::members_t> h_bonds(m_bond_data->getMembersArray(), access_location::host, access_mode::read);
+    ArrayHandle<typeval_t> h_typeval(m_bond_data->getTypeValArray(), access_location::host, access_mode::read);
+
+    unsigned int max_local = m_pdata->getN() + m_pdata->getNGhosts();
+
+    // for each of the bonds
+    const unsigned int size = (unsigned int)m_bond_data->getN();
+    for (unsigned int i = 0; i < size; i++)
+        {
+        // lookup the tag of each of the particles participating in the bond
+        const typename BondData::members_t& bond = h_bonds.data[i];
+        assert(bond.tag[0] < m_pdata->getMaximumTag()+1);
+        assert(bond.tag[1] < m_pdata->getMaximumTag()+1);
+
+        // transform a and b into indicies into the particle data arrays
+        // (MEM TRANSFER: 4 integers)
+        unsigned int idx[2];
+        idx[0] = h_rtag.data[bond.tag[0]];
+        idx[1] = h_rtag.data[bond.tag[1]];
 
-            if (idx_a < m_pdata->getN())
+        // throw an error if this bond is incomplete
+        if (idx[0] >= max_local || idx[1] >= max_local)
+            {
+            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond " <<
+                bond.tag[0] << " " << bond.tag[1] << " incomplete." << std::endl << std::endl;
+            throw std::runtime_error("Error in bond calculation");
+            }
+
+        Scalar3 f[2];
+        Scalar bond_eng;
+        compute_bond(idx, h_typeval.data[i].type, f, bond_eng, bond_virial);
+
+        // add the force to the particles (only for non-ghost particles)
+        for (unsigned int j = 0; j < 2; j++)
+            {
+            if (idx[j] < m_pdata->getN())
                 {
-                h_force.data[idx_a].x -= force_divr * dx.x;
-                h_force.data[idx_a].y -= force_divr * dx.y;
-                h_force.data[idx_a].z -= force_divr * dx.z;
-                h_force.data[idx_a].w += bond_eng;
+                h_force.data[idx[j]].x += f[j].x;
+                h_force.data[idx[j]].y += f[j].y;
+                h_force.data[idx[j]].z += f[j].z;
+                h_force.data[idx[j]].w += bond_eng;
                 if (compute_virial)
-                    for (unsigned int i = 0; i < 6; i++)
-                        h_virial.data[i*m_virial_pitch+idx_a]  += bond_virial[i];
+                    for (unsigned int k = 0; k < 6; k++)
+                        h_virial.data[k*m_virial_pitch+idx[j]]  += bond_virial[k];
                 }
             }
-        else
-            {
-            this->m_exec_conf->msg->error() << "bond." << evaluator::getName() << ": bond out of bounds" << std::endl << std::endl;
-            throw std::runtime_error("Error in bond calculation");
-            }
         }
 
     if (m_prof) m_prof->pop();
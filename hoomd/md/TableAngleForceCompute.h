@@ -49,6 +49,9 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - thmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - thmin) / dr - Scalar(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When cubic interpolation is enabled with setCubicInterpolation(), the same two table entries define a cubic
+    Hermite spline that uses the tabulated derivative as the slope of V. See table_interpolate() for details.
     \ingroup computes
 */
 class TableAngleForceCompute : public ForceCompute
@@ -68,6 +71,12 @@ class TableAngleForceCompute : public ForceCompute
                               const std::vector<Scalar> &T
                               );
 
+        //! Select cubic (true) or linear (false) interpolation of the tables
+        void setCubicInterpolation(bool cubic)
+            {
+            m_cubic = cubic;
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -94,6 +103,7 @@ class TableAngleForceCompute : public ForceCompute
         GPUArray<Scalar2> m_tables;                  //!< Stored V and T tables
         Index2D m_table_value;                      //!< Index table helper
         std::string m_log_name;                     //!< Cached log name
+        bool m_cubic;                               //!< True if the tables are interpolated with cubic splines
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -82,6 +82,7 @@ void TableAngleForceComputeGPU::computeForces(unsigned int timestep)
                              d_tables.data,
                              m_table_width,
                              m_table_value,
+                             m_cubic,
                              m_tuner->getParam(),
                              m_exec_conf->getComputeCapability());
         }
@@ -0,0 +1,132 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// Maintainer: joaander
+
+#ifndef __TABLE_INTERPOLATION_H__
+#define __TABLE_INTERPOLATION_H__
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file TableInterpolation.h
+    \brief Interpolation routines shared by the tabulated potentials
+    \details TablePotential, BondTablePotential, TableAngleForceCompute, TableDihedralForceCompute and
+    EAMForceCompute all evaluate functions sampled on a uniform grid. The routines in this file implement the
+    interpolation once, for both the CPU and the GPU code paths.
+
+    Two table formats are supported:
+     - <b>Value/derivative tables</b> store one Scalar2 per grid point, with the value V in x and the force
+       F = -dV/dx in y (table_interpolate()). The two Scalar2 entries that straddle x are read and combined either
+       linearly, or with a cubic Hermite spline that uses F as the slope. The cubic spline is continuous in V and F
+       and its force is the exact derivative of its energy, so tables can be several times coarser than with linear
+       interpolation for the same accuracy. Both forms need the same memory.
+     - <b>Coefficient tables</b> store one Scalar4 per grid interval with the coefficients of a cubic polynomial in
+       the local coordinate t in [0,1): w + z t + y t^2 + x t^3 (spline_value(), spline_derivative()). The derivative
+       is computed from the same coefficients, so no second table is needed. compute_spline_coefficients() fills
+       the coefficients from tabulated values.
+
+    All routines are branch free so that they vectorize on the CPU and do not diverge on the GPU.
+*/
+
+// need to declare these functions with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#ifdef NVCC
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Interpolate a value/derivative table
+/*! \param VF0 Value (x) and force (y) at the grid point below the evaluation point
+    \param VF1 Value (x) and force (y) at the grid point above the evaluation point
+    \param f Fractional position of the evaluation point between the two grid points (0 <= f < 1)
+    \param delta Grid spacing
+    \param cubic Set to true for cubic Hermite interpolation, false for linear interpolation
+    \param V Output interpolated value
+    \param F Output interpolated force
+
+    Linear interpolation interpolates V and F independently. Cubic interpolation builds the Hermite polynomial
+    V(t) = V0 + c1 t + c2 t^2 + c3 t^3 that matches V and dV/dx = -F at both grid points and returns F = -dV/dx of
+    that polynomial.
+*/
+DEVICE inline void table_interpolate(const Scalar2& VF0,
+                                     const Scalar2& VF1,
+                                     const Scalar f,
+                                     const Scalar delta,
+                                     const bool cubic,
+                                     Scalar& V,
+                                     Scalar& F)
+    {
+    // Hermite coefficients in the local coordinate f, the slopes are -F scaled to the grid spacing
+    Scalar dV = VF1.x - VF0.x;
+    Scalar c1 = -delta * VF0.y;
+    Scalar c2 = Scalar(3.0) * dV + Scalar(2.0) * delta * VF0.y + delta * VF1.y;
+    Scalar c3 = Scalar(-2.0) * dV - delta * (VF0.y + VF1.y);
+
+    Scalar V_cubic = VF0.x + f * (c1 + f * (c2 + f * c3));
+    Scalar F_cubic = VF0.y - f * (Scalar(2.0) * c2 + Scalar(3.0) * f * c3) / delta;
+
+    Scalar V_linear = VF0.x + f * dV;
+    Scalar F_linear = VF0.y + f * (VF1.y - VF0.y);
+
+    V = cubic ? V_cubic : V_linear;
+    F = cubic ? F_cubic : F_linear;
+    }
+
+//! Evaluate a cubic polynomial stored in a coefficient table
+/*! \param c Coefficients of the polynomial: w + z t + y t^2 + x t^3
+    \param t Local coordinate in the grid interval (0 <= t < 1)
+    \returns The value of the polynomial at \a t
+*/
+DEVICE inline Scalar spline_value(const Scalar4& c, const Scalar t)
+    {
+    return c.w + t * (c.z + t * (c.y + t * c.x));
+    }
+
+//! Evaluate the derivative of a cubic polynomial stored in a coefficient table
+/*! \param c Coefficients of the polynomial: w + z t + y t^2 + x t^3
+    \param t Local coordinate in the grid interval (0 <= t < 1)
+    \returns The derivative of the polynomial with respect to \a t. Multiply by the inverse grid spacing to obtain
+             the derivative with respect to the tabulated variable.
+*/
+DEVICE inline Scalar spline_derivative(const Scalar4& c, const Scalar t)
+    {
+    return c.z + t * (Scalar(2.0) * c.y + Scalar(3.0) * t * c.x);
+    }
+
+#ifndef NVCC
+//! Compute the coefficients of a cubic spline through tabulated values
+/*! \param c Table of \a n entries. On input, c[i].w holds the i-th tabulated value. On output, c[i] holds the
+             coefficients of the cubic polynomial on the interval [i, i+1).
+    \param n Number of tabulated values (must be at least 5)
+
+    The slopes at the grid points are estimated with a fourth order central finite difference (second order at the
+    ends), and each interval is the Hermite cubic that matches the values and slopes at its end points. The
+    polynomial of the last grid point is constant.
+*/
+inline void compute_spline_coefficients(Scalar4 *c, unsigned int n)
+    {
+    // slopes at the grid points (per grid interval)
+    c[0].z = c[1].w - c[0].w;
+    c[1].z = Scalar(0.5) * (c[2].w - c[0].w);
+    c[n - 2].z = Scalar(0.5) * (c[n - 1].w - c[n - 3].w);
+    c[n - 1].z = c[n - 1].w - c[n - 2].w;
+    for (unsigned int i = 2; i < n - 2; i++)
+        {
+        c[i].z = (c[i - 2].w - c[i + 2].w + Scalar(8.0) * (c[i + 1].w - c[i - 1].w)) / Scalar(12.0);
+        }
+
+    // Hermite cubic on each interval
+    for (unsigned int i = 0; i < n - 1; i++)
+        {
+        Scalar dv = c[i + 1].w - c[i].w;
+        c[i].y = Scalar(3.0) * dv - Scalar(2.0) * c[i].z - c[i + 1].z;
+        c[i].x = c[i].z + c[i + 1].z - Scalar(2.0) * dv;
+        }
+    c[n - 1].y = Scalar(0.0);
+    c[n - 1].x = Scalar(0.0);
+    }
+#endif
+
+#endif // __TABLE_INTERPOLATION_H__
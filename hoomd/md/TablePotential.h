@@ -56,6 +56,9 @@
     Values are interpolated linearly between two points straddling the given r. For a given r, the first point needed, i
     can be calculated via i = floorf((r - rmin) / dr). The fraction between ri and ri+1 can be calculated via
     f = (r - rmin) / dr - Scalar(i). And the linear interpolation can then be performed via V(r) ~= Vi + f * (Vi+1 - Vi)
+
+    When cubic interpolation is enabled with setCubicInterpolation(), the same two table entries define a cubic
+    Hermite spline that uses F as the slope of V. See table_interpolate() for details.
     \ingroup computes
 */
 class TablePotential : public ForceCompute
@@ -78,6 +81,12 @@ class TablePotential : public ForceCompute
                               Scalar rmin,
                               Scalar rmax);
 
+        //! Select cubic (true) or linear (false) interpolation of the tables
+        void setCubicInterpolation(bool cubic)
+            {
+            m_cubic = cubic;
+            }
+
         //! Returns a list of log quantities this compute calculates
         virtual std::vector< std::string > getProvidedLogQuantities();
 
@@ -91,6 +100,7 @@ class TablePotential : public ForceCompute
         GPUArray<Scalar2> m_tables;                  //!< Stored V and F tables
         GPUArray<Scalar4> m_params;                 //!< Parameters stored for each table
         std::string m_log_name;                     //!< Cached log name
+        bool m_cubic;                               //!< True if the tables are interpolated with cubic splines
 
         //! Actually compute the forces
         virtual void computeForces(unsigned int timestep);
@@ -93,6 +93,7 @@ void TablePotentialGPU::computeForces(unsigned int timestep)
                              this->m_nlist->getNListArray().getPitch(),
                              m_ntypes,
                              m_table_width,
+                             m_cubic,
                              m_tuner->getParam(),
                              m_exec_conf->getComputeCapability(),
                              m_exec_conf->dev_prop.maxTexture1DLinear);
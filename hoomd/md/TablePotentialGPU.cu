@@ -5,6 +5,7 @@
 // Maintainer: joaander
 
 #include "TablePotentialGPU.cuh"
+#include "TableInterpolation.h"
 #include "hoomd/TextureTools.h"
 
 #include "hoomd/Index1D.h"
@@ -38,6 +39,7 @@ scalar2_tex_t tables_tex;
     \param d_params Parameters for each table associated with a type pair
     \param ntypes Number of particle types in the system
     \param table_width Number of points in each table
+    \param cubic True to interpolate the tables with cubic splines
 
     See TablePotential for information on the memory layout.
 
@@ -61,7 +63,8 @@ __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
                                                 const Scalar2 *d_tables,
                                                 const Scalar4 *d_params,
                                                 const unsigned int ntypes,
-                                                const unsigned int table_width)
+                                                const unsigned int table_width,
+                                                const bool cubic)
     {
     // index calculation helpers
     Index2DUpperTriangular table_index(ntypes);
@@ -159,18 +162,12 @@ __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
             Scalar2 VF0 = texFetchScalar2(d_tables, tables_tex, table_value(value_i, cur_table_index));
             Scalar2 VF1 = texFetchScalar2(d_tables, tables_tex, table_value(value_i+1, cur_table_index));
 
-            // unpack the data
-            Scalar V0 = VF0.x;
-            Scalar V1 = VF1.x;
-            Scalar F0 = VF0.y;
-            Scalar F1 = VF1.y;
-
-            // compute the linear interpolation coefficient
+            // compute the interpolation coefficient
             Scalar f = value_f - Scalar(value_i);
 
             // interpolate to get V and F;
-            Scalar V = V0 + f * (V1 - V0);
-            Scalar F = F0 + f * (F1 - F0);
+            Scalar V, F;
+            table_interpolate(VF0, VF1, f, delta_r, cubic, V, F);
 
             // convert to standard variables used by the other pair computes in HOOMD-blue
             Scalar forcemag_divr = Scalar(0.0);
@@ -221,6 +218,7 @@ __global__ void gpu_compute_table_forces_kernel(Scalar4* d_force,
     \param size_nlist Total length of the neighborlist
     \param ntypes Number of particle types in the system
     \param table_width Number of points in each table
+    \param cubic True to interpolate the tables with cubic splines
     \param block_size Block size at which to run the kernel
     \param compute_capability Compute capability of the device (200, 300, 350)
     \param max_tex1d_width Maximum width of a linear 1d texture
@@ -242,6 +240,7 @@ cudaError_t gpu_compute_table_forces(Scalar4* d_force,
                                      const unsigned int size_nlist,
                                      const unsigned int ntypes,
                                      const unsigned int table_width,
+                                     const bool cubic,
                                      const unsigned int block_size,
                                      const unsigned int compute_capability,
                                      const unsigned int max_tex1d_width)
@@ -309,7 +308,8 @@ cudaError_t gpu_compute_table_forces(Scalar4* d_force,
                                                                                                            d_tables,
                                                                                                            d_params,
                                                                                                            ntypes,
-                                                                                                           table_width);
+                                                                                                           table_width,
+                                                                                                           cubic);
         }
     else
         {
@@ -342,7 +342,8 @@ cudaError_t gpu_compute_table_forces(Scalar4* d_force,
                                                                                                            d_tables,
                                                                                                            d_params,
                                                                                                            ntypes,
-                                                                                                           table_width);
+                                                                                                           table_width,
+                                                                                                           cubic);
         }
 
     return cudaSuccess;
@@ -31,6 +31,7 @@ cudaError_t gpu_compute_table_forces(Scalar4* d_force,
                                      const unsigned int size_nlist,
                                      const unsigned int ntypes,
                                      const unsigned int table_width,
+                                     const bool cubic,
                                      const unsigned int block_size,
                                      const unsigned int compute_capability,
                                      const unsigned int max_tex1d_width);
@@ -9,10 +9,6 @@
 #include "QuaternionMath.h"
 #include "hoomd/HOOMDMath.h"
 
-#include "hoomd/Saru.h"
-using namespace hoomd;
-
-
 #ifdef ENABLE_MPI
 #include "hoomd/HOOMDMPI.h"
 #endif
@@ -71,11 +67,15 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
     const Scalar currentTemp = m_T->getValue(timestep);
     const unsigned int D = Scalar(m_sysdef->getNDimensions());
 
+    // draw the random numbers for all group members at once
+    drawRandomNumbers(timestep, m_aniso ? 3 : 1);
+    ArrayHandle<Scalar4> h_uniform(m_uniform, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_normal(m_normal, access_location::host, access_mode::read);
+
     const GPUArray< Scalar4 >& net_force = m_pdata->getNetForce();
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::readwrite);
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_gamma(m_gamma, access_location::host, access_mode::read);
@@ -96,15 +96,11 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
         unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
-
-        // Initialize the RNG
-        detail::Saru saru(ptag, timestep, m_seed);
 
-        // compute the random force
-        Scalar rx = saru.s<Scalar>(-1,1);
-        Scalar ry = saru.s<Scalar>(-1,1);
-        Scalar rz = saru.s<Scalar>(-1,1);
+        // compute the random force from the pre-drawn uniform random numbers
+        Scalar rx = h_uniform.data[group_idx].x;
+        Scalar ry = h_uniform.data[group_idx].y;
+        Scalar rz = h_uniform.data[group_idx].z;
 
         Scalar gamma;
         if (m_use_lambda)
@@ -138,10 +134,10 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
         // draw a new random velocity for particle j
         Scalar mass =  h_vel.data[j].w;
         Scalar sigma = fast::sqrt(currentTemp/mass);
-        h_vel.data[j].x = gaussian_rng(saru, sigma);
-        h_vel.data[j].y = gaussian_rng(saru, sigma);
+        h_vel.data[j].x = h_normal.data[group_idx].x * sigma;
+        h_vel.data[j].y = h_normal.data[group_idx].y * sigma;
         if (D > 2)
-            h_vel.data[j].z = gaussian_rng(saru, sigma);
+            h_vel.data[j].z = h_normal.data[group_idx].z * sigma;
         else
             h_vel.data[j].z = 0;
 
@@ -167,9 +163,10 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
                 // original Gaussian random torque
                 // Gaussian random distribution is preferred in terms of preserving the exact math
                 vec3<Scalar> bf_torque;
-                bf_torque.x = gaussian_rng(saru, sigma_r);
-                bf_torque.y = gaussian_rng(saru, sigma_r);
-                bf_torque.z = gaussian_rng(saru, sigma_r);
+                Scalar4 normal_t = h_normal.data[group_size + group_idx];
+                bf_torque.x = normal_t.x * sigma_r;
+                bf_torque.y = normal_t.y * sigma_r;
+                bf_torque.z = normal_t.z * sigma_r;
 
                 if (x_zero) bf_torque.x = 0;
                 if (y_zero) bf_torque.y = 0;
@@ -194,9 +191,10 @@ void TwoStepBD::integrateStepOne(unsigned int timestep)
                 h_orientation.data[j] = quat_to_scalar4(q);
 
                 // draw a new random ang_mom for particle j in body frame
-                p_vec.x = gaussian_rng(saru, fast::sqrt(currentTemp * I.x));
-                p_vec.y = gaussian_rng(saru, fast::sqrt(currentTemp * I.y));
-                p_vec.z = gaussian_rng(saru, fast::sqrt(currentTemp * I.z));
+                Scalar4 normal_p = h_normal.data[2*group_size + group_idx];
+                p_vec.x = normal_p.x * fast::sqrt(currentTemp * I.x);
+                p_vec.y = normal_p.y * fast::sqrt(currentTemp * I.y);
+                p_vec.z = normal_p.z * fast::sqrt(currentTemp * I.z);
                 if (x_zero) p_vec.x = 0;
                 if (y_zero) p_vec.y = 0;
                 if (z_zero) p_vec.z = 0;
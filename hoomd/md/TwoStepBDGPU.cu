@@ -8,7 +8,7 @@
 #include "hoomd/VectorMath.h"
 #include "hoomd/HOOMDMath.h"
 
-#include "hoomd/Saru.h"
+#include "hoomd/Philox.h"
 using namespace hoomd;
 
 #include <assert.h>
@@ -50,8 +50,9 @@ extern __shared__ Scalar s_gammas[];
 
     This kernel is implemented in a very similar manner to gpu_nve_step_one_kernel(), see it for design details.
 
-    Random number generation is done per thread with Saru's 3-seed constructor. The seeds are, the time step,
-    the particle tag, and the user-defined seed.
+    Random number generation is done per thread with the Philox4x32 3-seed constructor. The seeds are the particle
+    tag, the time step, and the user-defined seed. The random force, velocity, torque and angular momentum each use
+    one block of four random numbers, in the same order as TwoStepBD on the CPU.
 
     This kernel must be launched with enough dynamic shared memory per block to read in d_gamma
 */
@@ -120,10 +121,9 @@ void gpu_brownian_step_one_kernel(Scalar4 *d_pos,
         unsigned int ptag = d_tag[idx];
 
         // compute the random force
-        detail::Saru saru(ptag, timestep, seed);
-        Scalar rx = saru.s<Scalar>(-1,1);
-        Scalar ry = saru.s<Scalar>(-1,1);
-        Scalar rz =  saru.s<Scalar>(-1,1);
+        detail::Philox4x32 rng(ptag, timestep, seed);
+        Scalar rx, ry, rz, rw;
+        rng.uniform4<Scalar>(Scalar(-1.0), Scalar(1.0), rx, ry, rz, rw);
 
         // calculate the magnitude of the random force
         Scalar gamma;
@@ -162,10 +162,10 @@ void gpu_brownian_step_one_kernel(Scalar4 *d_pos,
         // draw a new random velocity for particle j
         Scalar mass = vel.w;
         Scalar sigma = fast::sqrt(T/mass);
-        vel.x = gaussian_rng(saru, sigma);
-        vel.y = gaussian_rng(saru, sigma);
+        Scalar vel_z;
+        rng.normal4<Scalar>(sigma, vel.x, vel.y, vel_z, rw);
         if (D > 2)
-            vel.z = gaussian_rng(saru, sigma);
+            vel.z = vel_z;
         else
             vel.z = 0;
 
@@ -199,9 +199,7 @@ void gpu_brownian_step_one_kernel(Scalar4 *d_pos,
                 // original Gaussian random torque
                 // Gaussian random distribution is preferred in terms of preserving the exact math
                 vec3<Scalar> bf_torque;
-                bf_torque.x = gaussian_rng(saru, sigma_r);
-                bf_torque.y = gaussian_rng(saru, sigma_r);
-                bf_torque.z = gaussian_rng(saru, sigma_r);
+                rng.normal4<Scalar>(sigma_r, bf_torque.x, bf_torque.y, bf_torque.z, rw);
 
                 if (x_zero) bf_torque.x = 0;
                 if (y_zero) bf_torque.y = 0;
@@ -224,9 +222,10 @@ void gpu_brownian_step_one_kernel(Scalar4 *d_pos,
                 d_orientation[idx] = quat_to_scalar4(q);
 
                 // draw a new random ang_mom for particle j in body frame
-                p_vec.x = gaussian_rng(saru, fast::sqrt(T * I.x));
-                p_vec.y = gaussian_rng(saru, fast::sqrt(T * I.y));
-                p_vec.z = gaussian_rng(saru, fast::sqrt(T * I.z));
+                rng.normal4<Scalar>(Scalar(1.0), p_vec.x, p_vec.y, p_vec.z, rw);
+                p_vec.x *= fast::sqrt(T * I.x);
+                p_vec.y *= fast::sqrt(T * I.y);
+                p_vec.z *= fast::sqrt(T * I.z);
                 if (x_zero) p_vec.x = 0;
                 if (y_zero) p_vec.y = 0;
                 if (z_zero) p_vec.z = 0;
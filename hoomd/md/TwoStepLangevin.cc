@@ -5,7 +5,6 @@
 // Maintainer: joaander
 
 #include "TwoStepLangevin.h"
-#include "hoomd/Saru.h"
 #include "hoomd/VectorMath.h"
 
 #ifdef ENABLE_MPI
@@ -14,7 +13,6 @@
 
 namespace py = pybind11;
 using namespace std;
-using namespace hoomd;
 
 /*! \file TwoStepLangevin.h
     \brief Contains code for the TwoStepLangevin class
@@ -246,11 +244,15 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
     if (m_prof)
         m_prof->push("Langevin step 2");
 
+    // draw the random numbers for all group members at once
+    drawRandomNumbers(timestep, m_aniso ? 1 : 0);
+    ArrayHandle<Scalar4> h_uniform(m_uniform, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_normal(m_normal, access_location::host, access_mode::read);
+
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar3> h_accel(m_pdata->getAccelerations(), access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_gamma(m_gamma, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_gamma_r(m_gamma_r, access_location::host, access_mode::read);
@@ -272,16 +274,12 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
     for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
         {
         unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
-
-        // Initialize the RNG
-        detail::Saru saru(ptag, timestep, m_seed);
 
         // first, calculate the BD forces
-        // Generate three random numbers
-        Scalar rx = saru.s<Scalar>(-1,1);
-        Scalar ry = saru.s<Scalar>(-1,1);
-        Scalar rz = saru.s<Scalar>(-1,1);
+        // use the three pre-drawn uniform random numbers
+        Scalar rx = h_uniform.data[group_idx].x;
+        Scalar ry = h_uniform.data[group_idx].y;
+        Scalar rz = h_uniform.data[group_idx].z;
 
         Scalar gamma;
         if (m_use_lambda)
@@ -342,9 +340,9 @@ void TwoStepLangevin::integrateStepTwo(unsigned int timestep)
                 Scalar sigma_r = fast::sqrt(Scalar(2.0)*gamma_r*currentTemp/m_deltaT);
                 if (m_noiseless_r) sigma_r = Scalar(0.0);
 
-                Scalar rand_x = gaussian_rng(saru, sigma_r);
-                Scalar rand_y = gaussian_rng(saru, sigma_r);
-                Scalar rand_z = gaussian_rng(saru, sigma_r);
+                Scalar rand_x = h_normal.data[group_idx].x * sigma_r;
+                Scalar rand_y = h_normal.data[group_idx].y * sigma_r;
+                Scalar rand_z = h_normal.data[group_idx].z * sigma_r;
 
                 // check for degenerate moment of inertia
                 bool x_zero, y_zero, z_zero;
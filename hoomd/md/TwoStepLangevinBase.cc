@@ -7,6 +7,7 @@
 
 
 #include "TwoStepLangevinBase.h"
+#include "hoomd/Philox.h"
 
 #ifdef ENABLE_MPI
 #include "hoomd/HOOMDMPI.h"
@@ -67,6 +68,11 @@ TwoStepLangevinBase::TwoStepLangevinBase(std::shared_ptr<SystemDefinition> sysde
     for (unsigned int i = 0; i < m_gamma_r.size(); i++)
         h_gamma_r.data[i] = Scalar(1.0);
 
+    GPUVector<Scalar4> uniform(m_exec_conf);
+    m_uniform.swap(uniform);
+    GPUVector<Scalar4> normal(m_exec_conf);
+    m_normal.swap(normal);
+
     // connect to the ParticleData to receive notifications when the maximum number of particles changes
     m_pdata->getNumTypesChangeSignal().connect<TwoStepLangevinBase, &TwoStepLangevinBase::slotNumTypesChange>(this);
     }
@@ -100,6 +106,40 @@ void TwoStepLangevinBase::slotNumTypesChange()
         }
     }
 
+/*! \param timestep Current time step
+    \param n_normal_blocks Number of blocks of four normal random numbers to draw per group member
+
+    Draws the random numbers for all group members at once with hoomd::detail::Philox4x32 seeded with the particle
+    tag, the time step, and the seed. m_uniform[i] holds four uniform random numbers on (-1,1] for group member i
+    (block 0 of its stream), and m_normal[b*group_size + i] holds four normal random numbers with unit variance
+    (block b+1). The GPU kernels seed the generator the same way and draw the same numbers.
+
+    Call this before acquiring the particle tags.
+*/
+void TwoStepLangevinBase::drawRandomNumbers(unsigned int timestep, unsigned int n_normal_blocks)
+    {
+    unsigned int group_size = m_group->getNumMembers();
+
+    if (m_uniform.size() < group_size)
+        m_uniform.resize(group_size);
+    if (m_normal.size() < n_normal_blocks*group_size)
+        m_normal.resize(n_normal_blocks*group_size);
+
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_uniform(m_uniform, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_normal(m_normal, access_location::host, access_mode::overwrite);
+
+    hoomd::detail::philox_uniform4(h_uniform.data, h_index.data, h_tag.data, group_size, timestep, m_seed,
+        Scalar(-1.0), Scalar(1.0));
+
+    for (unsigned int b = 0; b < n_normal_blocks; b++)
+        {
+        hoomd::detail::philox_normal4(h_normal.data + b*group_size, h_index.data, h_tag.data, group_size, timestep,
+            m_seed, b+1);
+        }
+    }
+
 /*! \param typ Particle type to set gamma for
     \param gamma The gamma value to set
 */
@@ -60,8 +60,14 @@ class TwoStepLangevinBase : public IntegrationMethodTwoStep
         GPUVector<Scalar> m_gamma;        //!< List of per type gammas to use
         GPUVector<Scalar> m_gamma_r;      //!< List of per type gamma_r (for 2D-only rotational noise) to use
 
+        GPUVector<Scalar4> m_uniform;     //!< Uniform random numbers on (-1,1] per group member (CPU only)
+        GPUVector<Scalar4> m_normal;      //!< Blocks of normal random numbers per group member (CPU only)
+
         //! Method to be called when number of types changes
         virtual void slotNumTypesChange();
+
+        //! Draw the random numbers for all group members
+        void drawRandomNumbers(unsigned int timestep, unsigned int n_normal_blocks);
     };
 
 //! Exports the TwoStepLangevinBase class to python
@@ -6,7 +6,7 @@
 
 #include "TwoStepLangevinGPU.cuh"
 
-#include "hoomd/Saru.h"
+#include "hoomd/Philox.h"
 using namespace hoomd;
 
 #include <assert.h>
@@ -49,8 +49,9 @@ extern __shared__ Scalar bdtally_sdata[];
 
     This kernel will tally the energy transfer from the bd thermal reservoir and the particle system
 
-    Random number generation is done per thread with Saru's 3-seed constructor. The seeds are, the time step,
-    the particle tag, and the user-defined seed.
+    Random number generation is done per thread with the Philox4x32 3-seed constructor. The seeds are the particle
+    tag, the time step, and the user-defined seed. The translational noise is the first block of four random numbers
+    of each particle, the same block that TwoStepLangevin draws on the CPU.
 
     This kernel must be launched with enough dynamic shared memory per block to read in d_gamma
 */
@@ -125,11 +126,10 @@ void gpu_langevin_step_two_kernel(const Scalar4 *d_pos,
             coeff = Scalar(0.0);
 
         //Initialize the Random Number Generator and generate the 3 random numbers
-        detail::Saru s(ptag, timestep, seed); // 3 dimensional seeding
+        detail::Philox4x32 rng(ptag, timestep, seed); // 3 dimensional seeding
 
-        Scalar randomx=s.s<Scalar>(-1.0, 1.0);
-        Scalar randomy=s.s<Scalar>(-1.0, 1.0);
-        Scalar randomz=s.s<Scalar>(-1.0, 1.0);
+        Scalar randomx, randomy, randomz, randomw;
+        rng.uniform4<Scalar>(Scalar(-1.0), Scalar(1.0), randomx, randomy, randomz, randomw);
 
         bd_force.x = randomx*coeff - gamma*vel.x;
         bd_force.y = randomy*coeff - gamma*vel.y;
@@ -307,10 +307,11 @@ __global__ void gpu_langevin_angular_step_two_kernel(
             Scalar sigma_r = fast::sqrt(Scalar(2.0)*gamma_r*T/deltaT);
             if (noiseless_r) sigma_r = Scalar(0.0);
 
-            detail::Saru saru(ptag, timestep, seed); // 3 dimensional seeding
-            Scalar rand_x = gaussian_rng(saru, sigma_r);
-            Scalar rand_y = gaussian_rng(saru, sigma_r);
-            Scalar rand_z = gaussian_rng(saru, sigma_r);
+            // the second block of the particle's stream, the first one is used by the translational noise
+            detail::Philox4x32 rng(ptag, timestep, seed); // 3 dimensional seeding
+            rng.advance(1);
+            Scalar rand_x, rand_y, rand_z, rand_w;
+            rng.normal4<Scalar>(sigma_r, rand_x, rand_y, rand_z, rand_w);
 
             // check for zero moment of inertia
             bool x_zero, y_zero, z_zero;
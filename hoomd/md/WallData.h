@@ -5,8 +5,8 @@
 // Maintainer: jproc
 
 /*! \file WallData.h
-    \brief Contains declarations for all types (currently Sphere, Cylinder, and
-    Plane) of WallData and associated utilities.
+    \brief Contains declarations for all types (currently Sphere, Cylinder, Plane
+    and Mesh) of WallData and associated utilities.
  */
 #ifndef WALL_DATA_H
 #define WALL_DATA_H
@@ -16,8 +16,12 @@
 
 #ifdef NVCC
 #define DEVICE __device__
+class TriangleMesh;
 #else
 #define DEVICE
+#include "hoomd/TriangleMesh.h"
+#include <memory>
+#include <vector>
 #endif
 
 //! SphereWall Constructor
@@ -101,6 +105,31 @@ struct PlaneWall
     bool            inside;
     } __attribute__((aligned(ALIGN_SCALAR))); // align according to first member of vec3<Scalar>
 
+//! MeshWall Constructor
+/*! \param mesh Closed triangle mesh with outward normals, owned by the python wall object
+    \param inside Determines which half space is evaluated.
+
+    Mesh walls are only evaluated on the CPU.
+*/
+struct MeshWall
+    {
+    MeshWall(const TriangleMesh *m = NULL, bool ins = true) : mesh(m), inside(ins) {}
+    const TriangleMesh *mesh;
+    bool            inside;
+    };
+
+#ifndef NVCC
+//! Host storage for the mesh walls of a wall group
+/*! The wall field only points into \a walls, so that the mesh walls do not take up room in the field that
+    the GPU kernels copy. The shared pointers keep the meshes alive while the field refers to them.
+*/
+struct MeshWallList
+    {
+    std::vector< std::shared_ptr<TriangleMesh> > meshes; //!< The meshes of the walls
+    std::vector<MeshWall> walls;                          //!< The mesh walls
+    };
+#endif
+
 //! Point to wall vector for a sphere wall geometry
 /* Returns 0 vector when all normal directions are equal
 */
@@ -159,6 +188,27 @@ DEVICE inline vec3<Scalar> vecPtToWall(const PlaneWall& wall, const vec3<Scalar>
     return dx;
     };
 
+#ifndef NVCC
+//! Point to wall vector for a mesh wall geometry
+/* Returns the vector to the nearest point on the mesh and sets \a normal to the pseudo-normal of the mesh there.
+   Returns 0 vector with inside false when no point of the mesh is closer than r_max.
+*/
+inline vec3<Scalar> vecPtToWall(const MeshWall& wall, const vec3<Scalar>& position, bool& inside, vec3<Scalar>& normal,
+    Scalar r_max)
+    {
+    vec3<Scalar> dx;
+    if (!wall.mesh->findNearest(position, r_max, dx, normal))
+        {
+        inside = false;
+        return vec3<Scalar>(0.0,0.0,0.0);
+        }
+    // the normals point out of the mesh, and dx points from the position to the mesh
+    bool in_mesh = dot(dx, normal) >= 0.0;
+    inside = (in_mesh == wall.inside);
+    return dx;
+    };
+#endif
+
 //! Distance of point to inside sphere wall geometry, not really distance, +- based on if it's inside or not
 DEVICE inline Scalar distWall(const SphereWall& wall, const vec3<Scalar>& position)
     {
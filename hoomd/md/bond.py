@@ -385,6 +385,7 @@ class table(force._force):
     Args:
         width (int): Number of points to use to interpolate V and F
         name (str): Name of the potential instance
+        interpolation (str): Interpolation between grid points, ``'linear'`` (default) or ``'cubic'``
 
     :py:class:`table` specifies that a tabulated bond potential should be applied between the two particles in each
     defined bond.
@@ -412,6 +413,11 @@ class table(force._force):
     :math:`r_{\mathrm{min}}` and :math:`r_{\mathrm{max}}`. Values are interpolated linearly between grid points.
     For correctness, you must specify the force defined by: :math:`F = -\frac{\partial V}{\partial r}`
 
+    With ``interpolation='cubic'``, values between grid points are interpolated with a cubic Hermite spline that
+    uses the tabulated F as the derivative of V. The interpolated force is then the exact derivative of the
+    interpolated energy, and the same accuracy can be reached with several times fewer grid points than with linear
+    interpolation. Cubic interpolation requires that F is consistent with V.
+
     The following coefficients must be set for each bond type:
 
     - :math:`F_{\mathrm{user}}(r)` and :math:`V_{\mathrm{user}}(r)` - evaluated by ``func`` (see example)
@@ -454,9 +460,13 @@ class table(force._force):
         Ensure that ``rmin`` and ``rmax`` cover the range of possible bond lengths. When gpu eror checking is on, a error will
         be thrown if a bond distance is outside than this range.
     """
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interpolation='linear'):
         hoomd.util.print_status_line();
 
+        if interpolation not in ['linear', 'cubic']:
+            hoomd.context.msg.error("bond.table: interpolation must be 'linear' or 'cubic'\n");
+            raise RuntimeError("Error initializing bond.table");
+
         # initialize the base class
         force._force.__init__(self, name);
 
@@ -467,6 +477,7 @@ class table(force._force):
         else:
             self.cpp_force = _md.BondTablePotentialGPU(hoomd.context.current.system_definition, int(width), self.name);
 
+        self.cpp_force.setCubicInterpolation(interpolation == 'cubic');
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
         # setup the coefficent matrix
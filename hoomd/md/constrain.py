@@ -238,20 +238,46 @@ class distance(_constraint_force):
 
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
-    def set_params(self,rel_tol=None):
+    def set_params(self,rel_tol=None,solver=None,solver_tol=None):
         R""" Set parameters for constraint computation.
 
         Args:
             rel_tol (float): The relative tolerance with which constraint violations are detected (**optional**).
+            solver (str): Linear solver for the constraint equation, *direct* or *iterative* (**optional**).
+            solver_tol (float): Relative residual at which the *iterative* solver stops (**optional**).
+
+        The matrix of the constraint equation only couples constraints that share a particle. It is stored
+        as a sparse matrix, so that systems with many constraints, such as rigid water or bond-constrained polymers,
+        need memory and time proportional to the number of constraints.
+
+        The *direct* solver (default) computes the sparse LU factorization of the matrix on every step. The
+        *iterative* solver reuses the factorization of an earlier step to refine the Lagrange multipliers of the
+        previous step, and only factorizes the matrix again when this does not converge within a few iterations
+        or when the constraint topology changes. The *iterative* solver is only available on the CPU.
 
         Example::
 
             dist = constrain.distance()
             dist.set_params(rel_tol=0.0001)
+            dist.set_params(solver='iterative', solver_tol=1e-10)
         """
+        hoomd.util.print_status_line();
+
         if rel_tol is not None:
             self.cpp_force.setRelativeTolerance(float(rel_tol))
 
+        if solver is not None:
+            if solver == 'direct':
+                self.cpp_force.setSolver(_md.ForceDistanceConstraint.solverType.direct)
+            elif solver == 'iterative':
+                self.cpp_force.setSolver(_md.ForceDistanceConstraint.solverType.iterative)
+            else:
+                hoomd.context.msg.error("Invalid solver " + str(solver) + "\n");
+                raise RuntimeError('Error changing parameters in constrain.distance');
+
+        if solver_tol is not None:
+            self.cpp_force.setSolverTolerance(float(solver_tol))
+
 class rigid(_constraint_force):
     R""" Constrain particles in rigid bodies.
 
@@ -296,6 +296,7 @@ class table(force._force):
     Args:
         width (int): Number of points to use to interpolate V and T (see documentation above)
         name (str): Name of the force instance
+        interpolation (str): Interpolation between grid points, ``'linear'`` (default) or ``'cubic'``
 
     :py:class:`table` specifies that a tabulated dihedral force should be applied to every define dihedral.
 
@@ -304,6 +305,11 @@ class table(force._force):
     For correctness, you must specify the derivative of the potential with respect to the dihedral angle,
     defined by: :math:`T = -\frac{\partial V}{\partial \theta}`.
 
+    With ``interpolation='cubic'``, values between grid points are interpolated with a cubic Hermite spline that
+    uses the tabulated T as the derivative of V. The interpolated force is then the exact derivative of the
+    interpolated energy, and the same accuracy can be reached with several times fewer grid points than with linear
+    interpolation. Cubic interpolation requires that T is consistent with V.
+
     Parameters:
 
     - :math:`T_{\mathrm{user}}(\theta)` and :math:`V_{\mathrm{user}} (\theta)` - evaluated by ``func`` (see example)
@@ -334,9 +340,13 @@ class table(force._force):
         dtable.set_from_file('polymer', 'dihedral.dat')
 
     """
-    def __init__(self, width, name=None):
+    def __init__(self, width, name=None, interpolation='linear'):
         hoomd.util.print_status_line();
 
+        if interpolation not in ['linear', 'cubic']:
+            hoomd.context.msg.error("dihedral.table: interpolation must be 'linear' or 'cubic'\n");
+            raise RuntimeError("Error initializing dihedral.table");
+
         # initialize the base class
         force._force.__init__(self, name);
 
@@ -347,6 +357,7 @@ class table(force._force):
         else:
             self.cpp_force = _md.TableDihedralForceComputeGPU(hoomd.context.current.system_definition, int(width), self.name);
 
+        self.cpp_force.setCubicInterpolation(interpolation == 'cubic');
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
         # setup the coefficent matrix
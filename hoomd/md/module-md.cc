@@ -122,8 +122,27 @@ void export_tersoff_params(py::module& m)
     m.def("make_tersoff_params", &make_tersoff_params);
 }
 
+//! Helper function for collecting the mesh walls of a python wall group
+std::shared_ptr<MeshWallList> make_mesh_wall_list(py::object walls)
+    {
+    std::shared_ptr<MeshWallList> l(new MeshWallList());
+    py::list walls_meshes = walls.attr("meshes").cast<py::list>();
+    for(unsigned int i = 0; i < py::len(walls_meshes); i++)
+        {
+        std::shared_ptr<TriangleMesh> mesh = py::cast< std::shared_ptr<TriangleMesh> >(py::object(walls_meshes[i]).attr("cpp_mesh"));
+        bool    inside =py::cast<bool>(py::object(walls_meshes[i]).attr("inside"));
+        l->meshes.push_back(mesh);
+        l->walls.push_back(MeshWall(mesh.get(), inside));
+        }
+    return l;
+    }
+
 //! Helper function for converting python wall group structure to wall_type
-wall_type make_wall_field_params(py::object walls, std::shared_ptr<const ExecutionConfiguration> m_exec_conf)
+/*! \param walls Python wall group
+    \param meshes Mesh walls of the group, see make_mesh_wall_list(). The caller keeps them alive while the field is used.
+    \param m_exec_conf Execution configuration
+*/
+wall_type make_wall_field_params(py::object walls, std::shared_ptr<MeshWallList> meshes, std::shared_ptr<const ExecutionConfiguration> m_exec_conf)
     {
     wall_type w;
     py::list walls_spheres = walls.attr("spheres").cast<py::list>();
@@ -132,12 +151,19 @@ wall_type make_wall_field_params(py::object walls, std::shared_ptr<const Executi
     w.numSpheres = py::len(walls_spheres);
     w.numCylinders = py::len(walls_cylinders);
     w.numPlanes = py::len(walls_planes);
+    w.numMeshes = meshes->walls.size();
+    w.Meshes = w.numMeshes ? &meshes->walls[0] : NULL;
 
     if (w.numSpheres>MAX_N_SWALLS || w.numCylinders>MAX_N_CWALLS || w.numPlanes>MAX_N_PWALLS)
         {
         m_exec_conf->msg->error() << "A number of walls greater than the maximum number allowed was specified in a wall force." << std::endl;
         throw std::runtime_error("Error loading wall group.");
         }
+    else if (w.numMeshes > 0 && m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Mesh walls are not supported on the GPU." << std::endl;
+        throw std::runtime_error("Error loading wall group.");
+        }
     else
         {
 
@@ -247,6 +273,8 @@ PYBIND11_PLUGIN(_md)
     export_PPPMForceCompute(m);
     py::class_< wall_type, std::shared_ptr<wall_type> >(m, "wall_type")
         .def(py::init<>());
+    py::class_< MeshWallList, std::shared_ptr<MeshWallList> >(m, "MeshWallList");
+    m.def("make_mesh_wall_list", &make_mesh_wall_list);
     m.def("make_wall_field_params", &make_wall_field_params);
     export_PotentialExternal<PotentialExternalPeriodic>(m, "PotentialExternalPeriodic");
     export_PotentialExternal<PotentialExternalElectricField>(m, "PotentialExternalElectricField");
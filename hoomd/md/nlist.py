@@ -794,6 +794,7 @@ class tree(nlist):
         d_max (float): The maximum diameter a particle will achieve, only used in conjunction with slj diameter shifting.
         dist_check (bool): Flag to enable / disable distance checking.
         name (str): Optional name for this neighbor list instance.
+        body_tree (bool): Search pairs of rigid bodies before pairs of their constituent particles (CPU only).
 
     :py:class:`tree` creates a neighbor list using bounding volume hierarchy (BVH) tree traversal. Pair potentials are attached
     for computing non-bonded pairwise interactions. A BVH tree of axis-aligned bounding boxes is constructed per particle
@@ -808,6 +809,15 @@ class tree(nlist):
     Users can create multiple neighbor lists, and may see significant performance increases by doing so for systems with
     size asymmetry, especially when used in conjunction with nlist.cell.
 
+    When particles in the same rigid body are excluded (the default with :py:class:`hoomd.md.constrain.rigid`), the CPU
+    implementation first searches for pairs of bodies that are close enough to interact, using the bounding box of the
+    constituent particles of each body. Each constituent particle then only searches the constituents of these bodies
+    that are within its cutoff, and pairs within the same body are never tested. Set *body_tree* to False to search
+    the per-type trees of all particles instead, and benchmark both for your system.
+
+    .. versionchanged:: 2.3
+        Added the *body_tree* argument.
+
     Examples::
 
         nl_t = nlist.tree(check_period = 1)
@@ -824,7 +834,7 @@ class tree(nlist):
         BVH tree neighbor lists are currently only supported on Kepler (sm_30) architecture devices and newer.
 
     """
-    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None):
+    def __init__(self, r_buff=0.4, check_period=1, d_max=None, dist_check=True, name=None, body_tree=True):
         hoomd.util.print_status_line()
 
         # register the citation
@@ -845,6 +855,7 @@ class tree(nlist):
         # create the C++ mirror class
         if not hoomd.context.exec_conf.isCUDAEnabled():
             self.cpp_nlist = _md.NeighborListTree(hoomd.context.current.system_definition, 0.0, r_buff)
+            self.cpp_nlist.setBodyTree(body_tree)
         else:
             self.cpp_nlist = _md.NeighborListGPUTree(hoomd.context.current.system_definition, 0.0, r_buff)
 
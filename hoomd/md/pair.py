@@ -959,6 +959,7 @@ class table(force._force):
         width (int): Number of points to use to interpolate V and F.
         nlist (:py:mod:`hoomd.md.nlist`): Neighbor list (default of None automatically creates a global cell-list based neighbor list)
         name (str): Name of the force instance
+        interpolation (str): Interpolation between grid points, ``'linear'`` (default) or ``'cubic'``
 
     :py:class:`table` specifies that a tabulated pair potential should be applied between every
     non-excluded particle pair in the simulation.
@@ -991,6 +992,11 @@ class table(force._force):
     :math:`r_{\mathrm{min}}` and :math:`r_{\mathrm{max}}`. Values are interpolated linearly between grid points.
     For correctness, you must specify the force defined by: :math:`F = -\frac{\partial V}{\partial r}`.
 
+    With ``interpolation='cubic'``, values between grid points are interpolated with a cubic Hermite spline that
+    uses the tabulated F as the derivative of V. The interpolated force is then the exact derivative of the
+    interpolated energy, and the same accuracy can be reached with several times fewer grid points than with linear
+    interpolation. Cubic interpolation requires that F is consistent with V.
+
     The following coefficients must be set per unique pair of particle types:
 
     - :math:`V_{\mathrm{user}}(r)` and :math:`F_{\mathrm{user}}(r)` - evaluated by ``func`` (see example)
@@ -1031,9 +1037,13 @@ class table(force._force):
         not diverge near r=0, then a setting of *rmin=0* is valid.
 
     """
-    def __init__(self, width, nlist, name=None):
+    def __init__(self, width, nlist, name=None, interpolation='linear'):
         hoomd.util.print_status_line();
 
+        if interpolation not in ['linear', 'cubic']:
+            hoomd.context.msg.error("pair.table: interpolation must be 'linear' or 'cubic'\n");
+            raise RuntimeError("Error initializing pair.table");
+
         # initialize the base class
         force._force.__init__(self, name);
 
@@ -1051,6 +1061,7 @@ class table(force._force):
             self.nlist.cpp_nlist.setStorageMode(_md.NeighborList.storageMode.full);
             self.cpp_force = _md.TablePotentialGPU(hoomd.context.current.system_definition, self.nlist.cpp_nlist, int(width), self.name);
 
+        self.cpp_force.setCubicInterpolation(interpolation == 'cubic');
         hoomd.context.current.system.addCompute(self.cpp_force, self.force_name);
 
         # stash the width for later use
@@ -54,6 +54,53 @@ class charge_pppm_tests (unittest.TestCase):
         del self.s
         context.initialize()
 
+# the isotropic pressure includes the long-range virial with and without the pressure tensor
+class charge_pppm_pressure_tests (unittest.TestCase):
+    def setUp(self):
+        snap = data.make_snapshot(N=2, particle_types=[u'A1'], box = data.boxdim(xy=0.5,xz=0.5,yz=0.5,L=10))
+
+        if comm.get_rank() == 0:
+            snap.particles.position[0] = (0,0,0)
+            snap.particles.position[1] = (3,3,3)
+            snap.particles.charge[0] = 1
+            snap.particles.charge[1] = -1
+
+        self.s = init.read_snapshot(snap);
+
+    def test(self):
+        all = group.all()
+        nl = md.nlist.cell()
+        c = md.charge.pppm(all, nlist = nl);
+        c.set_params(Nx=128, Ny=128, Nz=128, order=3, rcut=2.0);
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(all);
+        nl.set_params(r_buff=0.1)
+
+        # the particles are at rest and the short-range virial is zero, so the pressure is the external virial
+        # of the k-space sum, with the tensor from charge_pppm_twoparticle_tests
+        expected = (-5.7313404e-05 - 7.8745142e-05 - 0.00010732774)/3.0
+
+        # only the isotropic virial is requested
+        log = analyze.log(quantities = ['pressure'], period = 1, filename=None);
+        run(1);
+        self.assertAlmostEqual(log.query('pressure'), expected, delta=1e-2*abs(expected))
+
+        # also request the pressure tensor
+        log_tensor = analyze.log(quantities = ['pressure_xx', 'pressure_yy', 'pressure_zz'], period = 1, filename=None);
+        run(1);
+        trace = log_tensor.query('pressure_xx') + log_tensor.query('pressure_yy') + log_tensor.query('pressure_zz')
+        self.assertAlmostEqual(log.query('pressure'), expected, delta=1e-2*abs(expected))
+        self.assertAlmostEqual(log.query('pressure'), trace/3.0, delta=1e-6*abs(expected))
+
+        del all
+        del c
+        del log
+        del log_tensor
+
+    def tearDown(self):
+        del self.s
+        context.initialize();
+
 # charge.pppm
 class charge_pppm_twoparticle_tests (unittest.TestCase):
     def setUp(self):
@@ -75,6 +75,27 @@ class compute_thermo_tests (unittest.TestCase):
         numpy.testing.assert_allclose(log.query('temperature_A'), 2.0 / (3*self.N-3) * K_ref)
 
 
+    # Unit test: Validate batched computation of several groups
+    def test_batch(self):
+        low = group.tags(name='low', tag_min=0, tag_max=self.N//2-1)
+        high = group.tags(name='high', tag_min=self.N//2, tag_max=self.N-1)
+        batch = compute.thermo_batch(groups=[low, high]);
+        self.assertEqual(len(batch.thermos), 2)
+
+        log = analyze.log(filename=None, quantities=['kinetic_energy_low', 'kinetic_energy_high'], period=None);
+
+        md.integrate.mode_standard(dt=0.0);
+        md.integrate.nve(group=group.all());
+
+        run(1);
+
+        m = self.m;
+        v = self.v;
+        K = 1/2 * m * (v[:,0]**2 + v[:,1]**2 + v[:,2]**2)
+
+        numpy.testing.assert_allclose(log.query('kinetic_energy_low'), numpy.sum(K[:self.N//2]))
+        numpy.testing.assert_allclose(log.query('kinetic_energy_high'), numpy.sum(K[self.N//2:]))
+
     def tearDown(self):
         context.initialize();
 
@@ -0,0 +1,97 @@
+# -*- coding: iso-8859-1 -*-
+
+from hoomd import *
+from hoomd import md, jit
+context.initialize()
+import unittest
+
+lennard_jones = """Scalar r2inv = Scalar(1.0) / rsq;
+                   Scalar r6inv = r2inv * r2inv * r2inv;
+                   force_divr = r2inv * r6inv * (Scalar(48.0) * r6inv - Scalar(24.0));
+                   return Scalar(4.0) * r6inv * (r6inv - Scalar(1.0));
+                """
+
+# jit.pair.user
+class jit_pair_tests (unittest.TestCase):
+    def setUp(self):
+        print
+        init.create_lattice(lattice.sc(a=1.2),n=[5,5,4]);
+        self.nl = md.nlist.cell()
+
+    # basic test of creation
+    def test(self):
+        lj = jit.pair.user(r_cut=2.5, nlist=self.nl, code=lennard_jones);
+        lj.pair_coeff.set('A', 'A', r_cut=2.5);
+        lj.update_coeffs();
+        self.assertTrue(lj.cpp_force.hasBatchKernel());
+
+    # test missing coefficients
+    def test_missing_AA(self):
+        lj = jit.pair.user(r_cut=2.5, nlist=self.nl, code=lennard_jones);
+        self.assertRaises(RuntimeError, lj.update_coeffs);
+
+    # test set params
+    def test_set_params(self):
+        lj = jit.pair.user(r_cut=2.5, nlist=self.nl, code=lennard_jones);
+        lj.set_params(mode="no_shift");
+        lj.set_params(mode="shift");
+        lj.set_params(mode="xplor");
+        self.assertRaises(RuntimeError, lj.set_params, mode="blah");
+
+    # test nlist subscribe
+    def test_nlist_subscribe(self):
+        lj = jit.pair.user(r_cut=2.5, nlist=self.nl, code=lennard_jones);
+
+        lj.pair_coeff.set('A', 'A', r_cut=2.5)
+        self.nl.update_rcut();
+        self.assertAlmostEqual(2.5, self.nl.r_cut.get_pair('A','A'));
+
+        lj.pair_coeff.set('A', 'A', r_cut = 2.0)
+        self.nl.update_rcut();
+        self.assertAlmostEqual(2.0, self.nl.r_cut.get_pair('A','A'));
+
+    def tearDown(self):
+        context.initialize();
+
+# test the validity of the pair potential against md.pair.lj
+class jit_pair_potential(unittest.TestCase):
+    def setUp(self):
+        snap = data.make_snapshot(N=3, box=data.boxdim(L=10),particle_types=['A'])
+        if comm.get_rank() == 0:
+            snap.particles.position[0] = (0,0,0)
+            snap.particles.position[1] = (1.1,0,0)
+            snap.particles.position[2] = (0.3,2.2,0)
+        init.read_snapshot(snap)
+        self.nl = md.nlist.cell()
+
+    def test_potential(self):
+        md.integrate.mode_standard(dt=0)
+        nve = md.integrate.nve(group = group.all())
+
+        for mode in ['no_shift', 'shift', 'xplor']:
+            ref = md.pair.lj(r_cut=2.5, nlist = self.nl)
+            ref.pair_coeff.set('A','A', epsilon=1.0, sigma=1.0, r_on=2.0)
+            ref.set_params(mode=mode)
+            run(1)
+            f_ref = [ref.forces[i].force for i in range(3)]
+            e_ref = [ref.forces[i].energy for i in range(3)]
+            ref.disable()
+
+            lj = jit.pair.user(r_cut=2.5, nlist = self.nl, code=lennard_jones)
+            lj.pair_coeff.set('A','A', r_on=2.0)
+            lj.set_params(mode=mode)
+            run(1)
+            f_jit = [lj.forces[i].force for i in range(3)]
+            e_jit = [lj.forces[i].energy for i in range(3)]
+            lj.disable()
+
+            for i in range(3):
+                self.assertAlmostEqual(e_ref[i], e_jit[i], 5)
+                for k in range(3):
+                    self.assertAlmostEqual(f_ref[i][k], f_jit[i][k], 5)
+
+    def tearDown(self):
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
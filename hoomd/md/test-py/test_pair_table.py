@@ -21,6 +21,13 @@ class pair_table_tests (unittest.TestCase):
         table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
         table.update_coeffs();
 
+    # test cubic interpolation
+    def test_cubic(self):
+        table = md.pair.table(width=100, nlist = self.nl, interpolation='cubic');
+        table.pair_coeff.set('A', 'A', rmin=0.0, rmax=1.0, func=lambda r, rmin, rmax: (r, 2*r), coeff=dict());
+        table.update_coeffs();
+        self.assertRaises(RuntimeError, md.pair.table, width=100, nlist = self.nl, interpolation='quintic');
+
     # test missing coefficients
     def test_set_missing_epsilon(self):
         table = md.pair.table(width=1000, nlist = self.nl);
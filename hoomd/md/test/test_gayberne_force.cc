@@ -135,6 +135,39 @@ UP_TEST( AnisoPotentialPairGB_particle )
     gb_force_particle_test(gb_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test that precomputed frames give the same result as the quaternions
+UP_TEST( EvaluatorPairGB_frames )
+    {
+    Scalar3 dr = make_scalar3(0.8, 0.45, 0.9);
+    quat<Scalar> qi = quat<Scalar>::fromAxisAngle(vec3<Scalar>(1,2,0)/sqrt(5.0), 0.3);
+    quat<Scalar> qj = quat<Scalar>::fromAxisAngle(vec3<Scalar>(0,1,0), M_PI/2.0);
+    Scalar4 quat_i = quat_to_scalar4(qi);
+    Scalar4 quat_j = quat_to_scalar4(qj);
+    Scalar3 params = make_scalar3(1.5, 0.5, 1.2);
+
+    Scalar3 force, torque_i, torque_j;
+    Scalar energy = Scalar(0.0);
+    EvaluatorPairGB eval(dr, quat_i, quat_j, Scalar(2.5*2.5), params);
+    UP_ASSERT(eval.evaluate(force, energy, false, torque_i, torque_j));
+
+    Scalar3 force_frames, torque_i_frames, torque_j_frames;
+    Scalar energy_frames = Scalar(0.0);
+    EvaluatorPairGB eval_frames(dr, quat_i, quat_j, Scalar(2.5*2.5), params);
+    eval_frames.setFrames(rotmat3<Scalar>(conj(qi)), rotmat3<Scalar>(conj(qj)));
+    UP_ASSERT(eval_frames.evaluate(force_frames, energy_frames, false, torque_i_frames, torque_j_frames));
+
+    MY_CHECK_CLOSE(energy_frames, energy, tol);
+    MY_CHECK_CLOSE(force_frames.x, force.x, tol);
+    MY_CHECK_CLOSE(force_frames.y, force.y, tol);
+    MY_CHECK_CLOSE(force_frames.z, force.z, tol);
+    MY_CHECK_CLOSE(torque_i_frames.x, torque_i.x, tol);
+    MY_CHECK_CLOSE(torque_i_frames.y, torque_i.y, tol);
+    MY_CHECK_CLOSE(torque_i_frames.z, torque_i.z, tol);
+    MY_CHECK_CLOSE(torque_j_frames.x, torque_j.x, tol);
+    MY_CHECK_CLOSE(torque_j_frames.y, torque_j.y, tol);
+    MY_CHECK_CLOSE(torque_j_frames.z, torque_j.z, tol);
+    }
+
 #ifdef ENABLE_CUDA
 //! test case for particle test on GPU
 UP_TEST( LJForceGPU_particle )
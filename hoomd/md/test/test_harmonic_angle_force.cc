@@ -388,6 +388,67 @@ void angle_force_comparison_tests(angleforce_creator af_creator1, angleforce_cre
     }
     }
 
+#ifdef ENABLE_TBB
+//! Checks that the threaded force computation matches the serial one
+void angle_force_thread_tests(angleforce_creator af_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    const unsigned int N = 1000;
+
+    // randomly place particles and connect them with angles, every particle is a member of up to three angles
+    RandomInitializer rand_init(N, Scalar(0.2), Scalar(0.9), "A");
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap =  rand_init.getSnapshot();
+    snap->angle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    std::shared_ptr<HarmonicAngleForceCompute> fc = af_creator(sysdef);
+    fc->setParams(0, Scalar(1.0), Scalar(1.348));
+
+    for (unsigned int i = 0; i < N-2; i++)
+        {
+        sysdef->getAngleData()->addBondedGroup(Angle(0, i, i+1,i+2));
+        }
+
+    // compute the forces serially
+    exec_conf->setNumThreads(1);
+    fc->compute(0);
+
+    std::vector<Scalar4> force_serial(N);
+    std::vector<Scalar> virial_serial(6*N);
+        {
+        GPUArray<Scalar>& virial_array = fc->getVirialArray();
+        unsigned int pitch = virial_array.getPitch();
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(),access_location::host,access_mode::read);
+        ArrayHandle<Scalar> h_virial(virial_array,access_location::host,access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            force_serial[i] = h_force.data[i];
+            for (unsigned int j = 0; j < 6; j++)
+                virial_serial[j*N+i] = h_virial.data[j*pitch+i];
+            }
+        }
+
+    // compute them again with several threads
+    exec_conf->setNumThreads(4);
+    fc->compute(1);
+
+        {
+        GPUArray<Scalar>& virial_array = fc->getVirialArray();
+        unsigned int pitch = virial_array.getPitch();
+        ArrayHandle<Scalar4> h_force(fc->getForceArray(),access_location::host,access_mode::read);
+        ArrayHandle<Scalar> h_virial(virial_array,access_location::host,access_mode::read);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            MY_CHECK_SMALL(h_force.data[i].x - force_serial[i].x, tol_small);
+            MY_CHECK_SMALL(h_force.data[i].y - force_serial[i].y, tol_small);
+            MY_CHECK_SMALL(h_force.data[i].z - force_serial[i].z, tol_small);
+            MY_CHECK_SMALL(h_force.data[i].w - force_serial[i].w, tol_small);
+            for (unsigned int j = 0; j < 6; j++)
+                MY_CHECK_SMALL(h_virial.data[j*pitch+i] - virial_serial[j*N+i], tol_small);
+            }
+        }
+    }
+#endif
+
 //! HarmonicAngleForceCompute creator for angle_force_basic_tests()
 std::shared_ptr<HarmonicAngleForceCompute> base_class_af_creator(std::shared_ptr<SystemDefinition> sysdef)
     {
@@ -412,6 +473,16 @@ UP_TEST( HarmonicAngleForceCompute_basic )
     angle_force_basic_tests(af_creator, exec_conf);
     }
 
+#ifdef ENABLE_TBB
+//! test case for comparing threaded and serial angle forces on the CPU
+UP_TEST( HarmonicAngleForceCompute_threads )
+    {
+    angleforce_creator af_creator = bind(base_class_af_creator, _1);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    angle_force_thread_tests(af_creator, exec_conf);
+    }
+#endif
+
 #ifdef ENABLE_CUDA
 //! test case for angle forces on the GPU
 UP_TEST( HarmonicAngleForceComputeGPU_basic )
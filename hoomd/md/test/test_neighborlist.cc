@@ -935,6 +935,123 @@ void neighborlist_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+//! Maximum diameter of the composite particles in neighborlist_body_comparison_test
+Scalar body_comparison_diameter()
+    {
+    return Scalar(2.0);
+    }
+
+//! Test two implementations of NeighborList on a system of rigid bodies and verify that the output is identical
+/*! \param large_bodies If true, the bodies have more particles than fit in a leaf of an AABB tree
+    \param body_tree Passed to NeighborListTree::setBodyTree() of the second neighbor list
+*/
+template <class NLA, class NLB>
+void neighborlist_body_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_conf, bool large_bodies=false,
+    bool body_tree=true)
+    {
+    // 64 bodies of 5 or 27 particles each, some of them wrapped across the periodic boundaries
+    std::vector<Scalar3> offset;
+    if (large_bodies)
+        {
+        for (int k = -1; k <= 1; ++k)
+            for (int j = -1; j <= 1; ++j)
+                for (int i = -1; i <= 1; ++i)
+                    offset.push_back(make_scalar3(Scalar(0.6)*i, Scalar(0.6)*j, Scalar(0.6)*k));
+        }
+    else
+        {
+        offset.push_back(make_scalar3(0,0,0));
+        offset.push_back(make_scalar3(0.9,0,0));
+        offset.push_back(make_scalar3(-0.9,0,0));
+        offset.push_back(make_scalar3(0,0.9,0));
+        offset.push_back(make_scalar3(0,-0.9,0));
+        }
+
+    const unsigned int n_bodies = 64;
+    const unsigned int body_size = offset.size();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(n_bodies*body_size, BoxDim(12.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->getCompositeParticlesSignal().connect<&body_comparison_diameter>();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_body(pdata->getBodies(), access_location::host, access_mode::readwrite);
+    ArrayHandle<int3> h_image(pdata->getImages(), access_location::host, access_mode::readwrite);
+
+    const BoxDim& box = pdata->getBox();
+    for (unsigned int b = 0; b < n_bodies; ++b)
+        {
+        Scalar3 center = make_scalar3(Scalar(-5.75) + Scalar(3.0)*(b % 4) + Scalar(0.1)*(b % 3),
+                                      Scalar(-5.75) + Scalar(3.0)*((b / 4) % 4),
+                                      Scalar(-5.75) + Scalar(3.0)*(b / 16) - Scalar(0.1)*(b % 2));
+        for (unsigned int k = 0; k < body_size; ++k)
+            {
+            unsigned int i = b*body_size + k;
+            Scalar3 pos = center + offset[k];
+            box.wrap(pos, h_image.data[i]);
+            h_pos.data[i] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(0));
+            h_body.data[i] = b*body_size;
+            }
+        }
+
+    pdata->notifyParticleSort();
+    }
+
+    std::shared_ptr<NeighborList> nlist1(new NLA(sysdef, Scalar(1.5), Scalar(0.4)));
+    nlist1->setRCutPair(0,0,1.5);
+    nlist1->setFilterBody(true);
+    nlist1->setStorageMode(NeighborList::full);
+
+    std::shared_ptr<NeighborList> nlist2(new NLB(sysdef, Scalar(1.5), Scalar(0.4)));
+    nlist2->setRCutPair(0,0,1.5);
+    nlist2->setFilterBody(true);
+    nlist2->setStorageMode(NeighborList::full);
+    std::shared_ptr<NeighborListTree> nlist2_tree = std::dynamic_pointer_cast<NeighborListTree>(nlist2);
+    if (nlist2_tree)
+        nlist2_tree->setBodyTree(body_tree);
+
+    nlist1->compute(0);
+    nlist2->compute(0);
+
+    ArrayHandle<unsigned int> h_body(pdata->getBodies(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh1(nlist1->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist1(nlist1->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list1(nlist1->getHeadList(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh2(nlist2->getNNeighArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist2(nlist2->getNListArray(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list2(nlist2->getHeadList(), access_location::host, access_mode::read);
+
+    std::vector<unsigned int> tmp_list1;
+    std::vector<unsigned int> tmp_list2;
+
+    unsigned int n_pairs = 0;
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        UP_ASSERT_EQUAL(h_n_neigh1.data[i], h_n_neigh2.data[i]);
+        n_pairs += h_n_neigh1.data[i];
+
+        tmp_list1.resize(h_n_neigh1.data[i]);
+        tmp_list2.resize(h_n_neigh1.data[i]);
+
+        for (unsigned int j = 0; j < h_n_neigh1.data[i]; j++)
+            {
+            tmp_list1[j] = h_nlist1.data[h_head_list1.data[i] + j];
+            tmp_list2[j] = h_nlist2.data[h_head_list2.data[i] + j];
+
+            // no particle is a neighbor of a particle of the same body
+            UP_ASSERT(h_body.data[i] != h_body.data[tmp_list2[j]]);
+            }
+
+        sort(tmp_list1.begin(), tmp_list1.end());
+        sort(tmp_list2.begin(), tmp_list2.end());
+
+        UP_ASSERT_EQUAL(tmp_list1,tmp_list2);
+        }
+
+    // the bodies are close enough to have neighbors
+    UP_ASSERT(n_pairs > 0);
+    }
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template <class NL>
 void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1217,6 +1334,17 @@ UP_TEST( NeighborListTree_comparison )
     {
     neighborlist_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! comparison test case for tree class with rigid bodies
+UP_TEST( NeighborListTree_body_comparison )
+    {
+    neighborlist_body_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    neighborlist_body_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)), true);
+    }
+//! comparison test case for tree class with rigid bodies, without the two-level search
+UP_TEST( NeighborListTree_body_comparison_no_body_tree )
+    {
+    neighborlist_body_comparison_test<NeighborListBinned, NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)), true, false);
+    }
 
 #ifdef ENABLE_CUDA
 ///////////////
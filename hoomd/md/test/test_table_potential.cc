@@ -304,6 +304,58 @@ void table_potential_type_test(table_potential_creator table_creator, std::share
     }
     }
 
+//! checks that cubic interpolation reproduces a cubic potential exactly between grid points
+void table_potential_cubic_test(table_potential_creator table_creator, std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // two particles at r = 1.3, between the grid points of a coarse table
+    std::shared_ptr<SystemDefinition> sysdef_2(new SystemDefinition(2, BoxDim(1000.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata_2 = sysdef_2->getParticleData();
+
+    {
+    ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(), access_location::host, access_mode::readwrite);
+    h_pos.data[0].x = h_pos.data[0].y = h_pos.data[0].z = 0.0;
+    h_pos.data[1].x = Scalar(1.3); h_pos.data[1].y = h_pos.data[1].z = 0.0;
+    }
+
+    std::shared_ptr<NeighborListTree> nlist_2(new NeighborListTree(sysdef_2, Scalar(7.0), Scalar(0.8)));
+    std::shared_ptr<TablePotential> fc_2 = table_creator(sysdef_2, nlist_2, 3);
+    fc_2->setCubicInterpolation(true);
+
+    // V(r) = r^3 - 3r, F(r) = -3r^2 + 3 sampled at r = 1.0, 1.5, 2.0
+    vector<Scalar> V, F;
+    for (unsigned int i = 0; i < 3; i++)
+        {
+        Scalar r = Scalar(1.0) + Scalar(0.5) * Scalar(i);
+        V.push_back(r*r*r - Scalar(3.0)*r);
+        F.push_back(Scalar(-3.0)*r*r + Scalar(3.0));
+        }
+    fc_2->setTable(0, 0, V, F, 1.0, 2.0);
+
+    fc_2->compute(0);
+
+    {
+    GPUArray<Scalar4>& force_array =  fc_2->getForceArray();
+    GPUArray<Scalar>& virial_array =  fc_2->getVirialArray();
+    unsigned int pitch = virial_array.getPitch();
+    ArrayHandle<Scalar4> h_force(force_array,access_location::host,access_mode::read);
+    ArrayHandle<Scalar> h_virial(virial_array,access_location::host,access_mode::read);
+
+    // V(1.3) = -1.703, F(1.3) = -2.07
+    MY_CHECK_CLOSE(h_force.data[0].x, 2.07, tol);
+    MY_CHECK_SMALL(h_force.data[0].y, tol_small);
+    MY_CHECK_SMALL(h_force.data[0].z, tol_small);
+    MY_CHECK_CLOSE(h_force.data[0].w, -1.703 / 2.0, tol);
+    MY_CHECK_CLOSE(Scalar(1./3.)*(h_virial.data[0*pitch+0]
+                                       +h_virial.data[3*pitch+0]
+                                       +h_virial.data[5*pitch+0]), (1.0 / 6.0) * 1.3 * -2.07, tol);
+
+    MY_CHECK_CLOSE(h_force.data[1].x, -2.07, tol);
+    MY_CHECK_SMALL(h_force.data[1].y, tol_small);
+    MY_CHECK_SMALL(h_force.data[1].z, tol_small);
+    MY_CHECK_CLOSE(h_force.data[1].w, -1.703 / 2.0, tol);
+    }
+    }
+
 //! TablePotential creator for unit tests
 std::shared_ptr<TablePotential> base_class_table_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                     std::shared_ptr<NeighborList> nlist,
@@ -339,6 +391,13 @@ UP_TEST( TablePotential_type )
     table_potential_type_test(table_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for cubic interpolation on CPU
+UP_TEST( TablePotential_cubic )
+    {
+    table_potential_creator table_creator_base = bind(base_class_table_creator, _1, _2, _3);
+    table_potential_cubic_test(table_creator_base, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_CUDA
 //! test case for basic test on GPU
 UP_TEST( TablePotentialGPU_basic )
@@ -353,4 +412,11 @@ UP_TEST( TablePotentialGPU_type )
     table_potential_creator table_creator_gpu = bind(gpu_table_creator, _1, _2, _3);
     table_potential_type_test(table_creator_gpu, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! test case for cubic interpolation on GPU
+UP_TEST( TablePotentialGPU_cubic )
+    {
+    table_potential_creator table_creator_gpu = bind(gpu_table_creator, _1, _2, _3);
+    table_potential_cubic_test(table_creator_gpu, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif
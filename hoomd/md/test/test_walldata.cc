@@ -17,6 +17,7 @@ HOOMD_UP_MAIN();
 #include <memory>
 #include <cstdlib>
 #include <vector>
+#include <limits>
 
 UP_TEST( construction )
     {
@@ -275,3 +276,55 @@ UP_TEST( plane_wall_math )
     MY_CHECK_SMALL(vx.z, tol_small);
     MY_CHECK_SMALL(dx, tol_small);
     }
+
+UP_TEST( mesh_wall_math )
+    {
+    // tetrahedron with outward normals
+    std::vector< vec3<Scalar> > verts;
+    verts.push_back(vec3<Scalar>(0.0,0.0,0.0));
+    verts.push_back(vec3<Scalar>(4.0,0.0,0.0));
+    verts.push_back(vec3<Scalar>(0.0,4.0,0.0));
+    verts.push_back(vec3<Scalar>(0.0,0.0,4.0));
+    unsigned int tris[12] = {0,2,1, 0,1,3, 0,3,2, 1,2,3};
+    TriangleMesh mesh(verts, std::vector<unsigned int>(tris, tris+12));
+
+    MeshWall Mesh = MeshWall(&mesh, true);
+    bool inside = false;
+    vec3<Scalar> n;
+    Scalar inf = std::numeric_limits<Scalar>::infinity();
+
+    // test inside
+    vec3<Scalar> x = vec3<Scalar>(0.5,1.0,1.5);
+    vec3<Scalar> vx = vecPtToWall(Mesh, x, inside, n, inf);
+    MY_CHECK_CLOSE(vx.x, -0.5, tol);
+    MY_CHECK_SMALL(vx.y, tol_small);
+    MY_CHECK_SMALL(vx.z, tol_small);
+    MY_CHECK_CLOSE(n.x, -1.0, tol);
+    UP_ASSERT(inside==true);
+
+    // test outside
+    x = vec3<Scalar>(1.0,1.0,-0.7);
+    vx = vecPtToWall(Mesh, x, inside, n, inf);
+    MY_CHECK_SMALL(vx.x, tol_small);
+    MY_CHECK_SMALL(vx.y, tol_small);
+    MY_CHECK_CLOSE(vx.z, 0.7, tol);
+    UP_ASSERT(inside==false);
+
+    // test outside beyond the cutoff
+    vx = vecPtToWall(Mesh, x, inside, n, 0.5);
+    MY_CHECK_SMALL(vx.z, tol_small);
+    UP_ASSERT(inside==false);
+
+    // test outside the slanted face
+    x = vec3<Scalar>(3.0,3.0,3.0);
+    vx = vecPtToWall(Mesh, x, inside, n, inf);
+    MY_CHECK_CLOSE(vx.x, -1.66666667, tol);
+    MY_CHECK_CLOSE(vx.y, -1.66666667, tol);
+    MY_CHECK_CLOSE(vx.z, -1.66666667, tol);
+    MY_CHECK_CLOSE(n.x, 0.57735027, tol);
+    UP_ASSERT(inside==false);
+
+    MeshWall invMesh = MeshWall(&mesh, false);
+    vx = vecPtToWall(invMesh, x, inside, n, inf);
+    UP_ASSERT(inside==true);
+    }
@@ -41,14 +41,15 @@ class group(object):
     All wall forces use a wall group as an input so it is necessary to create a
     wall group object before any wall force can be created. Modifications
     of the created wall group may occur at any time before :py:func:`hoomd.run`
-    is invoked. Current supported geometries are spheres, cylinder, and planes. The
-    maximum number of each type of wall is 20, 20, and 60 respectively.
+    is invoked. Current supported geometries are spheres, cylinder, planes, and
+    triangle meshes. The maximum number of spheres, cylinders, and planes is 20, 20,
+    and 60 respectively. The number of meshes is not limited.
 
     The **inside** parameter used in each wall geometry is used to specify the
     half-space that is to be used for the force implementation. See
     :py:class:`wallpotential` for more general details and :py:class:`sphere`
-    :py:class:`cylinder`, and :py:class:`plane` for the definition of inside for
-    each geometry.
+    :py:class:`cylinder`, :py:class:`plane`, and :py:class:`mesh` for the definition
+    of inside for each geometry.
 
     An effective use of wall forces **requires** considering the geometry of the
     system. Walls are only evaluated in one simulation box and are not periodic. It
@@ -134,6 +135,7 @@ class group(object):
         self.spheres=[];
         self.cylinders=[];
         self.planes=[];
+        self.meshes=[];
         for wall in walls:
             self.add(wall);
 
@@ -141,8 +143,8 @@ class group(object):
         R""" Generic wall add for wall objects.
 
         Generic convenience function to add any wall object to the group.
-        Accepts :py:class:`sphere`, :py:class:`cylinder`, :py:class:`plane`, and lists of any
-        combination of these.
+        Accepts :py:class:`sphere`, :py:class:`cylinder`, :py:class:`plane`, :py:class:`mesh`,
+        and lists of any combination of these.
         """
         if (isinstance(wall, sphere)):
             self.spheres.append(wall);
@@ -150,6 +152,8 @@ class group(object):
             self.cylinders.append(wall);
         elif (isinstance(wall, plane)):
             self.planes.append(wall);
+        elif (isinstance(wall, mesh)):
+            self.meshes.append(wall);
         elif (type(wall)==list):
             for wall_el in wall:
                 if (isinstance(wall_el, sphere)):
@@ -158,6 +162,8 @@ class group(object):
                     self.cylinders.append(wall_el);
                 elif (isinstance(wall_el, plane)):
                     self.planes.append(wall_el);
+                elif (isinstance(wall_el, mesh)):
+                    self.meshes.append(wall_el);
                 else:
                     print("Input of type "+str(type(wall_el))+" is not allowed. Skipping invalid list element...");
         else:
@@ -200,6 +206,20 @@ class group(object):
         """
         self.planes.append(plane(origin, normal, inside));
 
+    def add_mesh(self, vertices, faces, inside=True):
+        R""" Adds a triangle mesh to the wall group.
+
+        Args:
+            vertices (list): Mesh vertices (in x,y,z coordinates)
+            faces (list): Triangles of the mesh, each a list of three indices into *vertices*
+            inside (bool): Selects the half-space to be used (bool)
+
+        Adds a mesh with the specified parameters to the wallgroup.meshes list.
+
+        .. versionadded:: 2.3
+        """
+        self.meshes.append(mesh(vertices, faces, inside));
+
     def del_sphere(self, *indexs):
         R""" Deletes the sphere or spheres in index.
 
@@ -260,6 +280,28 @@ class group(object):
                     hoomd.context.msg.error("Specified index for deletion is not valid.\n");
                     raise RuntimeError("del_plane failed")
 
+    def del_mesh(self, *indexs):
+        R""" Deletes the mesh or meshes in index.
+
+        Args:
+            index (list): The index of mesh(es) desired to delete. Accepts int, range, and lists.
+
+        Removes the specified mesh or meshes from the wallgroup.meshes list.
+
+        .. versionadded:: 2.3
+        """
+        for index in indexs:
+            if type(index) is int: index = [index];
+            elif type(index) is range: index = list(index);
+            index=list(set(index));
+            index.sort(reverse=True);
+            for i in index:
+                try:
+                    del(self.meshes[i]);
+                except IndexError:
+                    hoomd.context.msg.error("Specified index for deletion is not valid.\n");
+                    raise RuntimeError("del_mesh failed")
+
     ## \internal
     # \brief Return metadata for this wall structure
     def get_metadata(self):
@@ -281,6 +323,10 @@ class group(object):
         for index in range(len(self.planes)):
             output+="\n[%s:\t%s]"%(repr(index), str(self.planes[index]));
 
+        output+="}\nmeshes:%s{"%(len(self.meshes));
+        for index in range(len(self.meshes)):
+            output+="\n[%s:\t%s]"%(repr(index), str(self.meshes[index]));
+
         output+="}";
         return output;
 
@@ -445,6 +491,52 @@ class plane(object):
     def __repr__(self):
         return "{'origin':%s, 'normal': %s, 'inside': %s}" % (str(self.origin), str(self.normal), str(self.inside));
 
+class mesh(object):
+    R""" Triangle mesh wall.
+
+    Args:
+        vertices (list): Mesh vertices (in x,y,z coordinates)
+        faces (list): Triangles of the mesh, each a list of three indices into *vertices*
+        inside (bool): Selects the half-space to be used (bool)
+
+    Define a half-space bounded by a closed triangle mesh, such as a porous medium or a
+    microfluidic channel read from a file with :py:func:`hoomd.data.read_mesh`. The vertices
+    of each face must be ordered counterclockwise when viewed from outside the mesh, so that
+    the face normals point out of the enclosed volume, as in STL files.
+
+    - inside = True selects the space enclosed by the mesh and includes the mesh surface.
+    - inside = False selects the space outside of the mesh.
+
+    The triangles are stored in a bounding volume hierarchy, so the distance of each particle
+    to the nearest triangle is found in a time that grows only logarithmically with the number
+    of triangles. Meshes are not periodic and are not rescaled with the box.
+
+    Note:
+        Mesh walls are only evaluated on the CPU.
+
+    Use in function calls or by reference in the creation or modification of wall groups.
+
+    Example::
+
+        vertices, faces = hoomd.data.read_mesh('channel.stl')
+        walls = wall.group(wall.mesh(vertices, faces, inside=True))
+
+    .. versionadded:: 2.3
+    """
+    def __init__(self, vertices, faces, inside=True):
+        self.cpp_mesh = _hoomd.make_triangle_mesh([list(v) for v in vertices], [list(f) for f in faces]);
+        self.inside = inside;
+
+    @property
+    def num_triangles(self):
+        return self.cpp_mesh.getNumTriangles();
+
+    def __str__(self):
+        return "Triangles=%s\tInside=%s" % (str(self.num_triangles), str(self.inside));
+
+    def __repr__(self):
+        return "{'num_triangles': %s, 'inside': %s}" % (str(self.num_triangles), str(self.inside));
+
 #           *** Potentials ***
 
 class wallpotential(external._external_force):
@@ -610,7 +702,9 @@ class wallpotential(external._external_force):
     ## \internal
     # \brief passes the wall field
     def process_field_coeff(self, coeff):
-        return _md.make_wall_field_params(coeff, hoomd.context.exec_conf);
+        # the field refers to the mesh walls without owning them
+        self._mesh_walls = _md.make_mesh_wall_list(coeff);
+        return _md.make_wall_field_params(coeff, self._mesh_walls, hoomd.context.exec_conf);
 
     ## \internal
     # \brief Return metadata for this wall potential
@@ -5,6 +5,7 @@
 // Previous Maintainer: Morozov
 
 #include "EAMForceCompute.h"
+#include "hoomd/md/TableInterpolation.h"
 
 #include <vector>
 
@@ -151,18 +152,6 @@ void EAMForceCompute::loadFile(char *filename, int type_of_file)
     m_rphi.swap(t_rphi);
     ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> t_dF(nrho * m_ntypes, m_exec_conf);
-    m_dF.swap(t_dF);
-    ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::readwrite);
-
-    GPUArray<Scalar4> t_drho(nr * m_ntypes * m_ntypes, m_exec_conf);
-    m_drho.swap(t_drho);
-    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::readwrite);
-
-    GPUArray<Scalar4> t_drphi((int) (0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
-    m_drphi.swap(t_drphi);
-    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::readwrite);
-
     int res = 0;
     for (type = 0; type < m_ntypes; type++)
         {
@@ -233,55 +222,23 @@ void EAMForceCompute::loadFile(char *filename, int type_of_file)
     fclose(fp);
 
     // Compute interpolation coefficients
-    interpolation(nrho * m_ntypes, nrho, drho, &h_F, &h_dF);
-    interpolation(nr * m_ntypes * m_ntypes, nr, dr, &h_rho, &h_drho);
-    interpolation((int) (0.5 * nr * (m_ntypes + 1) * m_ntypes), nr, dr, &h_rphi, &h_drphi);
+    interpolation(nrho * m_ntypes, nrho, &h_F);
+    interpolation(nr * m_ntypes * m_ntypes, nr, &h_rho);
+    interpolation((int) (0.5 * nr * (m_ntypes + 1) * m_ntypes), nr, &h_rphi);
 
     }
 
 /*! compute cubic interpolation coefficients
  \param num_all Total number of data points
  \param num_per Number of data points per chunk
- \param delta Interval distance between data points
  \param f Data need to be interpolated
- \param df Derivative data to be recorded
  */
-void EAMForceCompute::interpolation(int num_all, int num_per, Scalar delta, ArrayHandle<Scalar4> *f,
-        ArrayHandle<Scalar4> *df)
+void EAMForceCompute::interpolation(int num_all, int num_per, ArrayHandle<Scalar4> *f)
     {
-    int m, n;
-    int num_block;
-    int start, end;
-    num_block = num_all / num_per;
-    for (n = 0; n < num_block; n++)
-        {
-        start = num_per * n;
-        end = num_per * (n + 1) - 1;
-        f->data[start].z = f->data[start + 1].w - f->data[start].w;
-        f->data[start + 1].z = 0.5 * f->data[start + 2].w - f->data[start].w;
-        f->data[end - 1].z = 0.5 * f->data[end].w - f->data[end - 2].w;
-        f->data[end].z = f->data[end].w - f->data[end - 1].w;
-        for (int m = 2; m < num_per - 2; m++)
-            {
-            f->data[start + m].z = (f->data[start + m - 2].w - f->data[start + m + 2].w
-                    + 8.0 * (f->data[start + m + 1].w - f->data[start + m - 1].w)) / 12.0;
-            }
-        for (int m = 0; m < num_per - 1; m++)
-            {
-            f->data[start + m].y = 3.0 * (f->data[start + m + 1].w - f->data[start + m].w) - 2.0 * f->data[start + m].z
-                    - f->data[start + m + 1].z;
-            f->data[start + m].x = f->data[start + m].z + f->data[start + m + 1].z
-                    - 2.0 * (f->data[start + m + 1].w - f->data[start + m].w);
-            }
-        f->data[end].y = 0.0;
-        f->data[end].x = 0.0;
-        }
-    for (m = 0; m < num_all; m++)
+    int num_block = num_all / num_per;
+    for (int n = 0; n < num_block; n++)
         {
-        df->data[m].w = f->data[m].w;
-        df->data[m].z = f->data[m].z / delta;
-        df->data[m].y = 2.0 * f->data[m].y / delta;
-        df->data[m].x = 3.0 * f->data[m].x / delta;
+        compute_spline_coefficients(f->data + num_per * n, num_per);
         }
     }
 
@@ -337,29 +294,23 @@ void EAMForceCompute::computeForces(unsigned int timestep)
 
     // access potential table
     ArrayHandle<Scalar4> h_F(m_F, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::read);
     ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::read);
 
     // index and remainder
     Scalar position;  // look up position, scalar
     unsigned int int_position;  // look up index for position, integer
     unsigned int idxs; // look up index in F, rho, rphi array, considering shift, integer
     Scalar remainder;  // look up remainder in array, integer
-    Scalar4 v, dv;  // value, d(value)
+    Scalar4 v;  // spline coefficients
 
     // there are enough other checks on the input data: but it doesn't hurt to be safe
     assert(h_force.data);
     assert(h_virial.data);
     assert(h_pos.data);
     assert(h_F.data);
-    assert(h_dF.data);
     assert(h_rho.data);
-    assert(h_drho.data);
     assert(h_rphi.data);
-    assert(h_drphi.data);
 
     // Zero data for force calculation.
     memset((void *) h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
@@ -433,15 +384,13 @@ void EAMForceCompute::computeForces(unsigned int timestep)
                 // calculate P = sum{rho}
                 idxs = int_position + nr * (typej * ntypes + typei);
                 v = h_rho.data[idxs];
-                atomElectronDensity[i] += v.w + v.z * remainder + v.y * remainder * remainder
-                        + v.x * remainder * remainder * remainder;
+                atomElectronDensity[i] += spline_value(v, remainder);
                 // if third_law, pair it
                 if (third_law)
                     {
                     idxs = int_position + nr * (typei * ntypes + typej);
                     v = h_rho.data[idxs];
-                    atomElectronDensity[k] += v.w + v.z * remainder + v.y * remainder * remainder
-                            + v.x * remainder * remainder * remainder;
+                    atomElectronDensity[k] += spline_value(v, remainder);
                     }
                 }
             }
@@ -458,12 +407,10 @@ void EAMForceCompute::computeForces(unsigned int timestep)
 
         idxs = int_position + typei * nrho;
         v = h_F.data[idxs];
-        dv = h_dF.data[idxs];
         // compute dF / dP
-        atomDerivativeEmbeddingFunction[i] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        atomDerivativeEmbeddingFunction[i] = spline_derivative(v, remainder) * rdrho;
         // compute embedded energy F(P), sum up each particle
-        h_force.data[i].w += v.w + v.z * remainder + v.y * remainder * remainder
-                + v.x * remainder * remainder * remainder;
+        h_force.data[i].w += spline_value(v, remainder);
 
         }
 
@@ -530,20 +477,18 @@ void EAMForceCompute::computeForces(unsigned int timestep)
 
             idxs = int_position + shift;
             v = h_rphi.data[idxs];
-            dv = h_drphi.data[idxs];
             // pair_eng = phi
-            Scalar pair_eng = (v.w + v.z * remainder + v.y * remainder * remainder
-                    + v.x * remainder * remainder * remainder) * inverseR;
+            Scalar pair_eng = spline_value(v, remainder) * inverseR;
             // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
-            Scalar derivativePhi = (dv.z + dv.y * remainder + dv.x * remainder * remainder - pair_eng) * inverseR;
+            Scalar derivativePhi = (spline_derivative(v, remainder) * rdr - pair_eng) * inverseR;
             // derivativeRhoI = drho / dr of i
             idxs = int_position + typei * ntypes * nr + typej * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+            v = h_rho.data[idxs];
+            Scalar derivativeRhoI = spline_derivative(v, remainder) * rdr;
             // derivativeRhoJ = drho / dr of j
             idxs = int_position + typej * ntypes * nr + typei * nr;
-            dv = h_drho.data[idxs];
-            Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+            v = h_rho.data[idxs];
+            Scalar derivativeRhoJ = spline_derivative(v, remainder) * rdr;
             // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
             Scalar fullDerivativePhi = atomDerivativeEmbeddingFunction[i] * derivativeRhoJ
                     + atomDerivativeEmbeddingFunction[k] * derivativeRhoI + derivativePhi;
@@ -30,17 +30,16 @@
 
  \b Interpolation
  The cubic interpolation is used. For each data point, including the value of the point, there are 3
- coefficients.
+ coefficients. The coefficients are computed with compute_spline_coefficients() and evaluated with
+ spline_value() and spline_derivative() (see TableInterpolation.h).
 
  \b Potential memory layout
- The potential data and the coefficients are stored in six GPUArray<Scalar> arrays: the embedded
- potential function (m_F) and its derivative (m_dF), the electron density function (m_rho) and its
- derivative (m_drho), the pair potential function (m_rphi) and its derivative (m_drphi). The 3
- coefficients for a data point is stored continuously, for example, h_F.data[100].w is the embedded
+ The potential data and the coefficients are stored in three GPUArray<Scalar4> arrays: the embedded
+ potential function (m_F), the electron density function (m_rho) and the pair potential function (m_rphi).
+ The 3 coefficients for a data point is stored continuously, for example, h_F.data[100].w is the embedded
  potential function's value read from the 100st position of the potential file,
- h_F.data[100].z, h_F.data[100].y, h_F.data[100*].x, are for interpolating embedded function,
- h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
- function.
+ h_F.data[100].z, h_F.data[100].y, h_F.data[100].x, are for interpolating embedded function.
+ Derivatives are computed from the same coefficients, so each table is read only once per evaluation.
 
  \ingroup computes
  */
@@ -88,9 +87,6 @@ protected:
     GPUArray<Scalar4> m_F;                 //!< embedded function and its coefficients
     GPUArray<Scalar4> m_rho;               //!< electron density and its coefficients
     GPUArray<Scalar4> m_rphi;              //!< pair wise function and its coefficients
-    GPUArray<Scalar4> m_dF;                //!< derivative embedded function and its coefficients
-    GPUArray<Scalar4> m_drho;              //!< derivative electron density and its coefficients
-    GPUArray<Scalar4> m_drphi;             //!< derivative pair wise function and its coefficients
     GPUArray<Scalar> m_dFdP;               //!< derivative F / derivative P
 
     //! Actually compute the forces
@@ -104,8 +100,7 @@ protected:
         }
 
     //! cubic interpolation
-    virtual void interpolation(int num_all, int num_per, Scalar delta, ArrayHandle<Scalar4> *f,
-            ArrayHandle<Scalar4> *df);
+    virtual void interpolation(int num_all, int num_per, ArrayHandle<Scalar4> *f);
     };
 
 //! Exports the EAMForceCompute class to python
@@ -86,11 +86,8 @@ void EAMForceComputeGPU::computeForces(unsigned int timestep)
 
     // access the potential data
     ArrayHandle<Scalar4> d_F(m_F, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_dF(m_dF, access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_rho(m_rho, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_drho(m_drho, access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_rphi(m_rphi, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_drphi(m_drphi, access_location::device, access_mode::read);
 
     // Derivative Embedding Function for each atom
     GPUArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
@@ -102,7 +99,7 @@ void EAMForceComputeGPU::computeForces(unsigned int timestep)
     eam_data.block_size = m_tuner->getParam();
     gpu_compute_eam_tex_inter_forces(d_force.data, d_virial.data, m_virial.getPitch(), m_pdata->getN(), d_pos.data, box,
             d_n_neigh.data, d_nlist.data, d_head_list.data, this->m_nlist->getNListArray().getPitch(), eam_data,
-            d_dFdP.data, d_F.data, d_rho.data, d_rphi.data, d_dF.data, d_drho.data, d_drphi.data,
+            d_dFdP.data, d_F.data, d_rho.data, d_rphi.data,
             m_exec_conf->getComputeCapability() / 10, m_exec_conf->dev_prop.maxTexture1DLinear);
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -5,6 +5,7 @@
 // Previous Maintainer: Morozov
 
 #include "EAMForceGPU.cuh"
+#include "hoomd/md/TableInterpolation.h"
 #include "hoomd/TextureTools.h"
 
 #include <assert.h>
@@ -21,9 +22,6 @@ texture<unsigned int, 1, cudaReadModeElementType> nlist_tex;
 scalar4_tex_t tex_F;
 scalar4_tex_t tex_rho;
 scalar4_tex_t tex_rphi;
-scalar4_tex_t tex_dF;
-scalar4_tex_t tex_drho;
-scalar4_tex_t tex_drphi;
 //! Texture for dF/dP
 scalar_tex_t tex_dFdP;
 
@@ -35,7 +33,7 @@ template<unsigned char use_gmem_nlist>
 __global__ void gpu_kernel_1(Scalar4 *d_force, Scalar *d_virial, const unsigned int virial_pitch, const unsigned int N,
         const Scalar4 *d_pos, BoxDim box, const unsigned int *d_n_neigh, const unsigned int *d_nlist,
         const unsigned int *d_head_list, const Scalar4 *d_F, const Scalar4 *d_rho, const Scalar4 *d_rphi,
-        const Scalar4 *d_dF, const Scalar4 *d_drho, const Scalar4 *d_drphi, Scalar *d_dFdP)
+        Scalar *d_dFdP)
     {
 
     // start by identifying which particle we are to handle
@@ -57,7 +55,7 @@ __global__ void gpu_kernel_1(Scalar4 *d_force, Scalar *d_virial, const unsigned
     unsigned int int_position;// look up index for position, integer
     unsigned int idxs;// look up index in F, rho, rphi array, considering shift, integer
     Scalar remainder;// look up remainder in array, integer
-    Scalar4 v, dv;// value, d(value)
+    Scalar4 v;// spline coefficients
 
     // initialize the force to 0
     Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
@@ -121,8 +119,7 @@ __global__ void gpu_kernel_1(Scalar4 *d_force, Scalar *d_virial, const unsigned
             // calculate P = sum{rho}
             idxs = int_position + nr * (typej * ntypes + typei);
             v = texFetchScalar4(d_rho, tex_rho, idxs);
-            atomElectronDensity += v.w + v.z * remainder + v.y * remainder * remainder
-            + v.x * remainder * remainder * remainder;
+            atomElectronDensity += spline_value(v, remainder);
             }
         }
 
@@ -133,12 +130,11 @@ __global__ void gpu_kernel_1(Scalar4 *d_force, Scalar *d_virial, const unsigned
     remainder = position - int_position;
 
     idxs = int_position + typei * nrho;
-    dv = texFetchScalar4(d_dF, tex_dF, idxs);
     v = texFetchScalar4(d_F, tex_F, idxs);
     // compute dF / dP
-    d_dFdP[idx] = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+    d_dFdP[idx] = spline_derivative(v, remainder) * rdrho;
     // compute embedded energy F(P), sum up each particle
-    force.w += v.w + v.z * remainder + v.y * remainder * remainder + v.x * remainder * remainder * remainder;
+    force.w += spline_value(v, remainder);
     // update the d_force
     d_force[idx] = force;
 
@@ -149,7 +145,7 @@ template<unsigned char use_gmem_nlist>
 __global__ void gpu_kernel_2(Scalar4 *d_force, Scalar *d_virial, const unsigned int virial_pitch, const unsigned int N,
         const Scalar4 *d_pos, BoxDim box, const unsigned int *d_n_neigh, const unsigned int *d_nlist,
         const unsigned int *d_head_list, const Scalar4 *d_F, const Scalar4 *d_rho, const Scalar4 *d_rphi,
-        const Scalar4 *d_dF, const Scalar4 *d_drho, const Scalar4 *d_drphi, Scalar *d_dFdP)
+        Scalar *d_dFdP)
     {
 
     // start by identifying which particle we are to handle
@@ -172,7 +168,7 @@ __global__ void gpu_kernel_2(Scalar4 *d_force, Scalar *d_virial, const unsigned
     unsigned int int_position;// look up index for position, integer
     unsigned int idxs;// look up index in F, rho, rphi array, considering shift, integer
     Scalar remainder;// look up remainder in array, integer
-    Scalar4 v, dv;// value, d(value)
+    Scalar4 v;// spline coefficients
 
     // prefetch neighbor index
     int cur_neigh = 0;
@@ -246,24 +242,22 @@ __global__ void gpu_kernel_2(Scalar4 *d_force, Scalar *d_virial, const unsigned
 
         idxs = int_position + shift;
         v = texFetchScalar4(d_rphi, tex_rphi, idxs);
-        dv = texFetchScalar4(d_drphi, tex_drphi, idxs);
         // aspair_potential = r * phi
-        Scalar aspair_potential = v.w + v.z * remainder + v.y * remainder * remainder
-        + v.x * remainder * remainder * remainder;
+        Scalar aspair_potential = spline_value(v, remainder);
         // derivative_pair_potential = phi + r * dphi / dr
-        Scalar derivative_pair_potential = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        Scalar derivative_pair_potential = spline_derivative(v, remainder) * rdr;
         // pair_eng = phi
         Scalar pair_eng = aspair_potential * inverseR;
         // derivativePhi = (phi + r * dphi/dr - phi) * 1/r = dphi / dr
         Scalar derivativePhi = (derivative_pair_potential - pair_eng) * inverseR;
         // derivativeRhoI = drho / dr of i
         idxs = int_position + typei * ntypes * nr + typej * nr;
-        dv = texFetchScalar4(d_drho, tex_drho, idxs);
-        Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        v = texFetchScalar4(d_rho, tex_rho, idxs);
+        Scalar derivativeRhoI = spline_derivative(v, remainder) * rdr;
         // derivativeRhoJ = drho / dr of j
         idxs = int_position + typej * ntypes * nr + typei * nr;
-        dv = texFetchScalar4(d_drho, tex_drho, idxs);
-        Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
+        v = texFetchScalar4(d_rho, tex_rho, idxs);
+        Scalar derivativeRhoJ = spline_derivative(v, remainder) * rdr;
         // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
         Scalar d_dFdPcur = texFetchScalar(d_dFdP, tex_dFdP, cur_neigh);
         Scalar fullDerivativePhi = d_dFdPidx * derivativeRhoJ + d_dFdPcur * derivativeRhoI + derivativePhi;
@@ -301,8 +295,7 @@ cudaError_t gpu_compute_eam_tex_inter_forces(Scalar4 *d_force, Scalar *d_virial,
         const unsigned int N, const Scalar4 *d_pos, const BoxDim &box, const unsigned int *d_n_neigh,
         const unsigned int *d_nlist, const unsigned int *d_head_list, const unsigned int size_nlist,
         const EAMTexInterData &eam_data, Scalar *d_dFdP, const Scalar4 *d_F, const Scalar4 *d_rho,
-        const Scalar4 *d_rphi, const Scalar4 *d_dF, const Scalar4 *d_drho, const Scalar4 *d_drphi,
-        const unsigned int compute_capability, const unsigned int max_tex1d_width)
+        const Scalar4 *d_rphi, const unsigned int compute_capability, const unsigned int max_tex1d_width)
     {
 
     cudaError_t error;
@@ -325,38 +318,18 @@ cudaError_t gpu_compute_eam_tex_inter_forces(Scalar4 *d_force, Scalar *d_virial,
         if (error != cudaSuccess)
             return error;
 
-        tex_dF.normalized = false;
-        tex_dF.filterMode = cudaFilterModePoint;
-        error = cudaBindTexture(0, tex_dF, d_dF, sizeof(Scalar4) * eam_data.nrho * eam_data.ntypes);
-        if (error != cudaSuccess)
-            return error;
-
         tex_rho.normalized = false;
         tex_rho.filterMode = cudaFilterModePoint;
         error = cudaBindTexture(0, tex_rho, d_rho, sizeof(Scalar4) * eam_data.nrho * eam_data.ntypes * eam_data.ntypes);
         if (error != cudaSuccess)
             return error;
 
-        tex_drho.normalized = false;
-        tex_drho.filterMode = cudaFilterModePoint;
-        error = cudaBindTexture(0, tex_drho, d_drho,
-                sizeof(Scalar4) * eam_data.nrho * eam_data.ntypes * eam_data.ntypes);
-        if (error != cudaSuccess)
-            return error;
-
         tex_rphi.normalized = false;
         tex_rphi.filterMode = cudaFilterModePoint;
         error = cudaBindTexture(0, tex_rphi, d_rphi,
                 sizeof(Scalar4) * (int) (0.5 * eam_data.nr * (eam_data.ntypes + 1) * eam_data.ntypes));
         if (error != cudaSuccess)
             return error;
-
-        tex_drphi.normalized = false;
-        tex_drphi.filterMode = cudaFilterModePoint;
-        error = cudaBindTexture(0, tex_drphi, d_drphi,
-                sizeof(Scalar4) * (int) (0.5 * eam_data.nr * (eam_data.ntypes + 1) * eam_data.ntypes));
-        if (error != cudaSuccess)
-            return error;
         }
 
     pdata_pos_tex.normalized = false;
@@ -401,9 +374,9 @@ cudaError_t gpu_compute_eam_tex_inter_forces(Scalar4 *d_force, Scalar *d_virial,
         dim3 threads_2(run_block_size_2, 1, 1);
 
         gpu_kernel_1<1> <<<grid_1, threads_1>>>(d_force, d_virial, virial_pitch, N, d_pos, box, d_n_neigh, d_nlist,
-                d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP);
+                d_head_list, d_F, d_rho, d_rphi, d_dFdP);
         gpu_kernel_2<1> <<<grid_2, threads_2>>>(d_force, d_virial, virial_pitch, N, d_pos, box, d_n_neigh, d_nlist,
-                d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP);
+                d_head_list, d_F, d_rho, d_rphi, d_dFdP);
         }
     else
         {
@@ -432,9 +405,9 @@ cudaError_t gpu_compute_eam_tex_inter_forces(Scalar4 *d_force, Scalar *d_virial,
         dim3 threads_2(run_block_size_2, 1, 1);
 
         gpu_kernel_1<0> <<<grid_1, threads_1>>>(d_force, d_virial, virial_pitch, N, d_pos, box, d_n_neigh, d_nlist,
-                d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP);
+                d_head_list, d_F, d_rho, d_rphi, d_dFdP);
         gpu_kernel_2<0> <<<grid_2, threads_2>>>(d_force, d_virial, virial_pitch, N, d_pos, box, d_n_neigh, d_nlist,
-                d_head_list, d_F, d_rho, d_rphi, d_dF, d_drho, d_drphi, d_dFdP);
+                d_head_list, d_F, d_rho, d_rphi, d_dFdP);
         }
 
     return cudaSuccess;
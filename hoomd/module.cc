@@ -14,8 +14,12 @@
 #include "Initializers.h"
 #include "GetarInitializer.h"
 #include "GSDReader.h"
+#include "CheckpointReader.h"
+#include "DistributedGSDReader.h"
+#include "ReplicatedSnapshotReader.h"
 #include "Compute.h"
 #include "ComputeThermo.h"
+#include "ComputeThermoMulti.h"
 #include "CellList.h"
 #include "CellListStencil.h"
 #include "ForceCompute.h"
@@ -26,6 +30,7 @@
 #include "DCDDumpWriter.h"
 #include "GetarDumpWriter.h"
 #include "GSDDumpWriter.h"
+#include "CheckpointWriter.h"
 #include "Logger.h"
 #include "LogPlainTXT.h"
 #include "LogMatrix.h"
@@ -39,6 +44,7 @@
 #include "Variant.h"
 #include "Messenger.h"
 #include "SnapshotSystemData.h"
+#include "TriangleMesh.h"
 
 // include GPU classes
 #ifdef ENABLE_CUDA
@@ -364,6 +370,7 @@ PYBIND11_PLUGIN(_hoomd)
     export_ExecutionConfiguration(m);
     export_SystemDefinition(m);
     export_SnapshotSystemData(m);
+    export_TriangleMesh(m);
     export_BondedGroupData<BondData,Bond>(m,"BondData","BondDataSnapshot");
     export_BondedGroupData<AngleData,Angle>(m,"AngleData","AngleDataSnapshot");
     export_BondedGroupData<DihedralData,Dihedral>(m,"DihedralData","DihedralDataSnapshot");
@@ -373,11 +380,15 @@ PYBIND11_PLUGIN(_hoomd)
 
     // initializers
     export_GSDReader(m);
+    export_CheckpointReader(m);
+    export_DistributedGSDReader(m);
+    export_ReplicatedSnapshotReader(m);
     getardump::export_GetarInitializer(m);
 
     // computes
     export_Compute(m);
     export_ComputeThermo(m);
+    export_ComputeThermoMulti(m);
     export_CellList(m);
     export_CellListStencil(m);
     export_ForceCompute(m);
@@ -395,6 +406,7 @@ PYBIND11_PLUGIN(_hoomd)
     export_DCDDumpWriter(m);
     getardump::export_GetarDumpWriter(m);
     export_GSDDumpWriter(m);
+    export_CheckpointWriter(m);
     export_Logger(m);
     export_LogPlainTXT(m);
     export_LogMatrix(m);
@@ -19,7 +19,8 @@ mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
                          std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
         : Compute(sysdef), m_mpcd_pdata(mpcd_pdata),
           m_cell_size(1.0), m_cell_np_max(4), m_cell_np(m_exec_conf), m_cell_list(m_exec_conf),
-          m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_needs_compute_dim(true)
+          m_embed_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_prebinned(false), m_prebin_N(0),
+          m_needs_compute_dim(true)
     {
     assert(m_mpcd_pdata);
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellList" << std::endl;
@@ -109,6 +110,9 @@ void mpcd::CellList::compute(unsigned int timestep)
                 }
             } while (overflowed);
 
+        // the particles must be binned again after they move
+        m_prebinned = false;
+
         // we are finished building, explicitly mark everything (rather than using shouldCompute)
         m_first_compute = false;
         m_force_compute = false;
@@ -286,6 +290,9 @@ void mpcd::CellList::computeDimensions()
     // reallocate per-cell memory
     reallocate();
 
+    // cell indexes computed for the old grid are no longer valid
+    m_prebinned = false;
+
     // dimensions are now current
     m_needs_compute_dim = false;
     notifySizeChange();
@@ -487,14 +494,56 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
     }
 #endif // ENABLE_MPI
 
+/*!
+ * \returns A binner for the current grid dimensions and grid shift
+ */
+mpcd::detail::CellBinner mpcd::CellList::getBinner()
+    {
+    computeDimensions();
+
+    // total effective number of cells in the global box, optionally padded by
+    // extra cells in MPI simulations
+    uint3 n_global_cells = m_global_cell_dim;
+    #ifdef ENABLE_MPI
+    if (isCommunicating(mpcd::detail::face::east)) n_global_cells.x += 2*m_num_extra;
+    if (isCommunicating(mpcd::detail::face::north)) n_global_cells.y += 2*m_num_extra;
+    if (isCommunicating(mpcd::detail::face::up)) n_global_cells.z += 2*m_num_extra;
+    #endif // ENABLE_MPI
+
+    mpcd::detail::CellBinner binner;
+    binner.global_lo = m_pdata->getGlobalBox().getLo();
+    binner.grid_shift = m_grid_shift;
+    binner.cell_size = m_cell_size;
+    binner.periodic = m_pdata->getBox().getPeriodic();
+    binner.n_global_cells = n_global_cells;
+    binner.origin_idx = m_origin_idx;
+    binner.cell_dim = m_cell_dim;
+    binner.cell_indexer = m_cell_indexer;
+    return binner;
+    }
+
+/*!
+ * \returns True if the MPCD particles can be binned outside of the cell list
+ *
+ * Binning outside of the cell list is only possible without domain decomposition, because the
+ * MPCD particles are migrated between ranks before the cell list is built.
+ */
+bool mpcd::CellList::canPrebin()
+    {
+    #ifdef ENABLE_MPI
+    if (m_decomposition) return false;
+    #endif // ENABLE_MPI
+    return true;
+    }
+
 /*!
  * \param timestep Current simulation timestep
+ *
+ * If the MPCD particles were binned with the current grid while they were streamed (setPrebinned()),
+ * their cell indexes are read from their velocities and only the embedded particles are binned.
  */
 void mpcd::CellList::buildCellList()
     {
-    const BoxDim& box = m_pdata->getBox();
-    const uchar3 periodic = box.getPeriodic();
-
     ArrayHandle<unsigned int> h_cell_list(m_cell_list, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::overwrite);
     // zero the cell counter
@@ -519,82 +568,43 @@ void mpcd::CellList::buildCellList()
         N_tot += m_embed_group->getNumMembers();
         }
 
-    // total effective number of cells in the global box, optionally padded by
-    // extra cells in MPI simulations
-    uint3 n_global_cells = m_global_cell_dim;
-    #ifdef ENABLE_MPI
-    if (isCommunicating(mpcd::detail::face::east)) n_global_cells.x += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::north)) n_global_cells.y += 2*m_num_extra;
-    if (isCommunicating(mpcd::detail::face::up)) n_global_cells.z += 2*m_num_extra;
-    #endif // ENABLE_MPI
-
-    const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
+    // the cell indexes of the MPCD particles are still valid if neither the grid nor the particles changed
+    const bool prebinned = m_prebinned && m_prebin_N == N_mpcd && m_prebin_shift == m_grid_shift;
 
+    const mpcd::detail::CellBinner binner = getBinner();
     for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
         {
-        Scalar4 postype_i;
-        if (cur_p < N_mpcd)
+        unsigned int bin_idx = 0;
+        if (prebinned && cur_p < N_mpcd)
             {
-            postype_i = h_pos.data[cur_p];
+            bin_idx = __scalar_as_int(h_vel.data[cur_p].w);
             }
         else
             {
-            postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
-            }
-        Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
-
-        if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
-            {
-            conditions.y = cur_p + 1;
-            continue;
-            }
-
-        // bin particle assuming orthorhombic box (already validated)
-        const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
-        int3 global_bin = make_int3(std::floor(delta.x / m_cell_size),
-                                    std::floor(delta.y / m_cell_size),
-                                    std::floor(delta.z / m_cell_size));
-
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-        // this is done using periodic from the "local" box, since this will be periodic
-        // only when there is one rank along the dimension
-        if (periodic.x)
-            {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
-            }
-        if (periodic.y)
-            {
-            if (global_bin.y == (int)n_global_cells.y)
-                global_bin.y = 0;
-            else if (global_bin.y == -1)
-                global_bin.y = n_global_cells.y - 1;
-            }
-        if (periodic.z)
-            {
-            if (global_bin.z == (int)n_global_cells.z)
-                global_bin.z = 0;
-            else if (global_bin.z == -1)
-                global_bin.z = n_global_cells.z - 1;
-            }
-
-        // compute the local cell
-        int3 bin = make_int3(global_bin.x - m_origin_idx.x,
-                             global_bin.y - m_origin_idx.y,
-                             global_bin.z - m_origin_idx.z);
+            Scalar4 postype_i;
+            if (cur_p < N_mpcd)
+                {
+                postype_i = h_pos.data[cur_p];
+                }
+            else
+                {
+                postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+                }
+            Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-        // validate and make sure no particles blew out of the box
-        if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) ||
-            (bin.y < 0 || bin.y >= (int)m_cell_dim.y) ||
-            (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
-            {
-            conditions.z = cur_p + 1;
-            continue;
+            const unsigned int result = binner(pos_i, bin_idx);
+            if (result == mpcd::detail::CellBinner::nan)
+                {
+                conditions.y = cur_p + 1;
+                continue;
+                }
+            else if (result == mpcd::detail::CellBinner::out_of_bounds)
+                {
+                conditions.z = cur_p + 1;
+                continue;
+                }
             }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
         unsigned int offset = h_cell_np.data[bin_idx];
         if (offset < m_cell_np_max)
             {
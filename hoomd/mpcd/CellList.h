@@ -32,6 +32,92 @@ namespace mpcd
 // forward declaration
 class Communicator;
 
+namespace detail
+{
+//! Bins positions into the cells of an mpcd::CellList
+/*!
+ * The binner holds a copy of the grid parameters of the cell list, so that the same binning
+ * can be applied by other classes (e.g., while streaming) without a call back into the cell list.
+ * The grid is assumed to be orthorhombic (validated by the cell list).
+ */
+struct CellBinner
+    {
+    //! Result of binning a position
+    enum result
+        {
+        binned=0,       //!< Position was binned
+        nan,            //!< Position is NaN
+        out_of_bounds   //!< Position lies outside the cells of this rank
+        };
+
+    //! Bin a position
+    /*!
+     * \param pos Position to bin
+     * \param bin_idx Index of the cell holding \a pos (output)
+     * \returns One of the values of result
+     */
+    inline unsigned int operator()(const Scalar3& pos, unsigned int& bin_idx) const
+        {
+        if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+            return nan;
+
+        // bin particle assuming orthorhombic box (already validated)
+        const Scalar3 delta = (pos - grid_shift) - global_lo;
+        int3 global_bin = make_int3(std::floor(delta.x / cell_size),
+                                    std::floor(delta.y / cell_size),
+                                    std::floor(delta.z / cell_size));
+
+        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+        // this is done using periodic from the "local" box, since this will be periodic
+        // only when there is one rank along the dimension
+        if (periodic.x)
+            {
+            if (global_bin.x == (int)n_global_cells.x)
+                global_bin.x = 0;
+            else if (global_bin.x == -1)
+                global_bin.x = n_global_cells.x - 1;
+            }
+        if (periodic.y)
+            {
+            if (global_bin.y == (int)n_global_cells.y)
+                global_bin.y = 0;
+            else if (global_bin.y == -1)
+                global_bin.y = n_global_cells.y - 1;
+            }
+        if (periodic.z)
+            {
+            if (global_bin.z == (int)n_global_cells.z)
+                global_bin.z = 0;
+            else if (global_bin.z == -1)
+                global_bin.z = n_global_cells.z - 1;
+            }
+
+        // compute the local cell
+        int3 bin = make_int3(global_bin.x - origin_idx.x,
+                             global_bin.y - origin_idx.y,
+                             global_bin.z - origin_idx.z);
+
+        // validate and make sure no particles blew out of the box
+        if ((bin.x < 0 || bin.x >= (int)cell_dim.x) ||
+            (bin.y < 0 || bin.y >= (int)cell_dim.y) ||
+            (bin.z < 0 || bin.z >= (int)cell_dim.z))
+            return out_of_bounds;
+
+        bin_idx = cell_indexer(bin.x, bin.y, bin.z);
+        return binned;
+        }
+
+    Scalar3 global_lo;      //!< Lower corner of the global box
+    Scalar3 grid_shift;     //!< Grid shift
+    Scalar cell_size;       //!< Cell width
+    uchar3 periodic;        //!< Periodic flags of the local box
+    uint3 n_global_cells;   //!< Number of global cells, padded by extra cells in MPI simulations
+    int3 origin_idx;        //!< Global index of the first local cell
+    uint3 cell_dim;         //!< Number of local cells
+    Index3D cell_indexer;   //!< Local cell indexer
+    };
+} // end namespace detail
+
 //! Computes the MPCD cell list on the CPU
 class CellList : public Compute
     {
@@ -205,6 +291,33 @@ class CellList : public Compute
         //! Calculate current cell occupancy statistics
         virtual void getCellStatistics() const;
 
+        //! Get a binner for the current grid
+        mpcd::detail::CellBinner getBinner();
+
+        //! Check if the MPCD particles can be binned outside of the cell list
+        bool canPrebin();
+
+        //! Signal that the MPCD particles have been binned outside of the cell list
+        /*!
+         * \param N Number of MPCD particles that were binned
+         *
+         * The cell index of every MPCD particle must be stored in the w component of its velocity,
+         * using the binner returned by getBinner(). The next build of the cell list reuses these cell
+         * indexes if the grid has not changed in the meantime.
+         */
+        void setPrebinned(unsigned int N)
+            {
+            m_prebinned = true;
+            m_prebin_N = N;
+            m_prebin_shift = m_grid_shift;
+            }
+
+        //! Discard the cell indexes of a previous call to setPrebinned()
+        void invalidatePrebinned()
+            {
+            m_prebinned = false;
+            }
+
         //! Gets the group of particles that is coupled to the MPCD solvent through the collision step
         std::shared_ptr<ParticleGroup> getEmbeddedGroup() const
             {
@@ -271,6 +384,10 @@ class CellList : public Compute
 
         int3 m_origin_idx;                  //!< Origin as a global index
 
+        bool m_prebinned;                   //!< True if the MPCD particles have been binned outside of the cell list
+        unsigned int m_prebin_N;            //!< Number of MPCD particles that were binned
+        Scalar3 m_prebin_shift;             //!< Grid shift used to bin the MPCD particles
+
         #ifdef ENABLE_MPI
         unsigned int m_num_extra;               //!< Number of extra cells to communicate over
         std::array<unsigned int, 6> m_num_comm; //!< Number of cells to communicate on each face
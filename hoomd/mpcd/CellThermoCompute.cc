@@ -9,6 +9,7 @@
  */
 
 #include "CellThermoCompute.h"
+#include "GSDUtilities.h"
 #include "ReductionOperators.h"
 
 /*!
@@ -21,7 +22,7 @@ mpcd::CellThermoCompute::CellThermoCompute(std::shared_ptr<mpcd::SystemData> sys
           m_mpcd_pdata(sysdata->getParticleData()),
           m_cl(sysdata->getCellList()),
           m_needs_net_reduce(true), m_cell_vel(m_exec_conf), m_cell_energy(m_exec_conf),
-          m_ncells_alloc(0), m_enable_log(true)
+          m_ncells_alloc(0), m_grid_shift(make_scalar3(0,0,0)), m_enable_log(true)
     {
     assert(m_mpcd_pdata);
     assert(m_cl);
@@ -118,6 +119,9 @@ Scalar mpcd::CellThermoCompute::getLogValue(const std::string& quantity, unsigne
 
 void mpcd::CellThermoCompute::computeCellProperties(unsigned int timestep)
     {
+    // remember the grid the properties belong to
+    m_grid_shift = m_cl->getGridShift();
+
     /*
      * In MPI simulations, begin by calculating the velocities and energies of
      * cells that lie along the boundaries. These values will then be communicated
@@ -350,6 +354,17 @@ void mpcd::CellThermoCompute::finishOuterCellProperties()
 
 void mpcd::CellThermoCompute::calcInnerCellProperties()
     {
+    // without communication, all cells are inner cells
+    bool all_inner = true;
+    #ifdef ENABLE_MPI
+    all_inner = !m_use_mpi;
+    #endif // ENABLE_MPI
+    if (all_inner)
+        {
+        sumCellProperties();
+        return;
+        }
+
     // Cell list
     const Index2D& cli = m_cl->getCellListIndexer();
     ArrayHandle<unsigned int> h_cell_list(m_cl->getCellList(), access_location::host, access_mode::read);
@@ -441,6 +456,109 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
         } // k
     }
 
+/*!
+ * The cell of every particle is stashed in the velocities (and embedded cell ids) when the cell list is built,
+ * so the cell sums can be accumulated in a single sequential pass over the particles instead of gathering
+ * the particles of each cell through the cell list. This is particularly efficient when the particles are sorted
+ * by cell (mpcd::Sorter). The particles are added in the same order that the cell list holds them, so
+ * the result is identical to the gather in calcInnerCellProperties().
+ */
+void mpcd::CellThermoCompute::sumCellProperties()
+    {
+    const unsigned int ncells = m_cl->getNCells();
+    ArrayHandle<unsigned int> h_cell_np(m_cl->getCellSizeArray(), access_location::host, access_mode::read);
+
+    // MPCD particle data
+    const unsigned int N_mpcd = m_mpcd_pdata->getN();
+    const double mpcd_mass = m_mpcd_pdata->getMass();
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
+
+    // Cell properties
+    ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle<double3> h_cell_energy(m_cell_energy, access_location::host, access_mode::readwrite);
+    const bool need_energy = m_flags[mpcd::detail::thermo_options::energy];
+
+    for (unsigned int cur_cell = 0; cur_cell < ncells; ++cur_cell)
+        {
+        h_cell_vel.data[cur_cell] = make_double4(0.0, 0.0, 0.0, 0.0);
+        if (need_energy)
+            h_cell_energy.data[cur_cell].x = 0.0;
+        }
+
+    // accumulate the momentum, mass, and kinetic energy of the MPCD particles
+    for (unsigned int cur_p = 0; cur_p < N_mpcd; ++cur_p)
+        {
+        const Scalar4 vel_cell = h_vel.data[cur_p];
+        const unsigned int cell = __scalar_as_int(vel_cell.w);
+
+        double4& momentum = h_cell_vel.data[cell];
+        momentum.x += mpcd_mass * vel_cell.x;
+        momentum.y += mpcd_mass * vel_cell.y;
+        momentum.z += mpcd_mass * vel_cell.z;
+        momentum.w += mpcd_mass;
+
+        if (need_energy)
+            h_cell_energy.data[cell].x += 0.5 * mpcd_mass * ((double)vel_cell.x * vel_cell.x
+                                                             + (double)vel_cell.y * vel_cell.y
+                                                             + (double)vel_cell.z * vel_cell.z);
+        }
+
+    // then the embedded particles
+    if (m_cl->getEmbeddedGroup())
+        {
+        ArrayHandle<Scalar4> h_embed_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_embed_member_idx(m_cl->getEmbeddedGroup()->getIndexArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_embed_cell_ids(m_cl->getEmbeddedGroupCellIds(), access_location::host, access_mode::read);
+        const unsigned int N_embed = m_cl->getEmbeddedGroup()->getNumMembers();
+
+        for (unsigned int cur_p = 0; cur_p < N_embed; ++cur_p)
+            {
+            const Scalar4 vel_mass = h_embed_vel.data[h_embed_member_idx.data[cur_p]];
+            const double mass = vel_mass.w;
+            const unsigned int cell = h_embed_cell_ids.data[cur_p];
+
+            double4& momentum = h_cell_vel.data[cell];
+            momentum.x += mass * vel_mass.x;
+            momentum.y += mass * vel_mass.y;
+            momentum.z += mass * vel_mass.z;
+            momentum.w += mass;
+
+            if (need_energy)
+                h_cell_energy.data[cell].x += 0.5 * mass * ((double)vel_mass.x * vel_mass.x
+                                                            + (double)vel_mass.y * vel_mass.y
+                                                            + (double)vel_mass.z * vel_mass.z);
+            }
+        }
+
+    // average velocity, energy, temperature of every cell
+    for (unsigned int cur_cell = 0; cur_cell < ncells; ++cur_cell)
+        {
+        const double4 momentum = h_cell_vel.data[cur_cell];
+        const double mass = momentum.w;
+        double3 vel_cm = make_double3(0.0,0.0,0.0);
+        if (mass > 0.)
+            {
+            vel_cm.x = momentum.x / mass;
+            vel_cm.y = momentum.y / mass;
+            vel_cm.z = momentum.z / mass;
+            }
+
+        h_cell_vel.data[cur_cell] = make_double4(vel_cm.x, vel_cm.y, vel_cm.z, mass);
+        if (need_energy)
+            {
+            const double ke = h_cell_energy.data[cur_cell].x;
+            const unsigned int np = h_cell_np.data[cur_cell];
+            double temp(0.0);
+            if (np > 1)
+                {
+                const double ke_cm = 0.5 * mass * (vel_cm.x*vel_cm.x + vel_cm.y*vel_cm.y + vel_cm.z*vel_cm.z);
+                temp = 2. * (ke - ke_cm) / (m_sysdef->getNDimensions() * (np-1));
+                }
+            h_cell_energy.data[cur_cell] = make_double3(ke, temp, __int_as_double(np));
+            }
+        }
+    }
+
 void mpcd::CellThermoCompute::computeNetProperties()
     {
     if (m_prof) m_prof->push("MPCD thermo");
@@ -558,6 +676,110 @@ void mpcd::CellThermoCompute::reallocate(unsigned int ncells)
     m_ncells_alloc = ncells;
     }
 
+/*!
+ * \param writer GSD writer to connect to
+ *
+ * Every frame that \a writer writes will also hold the cell fields.
+ */
+void mpcd::CellThermoCompute::connectGSDSignal(std::shared_ptr<GSDDumpWriter> writer)
+    {
+    typedef hoomd::detail::SharedSignalSlot<int(gsd_handle&)> SlotType;
+    auto func = std::bind(&mpcd::CellThermoCompute::slotWriteGSD, this, std::placeholders::_1);
+    std::shared_ptr<hoomd::detail::SignalSlot> pslot(new SlotType(writer->getWriteSignal(), func));
+    addSlot(pslot);
+    }
+
+/*!
+ * \param handle Handle to the GSD file
+ * \returns 0 on success
+ *
+ * The cell fields from the last call to compute() are written for every cell of the global grid:
+ *  - mpcd/cell/size: edge length of a cell
+ *  - mpcd/cell/dimensions: number of cells along each direction
+ *  - mpcd/cell/grid_shift: shift of the grid the fields were computed on
+ *  - mpcd/cell/density: mass density of each cell
+ *  - mpcd/cell/velocity: center-of-mass velocity of each cell
+ *
+ * The cells are ordered with the x index varying fastest. The fields are normally computed on the
+ * collision steps, so they are the ones seen by the last collision. The collision conserves the
+ * momentum of each cell, so the velocities are also the ones after it. Before the first
+ * computation, all fields are zero.
+ *
+ * This method must be called on all ranks.
+ */
+int mpcd::CellThermoCompute::slotWriteGSD(gsd_handle& handle)
+    {
+    m_exec_conf->msg->notice(10) << "mpcd: writing cell fields to GSD file" << std::endl;
+
+    const Index3D& ci = m_cl->getCellIndexer();
+    const Index3D& global_ci = m_cl->getGlobalCellIndexer();
+    const unsigned int ncells_global = global_ci.getNumElements();
+    const Scalar cell_size = m_cl->getCellSize();
+    const Scalar cell_volume = cell_size * cell_size * cell_size;
+
+    // copy the fields of all local cells (cells shared between ranks hold the same values)
+    std::vector<unsigned int> cells;
+    std::vector<float> density;
+    std::vector<float> vel;
+    if (m_ncells_alloc == ci.getNumElements())
+        {
+        cells.resize(ci.getNumElements());
+        density.resize(ci.getNumElements());
+        vel.resize(3*ci.getNumElements());
+
+        ArrayHandle<double4> h_cell_vel(m_cell_vel, access_location::host, access_mode::read);
+        for (unsigned int k=0; k < ci.getD(); ++k)
+            {
+            for (unsigned int j=0; j < ci.getH(); ++j)
+                {
+                for (unsigned int i=0; i < ci.getW(); ++i)
+                    {
+                    const unsigned int idx = ci(i,j,k);
+                    const int3 global_cell = m_cl->getGlobalCell(make_int3(i,j,k));
+                    cells[idx] = global_ci(global_cell.x, global_cell.y, global_cell.z);
+
+                    const double4 cell_vel = h_cell_vel.data[idx];
+                    density[idx] = float(cell_vel.w / cell_volume);
+                    vel[3*idx] = float(cell_vel.x);
+                    vel[3*idx+1] = float(cell_vel.y);
+                    vel[3*idx+2] = float(cell_vel.z);
+                    }
+                }
+            }
+        }
+
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        mpcd::detail::gather_to_root(cells, mpi_comm);
+        mpcd::detail::gather_to_root(density, mpi_comm);
+        mpcd::detail::gather_to_root(vel, mpi_comm);
+        }
+    #endif // ENABLE_MPI
+
+    if (m_exec_conf->isRoot())
+        {
+        const float size = cell_size;
+        mpcd::detail::write_gsd_chunk(handle, "mpcd/cell/size", GSD_TYPE_FLOAT, 1, 1, &size, m_exec_conf);
+
+        const uint3 global_dim = m_cl->getGlobalDim();
+        const unsigned int dim[3] = {global_dim.x, global_dim.y, global_dim.z};
+        mpcd::detail::write_gsd_chunk(handle, "mpcd/cell/dimensions", GSD_TYPE_UINT32, 1, 3, dim, m_exec_conf);
+
+        const float grid_shift[3] = {float(m_grid_shift.x), float(m_grid_shift.y), float(m_grid_shift.z)};
+        mpcd::detail::write_gsd_chunk(handle, "mpcd/cell/grid_shift", GSD_TYPE_FLOAT, 1, 3, grid_shift, m_exec_conf);
+
+        density = mpcd::detail::reorder(density, cells, ncells_global, 1);
+        mpcd::detail::write_gsd_chunk(handle, "mpcd/cell/density", GSD_TYPE_FLOAT, ncells_global, 1, &density[0], m_exec_conf);
+
+        vel = mpcd::detail::reorder(vel, cells, ncells_global, 3);
+        mpcd::detail::write_gsd_chunk(handle, "mpcd/cell/velocity", GSD_TYPE_FLOAT, ncells_global, 3, &vel[0], m_exec_conf);
+        }
+
+    return 0;
+    }
+
 /*!
  * \param m Python module
  */
@@ -569,5 +791,6 @@ void mpcd::detail::export_CellThermoCompute(pybind11::module& m)
         (m, "CellThermoCompute", py::base<Compute>())
         .def(py::init< std::shared_ptr<mpcd::SystemData> >())
         .def(py::init< std::shared_ptr<mpcd::SystemData>, const std::string& >())
-        .def("enableLogging", &mpcd::CellThermoCompute::enableLogging);
+        .def("enableLogging", &mpcd::CellThermoCompute::enableLogging)
+        .def("connectGSDSignal", &mpcd::CellThermoCompute::connectGSDSignal);
     }
@@ -146,6 +146,12 @@ class CellThermoCompute : public Compute
             return m_callbacks;
             }
 
+        //! Write the cell fields alongside each frame of a GSD file
+        void connectGSDSignal(std::shared_ptr<GSDDumpWriter> writer);
+
+        //! Write the cell fields to a GSD file
+        int slotWriteGSD(gsd_handle& handle);
+
     protected:
         //! Compute the cell properties
         void computeCellProperties(unsigned int timestep);
@@ -161,6 +167,9 @@ class CellThermoCompute : public Compute
         //! Calculate the inner cell properties
         virtual void calcInnerCellProperties();
 
+        //! Sum the properties of all cells in a single pass over the particles
+        void sumCellProperties();
+
         //! Compute the net properties from the cell properties
         virtual void computeNetProperties();
 
@@ -178,6 +187,7 @@ class CellThermoCompute : public Compute
         GPUVector<double4> m_cell_vel;      //!< Average velocity of a cell + cell mass
         GPUVector<double3> m_cell_energy;   //!< Kinetic energy, unscaled temperature, dof in each cell
         unsigned int m_ncells_alloc;        //!< Number of cells allocated for
+        Scalar3 m_grid_shift;               //!< Grid shift of the last call to compute
 
         bool m_enable_log;                          //!< Flag to enable logging
         std::vector<std::string> m_logname_list;    //!< Cache all generated logged quantities names
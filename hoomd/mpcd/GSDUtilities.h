@@ -0,0 +1,152 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// Maintainer: mphoward
+
+/*!
+ * \file mpcd/GSDUtilities.h
+ * \brief Helpers for writing MPCD data to GSD files
+ */
+
+#ifndef MPCD_GSD_UTILITIES_H_
+#define MPCD_GSD_UTILITIES_H_
+
+#ifdef NVCC
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/extern/gsd.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif // ENABLE_MPI
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mpcd
+{
+namespace detail
+{
+
+//! Write a chunk to a GSD file
+/*!
+ * \param handle Handle to the GSD file
+ * \param name Name of the chunk
+ * \param type Type of the chunk data
+ * \param N Number of rows
+ * \param M Number of columns
+ * \param data Data to write (N x M values)
+ * \param exec_conf Execution configuration for error reporting
+ *
+ * \post An error is raised if the chunk could not be written.
+ */
+inline void write_gsd_chunk(gsd_handle& handle,
+                            const std::string& name,
+                            gsd_type type,
+                            uint64_t N,
+                            uint8_t M,
+                            const void *data,
+                            std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    exec_conf->msg->notice(10) << "mpcd: writing " << name << std::endl;
+    int retval = gsd_write_chunk(&handle, name.c_str(), type, N, M, 0, data);
+    if (retval != 0)
+        {
+        exec_conf->msg->error() << "mpcd: error " << retval << " writing " << name << " to GSD file" << std::endl;
+        throw std::runtime_error("Error writing MPCD data to GSD file");
+        }
+    }
+
+//! Write a list of names to a GSD file
+/*!
+ * \param handle Handle to the GSD file
+ * \param name Name of the chunk
+ * \param names Names to write
+ * \param exec_conf Execution configuration for error reporting
+ *
+ * The names are stored as fixed-width, null-terminated strings, as for the particle types.
+ */
+inline void write_gsd_names(gsd_handle& handle,
+                            const std::string& name,
+                            const std::vector<std::string>& names,
+                            std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    {
+    unsigned int max_len = 0;
+    for (unsigned int i=0; i < names.size(); ++i)
+        {
+        max_len = std::max(max_len, (unsigned int)names[i].size());
+        }
+    max_len += 1; // for null
+
+    std::vector<char> buf(max_len * names.size(), 0);
+    for (unsigned int i=0; i < names.size(); ++i)
+        {
+        strncpy(&buf[max_len*i], names[i].c_str(), max_len);
+        }
+    write_gsd_chunk(handle, name, GSD_TYPE_UINT8, names.size(), max_len, &buf[0], exec_conf);
+    }
+
+#ifdef ENABLE_MPI
+//! Concatenate the data of all ranks on the root rank
+/*!
+ * \param data Local data on input, data of all ranks in rank order on output (root only)
+ * \param mpi_comm MPI communicator
+ *
+ * The data of the non-root ranks is left untouched.
+ */
+template<typename T>
+void gather_to_root(std::vector<T>& data, const MPI_Comm mpi_comm)
+    {
+    std::vector< std::vector<T> > data_proc;
+    gather_v(data, data_proc, 0, mpi_comm);
+
+    int rank;
+    MPI_Comm_rank(mpi_comm, &rank);
+    if (rank == 0)
+        {
+        size_t n = 0;
+        for (unsigned int i=0; i < data_proc.size(); ++i)
+            n += data_proc[i].size();
+
+        data.clear();
+        data.reserve(n);
+        for (unsigned int i=0; i < data_proc.size(); ++i)
+            {
+            data.insert(data.end(), data_proc[i].begin(), data_proc[i].end());
+            // release memory as we go
+            std::vector<T>().swap(data_proc[i]);
+            }
+        }
+    }
+#endif // ENABLE_MPI
+
+//! Reorder data by index
+/*!
+ * \param data Data in arbitrary order, with \a width values per entry
+ * \param idx Destination index of each entry
+ * \param N Number of entries in the reordered data
+ * \param width Number of values per entry
+ * \returns The data with entry i moved to index idx[i]
+ */
+template<typename T>
+std::vector<T> reorder(const std::vector<T>& data, const std::vector<unsigned int>& idx, unsigned int N, unsigned int width)
+    {
+    std::vector<T> out(N*width, T(0));
+    for (unsigned int i=0; i < idx.size(); ++i)
+        {
+        const unsigned int dest = idx[i];
+        for (unsigned int k=0; k < width; ++k)
+            out[width*dest+k] = data[width*i+k];
+        }
+    return out;
+    }
+
+} // end namespace detail
+} // end namespace mpcd
+
+#endif // MPCD_GSD_UTILITIES_H_
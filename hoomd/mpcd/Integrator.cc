@@ -94,6 +94,14 @@ void mpcd::Integrator::update(unsigned int timestep)
         updateRigidBodies(timestep+1);
         }
 
+    // draw the MPCD grid shift at the next timestep in case analyzers are called in between
+    // (note: this is usually a **bad** idea). This is done before streaming so that the streaming
+    // method can bin the particles into the cells of the next collision.
+    if (m_collide)
+        {
+        m_collide->drawGridShift(timestep+1);
+        }
+
     // execute the MPCD streaming step now that MD particles are communicated onto their final domains
     if (m_stream)
         {
@@ -113,13 +121,6 @@ void mpcd::Integrator::update(unsigned int timestep)
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         (*method)->integrateStepTwo(timestep);
     if (m_prof) m_prof->pop();
-
-    // draw the MPCD grid shift at the next timestep in case analyzers are called in between
-    // (note: this is usually a **bad** idea)
-    if (m_collide)
-        {
-        m_collide->drawGridShift(timestep+1);
-        }
     }
 
 /*!
@@ -142,6 +143,9 @@ void mpcd::Integrator::prepRun(unsigned int timestep)
     {
     IntegratorTwoStep::prepRun(timestep);
 
+    // the particles may have been modified since the last run
+    m_mpcd_sys->getCellList()->invalidatePrebinned();
+
     // synchronize timestep in mpcd methods
     if (m_collide)
         {
@@ -46,6 +46,12 @@ mpcd::StreamingMethod::~StreamingMethod()
 
 /*!
  * \param timestep Current time to stream
+ *
+ * Without domain decomposition, the particles are also binned into the cells of the current grid
+ * while they are streamed, and the cell indexes are stashed in their velocities. The next build of
+ * the cell list then only needs to read these indexes, instead of making another pass over the
+ * positions, as long as the grid shift is the same. mpcd::Integrator draws the grid shift of
+ * the next step before streaming, so that this is the case when the next step collides.
  */
 void mpcd::StreamingMethod::stream(unsigned int timestep)
     {
@@ -53,12 +59,17 @@ void mpcd::StreamingMethod::stream(unsigned int timestep)
 
     if (m_prof) m_prof->push("MPCD stream");
 
-    const BoxDim& box = m_mpcd_sys->getCellList()->getCoverageBox();
+    std::shared_ptr<mpcd::CellList> cl = m_mpcd_sys->getCellList();
+    const BoxDim& box = cl->getCoverageBox();
+    const bool prebin = cl->canPrebin();
+    const mpcd::detail::CellBinner binner = cl->getBinner();
 
     ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(), access_location::host, access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(), access_location::host, access_mode::readwrite);
 
-    for (unsigned int cur_p = 0; cur_p < m_mpcd_pdata->getN(); ++cur_p)
+    const unsigned int N = m_mpcd_pdata->getN();
+    unsigned int n_unbinned = 0;
+    for (unsigned int cur_p = 0; cur_p < N; ++cur_p)
         {
         const Scalar4 postype = h_pos.data[cur_p];
         Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
@@ -75,10 +86,24 @@ void mpcd::StreamingMethod::stream(unsigned int timestep)
         box.wrap(pos, image);
 
         h_pos.data[cur_p] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+
+        // bin the particle at its new position
+        if (prebin)
+            {
+            unsigned int bin_idx = 0;
+            if (binner(pos, bin_idx) == mpcd::detail::CellBinner::binned)
+                h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
+            else
+                ++n_unbinned;
+            }
         }
 
     // particles have moved, so the cell cache is no longer valid
     m_mpcd_pdata->invalidateCellCache();
+
+    // but the cell list can reuse the new cell indexes (errors are reported when the cell list is built)
+    if (prebin && n_unbinned == 0)
+        cl->setPrebinned(N);
     if (m_prof) m_prof->pop();
     }
 
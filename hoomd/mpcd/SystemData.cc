@@ -9,6 +9,7 @@
  */
 
 #include "SystemData.h"
+#include "GSDUtilities.h"
 #ifdef ENABLE_CUDA
 #include "CellListGPU.h"
 #endif // ENABLE_CUDA
@@ -106,6 +107,151 @@ void mpcd::SystemData::initializeFromSnapshot(std::shared_ptr<mpcd::SystemDataSn
     m_particles->initializeFromSnapshot(snapshot->particles, m_global_box);
     }
 
+/*!
+ * \param writer GSD writer to connect to
+ *
+ * Every frame that \a writer writes will also hold the MPCD particles.
+ */
+void mpcd::SystemData::connectGSDSignal(std::shared_ptr<GSDDumpWriter> writer)
+    {
+    typedef hoomd::detail::SharedSignalSlot<int(gsd_handle&)> SlotType;
+    auto func = std::bind(&mpcd::SystemData::slotWriteGSD, this, std::placeholders::_1);
+    std::shared_ptr<hoomd::detail::SignalSlot> pslot(new SlotType(writer->getWriteSignal(), func));
+    m_slots.push_back(pslot);
+    }
+
+/*!
+ * \param handle Handle to the GSD file
+ * \returns 0 on success
+ *
+ * The following chunks are written in tag order, with positions and velocities in single precision:
+ *  - mpcd/N: number of MPCD particles
+ *  - mpcd/position: N x 3 particle positions
+ *  - mpcd/velocity: N x 3 particle velocities
+ *  - mpcd/typeid: N particle types
+ *  - mpcd/grid_shift: current shift of the cell grid
+ *
+ * The type names (mpcd/types) and the particle mass (mpcd/mass) are only written in the first frame.
+ *
+ * Each quantity is converted and written one at a time. In serial simulations, the extra memory peaks
+ * at about 28 bytes per particle while a vector quantity is put into tag order (the tags, and the
+ * converted and the reordered copy of the quantity). With domain decomposition, the data is gathered
+ * to the root rank one quantity at a time.
+ *
+ * This method must be called on all ranks.
+ */
+int mpcd::SystemData::slotWriteGSD(gsd_handle& handle)
+    {
+    std::shared_ptr<const ExecutionConfiguration> exec_conf = m_sysdef->getParticleData()->getExecConf();
+    exec_conf->msg->notice(10) << "mpcd: writing particles to GSD file" << std::endl;
+
+    const unsigned int N = m_particles->getN();
+    const unsigned int N_global = m_particles->getNGlobal();
+    const bool root = exec_conf->isRoot();
+    #ifdef ENABLE_MPI
+    const bool mpi = (bool)m_sysdef->getParticleData()->getDomainDecomposition();
+    #endif // ENABLE_MPI
+
+    // tags are needed to put each quantity into order
+    std::vector<unsigned int> tags(N);
+        {
+        ArrayHandle<unsigned int> h_tag(m_particles->getTags(), access_location::host, access_mode::read);
+        std::copy(h_tag.data, h_tag.data + N, tags.begin());
+        }
+    #ifdef ENABLE_MPI
+    if (mpi) mpcd::detail::gather_to_root(tags, exec_conf->getMPICommunicator());
+    #endif // ENABLE_MPI
+
+    uint64_t nframes = 0;
+    if (root)
+        {
+        nframes = gsd_get_nframes(&handle);
+        mpcd::detail::write_gsd_chunk(handle, "mpcd/N", GSD_TYPE_UINT32, 1, 1, &N_global, exec_conf);
+        }
+
+    // positions
+        {
+        std::vector<float> pos(3*N);
+            {
+            ArrayHandle<Scalar4> h_pos(m_particles->getPositions(), access_location::host, access_mode::read);
+            for (unsigned int idx=0; idx < N; ++idx)
+                {
+                const Scalar4 postype = h_pos.data[idx];
+                pos[3*idx] = float(postype.x);
+                pos[3*idx+1] = float(postype.y);
+                pos[3*idx+2] = float(postype.z);
+                }
+            }
+        #ifdef ENABLE_MPI
+        if (mpi) mpcd::detail::gather_to_root(pos, exec_conf->getMPICommunicator());
+        #endif // ENABLE_MPI
+        if (root)
+            {
+            pos = mpcd::detail::reorder(pos, tags, N_global, 3);
+            mpcd::detail::write_gsd_chunk(handle, "mpcd/position", GSD_TYPE_FLOAT, N_global, 3, &pos[0], exec_conf);
+            }
+        }
+
+    // velocities
+        {
+        std::vector<float> vel(3*N);
+            {
+            ArrayHandle<Scalar4> h_vel(m_particles->getVelocities(), access_location::host, access_mode::read);
+            for (unsigned int idx=0; idx < N; ++idx)
+                {
+                const Scalar4 velcell = h_vel.data[idx];
+                vel[3*idx] = float(velcell.x);
+                vel[3*idx+1] = float(velcell.y);
+                vel[3*idx+2] = float(velcell.z);
+                }
+            }
+        #ifdef ENABLE_MPI
+        if (mpi) mpcd::detail::gather_to_root(vel, exec_conf->getMPICommunicator());
+        #endif // ENABLE_MPI
+        if (root)
+            {
+            vel = mpcd::detail::reorder(vel, tags, N_global, 3);
+            mpcd::detail::write_gsd_chunk(handle, "mpcd/velocity", GSD_TYPE_FLOAT, N_global, 3, &vel[0], exec_conf);
+            }
+        }
+
+    // types
+        {
+        std::vector<unsigned int> type(N);
+            {
+            ArrayHandle<Scalar4> h_pos(m_particles->getPositions(), access_location::host, access_mode::read);
+            for (unsigned int idx=0; idx < N; ++idx)
+                type[idx] = __scalar_as_int(h_pos.data[idx].w);
+            }
+        #ifdef ENABLE_MPI
+        if (mpi) mpcd::detail::gather_to_root(type, exec_conf->getMPICommunicator());
+        #endif // ENABLE_MPI
+        if (root)
+            {
+            type = mpcd::detail::reorder(type, tags, N_global, 1);
+            mpcd::detail::write_gsd_chunk(handle, "mpcd/typeid", GSD_TYPE_UINT32, N_global, 1, &type[0], exec_conf);
+            }
+        }
+
+    if (root)
+        {
+        const Scalar3 shift = m_cl->getGridShift();
+        const float grid_shift[3] = {float(shift.x), float(shift.y), float(shift.z)};
+        mpcd::detail::write_gsd_chunk(handle, "mpcd/grid_shift", GSD_TYPE_FLOAT, 1, 3, grid_shift, exec_conf);
+
+        // static quantities only go into the first frame
+        if (nframes == 0)
+            {
+            mpcd::detail::write_gsd_names(handle, "mpcd/types", m_particles->getTypeNames(), exec_conf);
+
+            const float mass = m_particles->getMass();
+            mpcd::detail::write_gsd_chunk(handle, "mpcd/mass", GSD_TYPE_FLOAT, 1, 1, &mass, exec_conf);
+            }
+        }
+
+    return 0;
+    }
+
 /*!
  * \param m Python module to export to
  */
@@ -119,5 +265,6 @@ void mpcd::detail::export_SystemData(pybind11::module& m)
     .def("getParticleData", &mpcd::SystemData::getParticleData)
     .def("getCellList", &mpcd::SystemData::getCellList)
     .def("takeSnapshot", &mpcd::SystemData::takeSnapshot)
-    .def("initializeFromSnapshot", &mpcd::SystemData::initializeFromSnapshot);
+    .def("initializeFromSnapshot", &mpcd::SystemData::initializeFromSnapshot)
+    .def("connectGSDSignal", &mpcd::SystemData::connectGSDSignal);
     }
@@ -18,6 +18,8 @@
 #include "CellList.h"
 #include "ParticleData.h"
 #include "SystemDataSnapshot.h"
+#include "hoomd/GSDDumpWriter.h"
+#include "hoomd/SharedSignal.h"
 #include "hoomd/SystemDefinition.h"
 #include "hoomd/extern/pybind/include/pybind11/pybind11.h"
 
@@ -87,11 +89,18 @@ class SystemData
             m_particles->setAutotunerParams(enable, period);
             }
 
+        //! Write the MPCD particles alongside each frame of a GSD file
+        void connectGSDSignal(std::shared_ptr<GSDDumpWriter> writer);
+
+        //! Write the MPCD particles to a GSD file
+        int slotWriteGSD(gsd_handle& handle);
+
     private:
         std::shared_ptr<::SystemDefinition> m_sysdef;       //!< HOOMD system definition
         std::shared_ptr<mpcd::ParticleData> m_particles;    //!< MPCD particle data
         std::shared_ptr<mpcd::CellList> m_cl;               //!< MPCD cell list
         const BoxDim m_global_box;  //!< Global simulation box
+        std::vector< std::shared_ptr<hoomd::detail::SignalSlot> > m_slots; //!< Connections to GSD writers
 
         //! Check that the simulation box has not changed from the cached value on initialization
         void checkBox() const
@@ -219,6 +219,10 @@ class system(hoomd.meta._metadata):
         # no collision rule by default
         self._collide = None
 
+        # GSD writers that the particles and cell fields are written to
+        self._gsd_particles = []
+        self._gsd_cells = []
+
     @property
     def particles(self):
         return self.data.getParticleData()
@@ -264,6 +268,63 @@ class system(hoomd.meta._metadata):
         if cell is not None:
             self.cell.setCellSize(cell)
 
+    def dump_gsd(self, gsd, particles=True, cells=False):
+        R""" Write the MPCD system alongside the frames of a GSD file
+
+        Args:
+            gsd (:py:class:`hoomd.dump.gsd`): GSD writer
+            particles (bool): If true, write the MPCD particles
+            cells (bool): If true, write the coarse-grained cell fields
+
+        Every frame that *gsd* writes will hold the MPCD data in addition to
+        the HOOMD particle data. The particles are written in tag order in
+        single precision to the chunks ``mpcd/N``, ``mpcd/position``,
+        ``mpcd/velocity``, and ``mpcd/typeid``, together with the current shift
+        of the cell grid (``mpcd/grid_shift``). The type names (``mpcd/types``)
+        and particle mass (``mpcd/mass``) are written in the first frame.
+
+        The cell fields are much smaller than the particle data, and are written to
+        ``mpcd/cell/density`` (mass density of each cell) and ``mpcd/cell/velocity``
+        (center-of-mass velocity of each cell), together with the grid they were
+        computed on (``mpcd/cell/size``, ``mpcd/cell/dimensions``, and
+        ``mpcd/cell/grid_shift``). The cells are ordered with the *x* index varying
+        fastest. The fields are those computed at the most recent collision, and are
+        zero before the first collision.
+
+        Calling :py:meth:`hoomd.dump.gsd.dump_state` with the MPCD system is
+        equivalent to calling this method with the default arguments.
+
+        Examples::
+
+            traj = hoomd.dump.gsd(filename="traj.gsd", period=1000, group=hoomd.group.all())
+            mpcd_sys.dump_gsd(traj)
+
+            fields = hoomd.dump.gsd(filename="fields.gsd", period=100, group=hoomd.group.all())
+            mpcd_sys.dump_gsd(fields, particles=False, cells=True)
+
+        .. versionadded:: 2.3
+
+        """
+        hoomd.util.print_status_line()
+
+        if not isinstance(gsd, hoomd.dump.gsd):
+            hoomd.context.msg.error("mpcd: can only write to hoomd.dump.gsd\n")
+            raise TypeError("MPCD data can only be written to hoomd.dump.gsd")
+
+        # each writer gets each kind of data only once
+        if particles and gsd not in self._gsd_particles:
+            self.data.connectGSDSignal(gsd.cpp_analyzer)
+            self._gsd_particles.append(gsd)
+        if cells and gsd not in self._gsd_cells:
+            self._thermo.connectGSDSignal(gsd.cpp_analyzer)
+            self._gsd_cells.append(gsd)
+
+    def _connect_gsd(self, gsd):
+        # This is an internal method, and should not be called directly. See gsd.dump_state() instead
+        hoomd.util.quiet_status()
+        self.dump_gsd(gsd)
+        hoomd.util.unquiet_status()
+
     def take_snapshot(self, particles=True):
         R""" Takes a snapshot of the current state of the MPCD system
 
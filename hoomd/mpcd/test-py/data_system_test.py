@@ -4,9 +4,17 @@
 # Maintainer: mphoward
 
 import unittest
+import os
+import numpy as np
 import hoomd
 from hoomd import mpcd
 
+try:
+    import gsd.fl
+    have_gsd = True
+except ImportError:
+    have_gsd = False
+
 # unit tests for snapshots with mpcd particle data
 class mpcd_snapshot(unittest.TestCase):
     def setUp(self):
@@ -23,6 +31,57 @@ class mpcd_snapshot(unittest.TestCase):
         snap = s.take_snapshot()
         s.restore_snapshot(snap)
 
+    @unittest.skipIf(not have_gsd, "requires the gsd python module")
+    def test_dump_gsd(self):
+        s = mpcd.init.make_random(N=3, kT=1.0, seed=7)
+        snap = s.take_snapshot()
+
+        filename = 'mpcd_system.gsd'
+        traj = hoomd.dump.gsd(filename, period=1, group=hoomd.group.all(), overwrite=True)
+        traj.dump_state(s)
+        s.dump_gsd(traj, particles=False, cells=True)
+
+        # only hoomd.dump.gsd is supported
+        self.assertRaises(TypeError, s.dump_gsd, 'not_a_gsd')
+
+        # collide at step 0 without streaming, so frame 1 holds the cell fields of the initial configuration
+        mpcd.integrator(dt=0.1)
+        mpcd.collide.srd(seed=42, period=1, angle=130.)
+        hoomd.run(2)
+        del traj
+
+        if hoomd.comm.get_rank() == 0:
+            f = gsd.fl.GSDFile(filename, 'rb')
+            self.assertEqual(f.nframes, 2)
+
+            # particles are written in tag order
+            self.assertEqual(f.read_chunk(frame=0, name='mpcd/N')[0], 3)
+            np.testing.assert_array_almost_equal(f.read_chunk(frame=0, name='mpcd/position'), snap.particles.position, decimal=5)
+            np.testing.assert_array_almost_equal(f.read_chunk(frame=0, name='mpcd/velocity'), snap.particles.velocity, decimal=5)
+            np.testing.assert_array_equal(f.read_chunk(frame=0, name='mpcd/typeid'), [0,0,0])
+            self.assertEqual(f.read_chunk(frame=0, name='mpcd/types')[0].tobytes().rstrip(b'\0'), b'A')
+            self.assertAlmostEqual(f.read_chunk(frame=0, name='mpcd/mass')[0], 1.0)
+            self.assertTrue(f.chunk_exists(frame=1, name='mpcd/position'))
+            self.assertFalse(f.chunk_exists(frame=1, name='mpcd/mass'))
+
+            # cell fields are zero before the first collision
+            np.testing.assert_array_equal(f.read_chunk(frame=0, name='mpcd/cell/dimensions'), [10,10,10])
+            self.assertAlmostEqual(f.read_chunk(frame=0, name='mpcd/cell/size')[0], 1.0)
+            np.testing.assert_array_equal(f.read_chunk(frame=0, name='mpcd/cell/density'), np.zeros(1000))
+            np.testing.assert_array_equal(f.read_chunk(frame=0, name='mpcd/cell/velocity'), np.zeros((1000,3)))
+
+            # after it, the cells hold the total mass and momentum of the particles
+            density = f.read_chunk(frame=1, name='mpcd/cell/density')
+            vel = f.read_chunk(frame=1, name='mpcd/cell/velocity')
+            self.assertEqual(density.shape, (1000,))
+            self.assertEqual(vel.shape, (1000,3))
+            self.assertAlmostEqual(np.sum(density), 3.0, places=5)
+            np.testing.assert_array_almost_equal(np.sum(density[:,np.newaxis]*vel, axis=0), np.sum(snap.particles.velocity, axis=0), decimal=5)
+            self.assertTrue(np.all(np.abs(f.read_chunk(frame=1, name='mpcd/cell/grid_shift')) <= 0.5))
+
+            del f
+            os.remove(filename)
+
     def tearDown(self):
         pass
 
@@ -103,6 +103,64 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
         }
     }
 
+//! Test that the streaming method bins particles for the next cell list build
+void streaming_method_prebin_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr< SnapshotSystemData<Scalar> > snap( new SnapshotSystemData<Scalar>() );
+    snap->global_box = BoxDim(10.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    // 2 particle system, the second particle will cross the boundary
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        mpcd::ParticleDataSnapshot& mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap.resize(2);
+
+        mpcd_snap.position[0] = vec3<Scalar>(1.0, 4.85, 3.0);
+        mpcd_snap.position[1] = vec3<Scalar>(-3.0, -4.95, -1.0);
+
+        mpcd_snap.velocity[0] = vec3<Scalar>(1.0, 1.0, 1.0);
+        mpcd_snap.velocity[1] = vec3<Scalar>(-1.0, -1.0, -1.0);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    std::shared_ptr<mpcd::ParticleData> pdata_2 = mpcd_sys->getParticleData();
+    std::shared_ptr<mpcd::CellList> cl = mpcd_sys->getCellList();
+
+    std::shared_ptr<mpcd::StreamingMethod> stream = std::make_shared<mpcd::StreamingMethod>(mpcd_sys, 0, 1, -1);
+    stream->setDeltaT(0.1);
+    stream->stream(0);
+
+    // the cell indexes should be stashed in the velocities after streaming
+    Index3D ci = cl->getCellIndexer();
+        {
+        ArrayHandle<Scalar4> h_vel(pdata_2->getVelocities(), access_location::host, access_mode::read);
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[0].w), ci(6,9,8));
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[1].w), ci(1,9,3));
+        }
+
+    // and the cell list should be consistent with them
+    cl->compute(0);
+        {
+        ArrayHandle<unsigned int> h_cell_np(cl->getCellSizeArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list(cl->getCellList(), access_location::host, access_mode::read);
+        Index2D cli = cl->getCellListIndexer();
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(6,9,8)], 1);
+        CHECK_EQUAL_UINT(h_cell_list.data[cli(0,ci(6,9,8))], 0);
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(1,9,3)], 1);
+        CHECK_EQUAL_UINT(h_cell_list.data[cli(0,ci(1,9,3))], 1);
+        }
+
+    // shifting the grid should rebin the particles
+    cl->setGridShift(make_scalar3(0.5, 0.5, 0.5));
+    cl->compute(1);
+        {
+        ArrayHandle<Scalar4> h_vel(pdata_2->getVelocities(), access_location::host, access_mode::read);
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[0].w), ci(5,9,7));
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[1].w), ci(1,9,3));
+        }
+    }
+
 //! basic test case for MPCD StreamingMethod class
 UP_TEST( mpcd_streaming_method_basic )
     {
@@ -115,3 +173,9 @@ UP_TEST( mpcd_streaming_method_setup )
     streaming_method_basic_test<mpcd::StreamingMethodGPU>(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
 #endif // ENABLE_CUDA
+
+//! test case for binning during streaming with the MPCD StreamingMethod class
+UP_TEST( mpcd_streaming_method_prebin )
+    {
+    streaming_method_prebin_test(std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
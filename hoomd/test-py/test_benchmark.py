@@ -0,0 +1,49 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+import hoomd;
+import unittest
+import os
+import json
+
+# unit tests for benchmark.suite
+class benchmark_suite_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+        self.filename = 'test_benchmark.json';
+
+    # test that the report contains the metadata and the results
+    def test_report(self):
+        b = benchmark.suite(workloads=['lj_liquid'], sizes=[500], warmup=10, repeat=2, steps=10, micro_repeat=2);
+        b.run();
+        b.write(self.filename);
+
+        if comm.get_rank() == 0:
+            with open(self.filename) as f:
+                report = json.load(f);
+
+            self.assertEqual(report['metadata']['hoomd_version'], hoomd.__version__);
+            self.assertEqual(report['metadata']['num_ranks'], comm.get_num_ranks());
+            self.assertEqual(len(report['results']), 1);
+
+            result = report['results'][0];
+            self.assertEqual(result['workload'], 'lj_liquid');
+            self.assertEqual(result['N'], 500);
+            self.assertEqual(len(result['tps']), 2);
+            for name in ['cell_list', 'neighbor_list', 'pair', 'gsd_write']:
+                self.assertGreater(result['microbenchmarks'][name], 0);
+
+    # test that unknown workloads are rejected
+    def test_unknown(self):
+        self.assertRaises(RuntimeError, benchmark.suite, workloads=['unknown']);
+
+    def tearDown(self):
+        comm.barrier_all();
+        if comm.get_rank() == 0 and os.path.exists(self.filename):
+            os.remove(self.filename);
+        comm.barrier_all();
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,124 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+from hoomd import md
+import hoomd;
+import unittest
+import os
+import glob
+import numpy
+
+# unit tests for dump.checkpoint and init.read_checkpoint
+class checkpoint_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+        self.prefix = 'test_checkpoint_restart'
+
+        snapshot = data.make_snapshot(N=4, box=data.boxdim(Lx=10, Ly=20, Lz=30), particle_types=['p1', 'p2'], bond_types=['b1']);
+        if comm.get_rank() == 0:
+            snapshot.particles.position[:] = [[-3,1,2], [-2,2,3], [2,-1,-2], [3,-2,-3]];
+            snapshot.particles.velocity[:] = [[1,0,0], [0,1,0], [0,0,1], [1,1,1]];
+            snapshot.particles.typeid[:] = [0,1,0,1];
+            snapshot.particles.mass[:] = [1, 2, 3, 4];
+            snapshot.particles.charge[:] = [0.5, -0.5, 0.25, -0.25];
+            snapshot.particles.image[:] = [[1,0,0], [0,-1,0], [0,0,2], [3,0,0]];
+
+            snapshot.bonds.resize(3);
+            snapshot.bonds.group[:] = [[0,1], [1,2], [2,3]];
+            snapshot.bonds.typeid[:] = [0,0,0];
+
+        self.s = init.read_snapshot(snapshot);
+
+    def setup_integrator(self):
+        harmonic = md.bond.harmonic();
+        harmonic.bond_coeff.set('b1', k=10.0, r0=1.0);
+        md.integrate.mode_standard(dt=0.001);
+        md.integrate.nvt(group=group.all(), kT=1.0, tau=0.5);
+
+    # test that the restored system continues exactly the same trajectory
+    def test_restart(self):
+        self.setup_integrator();
+        run(10);
+        dump.checkpoint(prefix=self.prefix, period=None);
+        run(10);
+        ref = self.s.take_snapshot(all=True);
+
+        context.initialize();
+        s = init.read_checkpoint(prefix=self.prefix);
+        self.assertEqual(get_step(), 10);
+
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, 4);
+            self.assertEqual(snap.particles.types, ['p1', 'p2']);
+            numpy.testing.assert_array_equal(snap.particles.typeid, [0,1,0,1]);
+            numpy.testing.assert_array_equal(snap.particles.mass, [1, 2, 3, 4]);
+            numpy.testing.assert_array_equal(snap.particles.charge, [0.5, -0.5, 0.25, -0.25]);
+            self.assertEqual(snap.bonds.N, 3);
+            self.assertEqual(snap.bonds.types, ['b1']);
+            numpy.testing.assert_array_equal(snap.bonds.group, [[0,1], [1,2], [2,3]]);
+            self.assertAlmostEqual(snap.box.Lx, 10);
+            self.assertAlmostEqual(snap.box.Ly, 20);
+            self.assertAlmostEqual(snap.box.Lz, 30);
+
+        self.setup_integrator();
+        run(10);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            numpy.testing.assert_array_equal(snap.particles.position, ref.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, ref.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+
+    # test that a second checkpoint replaces the first
+    def test_overwrite(self):
+        ckpt = dump.checkpoint(prefix=self.prefix, period=None);
+        run(5);
+        ckpt.write();
+
+        # the files of the first checkpoint are removed
+        comm.barrier_all();
+        if comm.get_rank() == 0:
+            self.assertEqual(len(glob.glob(self.prefix + '.0.domain*')), 0);
+            self.assertEqual(len(glob.glob(self.prefix + '.5.domain*')), comm.get_num_ranks());
+
+        context.initialize();
+        init.read_checkpoint(prefix=self.prefix);
+        self.assertEqual(get_step(), 5);
+
+    # test that a failure after writing the domain files leaves the previous checkpoint intact
+    def test_interrupted(self):
+        ckpt = dump.checkpoint(prefix=self.prefix, period=None);
+        run(5);
+
+        # the new manifest cannot be created
+        if comm.get_rank() == 0:
+            os.mkdir(self.prefix + '.manifest.tmp');
+        comm.barrier_all();
+        self.assertRaises(RuntimeError, ckpt.write);
+
+        comm.barrier_all();
+        if comm.get_rank() == 0:
+            os.rmdir(self.prefix + '.manifest.tmp');
+            self.assertEqual(len(glob.glob(self.prefix + '.0.domain*')), comm.get_num_ranks());
+            self.assertEqual(len(glob.glob(self.prefix + '.5.domain*')), 0);
+
+        context.initialize();
+        init.read_checkpoint(prefix=self.prefix);
+        self.assertEqual(get_step(), 0);
+
+    # test that missing checkpoints raise an error
+    def test_missing(self):
+        context.initialize();
+        self.assertRaises(RuntimeError, init.read_checkpoint, prefix=self.prefix + '_missing');
+
+    def tearDown(self):
+        comm.barrier_all();
+        if comm.get_rank() == 0:
+            for f in glob.glob(self.prefix + '.*'):
+                os.remove(f);
+        comm.barrier_all();
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,160 @@
+# -*- coding: iso-8859-1 -*-
+# Maintainer: joaander
+
+from hoomd import *
+import hoomd;
+import unittest
+import os
+import numpy
+
+# unit tests for init.read_gsd(distributed=True)
+class read_gsd_distributed_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+        self.filename = 'test_init_distributed.gsd';
+
+        snapshot = data.make_snapshot(N=6, box=data.boxdim(Lx=10, Ly=20, Lz=30), particle_types=['p1', 'p2'],
+                                      bond_types=['b1', 'b2'], angle_types=['a1']);
+        if comm.get_rank() == 0:
+            snapshot.particles.position[:] = [[-4,-9,-14], [-3,8,2], [-1,1,-3], [2,-1,-2], [3,7,12], [4,-8,14]];
+            snapshot.particles.velocity[:] = [[1,0,0], [0,1,0], [0,0,1], [1,1,1], [2,0,0], [0,2,0]];
+            snapshot.particles.typeid[:] = [0,1,0,1,1,0];
+            snapshot.particles.mass[:] = [1, 2, 3, 4, 5, 6];
+            snapshot.particles.charge[:] = [0.5, -0.5, 0.25, -0.25, 1, -1];
+            snapshot.particles.image[:] = [[1,0,0], [0,-1,0], [0,0,2], [3,0,0], [0,0,0], [0,1,0]];
+
+            snapshot.bonds.resize(4);
+            snapshot.bonds.group[:] = [[0,1], [1,2], [2,5], [3,4]];
+            snapshot.bonds.typeid[:] = [0,1,0,1];
+
+            snapshot.angles.resize(2);
+            snapshot.angles.group[:] = [[0,1,2], [3,4,5]];
+            snapshot.angles.typeid[:] = [0,0];
+
+            snapshot.constraints.resize(1);
+            snapshot.constraints.group[:] = [[0,5]];
+            snapshot.constraints.value[:] = [2.5];
+
+        s = init.read_snapshot(snapshot);
+        dump.gsd(filename=self.filename, group=group.all(), period=None, overwrite=True);
+        self.ref = s.take_snapshot(all=True);
+        context.initialize();
+
+    # test that the distributed reader initializes the same system as the default one
+    def test_read(self):
+        s = init.read_gsd(filename=self.filename, distributed=True);
+        self.assertEqual(len(s.particles), 6);
+        self.assertEqual(len(s.bonds), 4);
+
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.types, ['p1', 'p2']);
+            numpy.testing.assert_array_equal(snap.particles.position, self.ref.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.velocity, self.ref.particles.velocity);
+            numpy.testing.assert_array_equal(snap.particles.typeid, self.ref.particles.typeid);
+            numpy.testing.assert_array_equal(snap.particles.mass, self.ref.particles.mass);
+            numpy.testing.assert_array_equal(snap.particles.charge, self.ref.particles.charge);
+            numpy.testing.assert_array_equal(snap.particles.image, self.ref.particles.image);
+
+            self.assertEqual(snap.bonds.types, ['b1', 'b2']);
+            numpy.testing.assert_array_equal(snap.bonds.group, self.ref.bonds.group);
+            numpy.testing.assert_array_equal(snap.bonds.typeid, self.ref.bonds.typeid);
+            numpy.testing.assert_array_equal(snap.angles.group, self.ref.angles.group);
+            numpy.testing.assert_array_equal(snap.constraints.group, self.ref.constraints.group);
+            numpy.testing.assert_allclose(snap.constraints.value, [2.5]);
+
+    # test that the system can run
+    def test_run(self):
+        init.read_gsd(filename=self.filename, distributed=True);
+        run(1);
+
+    def tearDown(self):
+        comm.barrier_all();
+        if comm.get_rank() == 0:
+            os.remove(self.filename);
+        comm.barrier_all();
+        context.initialize();
+
+# unit tests for init.create_lattice(distributed=True)
+class create_lattice_distributed_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+
+    def compare(self, unitcell, n):
+        s = init.create_lattice(unitcell=unitcell, n=n);
+        ref = s.take_snapshot(all=True);
+        context.initialize();
+
+        s = init.create_lattice(unitcell=unitcell, n=n, distributed=True);
+        snap = s.take_snapshot(all=True);
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, ref.particles.N);
+            self.assertEqual(snap.box.dimensions, ref.box.dimensions);
+            numpy.testing.assert_allclose(snap.box.Lx, ref.box.Lx);
+            numpy.testing.assert_allclose(snap.box.Ly, ref.box.Ly);
+            numpy.testing.assert_allclose(snap.box.Lz, ref.box.Lz);
+            numpy.testing.assert_array_equal(snap.particles.position, ref.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+            numpy.testing.assert_array_equal(snap.particles.typeid, ref.particles.typeid);
+
+    def test_bcc(self):
+        self.compare(lattice.bcc(a=1.5), [3,4,5]);
+
+    def test_hex(self):
+        self.compare(lattice.hex(a=1.0), [6,4]);
+
+    def tearDown(self):
+        context.initialize();
+
+# unit tests for init.read_snapshot(replicate=...)
+class read_snapshot_replicate_tests (unittest.TestCase):
+    def setUp(self):
+        context.initialize()
+
+        # one polymer chain per unit cell, crossing the boundary of the cell
+        self.unit_cell = data.make_snapshot(N=4, box=data.boxdim(Lx=4, Ly=3, Lz=2), particle_types=['A', 'B'],
+                                            bond_types=['backbone'], angle_types=['bend']);
+        if comm.get_rank() == 0:
+            self.unit_cell.particles.position[:] = [[1.5,0,0], [-1.5,0.5,0], [-0.5,0.5,0.5], [0.5,-0.5,0.5]];
+            self.unit_cell.particles.image[:] = [[-1,0,0], [0,0,0], [0,0,0], [0,0,0]];
+            self.unit_cell.particles.typeid[:] = [0,1,1,0];
+            self.unit_cell.bonds.resize(3);
+            self.unit_cell.bonds.group[:] = [[0,1], [1,2], [2,3]];
+            self.unit_cell.angles.resize(2);
+            self.unit_cell.angles.group[:] = [[0,1,2], [1,2,3]];
+
+    # test that the lazily replicated system is the same as the replicated snapshot
+    def test_replicate(self):
+        s = init.read_snapshot(self.unit_cell, replicate=[3,2,4]);
+        snap = s.take_snapshot(all=True);
+        context.initialize();
+
+        self.unit_cell.replicate(3,2,4);
+        s = init.read_snapshot(self.unit_cell);
+        ref = s.take_snapshot(all=True);
+
+        if comm.get_rank() == 0:
+            self.assertEqual(snap.particles.N, 96);
+            numpy.testing.assert_allclose(snap.box.Lx, 12);
+            numpy.testing.assert_array_equal(snap.particles.position, ref.particles.position);
+            numpy.testing.assert_array_equal(snap.particles.image, ref.particles.image);
+            numpy.testing.assert_array_equal(snap.particles.typeid, ref.particles.typeid);
+            self.assertEqual(snap.bonds.N, 72);
+            self.assertEqual(snap.bonds.types, ['backbone']);
+            numpy.testing.assert_array_equal(snap.bonds.group, ref.bonds.group);
+            self.assertEqual(snap.angles.N, 48);
+            numpy.testing.assert_array_equal(snap.angles.group, ref.angles.group);
+
+    # test the number of replicas
+    def test_invalid(self):
+        self.assertRaises(RuntimeError, init.read_snapshot, self.unit_cell, replicate=[3,2]);
+
+    def test_invalid_2d(self):
+        unit_cell = data.make_snapshot(N=1, box=data.boxdim(Lx=2, Ly=2, dimensions=2));
+        self.assertRaises(RuntimeError, init.read_snapshot, unit_cell, replicate=[3,2,2]);
+
+    def tearDown(self):
+        context.initialize();
+
+if __name__ == '__main__':
+    unittest.main(argv = ['test.py', '-v'])
@@ -0,0 +1,138 @@
+// Copyright (c) 2009-2017 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <iostream>
+#include <limits>
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+
+#include "hoomd/TriangleMesh.h"
+#include "hoomd/Saru.h"
+
+using namespace std;
+
+/*! \file test_triangle_mesh.cc
+    \brief Implements unit tests for TriangleMesh
+    \ingroup unit_tests
+*/
+
+//! Build a mesh of the cube [-1,1]^3 with outward normals
+std::shared_ptr<TriangleMesh> make_cube()
+    {
+    std::vector< vec3<Scalar> > verts;
+    for (unsigned int i = 0; i < 8; ++i)
+        verts.push_back(vec3<Scalar>((i & 1) ? 1 : -1, (i & 2) ? 1 : -1, (i & 4) ? 1 : -1));
+
+    unsigned int tris[36] = {0,2,3, 0,3,1,
+                             4,5,7, 4,7,6,
+                             0,1,5, 0,5,4,
+                             2,6,7, 2,7,3,
+                             0,4,6, 0,6,2,
+                             1,3,7, 1,7,5};
+
+    return std::shared_ptr<TriangleMesh>(new TriangleMesh(verts, std::vector<unsigned int>(tris, tris+36)));
+    }
+
+//! Check the construction of the mesh
+UP_TEST( construction )
+    {
+    std::shared_ptr<TriangleMesh> mesh = make_cube();
+    UP_ASSERT_EQUAL(mesh->getNumTriangles(), (unsigned int)12);
+
+    // all normals point outward
+    for (unsigned int i = 0; i < mesh->getNumTriangles(); ++i)
+        {
+        vec3<Scalar> a, b, c;
+        mesh->getTriangle(i, a, b, c);
+        UP_ASSERT(dot(mesh->getNormal(i), a+b+c) > 0);
+        MY_CHECK_CLOSE(dot(mesh->getNormal(i), mesh->getNormal(i)), 1.0, tol);
+        }
+
+    // degenerate triangles are ignored
+    std::vector< vec3<Scalar> > verts(3);
+    verts[1] = vec3<Scalar>(1,0,0);
+    verts[2] = vec3<Scalar>(2,0,0);
+    std::vector<unsigned int> tris;
+    tris.push_back(0); tris.push_back(1); tris.push_back(2);
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ TriangleMesh(verts, tris); });
+
+    // invalid indices are detected
+    tris[2] = 3;
+    UP_ASSERT_EXCEPTION(std::runtime_error, [&]{ TriangleMesh(verts, tris); });
+    }
+
+//! Check nearest points on faces, edges and vertices
+UP_TEST( nearest_features )
+    {
+    std::shared_ptr<TriangleMesh> mesh = make_cube();
+    Scalar inf = std::numeric_limits<Scalar>::infinity();
+    vec3<Scalar> dx, n;
+
+    // face, from the inside
+    UP_ASSERT(mesh->findNearest(vec3<Scalar>(0.5,0.2,-0.1), inf, dx, n));
+    MY_CHECK_CLOSE(dx.x, 0.5, tol);
+    MY_CHECK_SMALL(dx.y, tol_small);
+    MY_CHECK_SMALL(dx.z, tol_small);
+    MY_CHECK_CLOSE(n.x, 1.0, tol);
+    UP_ASSERT(dot(-dx, n) < 0);
+
+    // face, from the outside
+    UP_ASSERT(mesh->findNearest(vec3<Scalar>(0.2,-0.3,-2.5), inf, dx, n));
+    MY_CHECK_CLOSE(dx.z, 1.5, tol);
+    MY_CHECK_CLOSE(n.z, -1.0, tol);
+    UP_ASSERT(dot(-dx, n) > 0);
+
+    // edge, where the pseudo-normal is the average of the two faces
+    UP_ASSERT(mesh->findNearest(vec3<Scalar>(2,2,0.3), inf, dx, n));
+    MY_CHECK_CLOSE(dx.x, -1.0, tol);
+    MY_CHECK_CLOSE(dx.y, -1.0, tol);
+    MY_CHECK_SMALL(dx.z, tol_small);
+    MY_CHECK_CLOSE(n.x, 1.0/sqrt(2.0), tol);
+    MY_CHECK_CLOSE(n.y, 1.0/sqrt(2.0), tol);
+    MY_CHECK_SMALL(n.z, tol_small);
+
+    // vertex, the pseudo-normal weights the two triangles of each face that meet at the vertex by their angles
+    UP_ASSERT(mesh->findNearest(vec3<Scalar>(1.5,1.2,1.1), inf, dx, n));
+    MY_CHECK_CLOSE(dx.x, -0.5, tol);
+    MY_CHECK_CLOSE(dx.y, -0.2, tol);
+    MY_CHECK_CLOSE(dx.z, -0.1, tol);
+    MY_CHECK_CLOSE(n.x, 1.0/sqrt(3.0), tol);
+    MY_CHECK_CLOSE(n.y, 1.0/sqrt(3.0), tol);
+    MY_CHECK_CLOSE(n.z, 1.0/sqrt(3.0), tol);
+
+    // nothing closer than r_max
+    UP_ASSERT(!mesh->findNearest(vec3<Scalar>(3,0,0), 1.5, dx, n));
+    UP_ASSERT(mesh->findNearest(vec3<Scalar>(3,0,0), 2.5, dx, n));
+    MY_CHECK_CLOSE(dx.x, -2.0, tol);
+    }
+
+//! Compare distances and sides of random points against the analytic result for the cube
+UP_TEST( random_points )
+    {
+    std::shared_ptr<TriangleMesh> mesh = make_cube();
+    Scalar inf = std::numeric_limits<Scalar>::infinity();
+    hoomd::detail::Saru rng(1, 2, 3);
+
+    for (unsigned int i = 0; i < 1000; ++i)
+        {
+        vec3<Scalar> p(rng.s<Scalar>(-3,3), rng.s<Scalar>(-3,3), rng.s<Scalar>(-3,3));
+
+        // distance to the surface of the cube
+        vec3<Scalar> outside(std::max(fabs(p.x)-1, Scalar(0)), std::max(fabs(p.y)-1, Scalar(0)),
+            std::max(fabs(p.z)-1, Scalar(0)));
+        bool inside = (fabs(p.x) < 1 && fabs(p.y) < 1 && fabs(p.z) < 1);
+        Scalar r = inside ? std::min(1-fabs(p.x), std::min(1-fabs(p.y), 1-fabs(p.z))) : sqrt(dot(outside,outside));
+
+        vec3<Scalar> dx, n;
+        UP_ASSERT(mesh->findNearest(p, inf, dx, n));
+        MY_CHECK_CLOSE(sqrt(dot(dx,dx)), r, tol);
+        UP_ASSERT_EQUAL(dot(-dx, n) < 0, inside);
+        }
+    }